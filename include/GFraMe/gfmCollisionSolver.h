@@ -0,0 +1,109 @@
+/**
+ * @file include/GFraMe/gfmCollisionSolver.h
+ *
+ * Resolve every contact found on a frame at once, instead of separating each
+ * pair as soon as the broadphase reports it; Pairs are gathered (e.g., from
+ * gfmQuadtree_getOverlaping or gfmGroup_collideGroups) and then solved
+ * together, in an order that doesn't depend on the broadphase: vertical
+ * contacts are solved from the bottom up (so objects resting on fixed ones
+ * are treated as fixed by whatever is stacked above them) and then horizontal
+ * ones; This is repeated a fixed number of times, so piles and crowds settle
+ * without jittering;
+ * Collision flags are set exactly as gfmObject_collide would (through
+ * gfmObject_justOverlaped), and fixed objects (see gfmObject_setFixed) and
+ * hitboxes are never moved
+ */
+#ifndef __GFMCOLLISIONSOLVER_STRUCT__
+#define __GFMCOLLISIONSOLVER_STRUCT__
+
+/** Collision solver, with every pair added on the current frame */
+typedef struct stGFMCollisionSolver gfmCollisionSolver;
+
+#endif /* __GFMCOLLISIONSOLVER_STRUCT__ */
+
+#ifndef __GFMCOLLISIONSOLVER_H__
+#define __GFMCOLLISIONSOLVER_H__
+
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmGroup.h>
+#include <GFraMe/gfmObject.h>
+
+/**
+ * Alloc a new collision solver
+ *
+ * @param  [out]ppCtx The alloc'ed solver
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmCollisionSolver_getNew(gfmCollisionSolver **ppCtx);
+
+/**
+ * Release a collision solver and all its members
+ *
+ * @param  [ in]ppCtx The solver
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmCollisionSolver_free(gfmCollisionSolver **ppCtx);
+
+/**
+ * Clean all memory used by the solver
+ *
+ * @param  [ in]pCtx The solver
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmCollisionSolver_clean(gfmCollisionSolver *pCtx);
+
+/**
+ * Set how many times every contact is solved (4, by default)
+ *
+ * @param  [ in]pCtx The solver
+ * @param  [ in]num  Number of iterations
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmCollisionSolver_setIterations(gfmCollisionSolver *pCtx, int num);
+
+/**
+ * Start a new frame, discarding every pair previously added
+ *
+ * @param  [ in]pCtx The solver
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmCollisionSolver_init(gfmCollisionSolver *pCtx);
+
+/**
+ * Add a pair of overlapping objects (or an object and a hitbox) to be solved;
+ * Pairs may be added more than once (and in any order), as duplicates are
+ * removed when solving
+ *
+ * @param  [ in]pCtx   The solver
+ * @param  [ in]pSelf  An object
+ * @param  [ in]pOther Another object
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED,
+ *                     GFMRV_OBJECT_NOT_INITIALIZED, GFMRV_INVALID_TYPE,
+ *                     GFMRV_OBJECTS_CANT_COLLIDE
+ */
+gfmRV gfmCollisionSolver_addPair(gfmCollisionSolver *pCtx, gfmObject *pSelf,
+        gfmObject *pOther);
+
+/**
+ * Add every pair retrieved by gfmGroup_collideGroups
+ *
+ * @param  [ in]pCtx   The solver
+ * @param  [ in]pPairs The pairs
+ * @param  [ in]num    How many pairs there are
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED,
+ *                     GFMRV_OBJECT_NOT_INITIALIZED, GFMRV_INVALID_TYPE,
+ *                     GFMRV_OBJECTS_CANT_COLLIDE
+ */
+gfmRV gfmCollisionSolver_addPairs(gfmCollisionSolver *pCtx,
+        gfmGroupPair *pPairs, int num);
+
+/**
+ * Set the collision flags of every pair and separate them
+ *
+ * @param  [ in]pCtx The solver
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmCollisionSolver_solve(gfmCollisionSolver *pCtx);
+
+#endif /* __GFMCOLLISIONSOLVER_H__ */
+
@@ -186,6 +186,19 @@ enum enGFMError {
     // Texture erro (p. 2)
     GFMRV_TEXTURE_UNSUPPORTED,
     GFMRV_INVALID_TYPE,
+    // Thread pool errors
+    GFMRV_THREADPOOL_CREATE_FAILED,
+    // Quadtree errors (p. 2)
+    GFMRV_QUADTREE_INVALID_MODE,
+    // Spatial grid errors
+    GFMRV_SPATIALGRID_NOT_INITIALIZED,
+    GFMRV_SPATIALGRID_OPERATION_NOT_ACTIVE,
+    GFMRV_SPATIALGRID_OVERLAPED,
+    GFMRV_SPATIALGRID_NO_OVERLAP,
+    GFMRV_SPATIALGRID_DONE,
+    // Particle system errors
+    GFMRV_PARTICLES_MAX_PARTICLES,
+    GFMRV_PARTICLES_NO_LAST_PARTICLE,
     GFMRV_MAX
 }; /* enum enGFMError */
 typedef enum enGFMError gfmRV;
@@ -43,6 +43,8 @@ typedef struct stGFMGroupNode gfmGroupNode;
 typedef enum enGFMDrawOrder gfmDrawOrder;
 /** 'Exports' the gfmGroupCollision enumeration */
 typedef enum enGFMGroupCollision gfmGroupCollision;
+/** Overlap reported by gfmGroup_collideGroups */
+typedef struct stGFMGroupPair gfmGroupPair;
 
 #endif /* __GFMGROUP_STRUCT__ */
 
@@ -93,6 +95,14 @@ enum enGFMGroupCollision {
     gfmCollisionQuality_max
 };
 
+/** Overlap reported by gfmGroup_collideGroups */
+struct stGFMGroupPair {
+    /** The object from the first group */
+    gfmObject *pSelf;
+    /** The object from the second group */
+    gfmObject *pOther;
+};
+
 /**
  * Alloc a new group
  * 
@@ -226,6 +236,17 @@ gfmRV gfmGroup_setDefVelocity(gfmGroup *pCtx, int vx, int vy);
  */
 gfmRV gfmGroup_setDefAcceleration(gfmGroup *pCtx, int ax, int ay);
 
+/**
+ * Set for how many frames every recycled sprite must stand still before
+ * falling asleep (see gfmObject_setSleepDelay)
+ *
+ * @param  pCtx   The group
+ * @param  frames Number of frames; 0 (the default) makes the sprites never
+ *                sleep
+ * @return        GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmGroup_setDefSleepDelay(gfmGroup *pCtx, int frames);
+
 /**
  * Set whether every recycle sprite should 'die' when it leaves the screen
  * 
@@ -330,6 +351,63 @@ gfmRV gfmGroup_setDrawOrder(gfmGroup *pCtx, gfmDrawOrder order);
  */
 gfmRV gfmGroup_setCollisionQuality(gfmGroup *pCtx, gfmGroupCollision col);
 
+/**
+ * Cap how many sprites may be collideable on each frame; After the collision
+ * quality selects its sprites, only the ones that were deferred for the most
+ * frames are kept (so every sprite gets its turn), while the others are
+ * deferred to a later frame
+ *
+ * NOTE: This caps the number of sprites sent to the quadtree, not the number
+ * of overlap tests done with them (which still depends on how they are
+ * spread)
+ *
+ * @param  pCtx The group
+ * @param  max  Maximum number of collideable sprites per frame; 0 disables
+ *              the cap
+ * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmGroup_setMaxCollideable(gfmGroup *pCtx, int max);
+
+/**
+ * Get how many sprites were left out of the collideable list (to stay within
+ * the cap set by gfmGroup_setMaxCollideable) on the last update
+ *
+ * @param  pNum How many sprites were deferred
+ * @param  pCtx The group
+ * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmGroup_getDeferredSprites(int *pNum, gfmGroup *pCtx);
+
+/**
+ * Get how many of the group's live sprites were asleep on the last update
+ *
+ * @param  pNum How many sprites were asleep
+ * @param  pCtx The group
+ * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmGroup_getSleepingCount(int *pNum, gfmGroup *pCtx);
+
+/**
+ * Set how many threads gfmGroup_update may use; The active sprites are split
+ * into chunks, each updated (and checked against the camera) by any of the
+ * threads, and the results are merged afterward, so the active, visible and
+ * collideable lists are the same as if updated by a single thread
+ *
+ * NOTE: Sprites are updated concurrently; Each worker only writes to its own
+ * sprites (their objects, timers and animations, since every sprite has its
+ * own gfmAnimation and only reads the shared animation data) and to the
+ * sprites' own draw nodes; The game's context (i.e., the elapsed time), the
+ * camera and the spritesets are only read, so they must not be modified (nor
+ * shared with a sprite outside of the group) while gfmGroup_update runs
+ *
+ * @param  pCtx       The group
+ * @param  numThreads How many threads should be used (including the calling
+ *                    one); 1 disables threading
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED,
+ *                    GFMRV_THREADPOOL_CREATE_FAILED
+ */
+gfmRV gfmGroup_setThreads(gfmGroup *pCtx, int numThreads);
+
 /**
  * Get the list of collideable objects
  * 
@@ -339,6 +417,44 @@ gfmRV gfmGroup_setCollisionQuality(gfmGroup *pCtx, gfmGroupCollision col);
  */
 gfmRV gfmGroup_getCollideableList(gfmGroupNode **ppList, gfmGroup *pCtx);
 
+/**
+ * Collide every collideable object from a group against every collideable
+ * object from another one, without any quadtree; Both lists (as built by
+ * gfmGroup_update) are sorted by their objects' left edge and swept together,
+ * storing every overlap into a buffer
+ *
+ * If the buffer gets filled, GFMRV_QUADTREE_OVERLAPED is returned and
+ * gfmGroup_continueCollision must be called (after handling the pairs) to
+ * resume the operation
+ *
+ * NOTE: Only objects within the other group's widest object from each other
+ * are tested, so a single huge object makes every one of them be tested
+ *
+ * @param  [out]pPairs   Buffer that will be filled with the overlaps
+ * @param  [out]pCount   How many overlaps were stored on the buffer
+ * @param  [ in]pSelf    The first group (which keeps the operation's state)
+ * @param  [ in]pOther   The second group
+ * @param  [ in]maxPairs How many overlaps fit on the buffer
+ * @return               GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED,
+ *                       GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmGroup_collideGroups(gfmGroupPair *pPairs, int *pCount,
+        gfmGroup *pSelf, gfmGroup *pOther, int maxPairs);
+
+/**
+ * Continue a collision between groups, after its buffer was filled
+ *
+ * @param  [out]pPairs   Buffer that will be filled with the overlaps
+ * @param  [out]pCount   How many overlaps were stored on the buffer
+ * @param  [ in]pSelf    The first group
+ * @param  [ in]maxPairs How many overlaps fit on the buffer
+ * @return               GFMRV_ARGUMENTS_BAD,
+ *                       GFMRV_QUADTREE_OPERATION_NOT_ACTIVE,
+ *                       GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmGroup_continueCollision(gfmGroupPair *pPairs, int *pCount,
+        gfmGroup *pSelf, int maxPairs);
+
 /**
  * Get the next collideable sprite
  * 
@@ -6,6 +6,12 @@
  * Since this is the base type to be passed to the quadtree for
  * overlaping/collision, it also has info about it's "child type" (e.g., a
  * gfmSprite pointer and the type T_GFMSPRITE)
+ * When compiled with FIXED_POINT_PHYSICS, every physical attribute is kept
+ * (and integrated) in 16.16 fixed point, so the simulation is deterministic;
+ * The functions still take and return doubles, which are converted on the
+ * way in/out; Since that only fits values within [-32768, 32768), setting
+ * anything outside it fails with GFMRV_ARGUMENTS_BAD (and integrating past it
+ * overflows)
  */
 #ifndef __GFMOBJECT_STRUCT__
 #define __GFMOBJECT_STRUCT__
@@ -444,6 +450,37 @@ gfmRV gfmObject_setFixed(gfmObject *pCtx);
  */
 gfmRV gfmObject_setMovable(gfmObject *pCtx);
 
+/**
+ * Set for how many frames the object must stand still (i.e., without velocity,
+ * acceleration nor any change to its position) before falling asleep; A
+ * sleeping object isn't integrated (nor are its collision flags cleared) and
+ * isn't collided against other sleeping objects nor the quadtree's static
+ * layer; It's woken as soon as it's moved (e.g., by a collision or a call to
+ * gfmObject_setPosition) or its velocity or acceleration is modified
+ *
+ * @param  [ in]pCtx   The object
+ * @param  [ in]frames Number of frames; 0 (the default) makes the object never
+ *                     sleep
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_INVALID_TYPE
+ */
+gfmRV gfmObject_setSleepDelay(gfmObject *pCtx, int frames);
+
+/**
+ * Check whether the object is asleep
+ *
+ * @param  [ in]pCtx The object (or a hitbox, which never sleeps)
+ * @return           GFMRV_TRUE, GFMRV_FALSE, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmObject_isAsleep(gfmObject *pCtx);
+
+/**
+ * Wake the object, so it's integrated (and collided) again
+ *
+ * @param  [ in]pCtx The object
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_INVALID_TYPE
+ */
+gfmRV gfmObject_wake(gfmObject *pCtx);
+
 /**
  * Apply another object's translation into this object
  *
@@ -490,6 +527,33 @@ gfmRV gfmObject_applyDeltaY(gfmObject *pCtx, gfmObject *pOther);
  */
 gfmRV gfmObject_update(gfmObject *pObj, gfmCtx *pCtx);
 
+/**
+ * Update many objects at once; This has the same result as calling
+ * gfmObject_update on each object, but the elapsed time is retrieved only once
+ * and every object is validated before any is modified
+ *
+ * @param  [ in]ppObjs The objects
+ * @param  [ in]num    How many objects there are
+ * @param  [ in]pCtx   The game's context
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_INVALID_TYPE,
+ *                     GFMRV_OBJECT_NOT_INITIALIZED
+ */
+gfmRV gfmObject_updateMany(gfmObject **ppObjs, int num, gfmCtx *pCtx);
+
+/**
+ * Update every object on a contiguous array (i.e., objects placed
+ * sizeofGFMObject bytes apart); This has the same result as calling
+ * gfmObject_update on each object, but the elapsed time is retrieved only once
+ * and every object is validated before any is modified
+ *
+ * @param  [ in]pObjs The first object on the array
+ * @param  [ in]num   How many objects there are
+ * @param  [ in]pCtx  The game's context
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_INVALID_TYPE,
+ *                    GFMRV_OBJECT_NOT_INITIALIZED
+ */
+gfmRV gfmObject_updateArray(gfmObject *pObjs, int num, gfmCtx *pCtx);
+
 /**
  * Get the distance between two objects' centers
  * 
@@ -594,6 +658,37 @@ gfmRV gfmObject_justOverlapedHitbox(gfmObject *pObj, gfmHitbox *pHitbox);
  */
 gfmRV gfmObject_justOverlaped(gfmObject *pSelf, gfmObject *pOther);
 
+/**
+ * Retrieve the area swept by an object since its last update (i.e., the
+ * smallest box that contains both its previous and its current hitbox)
+ *
+ * @param  [out]pX      The area's top-left position
+ * @param  [out]pY      The area's top-left position
+ * @param  [out]pWidth  The area's width
+ * @param  [out]pHeight The area's height
+ * @param  [ in]pCtx    The object (or hitbox)
+ * @return              GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                      GFMRV_OBJECT_NOT_INITIALIZED
+ */
+gfmRV gfmObject_getSweptArea(int *pX, int *pY, int *pWidth, int *pHeight,
+        gfmObject *pCtx);
+
+/**
+ * Check if two objects touched at any moment while moving from their previous
+ * position to their current one (assuming both moved linearly), so fast
+ * objects can't go through thin ones
+ *
+ * @param  [out]pTime  When the objects first touched, in the range [0, 1]
+ *                     (where 0 is their previous position and 1 their
+ *                     current one)
+ * @param  [ in]pSelf  An object (or hitbox)
+ * @param  [ in]pOther An object (or hitbox)
+ * @return             GFMRV_TRUE, GFMRV_FALSE, GFMRV_ARGUMENTS_BAD,
+ *                     GFMRV_OBJECT_NOT_INITIALIZED
+ */
+gfmRV gfmObject_sweptOverlap(double *pTime, gfmObject *pSelf,
+        gfmObject *pOther);
+
 /**
  * Separate an object and a hitbox in the Y axis
  * 
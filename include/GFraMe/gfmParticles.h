@@ -0,0 +1,219 @@
+/**
+ * @file include/GFraMe/gfmParticles.h
+ *
+ * Particle system that stores every particle's attribute on parallel arrays
+ * (i.e., a structure-of-arrays), instead of on individually alloc'ed
+ * sprites/objects (as gfmGroup does); It's meant for things that spawn in huge
+ * numbers and only move, die and get drawn (e.g., explosions, sparks, rain);
+ * Particles can't be collided nor animated, but, other than that, they follow
+ * gfmGroup's concepts: there are default values set on every new particle
+ * (velocity, acceleration, frame, time to live and whether it should die when
+ * leaving the screen), and the attributes of the last spawned particle may be
+ * modified right after spawning it;
+ * Updating integrates every particle (the same way gfmObject does, but
+ * without drag) and then removes every dead particle, keeping the remaining
+ * ones on the order they were spawned (so they are drawn from the oldest to
+ * the newest); Drawing sends the visible particles straight to the video
+ * backend
+ */
+#ifndef __GFMPARTICLES_STRUCT__
+#define __GFMPARTICLES_STRUCT__
+
+/** 'Exports' the gfmParticles structure */
+typedef struct stGFMParticles gfmParticles;
+
+#endif /* __GFMPARTICLES_STRUCT__ */
+
+#ifndef __GFMPARTICLES_H__
+#define __GFMPARTICLES_H__
+
+#include <GFraMe/gframe.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmSpriteset.h>
+
+/**
+ * Alloc a new particle system
+ *
+ * @param  [out]ppCtx The particle system
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmParticles_getNew(gfmParticles **ppCtx);
+
+/**
+ * Release a particle system and all of its memory
+ *
+ * @param  [ in]ppCtx The particle system
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_free(gfmParticles **ppCtx);
+
+/**
+ * Release every particle (and its arrays) and reset the defaults
+ *
+ * @param  [ in]pCtx The particle system
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_clean(gfmParticles *pCtx);
+
+/**
+ * Alloc the particles' arrays and set the spriteset used to draw them; Any
+ * previously spawned particle is removed
+ *
+ * @param  [ in]pCtx   The particle system
+ * @param  [ in]pSset  The spriteset
+ * @param  [ in]maxLen How many particles may be alive at once
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmParticles_init(gfmParticles *pCtx, gfmSpriteset *pSset, int maxLen);
+
+/**
+ * Set the default velocity on every spawned particle
+ *
+ * @param  [ in]pCtx The particle system
+ * @param  [ in]vx   The horizontal velocity
+ * @param  [ in]vy   The vertical velocity
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_setDefVelocity(gfmParticles *pCtx, int vx, int vy);
+
+/**
+ * Set the default acceleration on every spawned particle
+ *
+ * @param  [ in]pCtx The particle system
+ * @param  [ in]ax   The horizontal acceleration
+ * @param  [ in]ay   The vertical acceleration
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_setDefAcceleration(gfmParticles *pCtx, int ax, int ay);
+
+/**
+ * Set the default frame on every spawned particle
+ *
+ * @param  [ in]pCtx  The particle system
+ * @param  [ in]frame The frame
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_setDefFrame(gfmParticles *pCtx, int frame);
+
+/**
+ * Set whether every particle should 'die' when it leaves the screen
+ *
+ * NOTE: This is a "global" attribute and it will take effect on every
+ * particle AS SOON as it's assigned
+ *
+ * @param  [ in]pCtx  The particle system
+ * @param  [ in]doDie Whether the particles should die or not
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_setDeathOnLeave(gfmParticles *pCtx, int doDie);
+
+/**
+ * Set for how long every spawned particle should live
+ *
+ * @param  [ in]pCtx The particle system
+ * @param  [ in]ttl  Time to live, in milliseconds (-1 for infinite)
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_setDeathOnTime(gfmParticles *pCtx, int ttl);
+
+/**
+ * Spawn a new particle, with the default attributes, at the desired position
+ *
+ * @param  [ in]pCtx The particle system
+ * @param  [ in]x    Horizontal position (top-left corner of its tile)
+ * @param  [ in]y    Vertical position (top-left corner of its tile)
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_NOT_INITIALIZED,
+ *                   GFMRV_PARTICLES_MAX_PARTICLES
+ */
+gfmRV gfmParticles_spawn(gfmParticles *pCtx, int x, int y);
+
+/**
+ * Set the velocity of the last spawned particle
+ *
+ * @param  [ in]pCtx The particle system
+ * @param  [ in]vx   The horizontal velocity
+ * @param  [ in]vy   The vertical velocity
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_PARTICLES_NO_LAST_PARTICLE
+ */
+gfmRV gfmParticles_setVelocity(gfmParticles *pCtx, int vx, int vy);
+
+/**
+ * Set the acceleration of the last spawned particle
+ *
+ * @param  [ in]pCtx The particle system
+ * @param  [ in]ax   The horizontal acceleration
+ * @param  [ in]ay   The vertical acceleration
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_PARTICLES_NO_LAST_PARTICLE
+ */
+gfmRV gfmParticles_setAcceleration(gfmParticles *pCtx, int ax, int ay);
+
+/**
+ * Set the frame of the last spawned particle
+ *
+ * @param  [ in]pCtx  The particle system
+ * @param  [ in]frame The frame
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                    GFMRV_PARTICLES_NO_LAST_PARTICLE
+ */
+gfmRV gfmParticles_setFrame(gfmParticles *pCtx, int frame);
+
+/**
+ * Set whether the last spawned particle should be drawn flipped
+ *
+ * @param  [ in]pCtx      The particle system
+ * @param  [ in]isFlipped Whether it's flipped
+ * @return                GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                        GFMRV_PARTICLES_NO_LAST_PARTICLE
+ */
+gfmRV gfmParticles_setFlipped(gfmParticles *pCtx, int isFlipped);
+
+/**
+ * Set for how long the last spawned particle should live
+ *
+ * @param  [ in]pCtx The particle system
+ * @param  [ in]ttl  Time to live, in milliseconds (-1 for infinite)
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_PARTICLES_NO_LAST_PARTICLE
+ */
+gfmRV gfmParticles_setTimeToLive(gfmParticles *pCtx, int ttl);
+
+/**
+ * Retrieve how many particles are alive
+ *
+ * @param  [out]pCount How many particles are alive
+ * @param  [ in]pCtx   The particle system
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_getCount(int *pCount, gfmParticles *pCtx);
+
+/**
+ * Integrate every particle and remove the dead ones
+ *
+ * @param  [ in]pParts The particle system
+ * @param  [ in]pCtx   The game's context
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, ...
+ */
+gfmRV gfmParticles_update(gfmParticles *pParts, gfmCtx *pCtx);
+
+/**
+ * Draw every visible particle, from the oldest to the newest
+ *
+ * @param  [ in]pParts The particle system
+ * @param  [ in]pCtx   The game's context
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                     GFMRV_BACKBUFFER_NOT_INITIALIZED, ...
+ */
+gfmRV gfmParticles_draw(gfmParticles *pParts, gfmCtx *pCtx);
+
+/**
+ * Remove every particle
+ *
+ * @param  [ in]pCtx The particle system
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_killAll(gfmParticles *pCtx);
+
+#endif /* __GFMPARTICLES_H__ */
+
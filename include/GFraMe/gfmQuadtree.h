@@ -12,6 +12,11 @@
  * Therefore, the proper way to use this would be to create the root node,
  * populate it with all the static 'objects' (e.g., tilemap, particles, etc) and
  * then add all the collideable 'objects';
+ * Geometry that never changes may instead be added only once to a separate
+ * static layer (through gfmQuadtree_initStatic and
+ * gfmQuadtree_populateStatic*), which is kept across gfmQuadtree_initRoot
+ * calls; Collided objects are tested against both layers, but only inserted
+ * into the dynamic one;
  * On success, gfmQuadtree_collide and gfmQuadtree_continue  can return in one
  * of a two ways:
  *   - GFMRV_QUADTREE_OVERLAPED: signs that an overlap just happened and should
@@ -23,12 +28,44 @@
  *   calling gfmSprite_getChild would return its 'sub-class'; This was a way to
  *   emulate (in a quite simple way) OOP in C;
  *   - GFMRV_QUADTREE_DONE: the 'object' was successfully added to the quadtree;
+ * Each pair of objects is reported at most once per frame (i.e., between calls
+ * to gfmQuadtree_initRoot), even if both objects share more than one leaf;
+ * Pairs whose types don't interact (as set by gfmQuadtree_setInteraction) are
+ * skipped without ever being tested;
+ * Alternatively, gfmQuadtree_collide*Batch store every overlap into a
+ * caller-provided buffer of gfmQuadtreePair (halting only if the buffer gets
+ * filled, in which case gfmQuadtree_continueBatch must be called);
+ * Lastly, objects may be added through gfmQuadtree_defer* and then collided
+ * all at once by gfmQuadtree_collideDeferred, which splits the work between
+ * worker threads (set by gfmQuadtree_setThreads) and returns every overlap in
+ * a deterministic order;
+ * The objects on both layers may also be searched (without modifying the
+ * quadtree) through gfmQuadtree_queryRect, gfmQuadtree_queryPoint and
+ * gfmQuadtree_queryRay;
+ * Fast objects may be kept from going through thin ones by enabling the
+ * continuous mode (gfmQuadtree_setContinuous), which collides the area swept by
+ * each object since its last update and reports when each pair first touched;
+ * When most objects are always present and move only a little between frames,
+ * the incremental mode (gfmQuadtree_initIncremental) keeps the dynamic layer
+ * across frames instead of rebuilding it: tracked objects are only moved when
+ * they cross a leaf's bounds (on gfmQuadtree_refresh) and are collided by
+ * gfmQuadtree_collideDeferred;
+ * Layers with objects of very different sizes may use the loose mode
+ * (gfmQuadtree_setLoose), which expands each node's bounds so every object is
+ * kept on a single node;
+ * How the objects are distributed through each layer (and how many pairs were
+ * tested) may be retrieved through gfmQuadtree_getStats, which helps tuning
+ * maxDepth and maxNodes;
  */
 #ifndef __GFMQUADTREE_STRUCT__
 #define __GFMQUADTREE_STRUCT__
 
 /** Quadtree's context, with the current stack and the the root node */
 typedef struct stGFMQuadtreeRoot gfmQuadtreeRoot;
+/** Overlap reported by the batched collision functions */
+typedef struct stGFMQuadtreePair gfmQuadtreePair;
+/** Counters describing a layer, as retrieved by gfmQuadtree_getStats */
+typedef struct stGFMQuadtreeStats gfmQuadtreeStats;
 
 #endif /* __GFMQUADTREE_STRUCT__ */
 
@@ -37,10 +74,62 @@ typedef struct stGFMQuadtreeRoot gfmQuadtreeRoot;
 
 #include <GFraMe/gfmError.h>
 #include <GFraMe/gfmGroup.h>
+#include <GFraMe/gfmHitbox.h>
 #include <GFraMe/gfmObject.h>
 #include <GFraMe/gfmSprite.h>
 #include <GFraMe/gfmTilemap.h>
 
+/** Overlap reported by the batched collision functions */
+struct stGFMQuadtreePair {
+    /** The object that was being added to the quadtree */
+    gfmObject *pSelf;
+    /** The object (already on the quadtree) that was overlapped */
+    gfmObject *pOther;
+    /** Index of the leaf where both objects were found (only valid until the
+     * next gfmQuadtree_initRoot) */
+    int node;
+    /** Whether pOther (and the leaf) belongs to the static layer */
+    int isStatic;
+    /** When both objects first touched, in the range [0, 1] (only set on
+     * continuous mode; otherwise, it's always 0) */
+    double time;
+};
+
+/** Length of the arrays on gfmQuadtreeStats */
+enum enGFMQuadtreeStats {
+    gfmQuadtreeStats_len = 16
+};
+
+/** Counters describing a layer, as retrieved by gfmQuadtree_getStats */
+struct stGFMQuadtreeStats {
+    /** How many nodes are in use */
+    int nodes;
+    /** How many of those are leaves */
+    int leaves;
+    /** Deepest level reached by any node (where the root is 0) */
+    int depth;
+    /** How many list cells are in use (i.e., objects, counted once for each
+     * leaf they are in) */
+    int cells;
+    /** How many bytes were alloc'ed for the nodes and cells */
+    int bytes;
+    /** How many nodes are on each level (the last entry also counts every
+     * deeper level) */
+    int nodesPerDepth[gfmQuadtreeStats_len];
+    /** How many cells are on each level (the last entry also counts every
+     * deeper level) */
+    int cellsPerDepth[gfmQuadtreeStats_len];
+    /** Histogram of how many objects are in each leaf (or in each node, on
+     * loose mode); The last entry also counts every fuller leaf */
+    int objectsPerLeaf[gfmQuadtreeStats_len];
+    /** How many pairs were tested against the layer's objects, on the current
+     * frame */
+    int overlapTests;
+    /** How many overlaps were reported against the layer's objects, on the
+     * current frame */
+    int pairs;
+};
+
 /**
  * Alloc a new root quadtree
  * 
@@ -168,6 +257,368 @@ gfmRV gfmQuadtree_populateSprite(gfmQuadtreeRoot *pCtx, gfmSprite *pSpr);
  */
 gfmRV gfmQuadtree_populateTilemap(gfmQuadtreeRoot *pCtx, gfmTilemap *pTMap);
 
+/**
+ * Initialize the static layer, removing anything previously added to it
+ *
+ * The static layer is kept across frames (i.e., it isn't modified by
+ * gfmQuadtree_initRoot) and every collided object is tested against it before
+ * being added to the dynamic layer; This way, the level's geometry may be
+ * added only once
+ *
+ * @param  [ in]pCtx     The quadtree's root
+ * @param  [ in]x        The static layer's top-left position
+ * @param  [ in]y        The static layer's top-left position
+ * @param  [ in]width    The static layer's width
+ * @param  [ in]height   The static layer's height
+ * @param  [ in]maxDepth How many levels can the static layer branch
+ * @param  [ in]maxNodes How many objects a subtree can have until it must split
+ * @return               GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmQuadtree_initStatic(gfmQuadtreeRoot *pCtx, int x, int y, int width,
+        int height, int maxDepth, int maxNodes);
+
+/**
+ * Remove the static layer, so objects are only collided against the dynamic
+ * one
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmQuadtree_clearStatic(gfmQuadtreeRoot *pCtx);
+
+/**
+ * Add an object to the static layer
+ *
+ * NOTE: The object must be kept alive until the static layer is cleared!
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @param  [ in]pObj The gfmObject
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_QUADTREE_NOT_INITIALIZED
+ */
+gfmRV gfmQuadtree_populateStaticObject(gfmQuadtreeRoot *pCtx, gfmObject *pObj);
+
+/**
+ * Add a list of hitboxes to the static layer
+ *
+ * NOTE: The list must be kept alive until the static layer is cleared!
+ *
+ * @param  [ in]pCtx  The quadtree's root
+ * @param  [ in]pList The list of hitboxes
+ * @param  [ in]count How many hitboxes there are on the list
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                    GFMRV_QUADTREE_NOT_INITIALIZED
+ */
+gfmRV gfmQuadtree_populateStaticHitboxes(gfmQuadtreeRoot *pCtx,
+        gfmHitbox *pList, int count);
+
+/**
+ * Add a tilemap's areas to the static layer
+ *
+ * NOTE: The tilemap must not be modified until the static layer is cleared!
+ *
+ * @param  [ in]pCtx  The quadtree's root
+ * @param  [ in]pTMap The tilemap
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                    GFMRV_QUADTREE_NOT_INITIALIZED
+ */
+gfmRV gfmQuadtree_populateStaticTilemap(gfmQuadtreeRoot *pCtx,
+        gfmTilemap *pTMap);
+
+/**
+ * Set whether two types of objects interact with each other; Pairs that don't
+ * interact are skipped while colliding, never being tested for overlap nor
+ * reported
+ *
+ * Only the lowest 5 bits of each type are used (the same ones used as colors
+ * by gfmQuadtree_drawBounds); Objects added to the static layer keep the type
+ * they had when added
+ *
+ * @param  [ in]pCtx       The quadtree's root
+ * @param  [ in]type1      One of the types
+ * @param  [ in]type2      The other type
+ * @param  [ in]doInteract Whether the types should interact
+ * @return                 GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmQuadtree_setInteraction(gfmQuadtreeRoot *pCtx, int type1, int type2,
+        int doInteract);
+
+/**
+ * Make every type interact with every other (which is the default)
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmQuadtree_resetInteractions(gfmQuadtreeRoot *pCtx);
+
+/**
+ * Set how many threads gfmQuadtree_collideDeferred may use
+ *
+ * @param  [ in]pCtx       The quadtree's root
+ * @param  [ in]numThreads How many threads should be used (including the
+ *                         calling one); 1 disables threading
+ * @return                 GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED,
+ *                         GFMRV_THREADPOOL_CREATE_FAILED
+ */
+gfmRV gfmQuadtree_setThreads(gfmQuadtreeRoot *pCtx, int numThreads);
+
+/**
+ * Add an object to the quadtree, deferring its collision until
+ * gfmQuadtree_collideDeferred is called
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @param  [ in]pObj The gfmObject
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmQuadtree_deferObject(gfmQuadtreeRoot *pCtx, gfmObject *pObj);
+
+/**
+ * Add every collideable object from a group to the quadtree, deferring their
+ * collision until gfmQuadtree_collideDeferred is called
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @param  [ in]pGrp The gfmGroup
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmQuadtree_deferGroup(gfmQuadtreeRoot *pCtx, gfmGroup *pGrp);
+
+/**
+ * Collide every deferred object against both layers, splitting the work
+ * between the threads set by gfmQuadtree_setThreads; The overlaps are returned
+ * in the same order (and from the same point of view) as if the objects had
+ * been added by gfmQuadtree_collideObject, regardless of how many threads were
+ * used; On continuous mode, they are ordered by their time of impact instead;
+ * On incremental mode, every tracked object is collided (ordered by their
+ * handles)
+ *
+ * NOTE: The returned buffer is owned by the quadtree and is kept valid until
+ * either this function or gfmQuadtree_initRoot is called again
+ *
+ * @param  [out]ppPairs Every overlap found
+ * @param  [out]pCount  How many overlaps were found
+ * @param  [ in]pCtx    The quadtree's root
+ * @return              GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                      GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmQuadtree_collideDeferred(gfmQuadtreePair **ppPairs, int *pCount,
+        gfmQuadtreeRoot *pCtx);
+
+/**
+ * Retrieve every object (from both layers) that touches an area, without
+ * modifying the quadtree; Objects are returned in the order they were added
+ * (with the ones on the static layer first)
+ *
+ * NOTE: This may be safely called while handling an overlap
+ *
+ * @param  [out]ppObjs  Buffer that will be filled with the objects
+ * @param  [out]pCount  How many objects were stored on the buffer
+ * @param  [ in]pCtx    The quadtree's root
+ * @param  [ in]x       The area's top-left position
+ * @param  [ in]y       The area's top-left position
+ * @param  [ in]width   The area's width
+ * @param  [ in]height  The area's height
+ * @param  [ in]maxObjs How many objects fit on the buffer
+ * @return              GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                      GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED,
+ *                      GFMRV_BUFFER_TOO_SMALL (the buffer was filled, but
+ *                      more objects were found)
+ */
+gfmRV gfmQuadtree_queryRect(gfmObject **ppObjs, int *pCount,
+        gfmQuadtreeRoot *pCtx, int x, int y, int width, int height,
+        int maxObjs);
+
+/**
+ * Retrieve every object (from both layers) that touches a point, without
+ * modifying the quadtree; Objects are returned in the order they were added
+ * (with the ones on the static layer first)
+ *
+ * NOTE: This may be safely called while handling an overlap
+ *
+ * @param  [out]ppObjs  Buffer that will be filled with the objects
+ * @param  [out]pCount  How many objects were stored on the buffer
+ * @param  [ in]pCtx    The quadtree's root
+ * @param  [ in]x       The point's position
+ * @param  [ in]y       The point's position
+ * @param  [ in]maxObjs How many objects fit on the buffer
+ * @return              GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                      GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED,
+ *                      GFMRV_BUFFER_TOO_SMALL (the buffer was filled, but
+ *                      more objects were found)
+ */
+gfmRV gfmQuadtree_queryPoint(gfmObject **ppObjs, int *pCount,
+        gfmQuadtreeRoot *pCtx, int x, int y, int maxObjs);
+
+/**
+ * Retrieve every object (from both layers) crossed by a segment, without
+ * modifying the quadtree; Objects are returned ordered by their distance to
+ * the segment's start (so the first one is the one that blocks a line of
+ * sight)
+ *
+ * NOTE: This may be safely called while handling an overlap
+ *
+ * @param  [out]ppObjs  Buffer that will be filled with the objects
+ * @param  [out]pCount  How many objects were stored on the buffer
+ * @param  [ in]pCtx    The quadtree's root
+ * @param  [ in]x0      The segment's start
+ * @param  [ in]y0      The segment's start
+ * @param  [ in]x1      The segment's end
+ * @param  [ in]y1      The segment's end
+ * @param  [ in]maxObjs How many objects fit on the buffer
+ * @return              GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                      GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED,
+ *                      GFMRV_BUFFER_TOO_SMALL (the buffer was filled with the
+ *                      nearest objects, but more were found)
+ */
+gfmRV gfmQuadtree_queryRay(gfmObject **ppObjs, int *pCount,
+        gfmQuadtreeRoot *pCtx, int x0, int y0, int x1, int y1, int maxObjs);
+
+/**
+ * Enable (or disable) the continuous mode; On it, objects are inserted into
+ * (and tested against) the quadtree by the area swept since their last update,
+ * and pairs overlap if they touched at any moment during that movement; This
+ * avoids fast objects going through thin ones (e.g., tilemap areas), at the
+ * cost of fatter objects
+ *
+ * The time of each overlap may be retrieved through
+ * gfmQuadtree_getTimeOfImpact (or from the pair's time, on the batched
+ * functions); gfmQuadtree_collideDeferred returns pairs ordered by it
+ *
+ * NOTE: This should be set before populating either layer
+ *
+ * @param  [ in]pCtx         The quadtree's root
+ * @param  [ in]isContinuous Whether continuous mode should be enabled
+ * @return                   GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmQuadtree_setContinuous(gfmQuadtreeRoot *pCtx, int isContinuous);
+
+/**
+ * Retrieve when the current overlap happened, in the range [0, 1] (where 0 is
+ * the objects' previous position and 1 their current one); Only meaningful on
+ * continuous mode (otherwise, it's always 0)
+ *
+ * @param  [out]pTime When the objects first touched
+ * @param  [ in]pCtx  The quadtree's root
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NO_OVERLAP
+ */
+gfmRV gfmQuadtree_getTimeOfImpact(double *pTime, gfmQuadtreeRoot *pCtx);
+
+/**
+ * Clean up the previous state and ready the quadtree for incremental mode; On
+ * it, the dynamic layer is kept across frames: objects are added only once
+ * (through gfmQuadtree_trackObject) and gfmQuadtree_refresh moves them to the
+ * leaves they currently overlap; Overlaps are then retrieved through
+ * gfmQuadtree_collideDeferred
+ *
+ * NOTE: gfmQuadtree_collide*, gfmQuadtree_populate* and gfmQuadtree_defer*
+ * can't be used on incremental mode; Calling gfmQuadtree_initRoot leaves it
+ *
+ * @param  pCtx     The quadtree root context
+ * @param  x        The quadtree top-left position
+ * @param  y        The quadtree top-left position
+ * @param  width    The quadtree width
+ * @param  height   The quadtree height
+ * @param  maxDepth How many levels can the quadtree branch
+ * @param  maxNodes How many objects a subtree can have until it must split
+ * @return          GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmQuadtree_initIncremental(gfmQuadtreeRoot *pCtx, int x, int y,
+        int width, int height, int maxDepth, int maxNodes);
+
+/**
+ * Add an object to the incremental quadtree, where it's kept until
+ * gfmQuadtree_untrackObject is called (or the quadtree is re-initialized)
+ *
+ * NOTE: The object's type is only retrieved when it's added
+ *
+ * @param  [out]pHandle Handle used to remove the object (also used as its
+ *                      order, when sorting the overlaps)
+ * @param  [ in]pCtx    The quadtree's root
+ * @param  [ in]pObj    The gfmObject
+ * @return              GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                      GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                      GFMRV_QUADTREE_INVALID_MODE, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmQuadtree_trackObject(int *pHandle, gfmQuadtreeRoot *pCtx,
+        gfmObject *pObj);
+
+/**
+ * Remove an object from the incremental quadtree; Nodes left sparse are only
+ * merged on the next gfmQuadtree_refresh
+ *
+ * @param  [ in]pCtx   The quadtree's root
+ * @param  [ in]handle The object's handle
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                     GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                     GFMRV_QUADTREE_INVALID_MODE, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmQuadtree_untrackObject(gfmQuadtreeRoot *pCtx, int handle);
+
+/**
+ * Update the incremental quadtree with every tracked object's current
+ * position; Objects are only removed from (and re-inserted into) the layer if
+ * they crossed the bounds of any of its nodes (or if a node around them was
+ * subdivided or merged); Nodes left sparse are merged afterward
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                   GFMRV_QUADTREE_INVALID_MODE, GFMRV_ALLOC_FAILED,
+ *                   GFMRV_QUADTREE_STACK_OVERFLOW
+ */
+gfmRV gfmQuadtree_refresh(gfmQuadtreeRoot *pCtx);
+
+/**
+ * Enable (or disable) the loose mode; On it, each node's bounds are expanded
+ * by a factor and every object is inserted into a single node (the deepest one
+ * whose expanded bounds contain it, chosen by the object's center), instead of
+ * into every leaf it overlaps; Big objects are therefore kept on nodes closer
+ * to the root, so the memory used doesn't grow with the objects' sizes and
+ * each pair is tested only once
+ *
+ * NOTE: This should be set before populating either layer; It can't be used
+ * with the incremental mode
+ *
+ * @param  [ in]pCtx      The quadtree's root
+ * @param  [ in]looseness By how much each node's bounds are expanded (2.0 is
+ *                        usually a good value), or 0 to disable loose mode
+ * @return                GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmQuadtree_setLoose(gfmQuadtreeRoot *pCtx, double looseness);
+
+/**
+ * Retrieve the stats of one of the quadtree's layers: how its nodes and
+ * objects are distributed (which is traversed on every call) and how many
+ * pairs were tested and reported on the current frame; Useful to tune
+ * maxDepth and maxNodes
+ *
+ * @param  [out]pStats   The stats
+ * @param  [ in]pCtx     The quadtree's root
+ * @param  [ in]isStatic Whether the static layer's stats should be retrieved
+ *                       (instead of the dynamic one's)
+ * @return               GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                       GFMRV_QUADTREE_NOT_INITIALIZED
+ */
+gfmRV gfmQuadtree_getStats(gfmQuadtreeStats *pStats, gfmQuadtreeRoot *pCtx,
+        int isStatic);
+
+/**
+ * Set whether gfmQuadtree_drawBounds should also print the dynamic layer's
+ * stats (as retrieved by gfmQuadtree_getStats)
+ *
+ * This function uses an internal bitmap font, only available on debug mode.
+ * Therefore, the stats are never printed on release mode.
+ *
+ * @param  [ in]pCtx      The quadtree's root
+ * @param  [ in]drawStats Whether the stats should be printed
+ * @param  [ in]x         Horizontal position (in screen space)
+ * @param  [ in]y         Vertical position (in screen space)
+ * @return                GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmQuadtree_setDrawStats(gfmQuadtreeRoot *pCtx, int drawStats, int x,
+        int y);
+
 /**
  * Return both objects that overlaped
  * 
@@ -179,6 +630,16 @@ gfmRV gfmQuadtree_populateTilemap(gfmQuadtreeRoot *pCtx, gfmTilemap *pTMap);
 gfmRV gfmQuadtree_getOverlaping(gfmObject **ppObj1, gfmObject **ppObj2,
         gfmQuadtreeRoot *pCtx);
 
+/**
+ * Retrieve how many overlaps were ignored on the current frame for being
+ * duplicated (i.e., the pair was already reported on another leaf)
+ *
+ * @param  [out]pCount How many overlaps were ignored
+ * @param  [ in]pCtx   The quadtree's root
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmQuadtree_getDuplicatedCount(int *pCount, gfmQuadtreeRoot *pCtx);
+
 /**
  * Continue colliding and adding the node to the quadtree
  * 
@@ -188,6 +649,58 @@ gfmRV gfmQuadtree_getOverlaping(gfmObject **ppObj1, gfmObject **ppObj2,
  */
 gfmRV gfmQuadtree_continue(gfmQuadtreeRoot *pCtx);
 
+/**
+ * Adds a new gfmGroup to the quadtree, colliding every one of its objects and
+ * storing the overlaps into a buffer instead of halting on each of them
+ *
+ * If the buffer gets filled, GFMRV_QUADTREE_OVERLAPED is returned and
+ * gfmQuadtree_continueBatch must be called (after handling the pairs) to
+ * resume the operation
+ *
+ * @param  [out]pPairs   Buffer that will be filled with the overlaps
+ * @param  [out]pCount   How many overlaps were stored on the buffer
+ * @param  [ in]pCtx     The quadtree's root
+ * @param  [ in]pGrp     The gfmGroup
+ * @param  [ in]maxPairs How many overlaps fit on the buffer
+ * @return               GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                       GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmQuadtree_collideGroupBatch(gfmQuadtreePair *pPairs, int *pCount,
+        gfmQuadtreeRoot *pCtx, gfmGroup *pGrp, int maxPairs);
+
+/**
+ * Adds a new gfmObject to the quadtree, storing every overlap into a buffer
+ * instead of halting on each of them
+ *
+ * If the buffer gets filled, GFMRV_QUADTREE_OVERLAPED is returned and
+ * gfmQuadtree_continueBatch must be called (after handling the pairs) to
+ * resume the operation
+ *
+ * @param  [out]pPairs   Buffer that will be filled with the overlaps
+ * @param  [out]pCount   How many overlaps were stored on the buffer
+ * @param  [ in]pCtx     The quadtree's root
+ * @param  [ in]pObj     The gfmObject
+ * @param  [ in]maxPairs How many overlaps fit on the buffer
+ * @return               GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                       GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmQuadtree_collideObjectBatch(gfmQuadtreePair *pPairs, int *pCount,
+        gfmQuadtreeRoot *pCtx, gfmObject *pObj, int maxPairs);
+
+/**
+ * Continue a batched collision, after its buffer was filled
+ *
+ * @param  [out]pPairs   Buffer that will be filled with the overlaps
+ * @param  [out]pCount   How many overlaps were stored on the buffer
+ * @param  [ in]pCtx     The quadtree's root
+ * @param  [ in]maxPairs How many overlaps fit on the buffer
+ * @return               GFMRV_ARGUMENTS_BAD,
+ *                       GFMRV_QUADTREE_OPERATION_NOT_ACTIVE,
+ *                       GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmQuadtree_continueBatch(gfmQuadtreePair *pPairs, int *pCount,
+        gfmQuadtreeRoot *pCtx, int maxPairs);
+
 /**
  * Draw the quadtree to the screen.
  *
@@ -204,6 +717,9 @@ gfmRV gfmQuadtree_continue(gfmQuadtreeRoot *pCtx);
  * This way, the user may specify 27 different types, each of which may be used
  * in any of 2^27 different entities.
  * NOTE: This functions will be most likely slow!! Be careful when calling it!
+ *
+ * If enabled through gfmQuadtree_setDrawStats, the dynamic layer's stats are
+ * printed over it (only on debug mode).
  * 
  * @param  pQt     The quadtree's root
  * @param  pCtx    The game's context
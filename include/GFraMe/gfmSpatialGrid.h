@@ -0,0 +1,179 @@
+/**
+ * @file include/GFraMe/gfmSpatialGrid.h
+ *
+ * Uniform grid broadphase, an alternative to gfmQuadtree for worlds where most
+ * objects have roughly the size of a cell (e.g., the size of a tile); Every
+ * object is added to each cell it touches, so only objects on the same cell
+ * are ever tested for overlap;
+ * The cells may either be stored on a dense array (covering a fixed area, set
+ * through gfmSpatialGrid_initRoot) or hashed into a fixed number of buckets
+ * (through gfmSpatialGrid_initHashed), which is better suited for big and
+ * sparse worlds;
+ * It has the same contract as gfmQuadtree: after initializing the grid (on
+ * every frame), 'objects' may be added with gfmSpatialGrid_populate* (which
+ * doesn't collide anything) or with gfmSpatialGrid_collide* (which collides
+ * the 'object' against every other 'object' previously added); The return
+ * values are equivalent, but with their own codes (i.e.,
+ * GFMRV_SPATIALGRID_OVERLAPED, in which case gfmSpatialGrid_getOverlaping
+ * return both objects and gfmSpatialGrid_continue *must* be called afterward,
+ * and GFMRV_SPATIALGRID_DONE);
+ * Each pair of objects is reported only once, even if both objects share more
+ * than one cell;
+ */
+#ifndef __GFMSPATIALGRID_STRUCT__
+#define __GFMSPATIALGRID_STRUCT__
+
+/** Spatial grid's context, with its cells and the current overlap */
+typedef struct stGFMSpatialGrid gfmSpatialGrid;
+
+#endif /* __GFMSPATIALGRID_STRUCT__ */
+
+#ifndef __GFMSPATIALGRID_H__
+#define __GFMSPATIALGRID_H__
+
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmGroup.h>
+#include <GFraMe/gfmObject.h>
+#include <GFraMe/gfmSprite.h>
+#include <GFraMe/gfmTilemap.h>
+
+/**
+ * Alloc a new spatial grid
+ *
+ * @param  [out]ppCtx The alloc'ed grid
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSpatialGrid_getNew(gfmSpatialGrid **ppCtx);
+
+/**
+ * Release a spatial grid and all its members
+ *
+ * @param  [ in]ppCtx The grid
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmSpatialGrid_free(gfmSpatialGrid **ppCtx);
+
+/**
+ * Clean all memory used by the grid
+ *
+ * @param  [ in]pCtx The grid
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmSpatialGrid_clean(gfmSpatialGrid *pCtx);
+
+/**
+ * Clean up the previous state and ready the grid for collision, storing its
+ * cells on a dense array; Objects outside the grid's area are ignored
+ *
+ * @param  [ in]pCtx       The grid
+ * @param  [ in]x          The grid's top-left position
+ * @param  [ in]y          The grid's top-left position
+ * @param  [ in]width      The grid's width
+ * @param  [ in]height     The grid's height
+ * @param  [ in]cellWidth  Width of each cell (e.g., the width of a tile)
+ * @param  [ in]cellHeight Height of each cell (e.g., the height of a tile)
+ * @return                 GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSpatialGrid_initRoot(gfmSpatialGrid *pCtx, int x, int y, int width,
+        int height, int cellWidth, int cellHeight);
+
+/**
+ * Clean up the previous state and ready the grid for collision, hashing its
+ * cells into a fixed number of buckets; There are no bounds, so no object is
+ * ever ignored
+ *
+ * @param  [ in]pCtx       The grid
+ * @param  [ in]cellWidth  Width of each cell (e.g., the width of a tile)
+ * @param  [ in]cellHeight Height of each cell (e.g., the height of a tile)
+ * @param  [ in]numBuckets How many buckets there are (rounded up to a power of
+ *                         2)
+ * @return                 GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSpatialGrid_initHashed(gfmSpatialGrid *pCtx, int cellWidth,
+        int cellHeight, int numBuckets);
+
+/**
+ * Collide every collideable object from a group
+ *
+ * @param  [ in]pCtx The grid
+ * @param  [ in]pGrp The group
+ * @return           GFMRV_ARGUMENTS_BAD, GFMRV_SPATIALGRID_NOT_INITIALIZED,
+ *                   GFMRV_SPATIALGRID_OVERLAPED, GFMRV_SPATIALGRID_DONE
+ */
+gfmRV gfmSpatialGrid_collideGroup(gfmSpatialGrid *pCtx, gfmGroup *pGrp);
+
+/**
+ * Add an object to every cell it touches, colliding it against every object
+ * previously added to those
+ *
+ * @param  [ in]pCtx The grid
+ * @param  [ in]pObj The gfmObject
+ * @return           GFMRV_ARGUMENTS_BAD, GFMRV_SPATIALGRID_NOT_INITIALIZED,
+ *                   GFMRV_SPATIALGRID_OVERLAPED, GFMRV_SPATIALGRID_DONE
+ */
+gfmRV gfmSpatialGrid_collideObject(gfmSpatialGrid *pCtx, gfmObject *pObj);
+
+/**
+ * Add a sprite to every cell it touches, colliding it against every object
+ * previously added to those
+ *
+ * @param  [ in]pCtx The grid
+ * @param  [ in]pSpr The gfmSprite
+ * @return           GFMRV_ARGUMENTS_BAD, GFMRV_SPATIALGRID_NOT_INITIALIZED,
+ *                   GFMRV_SPATIALGRID_OVERLAPED, GFMRV_SPATIALGRID_DONE
+ */
+gfmRV gfmSpatialGrid_collideSprite(gfmSpatialGrid *pCtx, gfmSprite *pSpr);
+
+/**
+ * Add an object to the grid without colliding it
+ *
+ * @param  [ in]pCtx The grid
+ * @param  [ in]pObj The gfmObject
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_SPATIALGRID_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSpatialGrid_populateObject(gfmSpatialGrid *pCtx, gfmObject *pObj);
+
+/**
+ * Add a sprite to the grid without colliding it
+ *
+ * @param  [ in]pCtx The grid
+ * @param  [ in]pSpr The gfmSprite
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_SPATIALGRID_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSpatialGrid_populateSprite(gfmSpatialGrid *pCtx, gfmSprite *pSpr);
+
+/**
+ * Add every area of a tilemap to the grid without colliding them
+ *
+ * @param  [ in]pCtx  The grid
+ * @param  [ in]pTMap The tilemap
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                    GFMRV_SPATIALGRID_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSpatialGrid_populateTilemap(gfmSpatialGrid *pCtx, gfmTilemap *pTMap);
+
+/**
+ * Return both objects that overlaped
+ *
+ * @param  [out]ppObj1 The object being collided
+ * @param  [out]ppObj2 The object that was previously added
+ * @param  [ in]pCtx   The grid
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_SPATIALGRID_NO_OVERLAP
+ */
+gfmRV gfmSpatialGrid_getOverlaping(gfmObject **ppObj1, gfmObject **ppObj2,
+        gfmSpatialGrid *pCtx);
+
+/**
+ * Continue colliding the current object (and group, if any)
+ *
+ * @param  [ in]pCtx The grid
+ * @return           GFMRV_ARGUMENTS_BAD, GFMRV_SPATIALGRID_NOT_INITIALIZED,
+ *                   GFMRV_SPATIALGRID_OPERATION_NOT_ACTIVE,
+ *                   GFMRV_SPATIALGRID_OVERLAPED, GFMRV_SPATIALGRID_DONE
+ */
+gfmRV gfmSpatialGrid_continue(gfmSpatialGrid *pCtx);
+
+#endif /* __GFMSPATIALGRID_H__ */
+
@@ -57,6 +57,19 @@ gfmRV gfmSprite_free(gfmSprite **ppCtx);
  * @param  type   The type of the sprite's "sub-class"
  * @return        GFMRV_OK, GFMRV_ARGUMENTS_BAD, ...
  */
+/**
+ * Make the sprite use an already alloc'ed object, instead of alloc'ing its own
+ * on gfmSprite_init; The object's memory isn't released by the sprite (e.g.,
+ * gfmGroup keeps it on the same block as the sprite itself)
+ * 
+ * NOTE: Must be called before the sprite is initialized
+ * 
+ * @param  pCtx The sprite
+ * @param  pObj The object's memory (at least sizeofGFMObject bytes, zeroed)
+ * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmSprite_setObjectStorage(gfmSprite *pCtx, gfmObject *pObj);
+
 gfmRV gfmSprite_init(gfmSprite *pCtx, int x, int y, int width, int height,
         gfmSpriteset *pSset, int offX, int offY, void *pChild, int type);
 
@@ -427,6 +440,32 @@ gfmRV gfmSprite_setFixed(gfmSprite *pCtx);
  */
 gfmRV gfmSprite_setMovable(gfmSprite *pCtx);
 
+/**
+ * Set for how many frames the sprite must stand still before falling asleep
+ * (see gfmObject_setSleepDelay)
+ * 
+ * @param  pCtx   The sprite
+ * @param  frames Number of frames; 0 (the default) makes the sprite never sleep
+ * @return        GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmSprite_setSleepDelay(gfmSprite *pCtx, int frames);
+
+/**
+ * Check whether the sprite is asleep
+ * 
+ * @param  pCtx The sprite
+ * @return      GFMRV_TRUE, GFMRV_FALSE, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmSprite_isAsleep(gfmSprite *pCtx);
+
+/**
+ * Wake the sprite, so it's updated (and collided) again
+ * 
+ * @param  pCtx The sprite
+ * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmSprite_wake(gfmSprite *pCtx);
+
 /**
  * Apply another sprite's translation into this sprite
  *
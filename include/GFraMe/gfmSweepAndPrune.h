@@ -0,0 +1,159 @@
+/**
+ * @file include/GFraMe/gfmSweepAndPrune.h
+ *
+ * Sort-and-sweep broadphase, an alternative to gfmQuadtree better suited for
+ * levels that are long strips (where most objects have similar sizes);
+ * Objects are kept on an array sorted by their left edge, which is kept across
+ * frames; Since objects move only a little between frames, re-sorting it is
+ * nearly linear;
+ * It has the same contract as gfmQuadtree: after starting a frame (through
+ * gfmSweepAndPrune_init), 'objects' may be added with
+ * gfmSweepAndPrune_populate* (which doesn't collide anything) or with
+ * gfmSweepAndPrune_collide* (which collides the 'object' against every other
+ * 'object' previously added on the same frame);
+ * The return values are also the same as gfmQuadtree's (i.e.,
+ * GFMRV_QUADTREE_OVERLAPED and GFMRV_QUADTREE_DONE), so a collision pass may
+ * switch between both broadphases simply by calling the other functions:
+ *   - GFMRV_QUADTREE_OVERLAPED: an overlap just happened and should be
+ *   handled; gfmSweepAndPrune_getOverlaping return both objects and
+ *   gfmSweepAndPrune_continue *must* be called afterward;
+ *   - GFMRV_QUADTREE_DONE: the 'object' was successfully added;
+ * 'Objects' that aren't added on a frame are removed from the sorted array on
+ * the next call to gfmSweepAndPrune_init;
+ */
+#ifndef __GFMSWEEPANDPRUNE_STRUCT__
+#define __GFMSWEEPANDPRUNE_STRUCT__
+
+/** Sort-and-sweep context, with the sorted objects and the current overlap */
+typedef struct stGFMSweepAndPrune gfmSweepAndPrune;
+
+#endif /* __GFMSWEEPANDPRUNE_STRUCT__ */
+
+#ifndef __GFMSWEEPANDPRUNE_H__
+#define __GFMSWEEPANDPRUNE_H__
+
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmGroup.h>
+#include <GFraMe/gfmObject.h>
+#include <GFraMe/gfmSprite.h>
+#include <GFraMe/gfmTilemap.h>
+
+/**
+ * Alloc a new sort-and-sweep context
+ *
+ * @param  [out]ppCtx The alloc'ed context
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSweepAndPrune_getNew(gfmSweepAndPrune **ppCtx);
+
+/**
+ * Release a sort-and-sweep context and all its members
+ *
+ * @param  [ in]ppCtx The context
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmSweepAndPrune_free(gfmSweepAndPrune **ppCtx);
+
+/**
+ * Clean all memory used by the context
+ *
+ * @param  [ in]pCtx The context
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmSweepAndPrune_clean(gfmSweepAndPrune *pCtx);
+
+/**
+ * Start a new frame, removing every object that wasn't added on the previous
+ * one (but keeping the sorted order of the others)
+ *
+ * @param  [ in]pCtx The context
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSweepAndPrune_init(gfmSweepAndPrune *pCtx);
+
+/**
+ * Collide every collideable object from a group
+ *
+ * @param  [ in]pCtx The context
+ * @param  [ in]pGrp The group
+ * @return           GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                   GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmSweepAndPrune_collideGroup(gfmSweepAndPrune *pCtx, gfmGroup *pGrp);
+
+/**
+ * Add an object and collide it against every object previously added on this
+ * frame
+ *
+ * @param  [ in]pCtx The context
+ * @param  [ in]pObj The gfmObject
+ * @return           GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                   GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmSweepAndPrune_collideObject(gfmSweepAndPrune *pCtx, gfmObject *pObj);
+
+/**
+ * Add a sprite and collide it against every object previously added on this
+ * frame
+ *
+ * @param  [ in]pCtx The context
+ * @param  [ in]pSpr The gfmSprite
+ * @return           GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                   GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmSweepAndPrune_collideSprite(gfmSweepAndPrune *pCtx, gfmSprite *pSpr);
+
+/**
+ * Add an object without colliding it
+ *
+ * @param  [ in]pCtx The context
+ * @param  [ in]pObj The gfmObject
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSweepAndPrune_populateObject(gfmSweepAndPrune *pCtx, gfmObject *pObj);
+
+/**
+ * Add a sprite without colliding it
+ *
+ * @param  [ in]pCtx The context
+ * @param  [ in]pSpr The gfmSprite
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSweepAndPrune_populateSprite(gfmSweepAndPrune *pCtx, gfmSprite *pSpr);
+
+/**
+ * Add every area of a tilemap without colliding them
+ *
+ * @param  [ in]pCtx  The context
+ * @param  [ in]pTMap The tilemap
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                    GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSweepAndPrune_populateTilemap(gfmSweepAndPrune *pCtx,
+        gfmTilemap *pTMap);
+
+/**
+ * Return both objects that overlaped
+ *
+ * @param  [out]ppObj1 The object being collided
+ * @param  [out]ppObj2 The object that was previously added
+ * @param  [ in]pCtx   The context
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NO_OVERLAP
+ */
+gfmRV gfmSweepAndPrune_getOverlaping(gfmObject **ppObj1, gfmObject **ppObj2,
+        gfmSweepAndPrune *pCtx);
+
+/**
+ * Continue colliding the current object (and group, if any)
+ *
+ * @param  [ in]pCtx The context
+ * @return           GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                   GFMRV_QUADTREE_OPERATION_NOT_ACTIVE,
+ *                   GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmSweepAndPrune_continue(gfmSweepAndPrune *pCtx);
+
+#endif /* __GFMSWEEPANDPRUNE_H__ */
+
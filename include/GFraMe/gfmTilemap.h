@@ -20,6 +20,8 @@
 
 /** 'Exports' the gfmTilemap structure */
 typedef struct stGFMTilemap gfmTilemap;
+/** First tile hit by gfmTilemap_raycast */
+typedef struct stGFMTilemapHit gfmTilemapHit;
 
 #endif /* __GFMTILEMAP_STRUCT__ */
 
@@ -31,6 +33,32 @@ typedef struct stGFMTilemap gfmTilemap;
 #include <GFraMe/gfmObject.h>
 #include <GFraMe/gfmSpriteset.h>
 
+#include <stdint.h>
+
+/** First tile hit by gfmTilemap_raycast */
+struct stGFMTilemapHit {
+    /** Column of the tile */
+    int tileX;
+    /** Row of the tile */
+    int tileY;
+    /** The tile's type */
+    int type;
+    /** Horizontal position where the segment entered the tile */
+    int x;
+    /** Vertical position where the segment entered the tile */
+    int y;
+    /** Horizontal component of the normal of the side that was hit (-1 for
+     * the tile's left side, 1 for its right side) */
+    int normalX;
+    /** Vertical component of the normal of the side that was hit (-1 for the
+     * tile's top side, 1 for its bottom side); Both components are set if
+     * the segment crossed exactly through a corner and both are 0 if it
+     * started inside the tile */
+    int normalY;
+    /** How much of the segment was traversed until the hit, in [0, 1] */
+    double time;
+};
+
 /** 'Exportable' size of gfmTilemap */
 extern const int sizeofGFMTilemap;
 
@@ -393,6 +421,30 @@ gfmRV gfmTilemap_getDimension(int *pWidth, int *pHeight, gfmTilemap *pCtx);
  */
 gfmRV gfmTilemap_getTypeAt(int *pType, gfmTilemap *pCtx, int x, int y);
 
+/**
+ * Walk a segment through the tilemap, cell by cell (i.e., with a DDA), until
+ * it reaches a tile whose type is set on a mask; Since only the cells crossed
+ * by the segment are visited, this costs as much as the segment is long,
+ * regardless of how many areas there are; Tiles are checked by their types
+ * (see gfmTilemap_addTileType), so the areas don't have to be recalculated
+ *
+ * NOTE: Just like gfmTilemap_getTypeAt (and the areas), the tilemap's position
+ * is ignored; Parts of the segment outside the tilemap are ignored as well
+ *
+ * @param  [out]pHit     The first tile hit (only modified on GFMRV_TRUE)
+ * @param  [ in]pCtx     The tilemap
+ * @param  [ in]x0       Horizontal position of the segment's start
+ * @param  [ in]y0       Vertical position of the segment's start
+ * @param  [ in]x1       Horizontal position of the segment's end
+ * @param  [ in]y1       Vertical position of the segment's end
+ * @param  [ in]typeMask Types that stop the segment, as a bit mask (e.g.,
+ *                       (1 << type), for types lower than gfmType_max)
+ * @return               GFMRV_TRUE, GFMRV_FALSE, GFMRV_ARGUMENTS_BAD,
+ *                       GFMRV_TILEMAP_NOT_INITIALIZED
+ */
+gfmRV gfmTilemap_raycast(gfmTilemapHit *pHit, gfmTilemap *pCtx, int x0,
+        int y0, int x1, int y1, uint32_t typeMask);
+
 /**
  * Disable batched draw; It should be used when it's desired to batch more tiles
  * at once
@@ -0,0 +1,109 @@
+/**
+ * @file src/core/noip/gfmThreadPool.c
+ *
+ * Pool of worker threads that run a list of independent tasks; This
+ * implementation actually runs every task on the calling thread (useful for
+ * targets without threads, for example)
+ */
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmError.h>
+
+#include <GFraMe_int/core/gfmThreadPool_bkend.h>
+
+#include <stdlib.h>
+
+struct stGFMThreadPool {
+    /** A single integer so it's not empty */
+    int null;
+};
+
+/**
+ * Alloc a new pool, spawning its workers
+ *
+ * @param  [out]ppCtx      The alloc'ed pool
+ * @param  [ in]numWorkers How many threads should run tasks (ignored, since
+ *                         only the calling one is ever used)
+ * @return                 GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmThreadPool_getNew(gfmThreadPool **ppCtx, int numWorkers) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(!(*ppCtx), GFMRV_ARGUMENTS_BAD);
+    ASSERT(numWorkers > 0, GFMRV_ARGUMENTS_BAD);
+
+    *ppCtx = (gfmThreadPool*)malloc(sizeof(gfmThreadPool));
+    ASSERT(*ppCtx, GFMRV_ALLOC_FAILED);
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Stop every worker and release the pool
+ *
+ * @param  [ in]ppCtx The pool
+ */
+void gfmThreadPool_free(gfmThreadPool **ppCtx) {
+    if (!ppCtx || !(*ppCtx)) {
+        return;
+    }
+    free(*ppCtx);
+    *ppCtx = 0;
+}
+
+/**
+ * Retrieve how many threads run tasks (always 1)
+ *
+ * @param  [out]pNum How many workers there are
+ * @param  [ in]pCtx The pool
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmThreadPool_getNumWorkers(int *pNum, gfmThreadPool *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pNum, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    *pNum = 1;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Run every task (in order) on the calling thread
+ *
+ * @param  [ in]pCtx     The pool
+ * @param  [ in]task     The function called for every task
+ * @param  [ in]pArg     Argument passed to every task
+ * @param  [ in]numTasks How many tasks there are
+ * @return               GFMRV_OK, GFMRV_ARGUMENTS_BAD, the first error
+ *                       returned by a task
+ */
+gfmRV gfmThreadPool_run(gfmThreadPool *pCtx, gfmThreadPoolTask task,
+        void *pArg, int numTasks) {
+    gfmRV rv;
+    int i;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(task, GFMRV_ARGUMENTS_BAD);
+    ASSERT(numTasks >= 0, GFMRV_ARGUMENTS_BAD);
+
+    i = 0;
+    while (i < numTasks) {
+        rv = task(pArg, 0, i);
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
@@ -0,0 +1,307 @@
+/**
+ * @file src/core/threadPool/gfmThreadPool_SDL2.c
+ *
+ * Pool of worker threads that run a list of independent tasks. This
+ * implementation uses SDL2 for threading.
+ */
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmError.h>
+
+#include <GFraMe_int/core/gfmThreadPool_bkend.h>
+
+#include <SDL2/SDL_atomic.h>
+#include <SDL2/SDL_mutex.h>
+#include <SDL2/SDL_thread.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+/** Argument passed to each worker thread */
+typedef struct stGFMThreadPoolWorker gfmThreadPoolWorker;
+
+/** Argument passed to each worker thread */
+struct stGFMThreadPoolWorker {
+    /** The pool */
+    gfmThreadPool *pPool;
+    /** The thread handle */
+    SDL_Thread *pThread;
+    /** Index of this worker (0 is reserved for the calling thread) */
+    int index;
+};
+
+struct stGFMThreadPool {
+    /** Every spawned worker (numWorkers - 1, since the caller also works) */
+    gfmThreadPoolWorker *pWorkers;
+    /** How many threads run tasks (including the calling one) */
+    int numWorkers;
+    /** How many threads were actually spawned */
+    int numSpawned;
+    /** Protects everything bellow (except for nextTask) */
+    SDL_mutex *pMutex;
+    /** Signaled whenever a new job starts (or the pool is being released) */
+    SDL_cond *pStart;
+    /** Signaled when the last worker finishes the current job */
+    SDL_cond *pDone;
+    /** Incremented on every job, so workers know when to start */
+    unsigned int job;
+    /** Whether the workers should exit */
+    int isQuitting;
+    /** How many spawned workers are still running the current job */
+    int pending;
+    /** The current job */
+    gfmThreadPoolTask task;
+    /** Argument passed to every task */
+    void *pArg;
+    /** How many tasks there are on the current job */
+    int numTasks;
+    /** Index of the next task to be run */
+    SDL_atomic_t nextTask;
+    /** First error returned by a task */
+    gfmRV rv;
+};
+
+/**
+ * Run tasks from the current job until there are no more
+ *
+ * @param  [ in]pCtx   The pool
+ * @param  [ in]worker Index of the running worker
+ */
+static void _gfmThreadPool_runTasks(gfmThreadPool *pCtx, int worker) {
+    int task;
+
+    task = SDL_AtomicAdd(&(pCtx->nextTask), 1);
+    while (task < pCtx->numTasks) {
+        gfmRV rv;
+
+        rv = pCtx->task(pCtx->pArg, worker, task);
+        if (rv != GFMRV_OK) {
+            SDL_LockMutex(pCtx->pMutex);
+            if (pCtx->rv == GFMRV_OK) {
+                pCtx->rv = rv;
+            }
+            SDL_UnlockMutex(pCtx->pMutex);
+        }
+
+        task = SDL_AtomicAdd(&(pCtx->nextTask), 1);
+    }
+}
+
+/**
+ * Worker thread, which waits for jobs until the pool is released
+ *
+ * @param  [ in]pArg The worker (gfmThreadPoolWorker)
+ */
+static int _gfmThreadPool_thread(void *pArg) {
+    gfmThreadPoolWorker *pWorker;
+    gfmThreadPool *pCtx;
+    unsigned int job;
+
+    pWorker = (gfmThreadPoolWorker*)pArg;
+    pCtx = pWorker->pPool;
+
+    /* Jobs are counted from the pool's creation (and not from when this
+     * thread started), so a job issued before then isn't missed */
+    job = 0;
+    SDL_LockMutex(pCtx->pMutex);
+    while (1) {
+        /* Wait for a new job */
+        while (job == pCtx->job && !pCtx->isQuitting) {
+            SDL_CondWait(pCtx->pStart, pCtx->pMutex);
+        }
+        if (pCtx->isQuitting) {
+            break;
+        }
+        job = pCtx->job;
+        SDL_UnlockMutex(pCtx->pMutex);
+
+        _gfmThreadPool_runTasks(pCtx, pWorker->index);
+
+        /* Signal the caller if this was the last worker */
+        SDL_LockMutex(pCtx->pMutex);
+        pCtx->pending--;
+        if (pCtx->pending == 0) {
+            SDL_CondSignal(pCtx->pDone);
+        }
+    }
+    SDL_UnlockMutex(pCtx->pMutex);
+
+    return 0;
+}
+
+/**
+ * Alloc a new pool, spawning its workers
+ *
+ * @param  [out]ppCtx      The alloc'ed pool
+ * @param  [ in]numWorkers How many threads should run tasks (including the
+ *                         calling one)
+ * @return                 GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED,
+ *                         GFMRV_THREADPOOL_CREATE_FAILED
+ */
+gfmRV gfmThreadPool_getNew(gfmThreadPool **ppCtx, int numWorkers) {
+    gfmThreadPool *pCtx;
+    gfmRV rv;
+    int i;
+
+    /* Sanitize arguments */
+    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(!(*ppCtx), GFMRV_ARGUMENTS_BAD);
+    ASSERT(numWorkers > 0, GFMRV_ARGUMENTS_BAD);
+
+    /* Alloc and clean it */
+    pCtx = (gfmThreadPool*)malloc(sizeof(gfmThreadPool));
+    ASSERT(pCtx, GFMRV_ALLOC_FAILED);
+    memset(pCtx, 0x0, sizeof(gfmThreadPool));
+    pCtx->numWorkers = numWorkers;
+    *ppCtx = pCtx;
+
+    pCtx->pMutex = SDL_CreateMutex();
+    ASSERT(pCtx->pMutex, GFMRV_THREADPOOL_CREATE_FAILED);
+    pCtx->pStart = SDL_CreateCond();
+    ASSERT(pCtx->pStart, GFMRV_THREADPOOL_CREATE_FAILED);
+    pCtx->pDone = SDL_CreateCond();
+    ASSERT(pCtx->pDone, GFMRV_THREADPOOL_CREATE_FAILED);
+
+    if (numWorkers > 1) {
+        pCtx->pWorkers = (gfmThreadPoolWorker*)malloc(
+                sizeof(gfmThreadPoolWorker) * (numWorkers - 1));
+        ASSERT(pCtx->pWorkers, GFMRV_ALLOC_FAILED);
+    }
+
+    /* Spawn every worker */
+    i = 0;
+    while (i < numWorkers - 1) {
+        gfmThreadPoolWorker *pWorker;
+
+        pWorker = pCtx->pWorkers + i;
+        pWorker->pPool = pCtx;
+        pWorker->index = i + 1;
+        pWorker->pThread = SDL_CreateThread(_gfmThreadPool_thread,
+                "GFraMe_worker", (void*)pWorker);
+        ASSERT(pWorker->pThread, GFMRV_THREADPOOL_CREATE_FAILED);
+        pCtx->numSpawned++;
+
+        i++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    if (rv != GFMRV_OK && ppCtx && *ppCtx) {
+        gfmThreadPool_free(ppCtx);
+    }
+
+    return rv;
+}
+
+/**
+ * Stop every worker and release the pool
+ *
+ * @param  [ in]ppCtx The pool
+ */
+void gfmThreadPool_free(gfmThreadPool **ppCtx) {
+    gfmThreadPool *pCtx;
+    int i;
+
+    /* Do nothing if there's no object */
+    if (!ppCtx || !(*ppCtx)) {
+        return;
+    }
+    pCtx = *ppCtx;
+
+    /* Wake every worker so they may exit */
+    if (pCtx->numSpawned > 0) {
+        SDL_LockMutex(pCtx->pMutex);
+        pCtx->isQuitting = 1;
+        SDL_CondBroadcast(pCtx->pStart);
+        SDL_UnlockMutex(pCtx->pMutex);
+
+        i = 0;
+        while (i < pCtx->numSpawned) {
+            SDL_WaitThread(pCtx->pWorkers[i].pThread, 0);
+            i++;
+        }
+    }
+
+    if (pCtx->pWorkers) {
+        free(pCtx->pWorkers);
+    }
+    if (pCtx->pDone) {
+        SDL_DestroyCond(pCtx->pDone);
+    }
+    if (pCtx->pStart) {
+        SDL_DestroyCond(pCtx->pStart);
+    }
+    if (pCtx->pMutex) {
+        SDL_DestroyMutex(pCtx->pMutex);
+    }
+    free(pCtx);
+    *ppCtx = 0;
+}
+
+/**
+ * Retrieve how many threads run tasks (including the calling one)
+ *
+ * @param  [out]pNum How many workers there are
+ * @param  [ in]pCtx The pool
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmThreadPool_getNumWorkers(int *pNum, gfmThreadPool *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pNum, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    *pNum = pCtx->numWorkers;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Run every task, blocking until they have all finished
+ *
+ * @param  [ in]pCtx     The pool
+ * @param  [ in]task     The function called for every task
+ * @param  [ in]pArg     Argument passed to every task
+ * @param  [ in]numTasks How many tasks there are
+ * @return               GFMRV_OK, GFMRV_ARGUMENTS_BAD, the first error
+ *                       returned by a task
+ */
+gfmRV gfmThreadPool_run(gfmThreadPool *pCtx, gfmThreadPoolTask task,
+        void *pArg, int numTasks) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(task, GFMRV_ARGUMENTS_BAD);
+    ASSERT(numTasks >= 0, GFMRV_ARGUMENTS_BAD);
+
+    /* Set up the job and wake the workers */
+    SDL_LockMutex(pCtx->pMutex);
+    pCtx->task = task;
+    pCtx->pArg = pArg;
+    pCtx->numTasks = numTasks;
+    SDL_AtomicSet(&(pCtx->nextTask), 0);
+    pCtx->rv = GFMRV_OK;
+    if (pCtx->numSpawned > 0 && numTasks > 1) {
+        pCtx->pending = pCtx->numSpawned;
+        pCtx->job++;
+        SDL_CondBroadcast(pCtx->pStart);
+    }
+    SDL_UnlockMutex(pCtx->pMutex);
+
+    /* Help running the tasks */
+    _gfmThreadPool_runTasks(pCtx, 0);
+
+    /* Wait until every worker is done */
+    SDL_LockMutex(pCtx->pMutex);
+    while (pCtx->pending > 0) {
+        SDL_CondWait(pCtx->pDone, pCtx->pMutex);
+    }
+    rv = pCtx->rv;
+    SDL_UnlockMutex(pCtx->pMutex);
+__ret:
+    return rv;
+}
+
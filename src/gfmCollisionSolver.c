@@ -0,0 +1,820 @@
+/**
+ * @file src/gfmCollisionSolver.c
+ *
+ * Iterative contact solver; Every object on a pair is stored (once) as a body,
+ * sorted by its address so pairs may find their bodies with a binary search;
+ * Each unique pair becomes a contact along a single axis (the one flagged by
+ * gfmObject_justOverlaped or, if they were already overlapping, the one with
+ * the least penetration), and contacts are then solved in a fixed order for a
+ * fixed number of iterations;
+ * While solving a vertical contact, the object below may be 'supported' (i.e.,
+ * it's fixed or was pushed out of something supported on this iteration), in
+ * which case only the object above is moved; Since vertical contacts are
+ * solved from the bottom up, a whole stack settles on a single iteration
+ */
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmCollisionSolver.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmGroup.h>
+#include <GFraMe/gfmObject.h>
+
+#include <GFraMe_int/gfmHitbox.h>
+#include <GFraMe_int/gfmObject.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** An object on any of the pairs */
+typedef struct stGFMCollisionBody gfmCollisionBody;
+/** A unique pair of bodies, separated along a single axis */
+typedef struct stGFMCollisionContact gfmCollisionContact;
+
+enum {
+    /** Default number of iterations */
+    gfmCollisionSolver_defIterations = 4,
+    /** Minimum number of pairs alloc'ed */
+    gfmCollisionSolver_minLen = 64
+};
+
+/** Axis along which a contact is separated */
+enum enGFMContactAxis {
+    gfmContact_none = 0,
+    gfmContact_horizontal,
+    gfmContact_vertical
+};
+
+/** An object on any of the pairs */
+struct stGFMCollisionBody {
+    /** The object (or hitbox) */
+    gfmObject *pSelf;
+    /** Whether the object may not be moved (i.e., it's fixed or a hitbox) */
+    int isFixed;
+    /** Whether the object rests on something that won't move (on the current
+     * iteration) */
+    int isSupported;
+};
+
+/** A unique pair of bodies, separated along a single axis */
+struct stGFMCollisionContact {
+    /** Body at the left/top */
+    int first;
+    /** Body at the right/bottom */
+    int second;
+    /** Axis along which the bodies are separated (see enGFMContactAxis) */
+    int axis;
+    /** Position used to sort the contacts */
+    int key;
+    /** Index of the pair that generated the contact (to break ties); on
+     * repeated pairs, the first one added is kept */
+    int index;
+};
+
+/** Collision solver, with every pair added on the current frame */
+struct stGFMCollisionSolver {
+    /** Every pair added on the current frame */
+    gfmGroupPair *pPairs;
+    /** How many pairs were added */
+    int pairsUsed;
+    /** How many pairs fit on the array */
+    int pairsLen;
+    /** Every object on the pairs, sorted by their address */
+    gfmCollisionBody *pBodies;
+    /** How many bodies fit on the array */
+    int bodiesLen;
+    /** The unique pairs */
+    gfmCollisionContact *pContacts;
+    /** How many contacts fit on the array */
+    int contactsLen;
+    /** How many times every contact is solved */
+    int iterations;
+};
+
+/**
+ * Retrieve an object's (or hitbox's) top-left position along an axis
+ *
+ * @param  [ in]pObj The object
+ * @param  [ in]axis The axis
+ * @return           The position, with sub-pixel precision
+ */
+static gfmObjReal gfmCollisionSolver_getPosition(gfmObject *pObj, int axis) {
+    if (pObj->t.innerType == gfmType_hitbox) {
+        if (axis == gfmContact_horizontal) {
+            return gfmObjReal_fromInt(pObj->t.x);
+        }
+        return gfmObjReal_fromInt(pObj->t.y);
+    }
+    if (axis == gfmContact_horizontal) {
+        return pObj->dx;
+    }
+    return pObj->dy;
+}
+
+/**
+ * Move an object (never a hitbox) along an axis, waking it up
+ *
+ * @param  [ in]pObj  The object
+ * @param  [ in]axis  The axis
+ * @param  [ in]delta How much it should be moved
+ */
+static void gfmCollisionSolver_move(gfmObject *pObj, int axis,
+        gfmObjReal delta) {
+    gfmObject_wake(pObj);
+    if (axis == gfmContact_horizontal) {
+        pObj->dx += delta;
+        pObj->t.x = gfmObjReal_toInt(pObj->dx);
+    }
+    else {
+        pObj->dy += delta;
+        pObj->t.y = gfmObjReal_toInt(pObj->dy);
+    }
+}
+
+/**
+ * Retrieve an object's half-dimension along an axis
+ *
+ * @param  [ in]pObj The object
+ * @param  [ in]axis The axis
+ * @return           The half width or half height
+ */
+static int gfmCollisionSolver_getHalf(gfmObject *pObj, int axis) {
+    if (axis == gfmContact_horizontal) {
+        return pObj->t.hw;
+    }
+    return pObj->t.hh;
+}
+
+/**
+ * Calculate how much two objects overlap along an axis
+ *
+ * @param  [ in]pFirst  The object at the left/top
+ * @param  [ in]pSecond The object at the right/bottom
+ * @param  [ in]axis    The axis
+ * @param  [ in]gap     Distance that should be kept between the objects
+ * @return              The penetration (<= 0 if they don't overlap)
+ */
+static gfmObjReal gfmCollisionSolver_getPenetration(gfmObject *pFirst,
+        gfmObject *pSecond, int axis, int gap) {
+    return gfmCollisionSolver_getPosition(pFirst, axis)
+            + gfmObjReal_fromInt(2 * gfmCollisionSolver_getHalf(pFirst, axis)
+            + gap) - gfmCollisionSolver_getPosition(pSecond, axis);
+}
+
+/**
+ * Check whether two objects still overlap along an axis (with the same
+ * criteria as gfmObject_isOverlaping, i.e., touching objects overlap)
+ *
+ * @param  [ in]pSelf  An object
+ * @param  [ in]pOther Another object
+ * @param  [ in]axis   The axis
+ * @return             Whether they overlap
+ */
+static int gfmCollisionSolver_isOverlaping(gfmObject *pSelf,
+        gfmObject *pOther, int axis) {
+    int delta, max;
+
+    if (axis == gfmContact_horizontal) {
+        delta = (pSelf->t.x + pSelf->t.hw) - (pOther->t.x + pOther->t.hw);
+        max = pSelf->t.hw + pOther->t.hw;
+    }
+    else {
+        delta = (pSelf->t.y + pSelf->t.hh) - (pOther->t.y + pOther->t.hh);
+        max = pSelf->t.hh + pOther->t.hh;
+    }
+    return delta <= max && delta >= -max;
+}
+
+/**
+ * Compare two bodies by their object's address
+ *
+ * @param  [ in]pA A body
+ * @param  [ in]pB Another body
+ * @return         <0 if pA comes first, >0 if pB comes first, 0 if equal
+ */
+static int gfmCollisionSolver_compareBodies(const void *pA, const void *pB) {
+    uintptr_t a, b;
+
+    a = (uintptr_t)((const gfmCollisionBody*)pA)->pSelf;
+    b = (uintptr_t)((const gfmCollisionBody*)pB)->pSelf;
+    if (a != b) {
+        return (a < b) ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ * Compare two contacts by their bodies (so duplicates end up side by side)
+ *
+ * @param  [ in]pA A contact
+ * @param  [ in]pB Another contact
+ * @return         <0 if pA comes first, >0 if pB comes first
+ */
+static int gfmCollisionSolver_compareBodyPairs(const void *pA,
+        const void *pB) {
+    const gfmCollisionContact *pCA, *pCB;
+
+    pCA = (const gfmCollisionContact*)pA;
+    pCB = (const gfmCollisionContact*)pB;
+    if (pCA->first != pCB->first) {
+        return pCA->first - pCB->first;
+    }
+    if (pCA->second != pCB->second) {
+        return pCA->second - pCB->second;
+    }
+    return pCA->index - pCB->index;
+}
+
+/**
+ * Retrieve the order in which contacts along an axis must be solved
+ *
+ * @param  [ in]axis The axis
+ * @return           The axis' rank (vertical, then horizontal, then none)
+ */
+static int gfmCollisionSolver_getAxisRank(int axis) {
+    switch (axis) {
+        case gfmContact_vertical: return 0;
+        case gfmContact_horizontal: return 1;
+        default: return 2;
+    }
+}
+
+/**
+ * Compare two contacts by the order they must be solved: vertical contacts
+ * from the bottom up, then horizontal ones from the left to the right and,
+ * lastly, the ones that don't have to be solved
+ *
+ * @param  [ in]pA A contact
+ * @param  [ in]pB Another contact
+ * @return         <0 if pA comes first, >0 if pB comes first
+ */
+static int gfmCollisionSolver_compareContacts(const void *pA, const void *pB) {
+    const gfmCollisionContact *pCA, *pCB;
+
+    pCA = (const gfmCollisionContact*)pA;
+    pCB = (const gfmCollisionContact*)pB;
+    if (pCA->axis != pCB->axis) {
+        return gfmCollisionSolver_getAxisRank(pCA->axis)
+                - gfmCollisionSolver_getAxisRank(pCB->axis);
+    }
+    if (pCA->key != pCB->key) {
+        if (pCA->axis == gfmContact_vertical) {
+            return (pCA->key > pCB->key) ? -1 : 1;
+        }
+        return (pCA->key < pCB->key) ? -1 : 1;
+    }
+    return pCA->index - pCB->index;
+}
+
+/**
+ * Retrieve the index of an object's body
+ *
+ * @param  [ in]pCtx The solver
+ * @param  [ in]num  How many bodies there are
+ * @param  [ in]pObj The object
+ * @return           The body's index
+ */
+static int gfmCollisionSolver_findBody(gfmCollisionSolver *pCtx, int num,
+        gfmObject *pObj) {
+    gfmCollisionBody key;
+    gfmCollisionBody *pBody;
+
+    key.pSelf = pObj;
+    pBody = (gfmCollisionBody*)bsearch(&key, pCtx->pBodies, num,
+            sizeof(gfmCollisionBody), gfmCollisionSolver_compareBodies);
+    return (int)(pBody - pCtx->pBodies);
+}
+
+/**
+ * Store every object (only once) on the bodies array
+ *
+ * @param  [out]pNum How many bodies there are
+ * @param  [ in]pCtx The solver
+ * @return           GFMRV_OK, GFMRV_ALLOC_FAILED
+ */
+static gfmRV gfmCollisionSolver_buildBodies(int *pNum,
+        gfmCollisionSolver *pCtx) {
+    gfmRV rv;
+    int i, num;
+
+    if (pCtx->bodiesLen < pCtx->pairsUsed * 2) {
+        gfmCollisionBody *pTmp;
+
+        pTmp = (gfmCollisionBody*)realloc(pCtx->pBodies,
+                sizeof(gfmCollisionBody) * pCtx->pairsUsed * 2);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+        pCtx->pBodies = pTmp;
+        pCtx->bodiesLen = pCtx->pairsUsed * 2;
+    }
+
+    i = 0;
+    while (i < pCtx->pairsUsed) {
+        pCtx->pBodies[i * 2].pSelf = pCtx->pPairs[i].pSelf;
+        pCtx->pBodies[i * 2 + 1].pSelf = pCtx->pPairs[i].pOther;
+        i++;
+    }
+    qsort(pCtx->pBodies, pCtx->pairsUsed * 2, sizeof(gfmCollisionBody),
+            gfmCollisionSolver_compareBodies);
+
+    /* Remove repeated objects */
+    num = 0;
+    i = 0;
+    while (i < pCtx->pairsUsed * 2) {
+        if (num == 0 || pCtx->pBodies[num - 1].pSelf != pCtx->pBodies[i].pSelf) {
+            gfmCollisionBody *pBody;
+
+            pBody = pCtx->pBodies + num;
+            pBody->pSelf = pCtx->pBodies[i].pSelf;
+            pBody->isFixed = (pBody->pSelf->t.innerType == gfmType_hitbox)
+                    || (pBody->pSelf->flags & gfmFlags_isFixed);
+            pBody->isSupported = 0;
+            num++;
+        }
+        i++;
+    }
+
+    *pNum = num;
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Set the collision flags of a contact and decide along which axis it must be
+ * separated
+ *
+ * @param  [ in]pCtx     The solver
+ * @param  [ in]pContact The contact (with first and second set to the pair's
+ *                       bodies, in any order, and index set to its pair)
+ * @return               GFMRV_OK, ...
+ */
+static gfmRV gfmCollisionSolver_detect(gfmCollisionSolver *pCtx,
+        gfmCollisionContact *pContact) {
+    gfmObject *pSelf, *pOther;
+    gfmRV rv;
+    int dist, flags, penX, penY;
+
+    /* Use the objects in the order they were added (instead of the bodies'
+     * order, which depends on their addresses) */
+    pSelf = pCtx->pPairs[pContact->index].pSelf;
+    pOther = pCtx->pPairs[pContact->index].pOther;
+    if (pCtx->pBodies[pContact->first].pSelf != pSelf) {
+        int tmp;
+
+        tmp = pContact->first;
+        pContact->first = pContact->second;
+        pContact->second = tmp;
+    }
+
+    /* Set the flags exactly as gfmObject_collide would */
+    rv = gfmObject_justOverlaped(pSelf, pOther);
+    ASSERT(rv == GFMRV_TRUE || rv == GFMRV_FALSE, rv);
+    if (rv == GFMRV_TRUE) {
+        if (pSelf->t.innerType == gfmType_hitbox) {
+            flags = pOther->flags;
+        }
+        else {
+            flags = pSelf->flags;
+        }
+    }
+    else if (gfmObject_isOverlaping(pSelf, pOther) == GFMRV_TRUE) {
+        /* They were already overlapping, so push them apart through the
+         * shortest axis */
+        flags = gfmCollision_instHor | gfmCollision_instVer;
+    }
+    else {
+        pContact->axis = gfmContact_none;
+        pContact->key = 0;
+        rv = GFMRV_OK;
+        goto __ret;
+    }
+
+    /* Get the penetration on each axis */
+    dist = (pSelf->t.x + pSelf->t.hw) - (pOther->t.x + pOther->t.hw);
+    penX = pSelf->t.hw + pOther->t.hw - abs(dist);
+    dist = (pSelf->t.y + pSelf->t.hh) - (pOther->t.y + pOther->t.hh);
+    penY = pSelf->t.hh + pOther->t.hh - abs(dist);
+
+    if (((flags & gfmCollision_instHor) && (flags & gfmCollision_instVer)) ||
+            !(flags & (gfmCollision_instHor | gfmCollision_instVer))) {
+        /* If both were triggered (or none), use the shortest one */
+        if (penX < penY) {
+            flags = gfmCollision_instHor;
+        }
+        else {
+            flags = gfmCollision_instVer;
+        }
+    }
+
+    /* Sort the bodies along the axis (as gfmObject_justOverlaped does) */
+    if (flags & gfmCollision_instHor) {
+        pContact->axis = gfmContact_horizontal;
+        if (pOther->t.x < pSelf->t.x) {
+            int tmp;
+
+            tmp = pContact->first;
+            pContact->first = pContact->second;
+            pContact->second = tmp;
+        }
+        pContact->key = pCtx->pBodies[pContact->first].pSelf->t.x;
+    }
+    else {
+        pContact->axis = gfmContact_vertical;
+        if (pOther->t.y < pSelf->t.y) {
+            int tmp;
+
+            tmp = pContact->first;
+            pContact->first = pContact->second;
+            pContact->second = tmp;
+        }
+        pContact->key = pCtx->pBodies[pContact->second].pSelf->t.y;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Push both objects of a contact apart along its axis
+ *
+ * @param  [ in]pCtx     The solver
+ * @param  [ in]pContact The contact
+ */
+static void gfmCollisionSolver_solveContact(gfmCollisionSolver *pCtx,
+        gfmCollisionContact *pContact) {
+    gfmCollisionBody *pFirst, *pSecond;
+    gfmObjReal moveFirst, moveSecond, pen;
+    int gap, perpAxis;
+
+    pFirst = pCtx->pBodies + pContact->first;
+    pSecond = pCtx->pBodies + pContact->second;
+
+    /* Skip the contact if they were moved apart on the other axis */
+    if (pContact->axis == gfmContact_horizontal) {
+        perpAxis = gfmContact_vertical;
+    }
+    else {
+        perpAxis = gfmContact_horizontal;
+    }
+    if (!gfmCollisionSolver_isOverlaping(pFirst->pSelf, pSecond->pSelf,
+            perpAxis)) {
+        return;
+    }
+
+    /* Just like gfmObject_separateHorizontal, keep a 1 pixel gap from fixed
+     * objects */
+    gap = 0;
+    if (pContact->axis == gfmContact_horizontal
+            && (pFirst->isFixed || pSecond->isFixed)) {
+        gap = 1;
+    }
+    pen = gfmCollisionSolver_getPenetration(pFirst->pSelf, pSecond->pSelf,
+            pContact->axis, gap);
+    if (pen <= 0) {
+        return;
+    }
+
+    if (pFirst->isFixed) {
+        moveFirst = 0;
+        moveSecond = pen;
+    }
+    else if (pSecond->isFixed) {
+        moveFirst = pen;
+        moveSecond = 0;
+    }
+    else if (pContact->axis == gfmContact_vertical && pSecond->isSupported) {
+        /* Whatever is below won't move, so push only the object above */
+        moveFirst = pen;
+        moveSecond = 0;
+    }
+    else {
+        moveFirst = pen / 2;
+        moveSecond = pen - moveFirst;
+    }
+
+    if (pContact->axis == gfmContact_vertical && pSecond->isSupported) {
+        pFirst->isSupported = 1;
+    }
+
+    if (moveFirst != 0) {
+        gfmCollisionSolver_move(pFirst->pSelf, pContact->axis, -moveFirst);
+    }
+    if (moveSecond != 0) {
+        gfmCollisionSolver_move(pSecond->pSelf, pContact->axis, moveSecond);
+    }
+}
+
+/**
+ * Alloc a new collision solver
+ *
+ * @param  [out]ppCtx The alloc'ed solver
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmCollisionSolver_getNew(gfmCollisionSolver **ppCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(!(*ppCtx), GFMRV_ARGUMENTS_BAD);
+
+    /* Alloc and clean it */
+    *ppCtx = (gfmCollisionSolver*)malloc(sizeof(gfmCollisionSolver));
+    ASSERT(*ppCtx, GFMRV_ALLOC_FAILED);
+    memset(*ppCtx, 0x0, sizeof(gfmCollisionSolver));
+    (*ppCtx)->iterations = gfmCollisionSolver_defIterations;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Release a collision solver and all its members
+ *
+ * @param  [ in]ppCtx The solver
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmCollisionSolver_free(gfmCollisionSolver **ppCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(*ppCtx, GFMRV_ARGUMENTS_BAD);
+
+    /* Clean the solver */
+    gfmCollisionSolver_clean(*ppCtx);
+    /* Free the struct */
+    free(*ppCtx);
+    *ppCtx = 0;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Clean all memory used by the solver
+ *
+ * @param  [ in]pCtx The solver
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmCollisionSolver_clean(gfmCollisionSolver *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    if (pCtx->pPairs) {
+        free(pCtx->pPairs);
+    }
+    if (pCtx->pBodies) {
+        free(pCtx->pBodies);
+    }
+    if (pCtx->pContacts) {
+        free(pCtx->pContacts);
+    }
+    memset(pCtx, 0x0, sizeof(gfmCollisionSolver));
+    pCtx->iterations = gfmCollisionSolver_defIterations;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Set how many times every contact is solved (4, by default)
+ *
+ * @param  [ in]pCtx The solver
+ * @param  [ in]num  Number of iterations
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmCollisionSolver_setIterations(gfmCollisionSolver *pCtx, int num) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(num > 0, GFMRV_ARGUMENTS_BAD);
+
+    pCtx->iterations = num;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Start a new frame, discarding every pair previously added
+ *
+ * @param  [ in]pCtx The solver
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmCollisionSolver_init(gfmCollisionSolver *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    pCtx->pairsUsed = 0;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Add a pair of overlapping objects (or an object and a hitbox) to be solved;
+ * Pairs may be added more than once (and in any order), as duplicates are
+ * removed when solving
+ *
+ * @param  [ in]pCtx   The solver
+ * @param  [ in]pSelf  An object
+ * @param  [ in]pOther Another object
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED,
+ *                     GFMRV_OBJECT_NOT_INITIALIZED, GFMRV_INVALID_TYPE,
+ *                     GFMRV_OBJECTS_CANT_COLLIDE
+ */
+gfmRV gfmCollisionSolver_addPair(gfmCollisionSolver *pCtx, gfmObject *pSelf,
+        gfmObject *pOther) {
+    gfmRV rv;
+    int isSelfFixed, isOtherFixed;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pSelf, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pOther, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pSelf != pOther, GFMRV_ARGUMENTS_BAD);
+    /* Check that the objects were initialized */
+    ASSERT(pSelf->t.hw > 0, GFMRV_OBJECT_NOT_INITIALIZED);
+    ASSERT(pSelf->t.hh > 0, GFMRV_OBJECT_NOT_INITIALIZED);
+    ASSERT(pOther->t.hw > 0, GFMRV_OBJECT_NOT_INITIALIZED);
+    ASSERT(pOther->t.hh > 0, GFMRV_OBJECT_NOT_INITIALIZED);
+    /* Check that at least one of them is an object that may be moved */
+    ASSERT(pSelf->t.innerType == gfmType_object
+            || pOther->t.innerType == gfmType_object, GFMRV_INVALID_TYPE);
+    isSelfFixed = (pSelf->t.innerType == gfmType_hitbox)
+            || (pSelf->flags & gfmFlags_isFixed);
+    isOtherFixed = (pOther->t.innerType == gfmType_hitbox)
+            || (pOther->flags & gfmFlags_isFixed);
+    ASSERT(!isSelfFixed || !isOtherFixed, GFMRV_OBJECTS_CANT_COLLIDE);
+
+    /* Expand the array, if needed */
+    if (pCtx->pairsUsed >= pCtx->pairsLen) {
+        gfmGroupPair *pTmp;
+        int len;
+
+        len = pCtx->pairsLen * 2;
+        if (len < gfmCollisionSolver_minLen) {
+            len = gfmCollisionSolver_minLen;
+        }
+        pTmp = (gfmGroupPair*)realloc(pCtx->pPairs, sizeof(gfmGroupPair) * len);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+        pCtx->pPairs = pTmp;
+        pCtx->pairsLen = len;
+    }
+
+    pCtx->pPairs[pCtx->pairsUsed].pSelf = pSelf;
+    pCtx->pPairs[pCtx->pairsUsed].pOther = pOther;
+    pCtx->pairsUsed++;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Add every pair retrieved by gfmGroup_collideGroups
+ *
+ * @param  [ in]pCtx   The solver
+ * @param  [ in]pPairs The pairs
+ * @param  [ in]num    How many pairs there are
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED,
+ *                     GFMRV_OBJECT_NOT_INITIALIZED, GFMRV_INVALID_TYPE,
+ *                     GFMRV_OBJECTS_CANT_COLLIDE
+ */
+gfmRV gfmCollisionSolver_addPairs(gfmCollisionSolver *pCtx,
+        gfmGroupPair *pPairs, int num) {
+    gfmRV rv;
+    int i;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pPairs || num == 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(num >= 0, GFMRV_ARGUMENTS_BAD);
+
+    i = 0;
+    while (i < num) {
+        rv = gfmCollisionSolver_addPair(pCtx, pPairs[i].pSelf,
+                pPairs[i].pOther);
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Set the collision flags of every pair and separate them
+ *
+ * @param  [ in]pCtx The solver
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmCollisionSolver_solve(gfmCollisionSolver *pCtx) {
+    gfmRV rv;
+    int i, iteration, numBodies, numContacts;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    if (pCtx->pairsUsed == 0) {
+        rv = GFMRV_OK;
+        goto __ret;
+    }
+
+    rv = gfmCollisionSolver_buildBodies(&numBodies, pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    if (pCtx->contactsLen < pCtx->pairsUsed) {
+        gfmCollisionContact *pTmp;
+
+        pTmp = (gfmCollisionContact*)realloc(pCtx->pContacts,
+                sizeof(gfmCollisionContact) * pCtx->pairsUsed);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+        pCtx->pContacts = pTmp;
+        pCtx->contactsLen = pCtx->pairsUsed;
+    }
+
+    /* Convert every pair into a contact between two bodies (with the lowest
+     * index first, so repeated pairs are equal regardless of their order) */
+    i = 0;
+    while (i < pCtx->pairsUsed) {
+        gfmCollisionContact *pContact;
+        int a, b;
+
+        a = gfmCollisionSolver_findBody(pCtx, numBodies,
+                pCtx->pPairs[i].pSelf);
+        b = gfmCollisionSolver_findBody(pCtx, numBodies,
+                pCtx->pPairs[i].pOther);
+
+        pContact = pCtx->pContacts + i;
+        pContact->first = (a < b) ? a : b;
+        pContact->second = (a < b) ? b : a;
+        pContact->index = i;
+        i++;
+    }
+    qsort(pCtx->pContacts, pCtx->pairsUsed, sizeof(gfmCollisionContact),
+            gfmCollisionSolver_compareBodyPairs);
+
+    /* Remove repeated contacts and set the flags of the unique ones */
+    numContacts = 0;
+    i = 0;
+    while (i < pCtx->pairsUsed) {
+        gfmCollisionContact *pContact;
+
+        pContact = pCtx->pContacts + i;
+        i++;
+        if (numContacts > 0
+                && pCtx->pContacts[numContacts - 1].first == pContact->first
+                && pCtx->pContacts[numContacts - 1].second == pContact->second) {
+            continue;
+        }
+        pCtx->pContacts[numContacts] = *pContact;
+        numContacts++;
+    }
+    i = 0;
+    while (i < numContacts) {
+        rv = gfmCollisionSolver_detect(pCtx, pCtx->pContacts + i);
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+    qsort(pCtx->pContacts, numContacts, sizeof(gfmCollisionContact),
+            gfmCollisionSolver_compareContacts);
+
+    /* Solve every contact, a few times */
+    iteration = 0;
+    while (iteration < pCtx->iterations) {
+        i = 0;
+        while (i < numBodies) {
+            pCtx->pBodies[i].isSupported = pCtx->pBodies[i].isFixed;
+            i++;
+        }
+
+        i = 0;
+        while (i < numContacts) {
+            if (pCtx->pContacts[i].axis == gfmContact_none) {
+                i++;
+                continue;
+            }
+            gfmCollisionSolver_solveContact(pCtx, pCtx->pContacts + i);
+            i++;
+        }
+
+        iteration++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
@@ -184,6 +184,19 @@ const char *gfmError_dict[GFMRV_MAX + 1] = {
     "Can't normalized fixed point number, as it's greater fp's limit", /* GFMRV_FIXED_POINT_TOO_BIG */
     "Unsupported texture format", /* GFMRV_TEXTURE_UNSUPPORTED */
     "Function does not operate on the given type", /* GFMRV_INVALID_TYPE */
+    // Thread pool errors
+    "Failed to create the worker threads", /* GFMRV_THREADPOOL_CREATE_FAILED */
+    // Quadtree errors (p. 2)
+    "Operation not available on the quadtree's current mode", /* GFMRV_QUADTREE_INVALID_MODE */
+    // Spatial grid errors
+    "Spatial grid not initialized", /* GFMRV_SPATIALGRID_NOT_INITIALIZED */
+    "Spatial grid operation not active", /* GFMRV_SPATIALGRID_OPERATION_NOT_ACTIVE */
+    "Spatial grid overlaped", /* GFMRV_SPATIALGRID_OVERLAPED */
+    "Spatial grid no overlap", /* GFMRV_SPATIALGRID_NO_OVERLAP */
+    "Spatial grid done", /* GFMRV_SPATIALGRID_DONE */
+    // Particle system errors
+    "Particle system max particles", /* GFMRV_PARTICLES_MAX_PARTICLES */
+    "Particle system no last particle", /* GFMRV_PARTICLES_NO_LAST_PARTICLE */
     "Max error" /* GFMRV_MAX */
 };
 
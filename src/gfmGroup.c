@@ -43,6 +43,7 @@
 #include <GFraMe/gfmSprite.h>
 #include <GFraMe/gfmTypes.h>
 #include <GFraMe_int/gfmGroupHelpers.h>
+#include <GFraMe_int/core/gfmThreadPool_bkend.h>
 
 #include <stdlib.h>
 #include <string.h>
@@ -81,18 +82,23 @@ struct stGFMGroupConf {
     int defAx;
     /** Default vertical acc */
     int defAy;
+    /** Default number of frames a sprite must stand still before sleeping */
+    int defSleepDelay;
 };
 typedef struct stGFMGroupConf gfmGroupConf;
 
 /**
  * Struct used to ease sorting/drawing
  *
- * All visible nodes are sequentially stored in pDrawArr. So, if a binary tree
- * is built from its elements, its root will be the first element.
+ * All visible nodes are sequentially stored in pDrawArr. When sorting, nodes
+ * are moved back and forth between it and pSortArr (and, afterward, pDrawArr
+ * points to the sorted ones).
  */
 struct stGFMGroupDrawCtx {
     /** Array with all draw elements */
     gfmGroupDrawNode *pDrawArr;
+    /** Array used as temporary storage while sorting pDrawArr */
+    gfmGroupDrawNode *pSortArr;
     /** Current draw order */
     gfmDrawOrder drawOrder;
     /** Total number of elements on the array */
@@ -102,6 +108,108 @@ struct stGFMGroupDrawCtx {
 };
 typedef struct stGFMGroupDrawCtx gfmGroupDrawCtx;
 
+/** How many active nodes are updated on each task of a threaded update */
+enum {
+    gfmGroup_updatePerTask = 256
+};
+
+/** Flags describing a node after it was updated */
+enum enGFMGroupNodeState {
+    /** The node is still alive */
+    gfmGroup_nodeAlive  = 0x00000001,
+    /** The node is inside the camera */
+    gfmGroup_nodeInside = 0x00000002,
+};
+
+/**
+ * Struct used to update the group on multiple threads
+ *
+ * The active list is flattened into ppNodes, which is split into chunks of
+ * gfmGroup_updatePerTask nodes; Each chunk stores its nodes' states on pStates
+ * and its visible sublist on pSortArr (at the chunk's first index), so they
+ * may be merged in order afterward
+ */
+struct stGFMGroupUpdateCtx {
+    /** Worker threads; NULL if updating on a single thread */
+    gfmThreadPool *pPool;
+    /** The active nodes, in order */
+    gfmGroupNode **ppNodes;
+    /** Flags (see enGFMGroupNodeState) for each active node */
+    int *pStates;
+    /** How many visible nodes each chunk found */
+    int *pVisible;
+    /** Camera used by the current update */
+    gfmCamera *pCam;
+    /** Game's context used by the current update */
+    gfmCtx *pCtx;
+    /** Time elapsed on the current update */
+    int elapsed;
+    /** How many nodes are active */
+    int used;
+    /** How many nodes fit on the buffers */
+    int len;
+};
+typedef struct stGFMGroupUpdateCtx gfmGroupUpdateCtx;
+
+/** An object (and its horizontal bounds) on a sorted collideable list */
+struct stGFMGroupCollideEntry {
+    /** The object */
+    gfmObject *pSelf;
+    /** The object's left edge */
+    int minX;
+    /** The object's right edge */
+    int maxX;
+    /** Position on the collideable list (to break ties) */
+    int index;
+};
+typedef struct stGFMGroupCollideEntry gfmGroupCollideEntry;
+
+/**
+ * Struct used to collide two groups; Both collideable lists are sorted by
+ * their left edges and swept together, keeping enough state to resume the
+ * sweep after the pairs buffer gets filled
+ */
+struct stGFMGroupCollideCtx {
+    /** This group's sorted objects */
+    gfmGroupCollideEntry *pSelfEntries;
+    /** The other group's sorted objects */
+    gfmGroupCollideEntry *pOtherEntries;
+    /** How many of this group's objects are being collided */
+    int selfUsed;
+    /** How many entries fit on pSelfEntries */
+    int selfLen;
+    /** How many of the other group's objects are being collided */
+    int otherUsed;
+    /** How many entries fit on pOtherEntries */
+    int otherLen;
+    /** Width of the other group's widest object */
+    int otherMaxWidth;
+    /** Current object on pSelfEntries */
+    int cur;
+    /** First object on pOtherEntries that may overlap the current one */
+    int start;
+    /** Next object on pOtherEntries to be tested (-1 on a new object) */
+    int scanPos;
+    /** Whether there's a collision to be continued */
+    int isActive;
+};
+typedef struct stGFMGroupCollideCtx gfmGroupCollideCtx;
+
+/** Round a length up to the next multiple of ALIGN */
+#define gfmGroup_alignLen(len) \
+    ((((len) + ALIGN - 1) / ALIGN) * ALIGN)
+
+/**
+ * Header of a block of memory where nodes are alloc'ed; Each slab holds an
+ * array of nodes, followed by an array with their sprites and another with
+ * their objects
+ */
+struct stGFMGroupSlab {
+    /** The next slab */
+    struct stGFMGroupSlab *pNext;
+};
+typedef struct stGFMGroupSlab gfmGroupSlab;
+
 /** The gfmGroup structure */
 struct stGFMGroup {
     /** This group's configurations */
@@ -110,6 +218,8 @@ struct stGFMGroup {
     gfmGroupDrawCtx *pDrawCtx;
     /** Array with every group node */
     gfmGenArr_var(gfmGroupNode, pNodes);
+    /** List of slabs where nodes, sprites and objects are kept */
+    gfmGroupSlab *pSlabs;
 
     /** List of currently active nodes */
     gfmGroupNode *pActive;
@@ -123,8 +233,18 @@ struct stGFMGroup {
     gfmSprite *pLast;
     /** How many sprites have been skipped */
     int skippedCollision;
+    /** Maximum number of collideable sprites per frame (0 if unlimited) */
+    int maxCollideable;
+    /** How many sprites were deferred, on the last frame, by the cap */
+    int deferredSprites;
+    /** How many sprites were asleep on the last frame */
+    int sleepingSprites;
     /** Whether should die on leaving the screen */
     int dieOnLeave;
+    /** This group's threaded update context */
+    gfmGroupUpdateCtx updateCtx;
+    /** This group's group-vs-group collision context */
+    gfmGroupCollideCtx collideCtx;
 };
 
 /**
@@ -238,7 +358,20 @@ __ret:
 }
 
 /**
- * Cache more sprite
+ * Used to expand the nodes buffer without alloc'ing the nodes (as they are
+ * placed on slabs)
+ *
+ * @param  ppNode The node's reference
+ * @return        GFMRV_OK
+ */
+static gfmRV gfmGroup_setNodeEmpty(gfmGroupNode **ppNode) {
+    *ppNode = 0;
+    return GFMRV_OK;
+}
+
+/**
+ * Cache more sprite; The new nodes, their sprites and their objects are
+ * alloc'ed on a single slab (that's released on gfmGroup_clean)
  *
  * @param  pCtx The group
  * @param  num  How many new sprites should be cached
@@ -246,8 +379,11 @@ __ret:
  *              GFMRV_GROUP_MAX_SPRITES
  */
 gfmRV gfmGroup_cacheSprites(gfmGroup *pCtx, int num) {
+    gfmGroupSlab *pSlab;
+    gfmGroupNode *pSlabNodes;
+    char *pSlabSprites, *pSlabObjects;
     gfmRV rv;
-    int newLen, pos, i;
+    int len, newLen, pos, i;
 
     // Sanitize arguments
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
@@ -262,24 +398,45 @@ gfmRV gfmGroup_cacheSprites(gfmGroup *pCtx, int num) {
     ASSERT(pCtx->pConf->maxLen == 0 || newLen <= pCtx->pConf->maxLen,
             GFMRV_GROUP_MAX_SPRITES);
 
+    // Alloc the slab: its header, followed by every node, every sprite and
+    // every object (each array starting at an aligned address)
+    len = gfmGroup_alignLen(sizeof(gfmGroupSlab));
+    len += gfmGroup_alignLen(sizeof(gfmGroupNode) * num);
+    len += gfmGroup_alignLen(sizeofGFMSprite * num);
+    len += sizeofGFMObject * num;
+    pSlab = (gfmGroupSlab*)malloc(len);
+    ASSERT(pSlab, GFMRV_ALLOC_FAILED);
+    memset(pSlab, 0x0, len);
+    // Prepend it to the slabs list, so it's released with the group
+    pSlab->pNext = pCtx->pSlabs;
+    pCtx->pSlabs = pSlab;
+
+    pSlabNodes = (gfmGroupNode*)(((char*)pSlab) +
+            gfmGroup_alignLen(sizeof(gfmGroupSlab)));
+    pSlabSprites = ((char*)pSlabNodes) +
+            gfmGroup_alignLen(sizeof(gfmGroupNode) * num);
+    pSlabObjects = pSlabSprites + gfmGroup_alignLen(sizeofGFMSprite * num);
+
     // Expand the nodes buffer
     gfmGenArr_setMinSize(gfmGroupNode, pCtx->pNodes, pos + num,
-            gfmGroupNode_getNew);
+            gfmGroup_setNodeEmpty);
 
     // Initialize every new sprite
-    i = pos;
-    while (i < newLen) {
+    i = 0;
+    while (i < num) {
         gfmGroupNode *pNode;
-        gfmGroupNode *pNextNode;
 
         // Retrieve a node
-        gfmGenArr_getNextRef(gfmGroupNode, pCtx->pNodes, 1/*inc*/, pNode,
-                gfmGroupNode_getNew);
+        pNode = pSlabNodes + i;
+        gfmGenArr_getObject(pCtx->pNodes, pos + i) = pNode;
         gfmGenArr_push(pCtx->pNodes);
 
-        // Alloc its sprite (and set it for auto dealloc'ing)
+        // Retrieve its sprite (and set it for auto dealloc'ing)
         pNode->autoFree = 1;
-        rv = gfmSprite_getNew(&(pNode->pSelf));
+        pNode->inSlab = 1;
+        pNode->pSelf = (gfmSprite*)(pSlabSprites + sizeofGFMSprite * i);
+        rv = gfmSprite_setObjectStorage(pNode->pSelf,
+                (gfmObject*)(pSlabObjects + sizeofGFMObject * i));
         ASSERT_NR(rv == GFMRV_OK);
         // Initialize the sprite
         rv = gfmSprite_init(pNode->pSelf, 0/*x*/, 0/*y*/, pCtx->pConf->defWidth,
@@ -294,23 +451,20 @@ gfmRV gfmGroup_cacheSprites(gfmGroup *pCtx, int num) {
         ASSERT_NR(rv == GFMRV_OK);
         }
 
-        if (i < newLen - 1) {
+        if (i < num - 1) {
             // Get the next node, if any
-            pNextNode = gfmGenArr_getObject(pCtx->pNodes, i + 1);
+            pNode->pNext = pNode + 1;
         }
         else {
             // Otherwise, prepend this new list to the inactive list
-            pNextNode = pCtx->pInactive;
+            pNode->pNext = pCtx->pInactive;
         }
 
-        // Set the next node in the list
-        pNode->pNext = pNextNode;
-
         i++;
     }
 
     // Inactive list must point to the first of the newly allocated nodes
-    pCtx->pInactive = gfmGenArr_getObject(pCtx->pNodes, pos);
+    pCtx->pInactive = pSlabNodes;
 
     rv = GFMRV_OK;
 __ret:
@@ -331,11 +485,44 @@ gfmRV gfmGroup_clean(gfmGroup *pCtx) {
 
     /* Free every node on the list */
     gfmGenArr_clean(pCtx->pNodes, gfmGroupNode_free);
+    /* Release the slabs where they were kept */
+    while (pCtx->pSlabs) {
+        gfmGroupSlab *pSlab;
+
+        pSlab = pCtx->pSlabs;
+        pCtx->pSlabs = pSlab->pNext;
+        free(pSlab);
+    }
 
     /* Free the nodes from the draw context */
     if (pCtx->pDrawCtx->pDrawArr) {
         free(pCtx->pDrawCtx->pDrawArr);
     }
+    if (pCtx->pDrawCtx->pSortArr) {
+        free(pCtx->pDrawCtx->pSortArr);
+    }
+
+    /* Stop the workers and free the update buffers */
+    gfmThreadPool_free(&(pCtx->updateCtx.pPool));
+    if (pCtx->updateCtx.ppNodes) {
+        free(pCtx->updateCtx.ppNodes);
+    }
+    if (pCtx->updateCtx.pStates) {
+        free(pCtx->updateCtx.pStates);
+    }
+    if (pCtx->updateCtx.pVisible) {
+        free(pCtx->updateCtx.pVisible);
+    }
+    memset(&(pCtx->updateCtx), 0x0, sizeof(gfmGroupUpdateCtx));
+
+    /* Free the group-vs-group collision buffers */
+    if (pCtx->collideCtx.pSelfEntries) {
+        free(pCtx->collideCtx.pSelfEntries);
+    }
+    if (pCtx->collideCtx.pOtherEntries) {
+        free(pCtx->collideCtx.pOtherEntries);
+    }
+    memset(&(pCtx->collideCtx), 0x0, sizeof(gfmGroupCollideCtx));
 
     rv = GFMRV_OK;
 __ret:
@@ -407,6 +594,7 @@ gfmRV gfmGroup_recycle(gfmSprite **ppSpr, gfmGroup *pCtx) {
 
     // Reset the node's timer
     pTmp->timeAlive = pCtx->pConf->ttl;
+    pTmp->deferredFrames = 0;
 
     // Set the sprite's default values
     rv = gfmSprite_resetObject(pTmp->pSelf);
@@ -417,6 +605,8 @@ gfmRV gfmGroup_recycle(gfmSprite **ppSpr, gfmGroup *pCtx) {
     rv = gfmSprite_setAcceleration(pTmp->pSelf, pCtx->pConf->defAx,
             pCtx->pConf->defAy);
     ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmSprite_setSleepDelay(pTmp->pSelf, pCtx->pConf->defSleepDelay);
+    ASSERT_NR(rv == GFMRV_OK);
 
     // Insert it at the begining of the active list
     pTmp->pNext = pCtx->pActive;
@@ -578,6 +768,29 @@ __ret:
     return rv;
 }
 
+/**
+ * Set for how many frames every recycled sprite must stand still before
+ * falling asleep (see gfmObject_setSleepDelay)
+ *
+ * @param  pCtx   The group
+ * @param  frames Number of frames; 0 (the default) makes the sprites never
+ *                sleep
+ * @return        GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmGroup_setDefSleepDelay(gfmGroup *pCtx, int frames) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(frames >= 0, GFMRV_ARGUMENTS_BAD);
+
+    pCtx->pConf->defSleepDelay = frames;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
 /**
  * Set whether every recycle sprite should 'die' when it leaves the screen
  *
@@ -824,6 +1037,116 @@ __ret:
     return rv;
 }
 
+/**
+ * Cap how many sprites may be collideable on each frame; After the collision
+ * quality selects its sprites, only the ones that were deferred for the most
+ * frames are kept (so every sprite gets its turn), while the others are
+ * deferred to a later frame
+ *
+ * NOTE: This caps the number of sprites sent to the quadtree, not the number
+ * of overlap tests done with them (which still depends on how they are
+ * spread)
+ *
+ * @param  pCtx The group
+ * @param  max  Maximum number of collideable sprites per frame; 0 disables
+ *              the cap
+ * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmGroup_setMaxCollideable(gfmGroup *pCtx, int max) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(max >= 0, GFMRV_ARGUMENTS_BAD);
+
+    pCtx->maxCollideable = max;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Get how many sprites were left out of the collideable list (to stay within
+ * the cap set by gfmGroup_setMaxCollideable) on the last update
+ *
+ * @param  pNum How many sprites were deferred
+ * @param  pCtx The group
+ * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmGroup_getDeferredSprites(int *pNum, gfmGroup *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pNum, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    *pNum = pCtx->deferredSprites;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Get how many of the group's live sprites were asleep on the last update
+ *
+ * @param  pNum How many sprites were asleep
+ * @param  pCtx The group
+ * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmGroup_getSleepingCount(int *pNum, gfmGroup *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pNum, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    *pNum = pCtx->sleepingSprites;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Set how many threads gfmGroup_update may use; The active sprites are split
+ * into chunks, each updated (and checked against the camera) by any of the
+ * threads, and the results are merged afterward, so the active, visible and
+ * collideable lists are the same as if updated by a single thread
+ *
+ * NOTE: Sprites are updated concurrently; Each worker only writes to its own
+ * sprites (their objects, timers and animations, since every sprite has its
+ * own gfmAnimation and only reads the shared animation data) and to the
+ * sprites' own draw nodes; The game's context (i.e., the elapsed time), the
+ * camera and the spritesets are only read, so they must not be modified (nor
+ * shared with a sprite outside of the group) while gfmGroup_update runs
+ *
+ * @param  pCtx       The group
+ * @param  numThreads How many threads should be used (including the calling
+ *                    one); 1 disables threading
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED,
+ *                    GFMRV_THREADPOOL_CREATE_FAILED
+ */
+gfmRV gfmGroup_setThreads(gfmGroup *pCtx, int numThreads) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(numThreads > 0, GFMRV_ARGUMENTS_BAD);
+
+    /* Release the previous workers (if any) and spawn new ones */
+    gfmThreadPool_free(&(pCtx->updateCtx.pPool));
+    if (numThreads > 1) {
+        rv = gfmThreadPool_getNew(&(pCtx->updateCtx.pPool), numThreads);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
 /**
  * Get the list of collideable objects
  *
@@ -851,6 +1174,251 @@ __ret:
     return rv;
 }
 
+/**
+ * Compare two entries by their left edge (and, on ties, by their position on
+ * the collideable list, so the sort is deterministic)
+ *
+ * @param  [ in]pA An entry
+ * @param  [ in]pB Another entry
+ * @return         <0 if pA comes first, >0 if pB comes first
+ */
+static int gfmGroup_compareEntries(const void *pA, const void *pB) {
+    const gfmGroupCollideEntry *pEntA, *pEntB;
+
+    pEntA = (const gfmGroupCollideEntry*)pA;
+    pEntB = (const gfmGroupCollideEntry*)pB;
+    if (pEntA->minX != pEntB->minX) {
+        return (pEntA->minX < pEntB->minX) ? -1 : 1;
+    }
+    return pEntA->index - pEntB->index;
+}
+
+/**
+ * Store every collideable object from a group on an array, sorted by their
+ * left edge
+ *
+ * @param  [out]ppEntries The array (expanded as necessary)
+ * @param  [out]pUsed     How many entries were stored
+ * @param  [out]pMaxWidth The widest object's width
+ * @param  [i/o]pLen      How many entries fit on the array
+ * @param  [ in]pGroup    The group
+ * @return                GFMRV_OK, GFMRV_ALLOC_FAILED, ...
+ */
+static gfmRV gfmGroup_sortCollideable(gfmGroupCollideEntry **ppEntries,
+        int *pUsed, int *pMaxWidth, int *pLen, gfmGroup *pGroup) {
+    gfmGroupNode *pNode;
+    gfmRV rv;
+    int used;
+
+    /* Count the collideable nodes and expand the array, if needed */
+    used = 0;
+    pNode = pGroup->pCollideable;
+    while (pNode) {
+        used++;
+        pNode = pNode->pNextCollideable;
+    }
+    if (*pLen < used) {
+        gfmGroupCollideEntry *pTmp;
+
+        pTmp = (gfmGroupCollideEntry*)realloc(*ppEntries,
+                sizeof(gfmGroupCollideEntry) * used);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+        *ppEntries = pTmp;
+        *pLen = used;
+    }
+
+    /* Retrieve each object's horizontal bounds */
+    *pMaxWidth = 0;
+    used = 0;
+    pNode = pGroup->pCollideable;
+    while (pNode) {
+        gfmGroupCollideEntry *pEntry;
+        int height, width, y;
+
+        pEntry = *ppEntries + used;
+        rv = gfmSprite_getObject(&(pEntry->pSelf), pNode->pSelf);
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmObject_getPosition(&(pEntry->minX), &y, pEntry->pSelf);
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmObject_getDimensions(&width, &height, pEntry->pSelf);
+        ASSERT_NR(rv == GFMRV_OK);
+        pEntry->maxX = pEntry->minX + width;
+        pEntry->index = used;
+        if (width > *pMaxWidth) {
+            *pMaxWidth = width;
+        }
+
+        used++;
+        pNode = pNode->pNextCollideable;
+    }
+
+    qsort(*ppEntries, used, sizeof(gfmGroupCollideEntry),
+            gfmGroup_compareEntries);
+    *pUsed = used;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Sweep both sorted arrays, storing overlaps until either the buffer is full
+ * or every object was tested
+ *
+ * @param  [out]pPairs   Buffer that will be filled with the overlaps
+ * @param  [out]pCount   How many overlaps were stored on the buffer
+ * @param  [ in]pSelf    The first group
+ * @param  [ in]maxPairs How many overlaps fit on the buffer
+ * @return               GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE, ...
+ */
+static gfmRV gfmGroup_sweepCollideable(gfmGroupPair *pPairs, int *pCount,
+        gfmGroup *pSelf, int maxPairs) {
+    gfmGroupCollideCtx *pColCtx;
+    gfmRV rv;
+
+    pColCtx = &(pSelf->collideCtx);
+    *pCount = 0;
+
+    while (pColCtx->cur < pColCtx->selfUsed) {
+        gfmGroupCollideEntry *pEntry;
+
+        pEntry = pColCtx->pSelfEntries + pColCtx->cur;
+
+        /* On a new object, skip every other object that ends before it; Since
+         * the objects are sorted, those won't overlap any later one either */
+        if (pColCtx->scanPos < 0) {
+            while (pColCtx->start < pColCtx->otherUsed &&
+                    pColCtx->pOtherEntries[pColCtx->start].minX +
+                    pColCtx->otherMaxWidth < pEntry->minX) {
+                pColCtx->start++;
+            }
+            pColCtx->scanPos = pColCtx->start;
+        }
+
+        /* Test every other object that starts before this one ends */
+        while (pColCtx->scanPos < pColCtx->otherUsed &&
+                pColCtx->pOtherEntries[pColCtx->scanPos].minX <=
+                pEntry->maxX) {
+            gfmGroupCollideEntry *pOther;
+
+            pOther = pColCtx->pOtherEntries + pColCtx->scanPos;
+            pColCtx->scanPos++;
+
+            if (pOther->maxX < pEntry->minX ||
+                    pOther->pSelf == pEntry->pSelf) {
+                continue;
+            }
+            rv = gfmObject_isOverlaping(pEntry->pSelf, pOther->pSelf);
+            ASSERT(rv == GFMRV_TRUE || rv == GFMRV_FALSE, rv);
+            if (rv == GFMRV_TRUE) {
+                pPairs[*pCount].pSelf = pEntry->pSelf;
+                pPairs[*pCount].pOther = pOther->pSelf;
+                (*pCount)++;
+                if (*pCount == maxPairs) {
+                    /* Halt, so the pairs may be handled */
+                    rv = GFMRV_QUADTREE_OVERLAPED;
+                    goto __ret;
+                }
+            }
+        }
+
+        pColCtx->cur++;
+        pColCtx->scanPos = -1;
+    }
+
+    pColCtx->isActive = 0;
+    rv = GFMRV_QUADTREE_DONE;
+__ret:
+    return rv;
+}
+
+/**
+ * Collide every collideable object from a group against every collideable
+ * object from another one, without any quadtree; Both lists (as built by
+ * gfmGroup_update) are sorted by their objects' left edge and swept together,
+ * storing every overlap into a buffer
+ *
+ * If the buffer gets filled, GFMRV_QUADTREE_OVERLAPED is returned and
+ * gfmGroup_continueCollision must be called (after handling the pairs) to
+ * resume the operation
+ *
+ * NOTE: Only objects within the other group's widest object from each other
+ * are tested, so a single huge object makes every one of them be tested
+ *
+ * @param  [out]pPairs   Buffer that will be filled with the overlaps
+ * @param  [out]pCount   How many overlaps were stored on the buffer
+ * @param  [ in]pSelf    The first group (which keeps the operation's state)
+ * @param  [ in]pOther   The second group
+ * @param  [ in]maxPairs How many overlaps fit on the buffer
+ * @return               GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED,
+ *                       GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmGroup_collideGroups(gfmGroupPair *pPairs, int *pCount,
+        gfmGroup *pSelf, gfmGroup *pOther, int maxPairs) {
+    gfmGroupCollideCtx *pColCtx;
+    gfmRV rv;
+    int maxWidth;
+
+    /* Sanitize arguments */
+    ASSERT(pPairs, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCount, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pSelf, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pOther, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pSelf != pOther, GFMRV_ARGUMENTS_BAD);
+    ASSERT(maxPairs > 0, GFMRV_ARGUMENTS_BAD);
+
+    pColCtx = &(pSelf->collideCtx);
+    *pCount = 0;
+
+    /* Sort both lists */
+    pColCtx->isActive = 0;
+    rv = gfmGroup_sortCollideable(&(pColCtx->pSelfEntries),
+            &(pColCtx->selfUsed), &maxWidth, &(pColCtx->selfLen), pSelf);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmGroup_sortCollideable(&(pColCtx->pOtherEntries),
+            &(pColCtx->otherUsed), &(pColCtx->otherMaxWidth),
+            &(pColCtx->otherLen), pOther);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    /* Start sweeping from the first object */
+    pColCtx->cur = 0;
+    pColCtx->start = 0;
+    pColCtx->scanPos = -1;
+    pColCtx->isActive = 1;
+
+    rv = gfmGroup_sweepCollideable(pPairs, pCount, pSelf, maxPairs);
+__ret:
+    return rv;
+}
+
+/**
+ * Continue a collision between groups, after its buffer was filled
+ *
+ * @param  [out]pPairs   Buffer that will be filled with the overlaps
+ * @param  [out]pCount   How many overlaps were stored on the buffer
+ * @param  [ in]pSelf    The first group
+ * @param  [ in]maxPairs How many overlaps fit on the buffer
+ * @return               GFMRV_ARGUMENTS_BAD,
+ *                       GFMRV_QUADTREE_OPERATION_NOT_ACTIVE,
+ *                       GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmGroup_continueCollision(gfmGroupPair *pPairs, int *pCount,
+        gfmGroup *pSelf, int maxPairs) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pPairs, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCount, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pSelf, GFMRV_ARGUMENTS_BAD);
+    ASSERT(maxPairs > 0, GFMRV_ARGUMENTS_BAD);
+    /* Check that there's something to continue */
+    ASSERT(pSelf->collideCtx.isActive, GFMRV_QUADTREE_OPERATION_NOT_ACTIVE);
+
+    rv = gfmGroup_sweepCollideable(pPairs, pCount, pSelf, maxPairs);
+__ret:
+    return rv;
+}
+
 /**
  * Get the next collideable sprite
  *
@@ -940,168 +1508,78 @@ __ret:
 }
 
 /**
- * Iterate through every sprite and update'em
+ * Update a single node: update its sprite and timer, check whether it's inside
+ * the camera and, if it's visible, initialize its draw node; Nodes that died
+ * are marked as so, but they aren't removed from the active list
  *
- * @param  pGrp The group
- * @param  pCtx The game's context
- * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ * This only modifies the node itself, its sprite (and its animation) and the
+ * draw node, while only reading the context, the camera and the spriteset, so
+ * it may be called concurrently for different nodes
+ *
+ * @param  [out]pState  Flags (see enGFMGroupNodeState) for the node
+ * @param  [out]pDraw   The node's draw node (initialized if it's visible)
+ * @param  [ in]pGroup  The group
+ * @param  [ in]pNode   The node
+ * @param  [ in]pCam    The current camera
+ * @param  [ in]elapsed Time elapsed from the previous frame
+ * @param  [ in]pCtx    The game's context
+ * @return              GFMRV_OK, GFMRV_ARGUMENTS_BAD, ...
  */
-gfmRV gfmGroup_update(gfmGroup *pGroup, gfmCtx *pCtx) {
-    gfmCamera *pCam;
-    gfmGroupDrawCtx *pDrawCtx;
-    gfmGroupNode *pTmp;
-    gfmGroupNode *pPrev;
+static gfmRV gfmGroup_updateNode(int *pState, gfmGroupDrawNode *pDraw,
+        gfmGroup *pGroup, gfmGroupNode *pNode, gfmCamera *pCam, int elapsed,
+        gfmCtx *pCtx) {
     gfmRV rv;
-    int elapsed;
+    int isAlive, isInside;
 
-    /* Sanitize arguments */
-    ASSERT(pGroup, GFMRV_ARGUMENTS_BAD);
-    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Clear the state, so it's valid even if the update fails */
+    *pState = 0;
 
-    pDrawCtx = pGroup->pDrawCtx;
-
-    /* Remove the reference to the last recycled/added sprite */
-    pGroup->pLast = 0;
-    /* Reset the list of visible sprites */
-    pDrawCtx->usedElements = 0;
-    /* Reset the list of collideable sprites */
-    pGroup->pCollideable = 0;
-    /* Don't reset pGroup->skippedCollision so it cycles the starting node
-     * every few frames */
-    /* Retrieve the current camera */
-    rv = gfm_getCamera(&pCam, pCtx);
+    /* Update the sprite */
+    rv = gfmSprite_update(pNode->pSelf, pCtx);
     ASSERT_NR(rv == GFMRV_OK);
 
-    /* Make sure the draw context is big enough */
-    if (pDrawCtx->totalElements < gfmGenArr_getUsed(pGroup->pNodes)) {
-        pDrawCtx->totalElements = gfmGenArr_getUsed(pGroup->pNodes);
-        pDrawCtx->pDrawArr = (gfmGroupDrawNode*)realloc(pDrawCtx->pDrawArr,
-                sizeof(gfmGroupDrawNode) * pDrawCtx->totalElements);
-        ASSERT(pDrawCtx->pDrawArr, GFMRV_ALLOC_FAILED);
+    /* Update the node's timer */
+    if (pNode->timeAlive > 0) {
+        pNode->timeAlive -= elapsed;
     }
 
-    /* Get the time elapsed from the previous frame */
-    rv = gfm_getElapsedTime(&elapsed, pCtx);
-    ASSERT_NR(rv == GFMRV_OK);
-
-    /* Loop through every node */
-    pPrev = 0;
-    pTmp = pGroup->pActive;
-    while (pTmp) {
-        gfmGroupNode *pNext;
-        int isInside, isAlive;
-
-        /* Update the sprite */
-        rv = gfmSprite_update(pTmp->pSelf, pCtx);
-        ASSERT_NR(rv == GFMRV_OK);
-
-        /* Update the node's timer */
-        if (pTmp->timeAlive > 0) {
-            pTmp->timeAlive -= elapsed;
-        }
-
-        /* Check if the sprite is inside the camera */
-        rv = gfmCamera_isSpriteInside(pCam, pTmp->pSelf);
-        ASSERT_NR(rv == GFMRV_TRUE || rv == GFMRV_FALSE);
-        isInside = (rv == GFMRV_TRUE);
-
-        /* Get the next node */
-        pNext = pTmp->pNext;
-
-        /* Check if the sprite should be "killed" */
-        isAlive = (!pGroup->dieOnLeave || isInside) &&
-                (pTmp->timeAlive == gfmGroup_keepAlive || pTmp->timeAlive > 0);
-        if (!isAlive) {
-            /* 'Kill' the node */
-            pTmp->timeAlive = gfmGroup_forceKill;
-            /* Remove the node */
-            if (pPrev) {
-                /* Simply bypass the 'dead' node */
-                pPrev->pNext = pTmp->pNext;
-            }
-            else {
-                /* It was the first node, modify the 'list root' */
-                pGroup->pActive = pGroup->pActive->pNext;
-            }
-            /* Prepend the 'dead' node to the inactive list */
-            pTmp->pNext = pGroup->pInactive;
-            pGroup->pInactive = pTmp;
-        }
-        else if (isInside) {
-            gfmGroupDrawNode *pNode;
-
-            /* Otherwise, add it to the visible list (on the same order) */
-            ASSERT(pDrawCtx->usedElements < pDrawCtx->totalElements,
-                    GFMRV_BUFFER_TOO_SMALL);
-
-            /* Retrieve the node's pointer */
-            pNode = &(pDrawCtx->pDrawArr[pDrawCtx->usedElements]);
-            pDrawCtx->usedElements++;
-
-            /* Initialize it */
-            pNode->pSelf = pTmp->pSelf;
-            pNode->pRight = 0;
-            pNode->pLeft = 0;
-            switch (pDrawCtx->drawOrder) {
-                /* Retrieve the vertical position for vertical sorting */
-                case gfmDrawOrder_topFirst:
-                case gfmDrawOrder_bottomFirst: {
-                    rv = gfmSprite_getVerticalPosition(&(pNode->data.y),
-                            pNode->pSelf);
-                    ASSERT(rv == GFMRV_OK, rv);
-                }; break;
-                /* Retrieve the time alive for 'age sorting' */
-                case gfmDrawOrder_newestFirst:
-                case gfmDrawOrder_oldestFirst: {
-                    pNode->data.timeAlive = pTmp->timeAlive;
-                } break;
-                default: { /* Otherwise, do nothing */ }
-            }
-        }
-
-        /* Add it to the collideable list */
-        switch (pGroup->collisionQuality) {
-            /*
-             * If you are reading this, I'm sorry... but I couldn't waste the
-             * chance to write this *-*
-             */
-            case gfmCollisionQuality_allEveryThird:
-            case gfmCollisionQuality_everyThird:
-                if (pGroup->skippedCollision < 2) {
-                    pGroup->skippedCollision++;
-                    break;
-                }
-            case gfmCollisionQuality_allEverySecond:
-            case gfmCollisionQuality_everySecond:
-                if (pGroup->skippedCollision < 1) {
-                    pGroup->skippedCollision++;
-                    break;
-                }
-            case gfmCollisionQuality_visibleOnly:
-                if (isInside == 0
-                        && pGroup->collisionQuality
-                            != gfmCollisionQuality_allEveryThird
-                        && pGroup->collisionQuality
-                            != gfmCollisionQuality_allEverySecond) {
-                    break;
-                }
-            case gfmCollisionQuality_collideEverything:
-                if (!isAlive) {
-                    break;
-                }
-                /* If we got here, it's something that is collideable */
-                pGroup->skippedCollision = 0;
-                /* So, update the list */
-                pTmp->pNextCollideable = pGroup->pCollideable;
-                pGroup->pCollideable = pTmp;
-            default: {}
+    /* Check if the sprite is inside the camera */
+    rv = gfmCamera_isSpriteInside(pCam, pNode->pSelf);
+    ASSERT_NR(rv == GFMRV_TRUE || rv == GFMRV_FALSE);
+    isInside = (rv == GFMRV_TRUE);
+
+    /* Check if the sprite should be "killed" */
+    isAlive = (!pGroup->dieOnLeave || isInside) &&
+            (pNode->timeAlive == gfmGroup_keepAlive || pNode->timeAlive > 0);
+    if (!isAlive) {
+        /* 'Kill' the node */
+        pNode->timeAlive = gfmGroup_forceKill;
+    }
+    else if (isInside) {
+        /* Otherwise, initialize its draw node */
+        pDraw->pSelf = pNode->pSelf;
+        switch (pGroup->pDrawCtx->drawOrder) {
+            /* Retrieve the vertical position for vertical sorting */
+            case gfmDrawOrder_topFirst:
+            case gfmDrawOrder_bottomFirst: {
+                rv = gfmSprite_getVerticalPosition(&(pDraw->key),
+                        pDraw->pSelf);
+                ASSERT(rv == GFMRV_OK, rv);
+            }; break;
+            /* Retrieve the time alive for 'age sorting' */
+            case gfmDrawOrder_newestFirst:
+            case gfmDrawOrder_oldestFirst: {
+                pDraw->key = pNode->timeAlive;
+            } break;
+            default: { /* Otherwise, do nothing */ }
         }
+    }
 
-        /* If the current node wasn't removed, make it the previous one */
-        if (pGroup->pInactive != pTmp)
-            pPrev = pTmp;
-        /* Go to the next node */
-        pTmp = pNext;
+    if (isAlive) {
+        *pState |= gfmGroup_nodeAlive;
+    }
+    if (isInside) {
+        *pState |= gfmGroup_nodeInside;
     }
 
     rv = GFMRV_OK;
@@ -1110,207 +1588,432 @@ __ret:
 }
 
 /**
- * Add nodes 'recursively' to a tree, placing the ones at a higher vertical
- * position (i.e., lower y value) earlier than the others
+ * Move a node (already updated by gfmGroup_updateNode) to the list where it
+ * belongs; Dead nodes are removed from the active list and the others may be
+ * added to the collideable list; This must be called on the same order as the
+ * nodes are on the active list
  *
- * @param  pRoot     Root node of a tree or sub-tree
- * @param  pTreeNode Node that will be added to the tree
- * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD, ...
+ * @param  [ in]pGroup The group
+ * @param  [ in]pNode  The node
+ * @param  [ in]pPrev  The node before it on the active list (if any)
+ * @param  [ in]state  Flags (see enGFMGroupNodeState) for the node
  */
-static gfmRV gfmGroup_addTopBottom(gfmGroupDrawNode *pRoot, gfmGroupDrawNode *pNode) {
-    gfmRV rv;
+static void gfmGroup_commitNode(gfmGroup *pGroup, gfmGroupNode *pNode,
+        gfmGroupNode *pPrev, int state) {
+    int isAlive, isInside;
+
+    isAlive = state & gfmGroup_nodeAlive;
+    isInside = state & gfmGroup_nodeInside;
+
+    if (!isAlive) {
+        /* Remove the node */
+        if (pPrev) {
+            /* Simply bypass the 'dead' node */
+            pPrev->pNext = pNode->pNext;
+        }
+        else {
+            /* It was the first node, modify the 'list root' */
+            pGroup->pActive = pGroup->pActive->pNext;
+        }
+        /* Prepend the 'dead' node to the inactive list */
+        pNode->pNext = pGroup->pInactive;
+        pGroup->pInactive = pNode;
+    }
+    else if (gfmSprite_isAsleep(pNode->pSelf) == GFMRV_TRUE) {
+        pGroup->sleepingSprites++;
+    }
 
-    while (1) {
-        /* Make the first visited node have the lowest position */
-        if (pNode->data.y <= pRoot->data.y) {
-            if (pRoot->pLeft) {
-                /* If not a leaf, move to the next node */
-                pRoot = pRoot->pLeft;
+    /* Add it to the collideable list */
+    switch (pGroup->collisionQuality) {
+        /*
+         * If you are reading this, I'm sorry... but I couldn't waste the
+         * chance to write this *-*
+         */
+        case gfmCollisionQuality_allEveryThird:
+        case gfmCollisionQuality_everyThird:
+            if (pGroup->skippedCollision < 2) {
+                pGroup->skippedCollision++;
+                break;
             }
-            else {
-                /* Otherwise, add a new node */
-                pRoot->pLeft = pNode;
+        case gfmCollisionQuality_allEverySecond:
+        case gfmCollisionQuality_everySecond:
+            if (pGroup->skippedCollision < 1) {
+                pGroup->skippedCollision++;
                 break;
             }
-        }
-        else {
-            if (pRoot->pRight) {
-                /* If not a leaf, move to the next node */
-                pRoot = pRoot->pRight;
+        case gfmCollisionQuality_visibleOnly:
+            if (isInside == 0
+                    && pGroup->collisionQuality
+                        != gfmCollisionQuality_allEveryThird
+                    && pGroup->collisionQuality
+                        != gfmCollisionQuality_allEverySecond) {
+                break;
             }
-            else {
-                /* Otherwise, add a new node */
-                pRoot->pRight = pNode;
+        case gfmCollisionQuality_collideEverything:
+            if (!isAlive) {
                 break;
             }
+            /* If we got here, it's something that is collideable */
+            pGroup->skippedCollision = 0;
+            /* So, update the list */
+            pNode->pNextCollideable = pGroup->pCollideable;
+            pGroup->pCollideable = pNode;
+        default: {}
+    }
+}
+
+/**
+ * Update a chunk of the active nodes; Visible nodes are appended to the
+ * chunk's own slice of pSortArr (i.e., its visible sublist), starting at the
+ * chunk's first index
+ *
+ * @param  [ in]pArg   The group
+ * @param  [ in]worker Index of the worker running the task
+ * @param  [ in]task   Index of the chunk
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, ...
+ */
+static gfmRV gfmGroup_updateTask(void *pArg, int worker, int task) {
+    gfmGroupDrawNode *pVisible;
+    gfmGroupUpdateCtx *pUpdCtx;
+    gfmGroup *pGroup;
+    gfmRV rv;
+    int i, last, visible;
+
+    pGroup = (gfmGroup*)pArg;
+    pUpdCtx = &(pGroup->updateCtx);
+
+    i = task * gfmGroup_updatePerTask;
+    last = i + gfmGroup_updatePerTask;
+    if (last > pUpdCtx->used) {
+        last = pUpdCtx->used;
+    }
+    pVisible = pGroup->pDrawCtx->pSortArr + i;
+
+    visible = 0;
+    while (i < last) {
+        rv = gfmGroup_updateNode(pUpdCtx->pStates + i, pVisible + visible,
+                pGroup, pUpdCtx->ppNodes[i], pUpdCtx->pCam,
+                pUpdCtx->elapsed, pUpdCtx->pCtx);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        if (pUpdCtx->pStates[i] ==
+                (gfmGroup_nodeAlive | gfmGroup_nodeInside)) {
+            visible++;
         }
+        i++;
     }
+    pUpdCtx->pVisible[task] = visible;
 
     rv = GFMRV_OK;
+__ret:
     return rv;
 }
 
 /**
- * Add nodes 'recursively' to a tree, placing the ones at a lower vertical
- * position (i.e., higher y value) earlier than the others
+ * Update every active node in chunks, split between the group's threads, and
+ * then merge the chunks' results in order
  *
- * @param  pRoot     Root node of a tree or sub-tree
- * @param  pTreeNode Node that will be added to the tree
- * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD, ...
+ * @param  [ in]pGroup  The group
+ * @param  [ in]pCam    The current camera
+ * @param  [ in]elapsed Time elapsed from the previous frame
+ * @param  [ in]pCtx    The game's context
+ * @return              GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED, ...
  */
-static gfmRV gfmGroup_addBottomTop(gfmGroupDrawNode *pRoot, gfmGroupDrawNode *pNode) {
+static gfmRV gfmGroup_updateParallel(gfmGroup *pGroup, gfmCamera *pCam,
+        int elapsed, gfmCtx *pCtx) {
+    gfmGroupDrawCtx *pDrawCtx;
+    gfmGroupUpdateCtx *pUpdCtx;
+    gfmGroupNode *pTmp;
+    gfmGroupNode *pPrev;
     gfmRV rv;
+    int i, len, numTasks, task;
 
-    while (1) {
-        /* Make the first visited node have the highest position */
-        if (pNode->data.y > pRoot->data.y) {
-            if (pRoot->pLeft) {
-                /* If not a leaf, move to the next node */
-                pRoot = pRoot->pLeft;
-            }
-            else {
-                /* Otherwise, add a new node */
-                pRoot->pLeft = pNode;
-                break;
-            }
+    pDrawCtx = pGroup->pDrawCtx;
+    pUpdCtx = &(pGroup->updateCtx);
+
+    /* Make sure the buffers are big enough */
+    len = gfmGenArr_getUsed(pGroup->pNodes);
+    if (pUpdCtx->len < len) {
+        gfmGroupNode **ppNodes;
+        int *pStates, *pVisible;
+
+        ppNodes = (gfmGroupNode**)realloc(pUpdCtx->ppNodes,
+                sizeof(gfmGroupNode*) * len);
+        ASSERT(ppNodes, GFMRV_ALLOC_FAILED);
+        pUpdCtx->ppNodes = ppNodes;
+        pStates = (int*)realloc(pUpdCtx->pStates, sizeof(int) * len);
+        ASSERT(pStates, GFMRV_ALLOC_FAILED);
+        pUpdCtx->pStates = pStates;
+        pVisible = (int*)realloc(pUpdCtx->pVisible, sizeof(int) *
+                ((len + gfmGroup_updatePerTask - 1) / gfmGroup_updatePerTask));
+        ASSERT(pVisible, GFMRV_ALLOC_FAILED);
+        pUpdCtx->pVisible = pVisible;
+        pUpdCtx->len = len;
+    }
+
+    /* Flatten the active list, so it may be split into chunks */
+    pUpdCtx->used = 0;
+    pTmp = pGroup->pActive;
+    while (pTmp) {
+        ASSERT(pUpdCtx->used < pUpdCtx->len, GFMRV_BUFFER_TOO_SMALL);
+        pUpdCtx->ppNodes[pUpdCtx->used] = pTmp;
+        pUpdCtx->used++;
+        pTmp = pTmp->pNext;
+    }
+    if (pUpdCtx->used == 0) {
+        rv = GFMRV_OK;
+        goto __ret;
+    }
+
+    /* Update every chunk */
+    pUpdCtx->pCam = pCam;
+    pUpdCtx->pCtx = pCtx;
+    pUpdCtx->elapsed = elapsed;
+    numTasks = (pUpdCtx->used + gfmGroup_updatePerTask - 1) /
+            gfmGroup_updatePerTask;
+    rv = gfmThreadPool_run(pUpdCtx->pPool, gfmGroup_updateTask,
+            (void*)pGroup, numTasks);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    /* Merge every chunk, in order */
+    pPrev = 0;
+    task = 0;
+    while (task < numTasks) {
+        int last;
+
+        /* Append the chunk's visible sublist */
+        memcpy(pDrawCtx->pDrawArr + pDrawCtx->usedElements,
+                pDrawCtx->pSortArr + task * gfmGroup_updatePerTask,
+                sizeof(gfmGroupDrawNode) * pUpdCtx->pVisible[task]);
+        pDrawCtx->usedElements += pUpdCtx->pVisible[task];
+
+        /* Splice its nodes into the active/inactive and collideable lists */
+        i = task * gfmGroup_updatePerTask;
+        last = i + gfmGroup_updatePerTask;
+        if (last > pUpdCtx->used) {
+            last = pUpdCtx->used;
         }
-        else {
-            if (pRoot->pRight) {
-                /* If not a leaf, move to the next node */
-                pRoot = pRoot->pRight;
-            }
-            else {
-                /* Otherwise, add a new node */
-                pRoot->pRight = pNode;
-                break;
+        while (i < last) {
+            pTmp = pUpdCtx->ppNodes[i];
+            gfmGroup_commitNode(pGroup, pTmp, pPrev, pUpdCtx->pStates[i]);
+            /* If the current node wasn't removed, make it the previous one */
+            if (pGroup->pInactive != pTmp) {
+                pPrev = pTmp;
             }
+            i++;
         }
+        task++;
     }
 
     rv = GFMRV_OK;
+__ret:
     return rv;
 }
 
 /**
- * Add nodes 'recursively' to a tree, placing the latest recycled ones first
+ * Trim the collideable list so it doesn't go over the collideable cap; The
+ * nodes that were deferred for the most frames are kept (ties are kept in the
+ * list's order), so a node is never deferred while another that was collided
+ * more recently is kept
  *
- * @param  pRoot     Root node of a tree or sub-tree
- * @param  pTreeNode Node that will be added to the tree
- * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD, ...
+ * @param  pGroup The group
  */
-static gfmRV gfmGroup_addNewest(gfmGroupDrawNode *pRoot, gfmGroupDrawNode *pNode) {
-    gfmRV rv;
+static void gfmGroup_capCollideable(gfmGroup *pGroup) {
+    gfmGroupNode *pNode, *pPrev;
+    int pCount[gfmGroup_maxDeferredFrames + 1];
+    int atThreshold, num, sum, threshold;
+
+    /* Count how many nodes were deferred for each number of frames */
+    memset(pCount, 0x0, sizeof(pCount));
+    num = 0;
+    pNode = pGroup->pCollideable;
+    while (pNode) {
+        pCount[pNode->deferredFrames]++;
+        num++;
+        pNode = pNode->pNextCollideable;
+    }
 
-    while (1) {
-        /* Make the first visited node have the lowest timeAlive */
-        if (pNode->data.timeAlive > pRoot->data.timeAlive) {
-            if (pRoot->pLeft) {
-                /* If not a leaf, move to the next node */
-                pRoot = pRoot->pLeft;
-            }
-            else {
-                /* Otherwise, add a new node */
-                pRoot->pLeft = pNode;
-                break;
+    if (num <= pGroup->maxCollideable) {
+        /* Everything fits, so simply reset the counters */
+        pNode = pGroup->pCollideable;
+        while (pNode) {
+            pNode->deferredFrames = 0;
+            pNode = pNode->pNextCollideable;
+        }
+        return;
+    }
+
+    /* Find the least number of deferred frames that still fits the cap,
+     * and how many of the nodes with that many frames may be kept */
+    threshold = gfmGroup_maxDeferredFrames;
+    sum = 0;
+    while (sum + pCount[threshold] < pGroup->maxCollideable) {
+        sum += pCount[threshold];
+        threshold--;
+    }
+    atThreshold = pGroup->maxCollideable - sum;
+
+    /* Remove every other node from the list */
+    pPrev = 0;
+    pNode = pGroup->pCollideable;
+    while (pNode) {
+        gfmGroupNode *pNext;
+
+        pNext = pNode->pNextCollideable;
+        if (pNode->deferredFrames > threshold ||
+                (pNode->deferredFrames == threshold && atThreshold > 0)) {
+            if (pNode->deferredFrames == threshold) {
+                atThreshold--;
             }
+            pNode->deferredFrames = 0;
+            pPrev = pNode;
         }
         else {
-            if (pRoot->pRight) {
-                /* If not a leaf, move to the next node */
-                pRoot = pRoot->pRight;
+            if (pPrev) {
+                pPrev->pNextCollideable = pNext;
             }
             else {
-                /* Otherwise, add a new node */
-                pRoot->pRight = pNode;
-                break;
+                pGroup->pCollideable = pNext;
             }
+            if (pNode->deferredFrames < gfmGroup_maxDeferredFrames) {
+                pNode->deferredFrames++;
+            }
+            pGroup->deferredSprites++;
         }
+        pNode = pNext;
     }
-
-    rv = GFMRV_OK;
-    return rv;
 }
 
 /**
- * Add nodes 'recursively' to a tree, placing the first recycled ones first
+ * Iterate through every sprite and update'em
  *
- * @param  pRoot     Root node of a tree or sub-tree
- * @param  pTreeNode Node that will be added to the tree
- * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD, ...
+ * @param  pGrp The group
+ * @param  pCtx The game's context
+ * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
  */
-static gfmRV gfmGroup_addOldest(gfmGroupDrawNode *pRoot, gfmGroupDrawNode *pNode) {
+gfmRV gfmGroup_update(gfmGroup *pGroup, gfmCtx *pCtx) {
+    gfmCamera *pCam;
+    gfmGroupDrawCtx *pDrawCtx;
+    gfmGroupNode *pTmp;
+    gfmGroupNode *pPrev;
     gfmRV rv;
+    int elapsed;
 
-    while (1) {
-        /* Make the first visited node have the highest timeAlive */
-        if (pNode->data.timeAlive <= pRoot->data.timeAlive) {
-            if (pRoot->pLeft) {
-                /* If not a leaf, move to the next node */
-                pRoot = pRoot->pLeft;
-            }
-            else {
-                /* Otherwise, add a new node */
-                pRoot->pLeft = pNode;
-                break;
-            }
-        }
-        else {
-            if (pRoot->pRight) {
-                /* If not a leaf, move to the next node */
-                pRoot = pRoot->pRight;
-            }
-            else {
-                /* Otherwise, add a new node */
-                pRoot->pRight = pNode;
-                break;
+    /* Sanitize arguments */
+    ASSERT(pGroup, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    pDrawCtx = pGroup->pDrawCtx;
+
+    /* Remove the reference to the last recycled/added sprite */
+    pGroup->pLast = 0;
+    /* Reset the list of visible sprites */
+    pDrawCtx->usedElements = 0;
+    /* Reset the list of collideable sprites */
+    pGroup->pCollideable = 0;
+    pGroup->sleepingSprites = 0;
+    /* Don't reset pGroup->skippedCollision so it cycles the starting node
+     * every few frames */
+    /* Retrieve the current camera */
+    rv = gfm_getCamera(&pCam, pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    /* Make sure the draw context is big enough */
+    if (pDrawCtx->totalElements < gfmGenArr_getUsed(pGroup->pNodes)) {
+        pDrawCtx->totalElements = gfmGenArr_getUsed(pGroup->pNodes);
+        pDrawCtx->pDrawArr = (gfmGroupDrawNode*)realloc(pDrawCtx->pDrawArr,
+                sizeof(gfmGroupDrawNode) * pDrawCtx->totalElements);
+        ASSERT(pDrawCtx->pDrawArr, GFMRV_ALLOC_FAILED);
+        pDrawCtx->pSortArr = (gfmGroupDrawNode*)realloc(pDrawCtx->pSortArr,
+                sizeof(gfmGroupDrawNode) * pDrawCtx->totalElements);
+        ASSERT(pDrawCtx->pSortArr, GFMRV_ALLOC_FAILED);
+    }
+
+    /* Get the time elapsed from the previous frame */
+    rv = gfm_getElapsedTime(&elapsed, pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    /* Split the update between the threads, if there are any */
+    if (pGroup->updateCtx.pPool) {
+        rv = gfmGroup_updateParallel(pGroup, pCam, elapsed, pCtx);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+    else {
+        /* Loop through every node */
+        pPrev = 0;
+        pTmp = pGroup->pActive;
+        while (pTmp) {
+            gfmGroupNode *pNext;
+            int state;
+
+            state = 0;
+            /* Make sure there's room for another visible node */
+            ASSERT(pDrawCtx->usedElements < pDrawCtx->totalElements,
+                    GFMRV_BUFFER_TOO_SMALL);
+
+            /* Update the node (initializing the next draw node, if visible) */
+            rv = gfmGroup_updateNode(&state,
+                    &(pDrawCtx->pDrawArr[pDrawCtx->usedElements]), pGroup, pTmp,
+                    pCam, elapsed, pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+            if (state == (gfmGroup_nodeAlive | gfmGroup_nodeInside)) {
+                pDrawCtx->usedElements++;
             }
+
+            /* Get the next node */
+            pNext = pTmp->pNext;
+
+            /* Remove it (if dead) and add it to the collideable list */
+            gfmGroup_commitNode(pGroup, pTmp, pPrev, state);
+
+            /* If the current node wasn't removed, make it the previous one */
+            if (pGroup->pInactive != pTmp)
+                pPrev = pTmp;
+            /* Go to the next node */
+            pTmp = pNext;
         }
     }
 
+    /* Stay within the collideable cap, if any */
+    pGroup->deferredSprites = 0;
+    if (pGroup->maxCollideable > 0) {
+        gfmGroup_capCollideable(pGroup);
+    }
+
     rv = GFMRV_OK;
+__ret:
     return rv;
 }
 
 /**
- * Draw a (sub-)tree traversing it in pre-order
+ * Draw every visible node, either on the order they are on the draw array or
+ * on the reverse order
  *
- * @param  [ in]pRoot  The (sub-)tree root
- * @param  [ in]pCtx   The game's context
- * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ * @param  [ in]pDrawCtx  The group's draw context
+ * @param  [ in]pCtx      The game's context
+ * @param  [ in]isReverse Whether the last node should be drawn first
+ * @return                GFMRV_OK, GFMRV_ARGUMENTS_BAD, ...
  */
-static gfmRV gfmGroup_drawTree(gfmGroupDrawNode *pRoot, gfmCtx *pCtx) {
-    gfmGroupDrawNode *pTop;
+static gfmRV gfmGroup_drawNodes(gfmGroupDrawCtx *pDrawCtx, gfmCtx *pCtx,
+        int isReverse) {
     gfmRV rv;
+    int i;
+
+    i = 0;
+    while (i < pDrawCtx->usedElements) {
+        gfmGroupDrawNode *pNode;
 
-    /* Initialize the tree's stack */
-    pTop = pRoot;
-    pTop->data.pStackNext = 0;
-
-    /* Traverse the tree in pre-order */
-    while (pTop) {
-        if (pTop->pLeft) {
-            /* Push the current node to be rendered after the current one */
-            pTop->pLeft->data.pStackNext = pTop;
-            pTop = pTop->pLeft;
-            /* Remove the sub-tree to the left from the previous node */
-            pTop->data.pStackNext->pLeft = 0;
+        if (isReverse) {
+            pNode = &(pDrawCtx->pDrawArr[pDrawCtx->usedElements - i - 1]);
         }
         else {
-            /* Render the current node */
-            rv = gfmSprite_draw(pTop->pSelf, pCtx);
-            ASSERT_NR(rv == GFMRV_OK);
-
-            if (pTop->pRight) {
-                /* Render the sub-tree to the right before anything else on the
-                 * stack (and remove the current node) */
-                pTop->pRight->data.pStackNext = pTop->data.pStackNext;
-                pTop = pTop->pRight;
-            }
-            else {
-                /* Pop the next object to be renderd */
-                pTop = pTop->data.pStackNext;
-            }
+            pNode = &(pDrawCtx->pDrawArr[i]);
         }
+
+        rv = gfmSprite_draw(pNode->pSelf, pCtx);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        i++;
     }
 
     rv = GFMRV_OK;
@@ -1321,6 +2024,11 @@ __ret:
 /**
  * Draw every sprite, following the desired mode
  *
+ * Sorted modes are all drawn from a single (stable) sort, from the highest key
+ * to the lowest one; Modes that start from the lowest key (i.e., topFirst and
+ * oldestFirst) simply traverse it backward, which also draws sprites with
+ * equal keys from the last added to the first (as the previous tree did)
+ *
  * @param  pGrp The group
  * @param  pCtx The game's context
  * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
@@ -1328,34 +2036,6 @@ __ret:
 gfmRV gfmGroup_draw(gfmGroup *pGroup,  gfmCtx *pCtx) {
     gfmGroupDrawCtx *pDrawCtx;
     gfmRV rv;
-    int i;
-
-    /**
-     * Macro to insert all visible nodes into a tree and draw it; It expects the
-     * first visible node to be at pNode;
-     * This macro already ASSERT errors
-     *
-     * @param insertFunction The function to insert a node into the tree (must
-     *                       receive two gfmDrawTree*, the first being the
-     *                       tree's root and the second the current node)
-     */
-#define insertAndDrawTree(insertFunction) \
-    do { \
-        gfmGroupDrawNode *pRoot; \
-        /* Since index 0 is the tree's root, start at the next one */ \
-        i++; \
-        pRoot = &(pDrawCtx->pDrawArr[0]); \
-        /* Add all nodes iteratively */ \
-        while (i < pDrawCtx->usedElements) { \
-            /* Insert it into the tree */ \
-            rv = insertFunction(pRoot, &(pDrawCtx->pDrawArr[i])); \
-            ASSERT(rv == GFMRV_OK, rv); \
-            i++; \
-        } \
-        /* Draw the tree */ \
-        rv = gfmGroup_drawTree(pRoot, pCtx); \
-        ASSERT(rv == GFMRV_OK, rv); \
-    } while (0);
 
     /* Sanitize arguments */
     ASSERT(pGroup, GFMRV_ARGUMENTS_BAD);
@@ -1368,28 +2048,27 @@ gfmRV gfmGroup_draw(gfmGroup *pGroup,  gfmCtx *pCtx) {
         goto __ret;
     }
 
-    i = 0;
     switch (pDrawCtx->drawOrder) {
         case gfmDrawOrder_linear: {
             /* Simply draw in the order they appear */
-            while (i < pDrawCtx->usedElements) {
-                rv = gfmSprite_draw(pDrawCtx->pDrawArr[i].pSelf, pCtx);
-                ASSERT_NR(rv == GFMRV_OK);
-
-                i++;
-            }
-        } break;
-        case gfmDrawOrder_topFirst: {
-            insertAndDrawTree(gfmGroup_addTopBottom);
+            rv = gfmGroup_drawNodes(pDrawCtx, pCtx, 0/*isReverse*/);
+            ASSERT(rv == GFMRV_OK, rv);
         } break;
-        case gfmDrawOrder_bottomFirst: {
-            insertAndDrawTree(gfmGroup_addBottomTop);
+        case gfmDrawOrder_topFirst:
+        case gfmDrawOrder_oldestFirst: {
+            /* Draw from the lowest key to the highest */
+            gfmGroupDrawNode_sort(&(pDrawCtx->pDrawArr), &(pDrawCtx->pSortArr),
+                    pDrawCtx->usedElements);
+            rv = gfmGroup_drawNodes(pDrawCtx, pCtx, 1/*isReverse*/);
+            ASSERT(rv == GFMRV_OK, rv);
         } break;
+        case gfmDrawOrder_bottomFirst:
         case gfmDrawOrder_newestFirst: {
-            insertAndDrawTree(gfmGroup_addNewest);
-        } break;
-        case gfmDrawOrder_oldestFirst: {
-            insertAndDrawTree(gfmGroup_addOldest);
+            /* Draw from the highest key to the lowest */
+            gfmGroupDrawNode_sort(&(pDrawCtx->pDrawArr), &(pDrawCtx->pSortArr),
+                    pDrawCtx->usedElements);
+            rv = gfmGroup_drawNodes(pDrawCtx, pCtx, 0/*isReverse*/);
+            ASSERT(rv == GFMRV_OK, rv);
         } break;
         case gfmDrawOrder_max: {
             /* Shouldn't happen! */
@@ -6,6 +6,10 @@
  * Since this is the base type to be passed to the quadtree for
  * overlaping/collision, it also has info about it's "child type" (e.g., a
  * gfmSprite pointer and the type T_GFMSPRITE)
+ * When compiled with FIXED_POINT_PHYSICS, every physical attribute is kept
+ * (and integrated) in 16.16 fixed point, so the simulation is deterministic;
+ * The functions still take and return doubles, which are converted on the
+ * way in/out
  */
 #include <GFraMe/gframe.h>
 #include <GFraMe/gfmAssert.h>
@@ -17,50 +21,27 @@
 #include <GFraMe_int/gfmFixedPoint.h>
 #include <GFraMe_int/gfmGeometry.h>
 #include <GFraMe_int/gfmHitbox.h>
+#include <GFraMe_int/gfmObject.h>
 
 #include <stdlib.h>
 #include <string.h>
 
-enum {
-    gfmFlags_isFixed    = 0x10000
-  , gfmFlags_currentBit = 0
-  , gfmFlags_lastBit    = 4
-  , gfmFlags_instBit    = 8
-};
-
-/** The gfmObject structure */
-struct stGFMObject {
-    /** The object's hitbox (i.e., its transform) */
-    gfmHitbox t;
-    /** Collision and fixed flags */
-    uint32_t flags;
-    /** Current accumulated (i.e., double) horizontal position */
-    double dx;
-    /** Current accumulated (i.e., double) vertical position */
-    double dy;
-    /** Previous accumulated (i.e., double) horizontal position */
-    double ldx;
-    /** Previous accumulated (i.e., double) vertical position */
-    double ldy;
-    /** Horizontal velocity */
-    double vx;
-    /** Vertical velocity */
-    double vy;
-    /** Horizontal acceleration */
-    double ax;
-    /** Vertical acceleration */
-    double ay;
-    /** Rate at which speed goed back to 0, if there's no horizontal acc */
-    double dragX;
-    /** Rate at which speed goed back to 0, if there's no vertical acc */
-    double dragY;
-};
-
 /** Size of gfmObject */
 const int sizeofGFMObject = (int)sizeof(gfmObject);
 
 /**
- * Set a object's horizontal position (as double)
+ * Wake an object, so it's integrated again and restart counting for how long
+ * it has been standing still
+ *
+ * @param  pCtx The object
+ */
+static inline void _gfmObject_wake(gfmObject *pCtx) {
+    pCtx->flags &= ~gfmFlags_isAsleep;
+    pCtx->stillFrames = 0;
+}
+
+/**
+ * Set a object's horizontal position (with sub-pixel precision)
  * 
  * NOTE: The anchor is the upper-left corner!
  * 
@@ -68,15 +49,19 @@ const int sizeofGFMObject = (int)sizeof(gfmObject);
  * @param  x    The horizontal position
  * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
  */
-static gfmRV _int_gfmObject_setHorizontalPosition(gfmObject *pCtx, double x) {
+static gfmRV _int_gfmObject_setHorizontalPosition(gfmObject *pCtx,
+        gfmObjReal x) {
     gfmRV rv;
     
     // Sanitize arguments
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
     
     // Set both the position and the previous position
-    pCtx->t.x = (int)x;
+    pCtx->t.x = gfmObjReal_toInt(x);
     if (pCtx->t.innerType == gfmType_object) {
+        if (pCtx->dx != x) {
+            _gfmObject_wake(pCtx);
+        }
         pCtx->dx = x;
     }
     
@@ -86,7 +71,7 @@ __ret:
 }
 
 /**
- * Set a object's vertical position (as double)
+ * Set a object's vertical position (with sub-pixel precision)
  * 
  * NOTE: The anchor is the upper-left corner!
  * 
@@ -94,15 +79,19 @@ __ret:
  * @param  y    The vertical position
  * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
  */
-static gfmRV _int_gfmObject_setVerticalPosition(gfmObject *pCtx, double y) {
+static gfmRV _int_gfmObject_setVerticalPosition(gfmObject *pCtx,
+        gfmObjReal y) {
     gfmRV rv;
     
     // Sanitize arguments
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
     
     // Set both the position and the previous position
-    pCtx->t.y = (int)y;
+    pCtx->t.y = gfmObjReal_toInt(y);
     if (pCtx->t.innerType == gfmType_object) {
+        if (pCtx->dy != y) {
+            _gfmObject_wake(pCtx);
+        }
         pCtx->dy = y;
     }
     
@@ -113,7 +102,7 @@ __ret:
 
 #if 0
 /**
- * Set a object's position (as doubles)
+ * Set a object's position (with sub-pixel precision)
  * 
  * NOTE: The anchor is the upper-left corner!
  * 
@@ -122,7 +111,8 @@ __ret:
  * @param  y    The vertical position
  * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
  */
-static gfmRV _int_gfmObject_setPosition(gfmObject *pCtx, double x, double y) {
+static gfmRV _int_gfmObject_setPosition(gfmObject *pCtx, gfmObjReal x,
+        gfmObjReal y) {
     gfmRV rv;
     
     // Sanitize arguments
@@ -213,6 +203,8 @@ gfmRV gfmObject_init(gfmObject *pCtx, int x, int y, int width, int height,
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
     ASSERT(width > 0, GFMRV_ARGUMENTS_BAD);
     ASSERT(height > 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(gfmObjReal_isInRange(x), GFMRV_ARGUMENTS_BAD);
+    ASSERT(gfmObjReal_isInRange(y), GFMRV_ARGUMENTS_BAD);
     
     // Clear it up
     rv = gfmObject_clean(pCtx);
@@ -222,10 +214,10 @@ gfmRV gfmObject_init(gfmObject *pCtx, int x, int y, int width, int height,
     pCtx->t.x = x;
     pCtx->t.y = y;
     // Must also set the previous position, to avoid collision errors
-    pCtx->dx = x;
-    pCtx->dy = y;
-    pCtx->ldx = x;
-    pCtx->ldy = y;
+    pCtx->dx = gfmObjReal_fromInt(x);
+    pCtx->dy = gfmObjReal_fromInt(y);
+    pCtx->ldx = pCtx->dx;
+    pCtx->ldy = pCtx->dy;
     
     // Set the object's dimensions
     pCtx->t.hw = width / 2;
@@ -441,11 +433,16 @@ gfmRV gfmObject_setHorizontalPosition(gfmObject *pCtx, int x) {
     
     // Sanitize arguments
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx->t.innerType != gfmType_object || gfmObjReal_isInRange(x),
+            GFMRV_ARGUMENTS_BAD);
     
     // Set both the position and the previous position
     pCtx->t.x = x;
     if (pCtx->t.innerType == gfmType_object) {
-        pCtx->dx = (double)x;
+        if (pCtx->dx != gfmObjReal_fromInt(x)) {
+            _gfmObject_wake(pCtx);
+        }
+        pCtx->dx = gfmObjReal_fromInt(x);
     }
     
     rv = GFMRV_OK;
@@ -467,11 +464,16 @@ gfmRV gfmObject_setVerticalPosition(gfmObject *pCtx, int y) {
     
     // Sanitize arguments
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx->t.innerType != gfmType_object || gfmObjReal_isInRange(y),
+            GFMRV_ARGUMENTS_BAD);
     
     // Set both the position and the previous position
     pCtx->t.y = y;
     if (pCtx->t.innerType == gfmType_object) {
-        pCtx->dy = (double)y;
+        if (pCtx->dy != gfmObjReal_fromInt(y)) {
+            _gfmObject_wake(pCtx);
+        }
+        pCtx->dy = gfmObjReal_fromInt(y);
     }
     
     rv = GFMRV_OK;
@@ -636,8 +638,8 @@ gfmRV gfmObject_getLastCenter(int *pX, int *pY, gfmObject *pCtx) {
     ASSERT(pCtx->t.hh > 0, GFMRV_OBJECT_NOT_INITIALIZED);
     
     // Get the position
-    *pX = (int)pCtx->ldx;
-    *pY = (int)pCtx->ldy;
+    *pX = gfmObjReal_toInt(pCtx->ldx);
+    *pY = gfmObjReal_toInt(pCtx->ldy);
     // Offset it to the center
     *pX += pCtx->t.hw;
     *pY += pCtx->t.hh;
@@ -686,9 +688,13 @@ gfmRV gfmObject_setHorizontalVelocity(gfmObject *pCtx, double vx) {
     // Sanitize arguments
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
     ASSERT(pCtx->t.innerType == gfmType_object, GFMRV_INVALID_TYPE);
+    ASSERT(gfmObjReal_isInRange(vx), GFMRV_ARGUMENTS_BAD);
     
     // Set the velocity
-    pCtx->vx = vx;
+    if (pCtx->vx != gfmObjReal_fromDouble(vx)) {
+        _gfmObject_wake(pCtx);
+    }
+    pCtx->vx = gfmObjReal_fromDouble(vx);
     
     rv = GFMRV_OK;
 __ret:
@@ -708,9 +714,13 @@ gfmRV gfmObject_setVerticalVelocity(gfmObject *pCtx, double vy) {
     // Sanitize arguments
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
     ASSERT(pCtx->t.innerType == gfmType_object, GFMRV_INVALID_TYPE);
+    ASSERT(gfmObjReal_isInRange(vy), GFMRV_ARGUMENTS_BAD);
     
     // Set the velocity
-    pCtx->vy = vy;
+    if (pCtx->vy != gfmObjReal_fromDouble(vy)) {
+        _gfmObject_wake(pCtx);
+    }
+    pCtx->vy = gfmObjReal_fromDouble(vy);
     
     rv = GFMRV_OK;
 __ret:
@@ -761,7 +771,7 @@ gfmRV gfmObject_getHorizontalVelocity(double *pVx, gfmObject *pCtx) {
     ASSERT(pCtx->t.innerType == gfmType_object, GFMRV_INVALID_TYPE);
     
     // Get the velocity
-    *pVx = pCtx->vx;
+    *pVx = gfmObjReal_toDouble(pCtx->vx);
     
     rv = GFMRV_OK;
 __ret:
@@ -784,7 +794,7 @@ gfmRV gfmObject_getVerticalVelocity(double *pVy, gfmObject *pCtx) {
     ASSERT(pCtx->t.innerType == gfmType_object, GFMRV_INVALID_TYPE);
     
     // Get the velocity
-    *pVy = pCtx->vy;
+    *pVy = gfmObjReal_toDouble(pCtx->vy);
     
     rv = GFMRV_OK;
 __ret:
@@ -830,9 +840,13 @@ gfmRV gfmObject_setHorizontalAcceleration(gfmObject *pCtx, double ax) {
     // Sanitize arguments
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
     ASSERT(pCtx->t.innerType == gfmType_object, GFMRV_INVALID_TYPE);
+    ASSERT(gfmObjReal_isInRange(ax), GFMRV_ARGUMENTS_BAD);
     
     // Set the object's acceleration
-    pCtx->ax = ax;
+    if (pCtx->ax != gfmObjReal_fromDouble(ax)) {
+        _gfmObject_wake(pCtx);
+    }
+    pCtx->ax = gfmObjReal_fromDouble(ax);
     
     rv = GFMRV_OK;
 __ret:
@@ -852,9 +866,13 @@ gfmRV gfmObject_setVerticalAcceleration(gfmObject *pCtx, double ay) {
     // Sanitize arguments
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
     ASSERT(pCtx->t.innerType == gfmType_object, GFMRV_INVALID_TYPE);
+    ASSERT(gfmObjReal_isInRange(ay), GFMRV_ARGUMENTS_BAD);
     
     // Set the object's acceleration
-    pCtx->ay = ay;
+    if (pCtx->ay != gfmObjReal_fromDouble(ay)) {
+        _gfmObject_wake(pCtx);
+    }
+    pCtx->ay = gfmObjReal_fromDouble(ay);
     
     rv = GFMRV_OK;
 __ret:
@@ -905,7 +923,7 @@ gfmRV gfmObject_getHorizontalAcceleration(double *pAx, gfmObject *pCtx) {
     ASSERT(pCtx->t.innerType == gfmType_object, GFMRV_INVALID_TYPE);
     
     // Get the object's acceleration
-    *pAx = pCtx->ax;
+    *pAx = gfmObjReal_toDouble(pCtx->ax);
     
     rv = GFMRV_OK;
 __ret:
@@ -928,7 +946,7 @@ gfmRV gfmObject_getVerticalAcceleration(double *pAy, gfmObject *pCtx) {
     ASSERT(pCtx->t.innerType == gfmType_object, GFMRV_INVALID_TYPE);
     
     // Get the object's acceleration
-    *pAy = pCtx->ay;
+    *pAy = gfmObjReal_toDouble(pCtx->ay);
     
     rv = GFMRV_OK;
 __ret:
@@ -974,9 +992,10 @@ gfmRV gfmObject_setHorizontalDrag(gfmObject *pCtx, double dx) {
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
     // Check that the drag is positive
     ASSERT(dx >= 0, GFMRV_NEGATIVE_DRAG);
+    ASSERT(gfmObjReal_isInRange(dx), GFMRV_ARGUMENTS_BAD);
     
     // Set the object's drag
-    pCtx->dragX = dx;
+    pCtx->dragX = gfmObjReal_fromDouble(dx);
     
     rv = GFMRV_OK;
 __ret:
@@ -997,9 +1016,10 @@ gfmRV gfmObject_setVerticalDrag(gfmObject *pCtx, double dy) {
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
     // Check that the drag is positive
     ASSERT(dy >= 0, GFMRV_NEGATIVE_DRAG);
+    ASSERT(gfmObjReal_isInRange(dy), GFMRV_ARGUMENTS_BAD);
     
     // Set the object's drag
-    pCtx->dragY = dy;
+    pCtx->dragY = gfmObjReal_fromDouble(dy);
     
     rv = GFMRV_OK;
 __ret:
@@ -1048,7 +1068,7 @@ gfmRV gfmObject_getHorizontalDrag(double *pDx, gfmObject *pCtx) {
     ASSERT(pDx, GFMRV_ARGUMENTS_BAD);
     
     // Get the object's drag
-    *pDx = pCtx->dragX;
+    *pDx = gfmObjReal_toDouble(pCtx->dragX);
     
     rv = GFMRV_OK;
 __ret:
@@ -1070,7 +1090,7 @@ gfmRV gfmObject_getVerticalDrag(double *pDy, gfmObject *pCtx) {
     ASSERT(pDy, GFMRV_ARGUMENTS_BAD);
     
     // Get the object's drag
-    *pDy = pCtx->dragY;
+    *pDy = gfmObjReal_toDouble(pCtx->dragY);
     
     rv = GFMRV_OK;
 __ret:
@@ -1145,6 +1165,78 @@ __ret:
     return rv;
 }
 
+/**
+ * Set for how many frames the object must stand still (i.e., without velocity,
+ * acceleration nor any change to its position) before falling asleep; A
+ * sleeping object isn't integrated (nor are its collision flags cleared) and
+ * isn't collided against other sleeping objects nor the quadtree's static
+ * layer; It's woken as soon as it's moved (e.g., by a collision or a call to
+ * gfmObject_setPosition) or its velocity or acceleration is modified
+ *
+ * @param  [ in]pCtx   The object
+ * @param  [ in]frames Number of frames; 0 (the default) makes the object never
+ *                     sleep
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_INVALID_TYPE
+ */
+gfmRV gfmObject_setSleepDelay(gfmObject *pCtx, int frames) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx->t.innerType == gfmType_object, GFMRV_INVALID_TYPE);
+    ASSERT(frames >= 0, GFMRV_ARGUMENTS_BAD);
+
+    pCtx->sleepDelay = frames;
+    _gfmObject_wake(pCtx);
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Check whether the object is asleep
+ *
+ * @param  [ in]pCtx The object (or a hitbox, which never sleeps)
+ * @return           GFMRV_TRUE, GFMRV_FALSE, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmObject_isAsleep(gfmObject *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    if (pCtx->t.innerType == gfmType_object
+            && (pCtx->flags & gfmFlags_isAsleep)) {
+        rv = GFMRV_TRUE;
+    }
+    else {
+        rv = GFMRV_FALSE;
+    }
+__ret:
+    return rv;
+}
+
+/**
+ * Wake the object, so it's integrated (and collided) again
+ *
+ * @param  [ in]pCtx The object
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_INVALID_TYPE
+ */
+gfmRV gfmObject_wake(gfmObject *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx->t.innerType == gfmType_object, GFMRV_INVALID_TYPE);
+
+    _gfmObject_wake(pCtx);
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
 /**
  * Integrate an object's components.
  * 
@@ -1157,6 +1249,38 @@ __ret:
  * @param  [in ]dx      The object's drag
  * @param  [in ]elapsed Time elapsed from the previous frame
  */
+#if defined(FIXED_POINT_PHYSICS)
+static inline void _gfmObject_integrate(gfmObjReal *x, gfmObjReal *vx,
+        gfmObjReal ax, gfmObjReal dx, gfmObjReal elapsed) {
+    *x += gfmFixedPoint32_mul(*vx, elapsed);
+    if (ax != 0) {
+        gfmObjReal dv;
+
+        /* Multiply by elapsed last, so the product doesn't lose precision */
+        dv = gfmFixedPoint32_mul(ax, elapsed);
+        *x += gfmFixedPoint32_mul(dv, elapsed) / 2;
+
+        *vx += dv;
+    }
+    else if (dx != 0) {
+        gfmObjReal dv;
+
+        dv = gfmFixedPoint32_mul(dx, elapsed);
+        *x -= gfmFixedPoint32_mul(dv, elapsed) / 2;
+
+        /* Only slow down the velocity if it wouldn't change its direction */
+        if (*vx > dv) {
+            *vx -= dv;
+        }
+        else if (*vx < -dv) {
+            *vx += dv;
+        }
+        else {
+            *vx = 0;
+        }
+    }
+}
+#else
 static inline void _gfmObject_integrate(double *x, double *vx, double ax,
         double dx, double elapsed) {
     *x += (*vx) * elapsed;
@@ -1180,6 +1304,7 @@ static inline void _gfmObject_integrate(double *x, double *vx, double ax,
         }
     }
 }
+#endif
 
 /**
  * Apply another object's translation into this object
@@ -1205,10 +1330,13 @@ gfmRV gfmObject_applyDelta(gfmObject *pCtx, gfmObject *pOther) {
     ASSERT(pOther->t.hh > 0, GFMRV_OBJECT_NOT_INITIALIZED);
 
     /* Update its position with the other's translation */
+    if (pOther->dx != pOther->ldx || pOther->dy != pOther->ldy) {
+        _gfmObject_wake(pCtx);
+    }
     pCtx->dx += pOther->dx - pOther->ldx;
     pCtx->dy += pOther->dy - pOther->ldy;
-    pCtx->t.x = (int)pCtx->dx;
-    pCtx->t.y = (int)pCtx->dy;
+    pCtx->t.x = gfmObjReal_toInt(pCtx->dx);
+    pCtx->t.y = gfmObjReal_toInt(pCtx->dy);
 
     rv = GFMRV_OK;
 __ret:
@@ -1239,8 +1367,11 @@ gfmRV gfmObject_applyDeltaX(gfmObject *pCtx, gfmObject *pOther) {
     ASSERT(pOther->t.hh > 0, GFMRV_OBJECT_NOT_INITIALIZED);
 
     /* Update its position with the other's translation */
+    if (pOther->dx != pOther->ldx) {
+        _gfmObject_wake(pCtx);
+    }
     pCtx->dx += pOther->dx - pOther->ldx;
-    pCtx->t.x = (int)pCtx->dx;
+    pCtx->t.x = gfmObjReal_toInt(pCtx->dx);
 
     rv = GFMRV_OK;
 __ret:
@@ -1271,14 +1402,86 @@ gfmRV gfmObject_applyDeltaY(gfmObject *pCtx, gfmObject *pOther) {
     ASSERT(pOther->t.hh > 0, GFMRV_OBJECT_NOT_INITIALIZED);
 
     /* Update its position with the other's translation */
+    if (pOther->dy != pOther->ldy) {
+        _gfmObject_wake(pCtx);
+    }
     pCtx->dy += pOther->dy - pOther->ldy;
-    pCtx->t.y = (int)pCtx->dy;
+    pCtx->t.y = gfmObjReal_toInt(pCtx->dy);
 
     rv = GFMRV_OK;
 __ret:
     return rv;
 }
 
+/**
+ * Retrieve the time elapsed from the previous frame, in the same unit used by
+ * the physical attributes
+ *
+ * @param  [out]pElapsed The elapsed time, in seconds
+ * @param  [ in]pCtx     The game's context
+ * @return               GFMRV_OK, ...
+ */
+static gfmRV _gfmObject_getElapsed(gfmObjReal *pElapsed, gfmCtx *pCtx) {
+#if defined(FIXED_POINT_PHYSICS)
+    gfmRV rv;
+    int ms;
+
+    // Use the integer time, so there's no rounding from any double
+    rv = gfm_getElapsedTime(&ms, pCtx);
+    if (rv == GFMRV_OK) {
+        *pElapsed = gfmFixedPoint32_fromRatio(ms, 1000);
+    }
+    return rv;
+#else
+    return gfm_getElapsedTimed(pElapsed, pCtx);
+#endif
+}
+
+/**
+ * Integrate a (previously validated) object and shift its collision flags
+ *
+ * @param  [ in]pObj    The object
+ * @param  [ in]elapsed Time elapsed from the previous frame
+ */
+static inline void _gfmObject_step(gfmObject *pObj, gfmObjReal elapsed) {
+    // Sleeping objects are left untouched (collision flags included)
+    if (pObj->flags & gfmFlags_isAsleep) {
+        return;
+    }
+    // Check whether the object stood still since the previous frame
+    if (pObj->sleepDelay > 0) {
+        if (pObj->dx == pObj->ldx && pObj->dy == pObj->ldy
+                && pObj->vx == 0 && pObj->vy == 0
+                && pObj->ax == 0 && pObj->ay == 0) {
+            pObj->stillFrames++;
+            if (pObj->stillFrames >= pObj->sleepDelay) {
+                pObj->flags |= gfmFlags_isAsleep;
+                return;
+            }
+        }
+        else {
+            pObj->stillFrames = 0;
+        }
+    }
+
+    // Store the previous position
+    pObj->ldx = pObj->dx;
+    pObj->ldy = pObj->dy;
+    
+    // Integrate the position and velocity
+    _gfmObject_integrate(&pObj->dx, &pObj->vx, pObj->ax, pObj->dragX, elapsed);
+    _gfmObject_integrate(&pObj->dy, &pObj->vy, pObj->ay, pObj->dragY, elapsed);
+    
+    // Set the actual (integer) position
+    pObj->t.x = gfmObjReal_toInt(pObj->dx);
+    pObj->t.y = gfmObjReal_toInt(pObj->dy);
+    
+    // Clear this frame's collisions and set the previous one
+    pObj->flags &= ~gfmCollision_last;
+    pObj->flags |= (pObj->flags & gfmCollision_cur) << gfmFlags_lastBit;
+    pObj->flags &= ~gfmCollision_cur;
+}
+
 /**
  * Update the object; Its last collision status is cleared and the object's
  * properties are integrated using the Euler method
@@ -1289,7 +1492,7 @@ __ret:
  */
 gfmRV gfmObject_update(gfmObject *pObj, gfmCtx *pCtx) {
     gfmRV rv;
-    double elapsed;
+    gfmObjReal elapsed;
     
     // Sanitize arguments
     ASSERT(pObj, GFMRV_ARGUMENTS_BAD);
@@ -1300,31 +1503,102 @@ gfmRV gfmObject_update(gfmObject *pObj, gfmCtx *pCtx) {
     ASSERT(pObj->t.hh > 0, GFMRV_OBJECT_NOT_INITIALIZED);
     
     // Get the delta time
-    rv = gfm_getElapsedTimed(&elapsed, pCtx);
+    rv = _gfmObject_getElapsed(&elapsed, pCtx);
     ASSERT_NR(rv == GFMRV_OK);
     
-    // Store the previous position
-    pObj->ldx = pObj->dx;
-    pObj->ldy = pObj->dy;
-    
-    // Integrate the position and velocity
-    _gfmObject_integrate(&pObj->dx, &pObj->vx, pObj->ax, pObj->dragX, elapsed);
-    _gfmObject_integrate(&pObj->dy, &pObj->vy, pObj->ay, pObj->dragY, elapsed);
-    
-    // Set the actual (integer) position
-    pObj->t.x = (int)pObj->dx;
-    pObj->t.y = (int)pObj->dy;
-    
-    // Clear this frame's collisions and set the previous one
-    pObj->flags &= ~gfmCollision_last;
-    pObj->flags |= (pObj->flags & gfmCollision_cur) << gfmFlags_lastBit;
-    pObj->flags &= ~gfmCollision_cur;
+    _gfmObject_step(pObj, elapsed);
     
     rv = GFMRV_OK;
 __ret:
     return rv;
 }
 
+/**
+ * Update many objects at once; This has the same result as calling
+ * gfmObject_update on each object, but the elapsed time is retrieved only once
+ * and every object is validated before any is modified
+ *
+ * @param  [ in]ppObjs The objects
+ * @param  [ in]num    How many objects there are
+ * @param  [ in]pCtx   The game's context
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_INVALID_TYPE,
+ *                     GFMRV_OBJECT_NOT_INITIALIZED
+ */
+gfmRV gfmObject_updateMany(gfmObject **ppObjs, int num, gfmCtx *pCtx) {
+    gfmRV rv;
+    gfmObjReal elapsed;
+    int i;
+
+    /* Sanitize arguments */
+    ASSERT(ppObjs || num == 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(num >= 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    i = 0;
+    while (i < num) {
+        ASSERT(ppObjs[i], GFMRV_ARGUMENTS_BAD);
+        ASSERT(ppObjs[i]->t.innerType == gfmType_object, GFMRV_INVALID_TYPE);
+        ASSERT(ppObjs[i]->t.hw > 0, GFMRV_OBJECT_NOT_INITIALIZED);
+        ASSERT(ppObjs[i]->t.hh > 0, GFMRV_OBJECT_NOT_INITIALIZED);
+        i++;
+    }
+
+    rv = _gfmObject_getElapsed(&elapsed, pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    i = 0;
+    while (i < num) {
+        _gfmObject_step(ppObjs[i], elapsed);
+        i++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Update every object on a contiguous array (i.e., objects placed
+ * sizeofGFMObject bytes apart); This has the same result as calling
+ * gfmObject_update on each object, but the elapsed time is retrieved only once
+ * and every object is validated before any is modified
+ *
+ * @param  [ in]pObjs The first object on the array
+ * @param  [ in]num   How many objects there are
+ * @param  [ in]pCtx  The game's context
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_INVALID_TYPE,
+ *                    GFMRV_OBJECT_NOT_INITIALIZED
+ */
+gfmRV gfmObject_updateArray(gfmObject *pObjs, int num, gfmCtx *pCtx) {
+    gfmRV rv;
+    gfmObjReal elapsed;
+    int i;
+
+    /* Sanitize arguments */
+    ASSERT(pObjs || num == 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(num >= 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    i = 0;
+    while (i < num) {
+        ASSERT(pObjs[i].t.innerType == gfmType_object, GFMRV_INVALID_TYPE);
+        ASSERT(pObjs[i].t.hw > 0, GFMRV_OBJECT_NOT_INITIALIZED);
+        ASSERT(pObjs[i].t.hh > 0, GFMRV_OBJECT_NOT_INITIALIZED);
+        i++;
+    }
+
+    rv = _gfmObject_getElapsed(&elapsed, pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    i = 0;
+    while (i < num) {
+        _gfmObject_step(pObjs + i, elapsed);
+        i++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
 /**
  * Get the distance between two objects' centers
  * 
@@ -1446,6 +1720,46 @@ __ret:
     return rv;
 }
 
+/**
+ * Get the horizontal distance between two objects' centers, with sub-pixel
+ * precision
+ *
+ * @param  [ in]pSelf  An object
+ * @param  [ in]pOther An object
+ * @return             The distance
+ */
+static gfmObjReal _gfmObject_getHorizontalDistanceReal(gfmObject *pSelf,
+        gfmObject *pOther) {
+    gfmObjReal dist;
+
+    dist = (pSelf->dx + gfmObjReal_fromInt(pSelf->t.hw))
+            - (pOther->dx + gfmObjReal_fromInt(pOther->t.hw));
+    if (dist < 0) {
+        return -dist;
+    }
+    return dist;
+}
+
+/**
+ * Get the vertical distance between two objects' centers, with sub-pixel
+ * precision
+ *
+ * @param  [ in]pSelf  An object
+ * @param  [ in]pOther An object
+ * @return             The distance
+ */
+static gfmObjReal _gfmObject_getVerticalDistanceReal(gfmObject *pSelf,
+        gfmObject *pOther) {
+    gfmObjReal dist;
+
+    dist = (pSelf->dy + gfmObjReal_fromInt(pSelf->t.hh))
+            - (pOther->dy + gfmObjReal_fromInt(pOther->t.hh));
+    if (dist < 0) {
+        return -dist;
+    }
+    return dist;
+}
+
 /**
  * Get the horizontal distance between two objects' centers
  * 
@@ -1467,9 +1781,8 @@ gfmRV gfmObject_getHorizontalDistanced(double *pDx, gfmObject *pSelf,
     ASSERT(pOther->t.innerType == gfmType_object, GFMRV_INVALID_TYPE);
     
     // Get the distance
-    *pDx = (pSelf->dx + pSelf->t.hw) - (pOther->dx + pOther->t.hw);
-    if (*pDx < 0)
-        *pDx = -(*pDx);
+    *pDx = gfmObjReal_toDouble(_gfmObject_getHorizontalDistanceReal(pSelf,
+            pOther));
     
     rv = GFMRV_OK;
 __ret:
@@ -1497,9 +1810,8 @@ gfmRV gfmObject_getVerticalDistanced(double *pDy, gfmObject *pSelf,
     ASSERT(pOther->t.innerType == gfmType_object, GFMRV_INVALID_TYPE);
     
     // Get the distance
-    *pDy = (pSelf->dy + pSelf->t.hh) - (pOther->dy + pOther->t.hh);
-    if (*pDy < 0)
-        *pDy = -(*pDy);
+    *pDy = gfmObjReal_toDouble(_gfmObject_getVerticalDistanceReal(pSelf,
+            pOther));
     
     rv = GFMRV_OK;
 __ret:
@@ -1630,7 +1942,7 @@ gfmRV gfmObject_justOverlapedHitbox(gfmObject *pObj, gfmHitbox *pHitbox) {
     if (dist > maxDist) {
         return GFMRV_FALSE;
     }
-    lastDist = (int32_t)pObj->ldx + pObj->t.hw;
+    lastDist = gfmObjReal_toInt(pObj->ldx) + pObj->t.hw;
     lastDist -= pHitbox->x + pHitbox->hw;
     /* Overlap was only triggered this frame if they weren't overlaping on the
      * previous one */
@@ -1653,7 +1965,7 @@ gfmRV gfmObject_justOverlapedHitbox(gfmObject *pObj, gfmHitbox *pHitbox) {
     if (dist > maxDist) {
         return GFMRV_FALSE;
     }
-    lastDist = (int32_t)pObj->ldy + pObj->t.hh;
+    lastDist = gfmObjReal_toInt(pObj->ldy) + pObj->t.hh;
     lastDist -= pHitbox->y + pHitbox->hh;
     /* Overlap was only triggered this frame if they weren't overlaping on the
      * previous one */
@@ -1802,6 +2114,168 @@ __ret:
     return rv;
 }
 
+/**
+ * Retrieve an object's (or hitbox's) previous top-left position; Hitboxes never
+ * move, so their current position is returned instead
+ *
+ * @param  [out]pX   The horizontal position
+ * @param  [out]pY   The vertical position
+ * @param  [ in]pCtx The object
+ */
+static void _gfmObject_getLastPosition(int *pX, int *pY, gfmObject *pCtx) {
+    if (pCtx->t.innerType == gfmType_object) {
+        *pX = gfmObjReal_toInt(pCtx->ldx);
+        *pY = gfmObjReal_toInt(pCtx->ldy);
+    }
+    else {
+        *pX = pCtx->t.x;
+        *pY = pCtx->t.y;
+    }
+}
+
+/**
+ * Retrieve the area swept by an object since its last update (i.e., the
+ * smallest box that contains both its previous and its current hitbox)
+ *
+ * @param  [out]pX      The area's top-left position
+ * @param  [out]pY      The area's top-left position
+ * @param  [out]pWidth  The area's width
+ * @param  [out]pHeight The area's height
+ * @param  [ in]pCtx    The object (or hitbox)
+ * @return              GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                      GFMRV_OBJECT_NOT_INITIALIZED
+ */
+gfmRV gfmObject_getSweptArea(int *pX, int *pY, int *pWidth, int *pHeight,
+        gfmObject *pCtx) {
+    gfmRV rv;
+    int lx, ly;
+
+    /* Sanitize arguments */
+    ASSERT(pX, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pY, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pWidth, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pHeight, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Check that the object was initialized */
+    ASSERT(pCtx->t.hw > 0, GFMRV_OBJECT_NOT_INITIALIZED);
+    ASSERT(pCtx->t.hh > 0, GFMRV_OBJECT_NOT_INITIALIZED);
+
+    _gfmObject_getLastPosition(&lx, &ly, pCtx);
+
+    /* Expand the current hitbox so it also contains the previous one */
+    if (lx < pCtx->t.x) {
+        *pX = lx;
+        *pWidth = pCtx->t.x - lx;
+    }
+    else {
+        *pX = pCtx->t.x;
+        *pWidth = lx - pCtx->t.x;
+    }
+    if (ly < pCtx->t.y) {
+        *pY = ly;
+        *pHeight = pCtx->t.y - ly;
+    }
+    else {
+        *pY = pCtx->t.y;
+        *pHeight = ly - pCtx->t.y;
+    }
+    *pWidth += pCtx->t.hw * 2;
+    *pHeight += pCtx->t.hh * 2;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Check if two objects touched at any moment while moving from their previous
+ * position to their current one (assuming both moved linearly), so fast
+ * objects can't go through thin ones
+ *
+ * @param  [out]pTime  When the objects first touched, in the range [0, 1]
+ *                     (where 0 is their previous position and 1 their
+ *                     current one)
+ * @param  [ in]pSelf  An object (or hitbox)
+ * @param  [ in]pOther An object (or hitbox)
+ * @return             GFMRV_TRUE, GFMRV_FALSE, GFMRV_ARGUMENTS_BAD,
+ *                     GFMRV_OBJECT_NOT_INITIALIZED
+ */
+gfmRV gfmObject_sweptOverlap(double *pTime, gfmObject *pSelf,
+        gfmObject *pOther) {
+    double tEnter, tExit;
+    gfmRV rv;
+    int i, lox, loy, lsx, lsy;
+
+    /* Sanitize arguments */
+    ASSERT(pTime, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pSelf, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pOther, GFMRV_ARGUMENTS_BAD);
+    /* Check that the object was initialized */
+    ASSERT(pSelf->t.hw > 0, GFMRV_OBJECT_NOT_INITIALIZED);
+    ASSERT(pSelf->t.hh > 0, GFMRV_OBJECT_NOT_INITIALIZED);
+    ASSERT(pOther->t.hw > 0, GFMRV_OBJECT_NOT_INITIALIZED);
+    ASSERT(pOther->t.hh > 0, GFMRV_OBJECT_NOT_INITIALIZED);
+
+    _gfmObject_getLastPosition(&lsx, &lsy, pSelf);
+    _gfmObject_getLastPosition(&lox, &loy, pOther);
+
+    /* Move 'the other' object's frame of reference and find when (on each
+     * axis) 'this' object's relative position is within the overlap range */
+    tEnter = 0.0;
+    tExit = 1.0;
+    i = 0;
+    while (i < 2) {
+        double t0, t1;
+        int min, max, start, delta;
+
+        if (i == 0) {
+            start = lsx - lox;
+            delta = (pSelf->t.x - lsx) - (pOther->t.x - lox);
+            min = -pSelf->t.hw * 2;
+            max = pOther->t.hw * 2;
+        }
+        else {
+            start = lsy - loy;
+            delta = (pSelf->t.y - lsy) - (pOther->t.y - loy);
+            min = -pSelf->t.hh * 2;
+            max = pOther->t.hh * 2;
+        }
+
+        if (delta == 0) {
+            /* No relative movement, so they either always or never overlap */
+            if (start < min || start > max) {
+                return GFMRV_FALSE;
+            }
+        }
+        else {
+            t0 = (double)(min - start) / (double)delta;
+            t1 = (double)(max - start) / (double)delta;
+            if (t0 > t1) {
+                double tmp;
+
+                tmp = t0;
+                t0 = t1;
+                t1 = tmp;
+            }
+            if (t0 > tEnter) {
+                tEnter = t0;
+            }
+            if (t1 < tExit) {
+                tExit = t1;
+            }
+            if (tEnter > tExit) {
+                return GFMRV_FALSE;
+            }
+        }
+        i++;
+    }
+
+    *pTime = tEnter;
+    rv = GFMRV_TRUE;
+__ret:
+    return rv;
+}
+
 /**
  * Separate an object and a hitbox in the Y axis
  * 
@@ -1828,13 +2302,16 @@ gfmRV gfmObject_separateHorizontalHitbox(gfmObject *pObj, gfmHitbox *pHitbox) {
 
     if (pObj->flags & gfmCollision_instLeft) {
         /* pMovable collided to the left, place it at static's right */
-        pObj->dx = pHitbox->x + 2 * pHitbox->hw + 1;
+        pObj->dx = gfmObjReal_fromInt(pHitbox->x + 2 * pHitbox->hw + 1);
     }
     else if (pObj->flags & gfmCollision_instRight) {
         /* pMovable collided to the right, place it at static's left */
-        pObj->dx = pHitbox->x - 2 * pObj->t.hw - 1;
+        pObj->dx = gfmObjReal_fromInt(pHitbox->x - 2 * pObj->t.hw - 1);
     }
-    pObj->t.x = (int)pObj->dx;
+    if (pObj->t.x != gfmObjReal_toInt(pObj->dx)) {
+        _gfmObject_wake(pObj);
+    }
+    pObj->t.x = gfmObjReal_toInt(pObj->dx);
 
     rv = GFMRV_TRUE;
 __ret:
@@ -1867,13 +2344,16 @@ gfmRV gfmObject_separateVerticalHitbox(gfmObject *pObj, gfmHitbox *pHitbox) {
 
     if (pObj->flags & gfmCollision_instUp) {
         /* pMovable collided above, place it bellow static */
-        pObj->dy = pHitbox->y + 2 * pHitbox->hh;
+        pObj->dy = gfmObjReal_fromInt(pHitbox->y + 2 * pHitbox->hh);
     }
     else if (pObj->flags & gfmCollision_instDown) {
         /* pMovable collided bellow, place it above static */
-        pObj->dy = pHitbox->y - 2 * pObj->t.hh;
+        pObj->dy = gfmObjReal_fromInt(pHitbox->y - 2 * pObj->t.hh);
+    }
+    if (pObj->t.y != gfmObjReal_toInt(pObj->dy)) {
+        _gfmObject_wake(pObj);
     }
-    pObj->t.y = (int)pObj->dy;
+    pObj->t.y = gfmObjReal_toInt(pObj->dy);
 
     rv = GFMRV_TRUE;
 __ret:
@@ -2039,16 +2519,16 @@ gfmRV gfmObject_separateHorizontal(gfmObject *pSelf, gfmObject *pOther) {
         pStatic = 0;
     
     if (pStatic && pMovable) {
-        double newX;
+        gfmObjReal newX;
         // If one object is static
         
         if (pMovable->flags & gfmCollision_instLeft) {
             // pMovable collided to the left, place it at static's right
-            newX = pStatic->dx + 2 * pStatic->t.hw + 1;
+            newX = pStatic->dx + gfmObjReal_fromInt(2 * pStatic->t.hw + 1);
         }
         else if (pMovable->flags & gfmCollision_instRight) {
             // pMovable collided to the right, place it at static's left
-            newX = pStatic->dx - 2 * pMovable->t.hw - 1;
+            newX = pStatic->dx - gfmObjReal_fromInt(2 * pMovable->t.hw + 1);
         }
         else {
             // Never gonna happen, but avoids warning (stupid compiler!)
@@ -2058,12 +2538,10 @@ gfmRV gfmObject_separateHorizontal(gfmObject *pSelf, gfmObject *pOther) {
         ASSERT_NR(rv == GFMRV_OK);
     }
     else {
-        double dist;
+        gfmObjReal dist;
         
         // Get the object's distance
-        rv = gfmObject_getHorizontalDistanced(&dist, pSelf, pOther);
-        ASSERT_NR(rv == GFMRV_OK);
-        dist *= 0.5;
+        dist = _gfmObject_getHorizontalDistanceReal(pSelf, pOther) / 2;
         // Push both objects
         if (pSelf->flags & gfmCollision_instLeft) {
             // pSelf collided left, so it must be pushed to the right
@@ -2143,17 +2621,17 @@ gfmRV gfmObject_separateVertical(gfmObject *pSelf, gfmObject *pOther) {
         pStatic = 0;
     
     if (pStatic && pMovable) {
-        double newY;
+        gfmObjReal newY;
         // If one object is static
         
         // If the object was just placed inside another object, push it out
         if (pMovable->flags & gfmCollision_instUp) {
             // pMovable collided above, place it bellow static
-            newY = pStatic->dy + 2 * pStatic->t.hh;
+            newY = pStatic->dy + gfmObjReal_fromInt(2 * pStatic->t.hh);
         }
         else if (pMovable->flags & gfmCollision_instDown) {
             // pMovable collided bellow, place it above static
-            newY = pStatic->dy - 2 * pMovable->t.hh;
+            newY = pStatic->dy - gfmObjReal_fromInt(2 * pMovable->t.hh);
         }
         else {
             // Never gonna happen, but avoids warning (stupid compiler!)
@@ -2163,12 +2641,10 @@ gfmRV gfmObject_separateVertical(gfmObject *pSelf, gfmObject *pOther) {
         ASSERT_NR(rv == GFMRV_OK);
     }
     else {
-        double dist;
+        gfmObjReal dist;
         
         // Get the object's distance
-        rv = gfmObject_getVerticalDistanced(&dist, pSelf, pOther);
-        ASSERT_NR(rv == GFMRV_OK);
-        dist *= 0.5;
+        dist = _gfmObject_getVerticalDistanceReal(pSelf, pOther) / 2;
         // Push both objects
         if (pSelf->flags & gfmCollision_instUp) {
             // pSelf collided above so it must be pushed downward
@@ -0,0 +1,678 @@
+/**
+ * @file src/gfmParticles.c
+ *
+ * Particle system that stores every particle's attribute on parallel arrays
+ * (i.e., a structure-of-arrays), instead of on individually alloc'ed
+ * sprites/objects (as gfmGroup does); Both integrating and culling are done
+ * on tight loops over those arrays, without calling any per-particle function
+ * (so the compiler may vectorize them), and particles are drawn straight
+ * through the video backend
+ */
+#include <GFraMe/gframe.h>
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmParticles.h>
+#include <GFraMe/gfmSpriteset.h>
+#include <GFraMe_int/gfmCtx_struct.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+/** Flags set on each particle */
+enum enGFMParticleFlags {
+    /** The particle is drawn flipped */
+    gfmParticle_flipped  = 0x00000001,
+    /** The particle never dies on time */
+    gfmParticle_immortal = 0x00000002,
+};
+
+/** The gfmParticles structure */
+struct stGFMParticles {
+    /** Spriteset used to draw every particle */
+    gfmSpriteset *pSset;
+    /** Buffer with every array below */
+    void *pBuf;
+    /** Position (top-left corner of the tile) of each particle */
+    float *pX;
+    float *pY;
+    /** Velocity of each particle */
+    float *pVx;
+    float *pVy;
+    /** Acceleration of each particle */
+    float *pAx;
+    float *pAy;
+    /** For how long (in milliseconds) each particle will keep living */
+    int *pTtl;
+    /** Frame of each particle */
+    int *pFrame;
+    /** Flags (see enGFMParticleFlags) of each particle */
+    int *pFlags;
+    /** How many particles are alive */
+    int used;
+    /** How many particles may be alive */
+    int len;
+    /** Whether the last particle was just spawned (i.e., whether it may be
+     * modified through gfmParticles_set*) */
+    int hasLast;
+    /** Default horizontal velocity */
+    float defVx;
+    /** Default vertical velocity */
+    float defVy;
+    /** Default horizontal acceleration */
+    float defAx;
+    /** Default vertical acceleration */
+    float defAy;
+    /** Default frame */
+    int defFrame;
+    /** For how long the particles should live; -1 for infinite */
+    int ttl;
+    /** Whether should die on leaving the screen */
+    int dieOnLeave;
+};
+
+/**
+ * Alloc a new particle system
+ *
+ * @param  [out]ppCtx The particle system
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmParticles_getNew(gfmParticles **ppCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(!(*ppCtx), GFMRV_ARGUMENTS_BAD);
+
+    *ppCtx = (gfmParticles*)malloc(sizeof(gfmParticles));
+    ASSERT(*ppCtx, GFMRV_ALLOC_FAILED);
+    memset(*ppCtx, 0x0, sizeof(gfmParticles));
+    (*ppCtx)->ttl = -1;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Release a particle system and all of its memory
+ *
+ * @param  [ in]ppCtx The particle system
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_free(gfmParticles **ppCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(*ppCtx, GFMRV_ARGUMENTS_BAD);
+
+    rv = gfmParticles_clean(*ppCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+    free(*ppCtx);
+    *ppCtx = 0;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Release every particle (and its arrays) and reset the defaults
+ *
+ * @param  [ in]pCtx The particle system
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_clean(gfmParticles *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    if (pCtx->pBuf) {
+        free(pCtx->pBuf);
+    }
+    memset(pCtx, 0x0, sizeof(gfmParticles));
+    pCtx->ttl = -1;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Alloc the particles' arrays and set the spriteset used to draw them; Any
+ * previously spawned particle is removed
+ *
+ * @param  [ in]pCtx   The particle system
+ * @param  [ in]pSset  The spriteset
+ * @param  [ in]maxLen How many particles may be alive at once
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmParticles_init(gfmParticles *pCtx, gfmSpriteset *pSset, int maxLen) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pSset, GFMRV_ARGUMENTS_BAD);
+    ASSERT(maxLen > 0, GFMRV_ARGUMENTS_BAD);
+
+    if (pCtx->len < maxLen) {
+        char *pBuf;
+
+        /* Every array has 4 bytes per particle (and is, therefore, always
+         * aligned) */
+        pBuf = (char*)realloc(pCtx->pBuf, maxLen * (sizeof(float) * 6
+                + sizeof(int) * 3));
+        ASSERT(pBuf, GFMRV_ALLOC_FAILED);
+        pCtx->pBuf = pBuf;
+
+        pCtx->pX = (float*)pBuf;
+        pCtx->pY = pCtx->pX + maxLen;
+        pCtx->pVx = pCtx->pY + maxLen;
+        pCtx->pVy = pCtx->pVx + maxLen;
+        pCtx->pAx = pCtx->pVy + maxLen;
+        pCtx->pAy = pCtx->pAx + maxLen;
+        pCtx->pTtl = (int*)(pCtx->pAy + maxLen);
+        pCtx->pFrame = pCtx->pTtl + maxLen;
+        pCtx->pFlags = pCtx->pFrame + maxLen;
+        pCtx->len = maxLen;
+    }
+
+    pCtx->pSset = pSset;
+    pCtx->used = 0;
+    pCtx->hasLast = 0;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Set the default velocity on every spawned particle
+ *
+ * @param  [ in]pCtx The particle system
+ * @param  [ in]vx   The horizontal velocity
+ * @param  [ in]vy   The vertical velocity
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_setDefVelocity(gfmParticles *pCtx, int vx, int vy) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    pCtx->defVx = (float)vx;
+    pCtx->defVy = (float)vy;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Set the default acceleration on every spawned particle
+ *
+ * @param  [ in]pCtx The particle system
+ * @param  [ in]ax   The horizontal acceleration
+ * @param  [ in]ay   The vertical acceleration
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_setDefAcceleration(gfmParticles *pCtx, int ax, int ay) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    pCtx->defAx = (float)ax;
+    pCtx->defAy = (float)ay;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Set the default frame on every spawned particle
+ *
+ * @param  [ in]pCtx  The particle system
+ * @param  [ in]frame The frame
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_setDefFrame(gfmParticles *pCtx, int frame) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    pCtx->defFrame = frame;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Set whether every particle should 'die' when it leaves the screen
+ *
+ * @param  [ in]pCtx  The particle system
+ * @param  [ in]doDie Whether the particles should die or not
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_setDeathOnLeave(gfmParticles *pCtx, int doDie) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    pCtx->dieOnLeave = doDie;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Set for how long every spawned particle should live
+ *
+ * @param  [ in]pCtx The particle system
+ * @param  [ in]ttl  Time to live, in milliseconds (-1 for infinite)
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_setDeathOnTime(gfmParticles *pCtx, int ttl) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(ttl >= -1, GFMRV_ARGUMENTS_BAD);
+
+    pCtx->ttl = ttl;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Spawn a new particle, with the default attributes, at the desired position
+ *
+ * @param  [ in]pCtx The particle system
+ * @param  [ in]x    Horizontal position (top-left corner of its tile)
+ * @param  [ in]y    Vertical position (top-left corner of its tile)
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_NOT_INITIALIZED,
+ *                   GFMRV_PARTICLES_MAX_PARTICLES
+ */
+gfmRV gfmParticles_spawn(gfmParticles *pCtx, int x, int y) {
+    gfmRV rv;
+    int i;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Check that it was initialized */
+    ASSERT(pCtx->pSset, GFMRV_NOT_INITIALIZED);
+    ASSERT(pCtx->used < pCtx->len, GFMRV_PARTICLES_MAX_PARTICLES);
+
+    i = pCtx->used;
+    pCtx->pX[i] = (float)x;
+    pCtx->pY[i] = (float)y;
+    pCtx->pVx[i] = pCtx->defVx;
+    pCtx->pVy[i] = pCtx->defVy;
+    pCtx->pAx[i] = pCtx->defAx;
+    pCtx->pAy[i] = pCtx->defAy;
+    pCtx->pFrame[i] = pCtx->defFrame;
+    if (pCtx->ttl == -1) {
+        pCtx->pTtl[i] = 0;
+        pCtx->pFlags[i] = gfmParticle_immortal;
+    }
+    else {
+        pCtx->pTtl[i] = pCtx->ttl;
+        pCtx->pFlags[i] = 0;
+    }
+    pCtx->used++;
+    pCtx->hasLast = 1;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Set the velocity of the last spawned particle
+ *
+ * @param  [ in]pCtx The particle system
+ * @param  [ in]vx   The horizontal velocity
+ * @param  [ in]vy   The vertical velocity
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_PARTICLES_NO_LAST_PARTICLE
+ */
+gfmRV gfmParticles_setVelocity(gfmParticles *pCtx, int vx, int vy) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Check that there is a previous particle */
+    ASSERT(pCtx->hasLast, GFMRV_PARTICLES_NO_LAST_PARTICLE);
+
+    pCtx->pVx[pCtx->used - 1] = (float)vx;
+    pCtx->pVy[pCtx->used - 1] = (float)vy;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Set the acceleration of the last spawned particle
+ *
+ * @param  [ in]pCtx The particle system
+ * @param  [ in]ax   The horizontal acceleration
+ * @param  [ in]ay   The vertical acceleration
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_PARTICLES_NO_LAST_PARTICLE
+ */
+gfmRV gfmParticles_setAcceleration(gfmParticles *pCtx, int ax, int ay) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Check that there is a previous particle */
+    ASSERT(pCtx->hasLast, GFMRV_PARTICLES_NO_LAST_PARTICLE);
+
+    pCtx->pAx[pCtx->used - 1] = (float)ax;
+    pCtx->pAy[pCtx->used - 1] = (float)ay;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Set the frame of the last spawned particle
+ *
+ * @param  [ in]pCtx  The particle system
+ * @param  [ in]frame The frame
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                    GFMRV_PARTICLES_NO_LAST_PARTICLE
+ */
+gfmRV gfmParticles_setFrame(gfmParticles *pCtx, int frame) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Check that there is a previous particle */
+    ASSERT(pCtx->hasLast, GFMRV_PARTICLES_NO_LAST_PARTICLE);
+
+    pCtx->pFrame[pCtx->used - 1] = frame;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Set whether the last spawned particle should be drawn flipped
+ *
+ * @param  [ in]pCtx      The particle system
+ * @param  [ in]isFlipped Whether it's flipped
+ * @return                GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                        GFMRV_PARTICLES_NO_LAST_PARTICLE
+ */
+gfmRV gfmParticles_setFlipped(gfmParticles *pCtx, int isFlipped) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Check that there is a previous particle */
+    ASSERT(pCtx->hasLast, GFMRV_PARTICLES_NO_LAST_PARTICLE);
+
+    if (isFlipped) {
+        pCtx->pFlags[pCtx->used - 1] |= gfmParticle_flipped;
+    }
+    else {
+        pCtx->pFlags[pCtx->used - 1] &= ~gfmParticle_flipped;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Set for how long the last spawned particle should live
+ *
+ * @param  [ in]pCtx The particle system
+ * @param  [ in]ttl  Time to live, in milliseconds (-1 for infinite)
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_PARTICLES_NO_LAST_PARTICLE
+ */
+gfmRV gfmParticles_setTimeToLive(gfmParticles *pCtx, int ttl) {
+    gfmRV rv;
+    int i;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(ttl >= -1, GFMRV_ARGUMENTS_BAD);
+    /* Check that there is a previous particle */
+    ASSERT(pCtx->hasLast, GFMRV_PARTICLES_NO_LAST_PARTICLE);
+
+    i = pCtx->used - 1;
+    if (ttl == -1) {
+        pCtx->pTtl[i] = 0;
+        pCtx->pFlags[i] |= gfmParticle_immortal;
+    }
+    else {
+        pCtx->pTtl[i] = ttl;
+        pCtx->pFlags[i] &= ~gfmParticle_immortal;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Retrieve how many particles are alive
+ *
+ * @param  [out]pCount How many particles are alive
+ * @param  [ in]pCtx   The particle system
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_getCount(int *pCount, gfmParticles *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCount, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    *pCount = pCtx->used;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Integrate every particle and remove the dead ones
+ *
+ * @param  [ in]pParts The particle system
+ * @param  [ in]pCtx   The game's context
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, ...
+ */
+gfmRV gfmParticles_update(gfmParticles *pParts, gfmCtx *pCtx) {
+    float *pX, *pY, *pVx, *pVy, *pAx, *pAy;
+    int *pTtl, *pFrame, *pFlags;
+    float dt, halfDt2;
+    gfmRV rv;
+    int camX, camY, camW, camH, elapsed, i, tileW, tileH, used, w;
+
+    /* Sanitize arguments */
+    ASSERT(pParts, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    /* Nothing may be modified after the update */
+    pParts->hasLast = 0;
+    if (pParts->used == 0) {
+        rv = GFMRV_OK;
+        goto __ret;
+    }
+
+    rv = gfm_getElapsedTime(&elapsed, pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfm_getElapsedTimef(&dt, pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+    halfDt2 = 0.5f * dt * dt;
+
+    pX = pParts->pX;
+    pY = pParts->pY;
+    pVx = pParts->pVx;
+    pVy = pParts->pVy;
+    pAx = pParts->pAx;
+    pAy = pParts->pAy;
+    pTtl = pParts->pTtl;
+    pFrame = pParts->pFrame;
+    pFlags = pParts->pFlags;
+    used = pParts->used;
+
+    /* Integrate everything (as gfmObject does, but with no drag) */
+    i = 0;
+    while (i < used) {
+        pX[i] += pVx[i] * dt + pAx[i] * halfDt2;
+        pY[i] += pVy[i] * dt + pAy[i] * halfDt2;
+        pVx[i] += pAx[i] * dt;
+        pVy[i] += pAy[i] * dt;
+        i++;
+    }
+    i = 0;
+    while (i < used) {
+        pTtl[i] -= (pFlags[i] & gfmParticle_immortal) ? 0 : elapsed;
+        i++;
+    }
+
+    /* Retrieve the visible area, if particles must die outside it */
+    camX = 0;
+    camY = 0;
+    camW = 0;
+    camH = 0;
+    tileW = 0;
+    tileH = 0;
+    if (pParts->dieOnLeave) {
+        rv = gfm_getCameraPosition(&camX, &camY, pCtx);
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfm_getCameraDimensions(&camW, &camH, pCtx);
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmSpriteset_getDimension(&tileW, &tileH, pParts->pSset);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+
+    /* Remove every dead particle, keeping the others on the same order */
+    w = 0;
+    i = 0;
+    while (i < used) {
+        int isAlive;
+
+        isAlive = (pFlags[i] & gfmParticle_immortal) || pTtl[i] > 0;
+        if (isAlive && pParts->dieOnLeave) {
+            int x, y;
+
+            /* Same test as gfmCamera_isSpriteInside */
+            x = (int)pX[i];
+            y = (int)pY[i];
+            isAlive = (x <= camX + camW) && (x + tileW >= camX) &&
+                    (y <= camY + camH) && (y + tileH >= camY);
+        }
+
+        if (isAlive) {
+            if (w != i) {
+                pX[w] = pX[i];
+                pY[w] = pY[i];
+                pVx[w] = pVx[i];
+                pVy[w] = pVy[i];
+                pAx[w] = pAx[i];
+                pAy[w] = pAy[i];
+                pTtl[w] = pTtl[i];
+                pFrame[w] = pFrame[i];
+                pFlags[w] = pFlags[i];
+            }
+            w++;
+        }
+        i++;
+    }
+    pParts->used = w;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Draw every visible particle, from the oldest to the newest
+ *
+ * @param  [ in]pParts The particle system
+ * @param  [ in]pCtx   The game's context
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                     GFMRV_BACKBUFFER_NOT_INITIALIZED, ...
+ */
+gfmRV gfmParticles_draw(gfmParticles *pParts, gfmCtx *pCtx) {
+    gfmRV rv;
+    int camX, camY, camW, camH, i, tileW, tileH;
+
+    /* Sanitize arguments */
+    ASSERT(pParts, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Check that the video context was initialized */
+    ASSERT(pCtx->pVideo, GFMRV_BACKBUFFER_NOT_INITIALIZED);
+
+    if (pParts->used == 0) {
+        rv = GFMRV_OK;
+        goto __ret;
+    }
+
+    rv = gfm_getCameraPosition(&camX, &camY, pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfm_getCameraDimensions(&camW, &camH, pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmSpriteset_getDimension(&tileW, &tileH, pParts->pSset);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    i = 0;
+    while (i < pParts->used) {
+        int x, y;
+
+        /* Convert to screen-space and skip everything outside the camera
+         * (or without a valid frame) */
+        x = (int)pParts->pX[i] - camX;
+        y = (int)pParts->pY[i] - camY;
+        if (x <= camW && x + tileW >= 0 && y <= camH && y + tileH >= 0 &&
+                pParts->pFrame[i] >= 0) {
+            rv = (*(pCtx->videoFuncs.gfmVideo_drawTile))(pCtx->pVideo,
+                    pParts->pSset, x, y, pParts->pFrame[i],
+                    pParts->pFlags[i] & gfmParticle_flipped);
+            ASSERT_NR(rv == GFMRV_OK);
+        }
+        i++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Remove every particle
+ *
+ * @param  [ in]pCtx The particle system
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmParticles_killAll(gfmParticles *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    pCtx->used = 0;
+    pCtx->hasLast = 0;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
@@ -25,8 +25,8 @@
  *   - GFMRV_QUADTREE_DONE: the 'object' was successfully added to the quadtree;
  */
 #include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmDebug.h>
 #include <GFraMe/gfmError.h>
-#include <GFraMe/gfmGenericArray.h>
 #include <GFraMe/gfmGroup.h>
 #include <GFraMe/gfmHitbox.h>
 #include <GFraMe/gfmObject.h>
@@ -35,6 +35,13 @@
 #include <GFraMe/gfmTilemap.h>
 #include <GFraMe/gfmTypes.h>
 
+#include <GFraMe_int/core/gfmThreadPool_bkend.h>
+#include <GFraMe_int/gfmHitbox.h>
+#include <GFraMe_int/gfmPackedHitboxes.h>
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -83,10 +90,23 @@ typedef struct stGFMQuadtreeLL gfmQuadtreeLL;
 typedef struct stGFMQuadtreeStack gfmQuadtreeStack;
 /** Index of a child relative to its parent */
 typedef enum enGFMQuadtreePosition gfmQuadtreePosition;
-/** Define array of quadtree nodes */
-gfmGenArr_define(gfmQuadtree);
-/** Define array of quadtree linked-list nodes */
-gfmGenArr_define(gfmQuadtreeLL);
+/** Pair of objects that was already reported */
+typedef struct stGFMQuadtreeReported gfmQuadtreeReported;
+/** A tree of nodes, with the lists of objects on its leaves */
+typedef struct stGFMQuadtreeLayer gfmQuadtreeLayer;
+/** Object added through gfmQuadtree_defer*, waiting to be collided */
+typedef struct stGFMQuadtreeDeferred gfmQuadtreeDeferred;
+/** Overlap found by gfmQuadtree_collideDeferred, with its sorting keys */
+typedef struct stGFMQuadtreeSortedPair gfmQuadtreeSortedPair;
+/** Data local to each thread running gfmQuadtree_collideDeferred */
+typedef struct stGFMQuadtreeWorker gfmQuadtreeWorker;
+/** Area (or segment) searched by gfmQuadtree_query* */
+typedef struct stGFMQuadtreeQuery gfmQuadtreeQuery;
+/** Object found by gfmQuadtree_query* */
+typedef struct stGFMQuadtreeHit gfmQuadtreeHit;
+
+/** Area used to insert an object into a layer */
+typedef struct stGFMQuadtreeArea gfmQuadtreeArea;
 
 /** Index of a child relative to its parent */
 enum enGFMQuadtreePosition {
@@ -97,18 +117,139 @@ enum enGFMQuadtreePosition {
     gfmQT_max,
 };
 
+/** How many deferred objects are collided against the static layer on each
+ * task of gfmQuadtree_collideDeferred */
+enum {
+    gfmQT_deferredPerTask = 64
+};
+
+/** Area used to insert an object into a layer */
+struct stGFMQuadtreeArea {
+    /** Center of the area */
+    int centerX;
+    /** Center of the area */
+    int centerY;
+    /** Half the area's width (rounded up) */
+    int halfWidth;
+    /** Half the area's height (rounded up) */
+    int halfHeight;
+};
+
 /** Index of a child relative to its parent */
 struct stGFMQuadtreeLL {
     /** This nodes object */
     gfmObject *pSelf;
-    /** The next node */
-    struct stGFMQuadtreeLL *pNext;
+    /** Index of the next node (0 if this is the last one) */
+    uint32_t next;
+    /** Object's type (only its lowest 5 bits) */
+    uint32_t type;
+    /** Order in which the object was added to the layer */
+    uint32_t seq;
+    /** Whether the object was added through gfmQuadtree_defer* (or
+     * gfmQuadtree_trackObject) */
+    uint32_t isDeferred;
+    /** Area used to insert the object (so it's kept when a node subdivides) */
+    gfmQuadtreeArea area;
+};
+
+/** Object added through gfmQuadtree_defer*, waiting to be collided */
+struct stGFMQuadtreeDeferred {
+    /** The object */
+    gfmObject *pSelf;
+    /** Object's type (only its lowest 5 bits) */
+    uint32_t type;
+    /** Order in which the object was added to the dynamic layer (on
+     * incremental mode, the object's handle) */
+    uint32_t seq;
+    /** Area with which a tracked object was inserted into the dynamic layer */
+    gfmQuadtreeArea area;
+    /** Whether the range below is valid (i.e., no leaf containing the
+     * tracked object was subdivided since it was inserted) */
+    int isValid;
+    /** Range within which the object's center may move without changing the
+     * leaves it overlaps */
+    int minX;
+    int maxX;
+    int minY;
+    int maxY;
+    /** Next unused handle, plus 1 (only if this one isn't in use) */
+    int nextFree;
+};
+
+/** Overlap found by gfmQuadtree_collideDeferred, with its sorting keys */
+struct stGFMQuadtreeSortedPair {
+    /** The overlap */
+    gfmQuadtreePair pair;
+    /** Order in which pSelf was added */
+    uint32_t selfSeq;
+    /** Order in which pOther was added (to its layer) */
+    uint32_t otherSeq;
+};
+
+/** Data local to each thread running gfmQuadtree_collideDeferred */
+struct stGFMQuadtreeWorker {
+    /** Overlaps found by this worker */
+    gfmQuadtreeSortedPair *pPairs;
+    /** How many overlaps were found */
+    int used;
+    /** How many overlaps fit on the buffer */
+    int len;
+    /** Stack used to traverse the static layer */
+    uint32_t *pStack;
+    /** How many nodes fit on the stack */
+    int stackLen;
+    /** How many pairs were tested against the static layer */
+    int staticTests;
+    /** How many pairs were tested against the dynamic layer */
+    int dynamicTests;
+    /** Copy of the hitboxes on the node being collided */
+    gfmPackedHitboxes packed;
+};
+
+/** Area (or segment) searched by gfmQuadtree_query* */
+struct stGFMQuadtreeQuery {
+    /** Bounds of the area (or of the segment), inclusive */
+    int left;
+    int top;
+    int right;
+    int bottom;
+    /** Whether this is a segment (from (x0, y0) to (x1, y1)) */
+    int isRay;
+    /** Segment's start */
+    int x0;
+    int y0;
+    /** Segment's end */
+    int x1;
+    int y1;
+};
+
+/** Object found by gfmQuadtree_query* */
+struct stGFMQuadtreeHit {
+    /** The object */
+    gfmObject *pSelf;
+    /** Where, along the segment, the object was hit (in the range [0, 1]) */
+    double dist;
+    /** Order in which the object was added to its layer */
+    uint32_t seq;
+    /** Whether the object is on the static layer */
+    uint32_t isStatic;
+};
+
+/** Pair of objects that was already reported */
+struct stGFMQuadtreeReported {
+    /** The pair's object with the lowest address */
+    gfmObject *pA;
+    /** The pair's object with the highest address */
+    gfmObject *pB;
+    /** Frame when the pair was reported; The entry is empty if it differs
+     * from the root's current epoch */
+    unsigned int epoch;
 };
 
 /** Stack of quadtree nodes */
 struct stGFMQuadtreeStack {
-    /** The nodes that were pushed */
-    gfmQuadtree **ppStack;
+    /** Index of the nodes that were pushed */
+    uint32_t *pStack;
     /** Position where pushes may happen (pop happens on this - 1) */
     int pushPos;
     /** How many nodes this can handle */
@@ -117,10 +258,11 @@ struct stGFMQuadtreeStack {
 
 /** Quadtree node type */
 struct stGFMQuadtree {
-    /** The tree's sub-nodes */
-    gfmQuadtree *ppChildren[gfmQT_max];
-    /** List of all objects inside this node */
-    gfmQuadtreeLL *pNodes;
+    /** Index of the first of the tree's sub-nodes (which are stored
+     * sequentially); Since the root is never a child, 0 means it's a leaf */
+    uint32_t children;
+    /** Index of the first object inside this node (0 if it's empty) */
+    uint32_t nodes;
     /** Center of the hitbox */
     int centerX;
     /** Center of the hitbox */
@@ -129,39 +271,166 @@ struct stGFMQuadtree {
     int halfWidth;
     /** Half the hitbox's height */
     int halfHeight;
-    /** The node's depth */
+    /** Half the width of the area where the node's objects may be (only
+     * larger than the hitbox on loose mode) */
+    int looseHalfWidth;
+    /** Half the height of the area where the node's objects may be */
+    int looseHalfHeight;
+    /** The node's depth (-1 if it was released) */
     int depth;
     /** How many objects were added to this node */
     int numObjects;
+    /** Index of the node's parent (0 for the root) */
+    uint32_t parent;
 };
 
-/** Quadtree's context, with the current stack and the the root node */
-struct stGFMQuadtreeRoot {
+/** A tree of nodes, with the lists of objects on its leaves */
+struct stGFMQuadtreeLayer {
     /** How many nodes can a node have until it must subdivide */
     int maxNodes;
-    /** How many depths the quadtree can have */
+    /** How many depths the quadtree can have (0 if not initialized) */
     int maxDepth;
+    /** Pool of quadtree nodes; The first one is always the actual root */
+    gfmQuadtree *pNodes;
+    /** How many nodes are in use */
+    uint32_t nodesUsed;
+    /** How many nodes fit on the pool */
+    uint32_t nodesLen;
+    /** Pool of quadtree LL nodes; The first one is never used, so 0 may be
+     * used to signal the end of a list */
+    gfmQuadtreeLL *pCells;
+    /** How many LL nodes are in use */
+    uint32_t cellsUsed;
+    /** How many LL nodes fit on the pool */
+    uint32_t cellsLen;
+    /** List of available LL nodes */
+    uint32_t available;
+    /** Order of the next object added to the layer */
+    uint32_t nextSeq;
+    /** Whether objects are inserted (and tested) by the area swept since
+     * their last update, as set by gfmQuadtree_setContinuous */
+    int isSwept;
+    /** List of released groups of children (linked through their first
+     * node's children) */
+    uint32_t freeNodes;
+    /** Whether each object is inserted into a single node (the deepest one
+     * whose expanded bounds contain it), as set by gfmQuadtree_setLoose */
+    int isLoose;
+    /** By how much each node's bounds are expanded, on loose mode */
+    double looseness;
+    /** How many pairs were tested against this layer's objects (on the
+     * current frame) */
+    int overlapTests;
+    /** How many overlaps were reported against this layer's objects (on the
+     * current frame) */
+    int pairs;
+};
+
+/** Quadtree's context, with the current stack and the the root node */
+struct stGFMQuadtreeRoot {
     /** Whether this is a static quadtree (one that may be populated but
      * colliding doesn't insert nodes */
     int isStatic;
-    /** Pool of quadtree nodes */
-    gfmGenArr_var(gfmQuadtree, pQTPool);
-    /** Pool of quadtree LL nodes */
-    gfmGenArr_var(gfmQuadtreeLL, pQTLLPool);
+    /** Layer that is cleared on every gfmQuadtree_initRoot, where collided
+     * objects are inserted */
+    gfmQuadtreeLayer dynamicLayer;
+    /** Layer that is kept across frames (until gfmQuadtree_initStatic or
+     * gfmQuadtree_clearStatic are called); Objects are collided against it
+     * but never inserted into it */
+    gfmQuadtreeLayer staticLayer;
+    /** Layer currently being traversed */
+    gfmQuadtreeLayer *pLayer;
     /** List of collideables objects from a group */
     gfmGroupNode *pGroupList;
-    /** The actual root node of the quadtree */
-    gfmQuadtree *pSelf;
-    /** List of available LL nodes */
-    gfmQuadtreeLL *pAvailable;
     /** List of nodes to be collided */
-    gfmQuadtreeLL *pColliding;
+    uint32_t colliding;
     /** Stack of nodes which the object must still be added to */
     gfmQuadtreeStack stack;
     /** Object being collided */
     gfmObject *pObject;
     /** The object that was just overlapped */
     gfmObject *pOther;
+    /** Index of the leaf whose objects are being collided */
+    uint32_t curNode;
+    /** Hash set with every pair reported on the current frame */
+    gfmQuadtreeReported *pReported;
+    /** Length of the hash set (always a power of 2) */
+    int reportedLen;
+    /** How many pairs were reported on the current frame */
+    int reportedCount;
+    /** Current frame, used to clear the hash set by simply incrementing it */
+    unsigned int epoch;
+    /** How many overlaps were ignored (on the current frame) because the pair
+     * had already been reported on another leaf */
+    int duplicates;
+    /** Type of the object being collided (only its lowest 5 bits) */
+    uint32_t curType;
+    /** Order in which the object being collided was added */
+    uint32_t curSeq;
+    /** Area of the object being collided (on the layer being traversed) */
+    gfmQuadtreeArea curArea;
+    /** When the current overlap happened (only set on continuous mode) */
+    double time;
+    /** For each type, a bitmask of the types it doesn't interact with (both
+     * indexed by the type's lowest 5 bits) */
+    uint32_t ignored[gfmType_max];
+    /** Worker threads used by gfmQuadtree_collideDeferred (NULL if only the
+     * calling thread should be used) */
+    gfmThreadPool *pPool;
+    /** Data local to each worker */
+    gfmQuadtreeWorker *pWorkers;
+    /** How many workers were alloc'ed */
+    int numWorkers;
+    /** Objects added through gfmQuadtree_defer* on the current frame (or,
+     * on incremental mode, every tracked object, indexed by its handle) */
+    gfmQuadtreeDeferred *pDeferred;
+    /** How many objects were deferred (or how many handles were used) */
+    int deferredUsed;
+    /** How many deferred objects fit on the buffer */
+    int deferredLen;
+    /** Leaves of the dynamic layer collided by gfmQuadtree_collideDeferred */
+    uint32_t *pLeaves;
+    /** How many leaves are being collided */
+    int leavesUsed;
+    /** How many leaves fit on the buffer */
+    int leavesLen;
+    /** Every worker's overlaps, merged and sorted */
+    gfmQuadtreeSortedPair *pSorted;
+    /** How many sorted overlaps fit on the buffer */
+    int sortedLen;
+    /** Overlaps returned by gfmQuadtree_collideDeferred */
+    gfmQuadtreePair *pPairs;
+    /** How many overlaps fit on the buffer */
+    int pairsLen;
+    /** Objects found by gfmQuadtree_query* (possibly repeated) */
+    gfmQuadtreeHit *pHits;
+    /** How many objects were found */
+    int hitsUsed;
+    /** How many objects fit on the buffer */
+    int hitsLen;
+    /** Stack used by gfmQuadtree_query* (so it may be called while an
+     * overlap is being handled) */
+    uint32_t *pQueryStack;
+    /** How many nodes fit on the stack */
+    int queryStackLen;
+    /** Whether the dynamic layer is kept across frames, being updated by
+     * gfmQuadtree_refresh */
+    int isIncremental;
+    /** First unused tracked handle, plus 1 (0 if there's none); The others
+     * are linked through nextFree */
+    int trackedFree;
+    /** Nodes whose children may have become sparse enough to be merged */
+    uint32_t *pCollapse;
+    /** How many nodes must be checked */
+    int collapseUsed;
+    /** How many nodes fit on the buffer */
+    int collapseLen;
+    /** Whether gfmQuadtree_drawBounds should also print the dynamic layer's
+     * stats */
+    int drawStats;
+    /** Position (in screen space) where the stats are printed */
+    int statsX;
+    int statsY;
 };
 
 /******************************************************************************/
@@ -171,94 +440,86 @@ struct stGFMQuadtreeRoot {
 /******************************************************************************/
 
 /**
- * Alloc a new quadtree linked-list node
- * 
- * @param  ppCtx The linked list node
- * @return       GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ * Retrieve sequential nodes from the pool, expanding it as necessary; Groups
+ * of children released by a collapsed node are recycled first
+ *
+ * NOTE: Expanding the pool invalidates any pointer to a node!
+ *
+ * @param  [out]pIndex Index of the first retrieved node
+ * @param  [ in]pCtx   The layer
+ * @param  [ in]count  How many nodes should be retrieved
+ * @return             GFMRV_OK, GFMRV_ALLOC_FAILED
  */
-static gfmRV gfmQuadtreeLL_getNew(gfmQuadtreeLL **ppCtx) {
+static gfmRV gfmQuadtree_getNodes(uint32_t *pIndex, gfmQuadtreeLayer *pCtx,
+        uint32_t count) {
     gfmRV rv;
-    
-    // Sanitize arguments
-    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
-    ASSERT(!(*ppCtx), GFMRV_ARGUMENTS_BAD);
-    
-    // Alloc it
-    *ppCtx = (gfmQuadtreeLL*)malloc(sizeof(gfmQuadtreeLL));
-    ASSERT(*ppCtx, GFMRV_ALLOC_FAILED);
-    // Clean it
-    memset(*ppCtx, 0x0, sizeof(gfmQuadtreeLL));
-    
-    rv = GFMRV_OK;
-__ret:
-    return rv;
-}
 
-/**
- * Frees a quadtree linked-list node
- * 
- * @param  ppCtx The linked list node
- * @return       GFMRV_OK, GFMRV_ARGUMENTS_BAD
- */
-static gfmRV gfmQuadtreeLL_free(gfmQuadtreeLL **ppCtx) {
-    gfmRV rv;
-    
-    // Sanitize arguments
-    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
-    
-    // Remove all of its pointers
-    memset(*ppCtx, 0x0, sizeof(gfmQuadtreeLL));
-    // Release the memory
-    free(*ppCtx);
-    *ppCtx = 0;
-    
-    rv = GFMRV_OK;
-__ret:
-    return rv;
-}
+    if (count == gfmQT_max && pCtx->freeNodes) {
+        /* Recycle the children of a collapsed node */
+        *pIndex = pCtx->freeNodes;
+        pCtx->freeNodes = pCtx->pNodes[pCtx->freeNodes].children;
+        return GFMRV_OK;
+    }
+    if (pCtx->nodesUsed + count > pCtx->nodesLen) {
+        gfmQuadtree *pTmp;
+        uint32_t len;
+
+        len = pCtx->nodesLen * 2;
+        if (len < pCtx->nodesUsed + count) {
+            len = pCtx->nodesUsed + count + 64;
+        }
+        pTmp = (gfmQuadtree*)realloc(pCtx->pNodes, sizeof(gfmQuadtree) * len);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+
+        pCtx->pNodes = pTmp;
+        pCtx->nodesLen = len;
+    }
+
+    *pIndex = pCtx->nodesUsed;
+    pCtx->nodesUsed += count;
 
-/**
- * Alloc a new quadtree structure
- * 
- * @param  ppCtx The quadtree
- * @return       GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
- */
-static gfmRV gfmQuadtreeNode_getNew(gfmQuadtree **ppCtx) {
-    gfmRV rv;
-    
-    // Sanitize arguments
-    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
-    ASSERT(!(*ppCtx), GFMRV_ARGUMENTS_BAD);
-    
-    // Alloc it
-    *ppCtx = (gfmQuadtree*)malloc(sizeof(gfmQuadtree));
-    ASSERT(*ppCtx, GFMRV_ALLOC_FAILED);
-    // Clean it
-    memset(*ppCtx, 0x0, sizeof(gfmQuadtree));
-    
     rv = GFMRV_OK;
 __ret:
     return rv;
 }
 
 /**
- * Frees a quadtree node
- * 
- * @param  ppCtx The quadtree node
- * @return       GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ * Retrieve a LL node, either recycling it or from the pool (which is expanded
+ * as necessary)
+ *
+ * @param  [out]pIndex Index of the retrieved LL node
+ * @param  [ in]pCtx   The layer
+ * @return             GFMRV_OK, GFMRV_ALLOC_FAILED
  */
-static gfmRV gfmQuadtreeNode_free(gfmQuadtree **ppCtx) {
+static gfmRV gfmQuadtree_getCell(uint32_t *pIndex, gfmQuadtreeLayer *pCtx) {
     gfmRV rv;
-    
-    // Sanitize arguments
-    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
-    
-    // Remove all of its pointers
-    memset(*ppCtx, 0x0, sizeof(gfmQuadtree));
-    // Release the memory
-    free(*ppCtx);
-    *ppCtx = 0;
-    
+
+    if (pCtx->available) {
+        /* Recycle a used node */
+        *pIndex = pCtx->available;
+        pCtx->available = pCtx->pCells[pCtx->available].next;
+    }
+    else {
+        if (pCtx->cellsUsed >= pCtx->cellsLen) {
+            gfmQuadtreeLL *pTmp;
+            uint32_t len;
+
+            len = pCtx->cellsLen * 2;
+            if (len < 256) {
+                len = 256;
+            }
+            pTmp = (gfmQuadtreeLL*)realloc(pCtx->pCells,
+                    sizeof(gfmQuadtreeLL) * len);
+            ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+
+            pCtx->pCells = pTmp;
+            pCtx->cellsLen = len;
+        }
+
+        *pIndex = pCtx->cellsUsed;
+        pCtx->cellsUsed++;
+    }
+
     rv = GFMRV_OK;
 __ret:
     return rv;
@@ -273,7 +534,6 @@ __ret:
  */
 static gfmRV gfmQuadtree_init(gfmQuadtree *pCtx, gfmQuadtree *pParent,
         gfmQuadtreePosition pos) {
-    gfmQuadtreePosition i;
     gfmRV rv;
     int offX;
     int offY;
@@ -285,13 +545,9 @@ static gfmRV gfmQuadtree_init(gfmQuadtree *pCtx, gfmQuadtree *pParent,
     ASSERT(pos < gfmQT_max, GFMRV_ARGUMENTS_BAD);
     
     // Clear all children
-    i = gfmQT_nw;
-    while (i < gfmQT_max) {
-        pCtx->ppChildren[i] = 0;
-        i++;
-    }
+    pCtx->children = 0;
     // Clear the node's objects
-    pCtx->pNodes = 0;
+    pCtx->nodes = 0;
     pCtx->numObjects = 0;
     // Set the node's depth
     pCtx->depth = pParent->depth + 1;
@@ -333,24 +589,24 @@ __ret:
  * Push a node into the stack, so it'll be checked later
  * 
  * @param  pCtx  The quadtree's root/ctx
- * @param  pNode The node to be pushed
+ * @param  node  Index of the node to be pushed
  * @return       GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED,
  *               GFMRV_QUADTREE_STACK_OVERFLOW
  */
-static gfmRV gfmQuadtree_pushNode(gfmQuadtreeRoot *pCtx, gfmQuadtree *pNode) {
+static gfmRV gfmQuadtree_pushNode(gfmQuadtreeRoot *pCtx, uint32_t node) {
     gfmRV rv;
     
     // Sanitize arguments
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
-    ASSERT(pNode, GFMRV_ARGUMENTS_BAD);
+    ASSERT(node < pCtx->pLayer->nodesUsed, GFMRV_ARGUMENTS_BAD);
     // Check if initialized
-    ASSERT(pCtx->maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+    ASSERT(pCtx->pLayer->maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
     // Check that pushed can still be done
     ASSERT(pCtx->stack.pushPos < pCtx->stack.len,
             GFMRV_QUADTREE_STACK_OVERFLOW);
     
     // Push the node
-    pCtx->stack.ppStack[pCtx->stack.pushPos] = pNode;
+    pCtx->stack.pStack[pCtx->stack.pushPos] = node;
     pCtx->stack.pushPos++;
     
     rv = GFMRV_OK;
@@ -361,67 +617,103 @@ __ret:
 /**
  * Pop a node from the quadtree's context
  * 
- * @param  ppNode The popped node
+ * @param  pNode  Index of the popped node
  * @param  pCtx   The quadtree's root/ctx
  * @return        GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED,
  *                GFMRV_QUADTREE_EMPTY
  */
-static gfmRV gfmQuadtree_popNode(gfmQuadtree **ppNode, gfmQuadtreeRoot *pCtx) {
+static gfmRV gfmQuadtree_popNode(uint32_t *pNode, gfmQuadtreeRoot *pCtx) {
     gfmRV rv;
     
     // Sanitize arguments
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
-    ASSERT(ppNode, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pNode, GFMRV_ARGUMENTS_BAD);
     // Check if initialized
-    ASSERT(pCtx->maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+    ASSERT(pCtx->pLayer->maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
     // Check if there are any nodes to be popped
     ASSERT(pCtx->stack.pushPos > 0, GFMRV_QUADTREE_EMPTY);
     
     // Pop the node
     pCtx->stack.pushPos--;
-    *ppNode = pCtx->stack.ppStack[pCtx->stack.pushPos];
+    *pNode = pCtx->stack.pStack[pCtx->stack.pushPos];
     
     rv = GFMRV_OK;
 __ret:
     return rv;
 }
 
+/**
+ * Retrieve an object's type, as used to index both the interaction masks and
+ * the colors on gfmQuadtree_drawBounds
+ *
+ * If the object is a sprite, its child's type is used instead; Objects (and
+ * sprites) without a custom type are set to gfmType_object (or
+ * gfmType_sprite)
+ *
+ * @param  [out]pType The type (only its lowest 5 bits)
+ * @param  [ in]pObj  The object
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+static gfmRV gfmQuadtree_getType(uint32_t *pType, gfmObject *pObj) {
+    void *pChild;
+    gfmRV rv;
+    int type;
+
+    rv = gfmObject_getChild(&pChild, &type, pObj);
+    ASSERT_NR(rv == GFMRV_OK);
+    if (type == gfmType_sprite) {
+        rv = gfmSprite_getChild(&pChild, &type, (gfmSprite*)pChild);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        if (type == gfmType_none) {
+            /* If no custom type was specified, set it to sprite */
+            type = gfmType_sprite;
+        }
+    }
+    else if (type == gfmType_none) {
+        /* If no custom type was specified, set it to object */
+        type = gfmType_object;
+    }
+
+    *pType = (uint32_t)type % gfmType_max;
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
 /**
  * Adds an object to a node
  * 
- * @param  pCtx  The quadtree root context
- * @param  pNode The node where insertion should happen
- * @param  pObj  The object to be added
+ * @param  pCtx  The layer
+ * @param  node  Index of the node where insertion should happen
+ * @param  pInfo The object to be added (and its type, order, etc)
  * @return       GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
  */
-static gfmRV gfmQuadtree_insertObject(gfmQuadtreeRoot *pCtx, gfmQuadtree *pNode,
-        gfmObject *pObj) {
-    gfmQuadtreeLL *pQTLL;
+static gfmRV gfmQuadtree_insertObject(gfmQuadtreeLayer *pCtx, uint32_t node,
+        gfmQuadtreeLL *pInfo) {
+    gfmQuadtreeLL info;
+    gfmQuadtree *pNode;
+    uint32_t cell;
     gfmRV rv;
     
     // Sanitize arguments
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
-    ASSERT(pNode, GFMRV_ARGUMENTS_BAD);
-    ASSERT(pObj, GFMRV_ARGUMENTS_BAD);
+    ASSERT(node < pCtx->nodesUsed, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pInfo, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pInfo->pSelf, GFMRV_ARGUMENTS_BAD);
     
+    // Copy the info, since it may be on the pool (that may be expanded)
+    info = *pInfo;
     // Retrieve a new linked-list node
-    if (pCtx->pAvailable) {
-        // Recycle a used node
-        pQTLL = pCtx->pAvailable;
-        pCtx->pAvailable = pCtx->pAvailable->pNext;
-    }
-    else {
-        // Retrieve a new node
-        gfmGenArr_getNextRef(gfmQuadtreeLL, pCtx->pQTLLPool, pCtx->maxNodes,
-                pQTLL, gfmQuadtreeLL_getNew);
-        gfmGenArr_push(pCtx->pQTLLPool);
-    }
+    rv = gfmQuadtree_getCell(&cell, pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
     
     // Add the object to the LL node
-    pQTLL->pSelf = pObj;
+    pNode = pCtx->pNodes + node;
+    pCtx->pCells[cell] = info;
     // Prepend the node to the list
-    pQTLL->pNext = pNode->pNodes;
-    pNode->pNodes = pQTLL;
+    pCtx->pCells[cell].next = pNode->nodes;
+    pNode->nodes = cell;
     // Increase the counter
     pNode->numObjects++;
     
@@ -431,102 +723,260 @@ __ret:
 }
 
 /**
- * Checks if a quadtree node overlaps an object
- * 
- * @param  pCtx The quadtree node
- * @param  pObj The gfmObject
- * @return      GFMRV_TRUE, GFMRV_FALSE, GFMRV_ARGUMENTS_BAD
+ * Retrieve the area used to insert an object into a layer
+ *
+ * @param  [out]pArea   The object's area
+ * @param  [ in]pObj    The gfmObject
+ * @param  [ in]isSwept Whether the area swept by the object since its last
+ *                      update should be used (instead of its current hitbox)
+ * @return              GFMRV_OK, GFMRV_ARGUMENTS_BAD
  */
-static gfmRV gfmQuadtree_overlap(gfmQuadtree *pCtx, gfmObject *pObj) {
+static gfmRV gfmQuadtree_getArea(gfmQuadtreeArea *pArea, gfmObject *pObj,
+        int isSwept) {
     gfmRV rv;
-    int cX, cY, dist, hWidth, hHeight, maxDist;
-    
+    int cX, cY, hWidth, hHeight;
+
     // Sanitize arguments
-    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pArea, GFMRV_ARGUMENTS_BAD);
     ASSERT(pObj, GFMRV_ARGUMENTS_BAD);
-    // Get the object's dimensions
-    rv = gfmObject_getCenter(&cX, &cY, pObj);
-    ASSERT_NR(rv == GFMRV_OK);
-    rv = gfmObject_getDimensions(&hWidth, &hHeight, pObj);
-    ASSERT_NR(rv == GFMRV_OK);
+    if (isSwept) {
+        int x, y;
+
+        /* Get the area swept by the object (and its center) */
+        rv = gfmObject_getSweptArea(&x, &y, &hWidth, &hHeight, pObj);
+        ASSERT_NR(rv == GFMRV_OK);
+        cX = x + hWidth / 2;
+        cY = y + hHeight / 2;
+    }
+    else {
+        // Get the object's dimensions
+        rv = gfmObject_getCenter(&cX, &cY, pObj);
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmObject_getDimensions(&hWidth, &hHeight, pObj);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+    pArea->centerX = cX;
+    pArea->centerY = cY;
     // Get half the dimensions (rounded up)
-    hWidth = hWidth / 2 + (hWidth % 2);
-    hHeight = hHeight / 2 + (hHeight % 2);
-    
+    pArea->halfWidth = hWidth / 2 + (hWidth % 2);
+    pArea->halfHeight = hHeight / 2 + (hHeight % 2);
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Checks if the area where a quadtree node's objects may be overlaps an area
+ *
+ * @param  pCtx  The quadtree node
+ * @param  pArea The area
+ * @return       GFMRV_TRUE, GFMRV_FALSE
+ */
+static gfmRV gfmQuadtree_overlapArea(gfmQuadtree *pCtx,
+        gfmQuadtreeArea *pArea) {
+    int dist;
+
     // Check that they are overlaping (horizontally)
-    dist = cX - pCtx->centerX;
+    dist = pArea->centerX - pCtx->centerX;
     if (dist < 0) {
         dist = -dist;
     }
-    maxDist = hWidth + pCtx->halfWidth;
-    if (dist > maxDist) {
+    if (dist > pArea->halfWidth + pCtx->looseHalfWidth) {
         return GFMRV_FALSE;
     }
-    //ASSERT(dist <= maxDist, GFMRV_FALSE);
-    
+
     // Check vertically...
-    dist = cY - pCtx->centerY;
+    dist = pArea->centerY - pCtx->centerY;
     if (dist < 0) {
         dist = -dist;
     }
-    maxDist = hHeight + pCtx->halfHeight;
-    if (dist > maxDist) {
+    if (dist > pArea->halfHeight + pCtx->looseHalfHeight) {
         return GFMRV_FALSE;
     }
-    //ASSERT(dist <= maxDist, GFMRV_FALSE);
-    
-    rv = GFMRV_TRUE;
+
+    return GFMRV_TRUE;
+}
+
+/**
+ * Checks if a quadtree node overlaps an object
+ * 
+ * @param  pCtx    The quadtree node
+ * @param  pObj    The gfmObject
+ * @param  isSwept Whether the area swept by the object since its last update
+ *                 should be used (instead of its current hitbox)
+ * @return         GFMRV_TRUE, GFMRV_FALSE, GFMRV_ARGUMENTS_BAD
+ */
+static gfmRV gfmQuadtree_overlap(gfmQuadtree *pCtx, gfmObject *pObj,
+        int isSwept) {
+    gfmQuadtreeArea area;
+    gfmRV rv;
+
+    // Sanitize arguments
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    rv = gfmQuadtree_getArea(&area, pObj, isSwept);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    rv = gfmQuadtree_overlapArea(pCtx, &area);
 __ret:
     return rv;
 }
 
+/**
+ * Retrieve the child of a node (on loose mode) that should contain an area,
+ * chosen by the area's center; The area fits the child only if it's completely
+ * inside the child's expanded bounds
+ *
+ * @param  [out]pChild Index of the child
+ * @param  [ in]pCtx   The layer
+ * @param  [ in]node   Index of the node (which must have children)
+ * @param  [ in]pArea  The area
+ * @return             GFMRV_TRUE, GFMRV_FALSE (if it doesn't fit the child)
+ */
+static gfmRV gfmQuadtree_getLooseChild(uint32_t *pChild,
+        gfmQuadtreeLayer *pCtx, uint32_t node, gfmQuadtreeArea *pArea) {
+    gfmQuadtree *pNode, *pChildNode;
+    int dist;
+
+    pNode = pCtx->pNodes + node;
+    *pChild = pNode->children;
+    if (pArea->centerX >= pNode->centerX) {
+        *pChild += gfmQT_ne;
+    }
+    if (pArea->centerY >= pNode->centerY) {
+        *pChild += gfmQT_sw;
+    }
+    pChildNode = pCtx->pNodes + *pChild;
+
+    dist = pArea->centerX - pChildNode->centerX;
+    if (dist < 0) {
+        dist = -dist;
+    }
+    if (dist + pArea->halfWidth > pChildNode->looseHalfWidth) {
+        return GFMRV_FALSE;
+    }
+    dist = pArea->centerY - pChildNode->centerY;
+    if (dist < 0) {
+        dist = -dist;
+    }
+    if (dist + pArea->halfHeight > pChildNode->looseHalfHeight) {
+        return GFMRV_FALSE;
+    }
+
+    return GFMRV_TRUE;
+}
+
 /**
  * Subdivides a quadtree
  * 
- * @param  pCtx The node to be subdivided
- * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ * @param  pRoot The quadtree's root
+ * @param  pCtx  The layer
+ * @param  node  Index of the node to be subdivided
+ * @return       GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
  */
-static gfmRV gfmQuadtree_subdivide(gfmQuadtreeRoot *pCtx, gfmQuadtree *pNode) {
-    gfmQuadtree *pChild;
+static gfmRV gfmQuadtree_subdivide(gfmQuadtreeRoot *pRoot,
+        gfmQuadtreeLayer *pCtx, uint32_t node) {
     gfmQuadtreePosition i;
+    uint32_t children;
+    int isTracked;
     gfmRV rv;
     
     // Sanitize arguments
+    ASSERT(pRoot, GFMRV_ARGUMENTS_BAD);
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
-    ASSERT(pNode, GFMRV_ARGUMENTS_BAD);
+    ASSERT(node < pCtx->nodesUsed, GFMRV_ARGUMENTS_BAD);
     
-    // Alloc and initialize all the children
+    // Alloc all the children (this may move the node!)
+    rv = gfmQuadtree_getNodes(&children, pCtx, gfmQT_max);
+    ASSERT_NR(rv == GFMRV_OK);
+    // Initialize all the children
     i = gfmQT_nw;
     while (i < gfmQT_max) {
-        gfmGenArr_getNextRef(gfmQuadtree, pCtx->pQTPool, 5, pChild,
-                gfmQuadtreeNode_getNew);
-        gfmGenArr_push(pCtx->pQTPool);
-        // Initialize the child
-        rv = gfmQuadtree_init(pChild, pNode, i);
+        gfmQuadtree *pChild;
+
+        pChild = pCtx->pNodes + children + i;
+        rv = gfmQuadtree_init(pChild, pCtx->pNodes + node, i);
         ASSERT_NR(rv == GFMRV_OK);
-        // Set the node's child
-        pNode->ppChildren[i] = pChild;
+        pChild->parent = node;
+        // Expand the area where its objects may be
+        if (pCtx->isLoose) {
+            pChild->looseHalfWidth = (int)(pChild->halfWidth *
+                    pCtx->looseness);
+            pChild->looseHalfHeight = (int)(pChild->halfHeight *
+                    pCtx->looseness);
+        }
+        else {
+            pChild->looseHalfWidth = pChild->halfWidth;
+            pChild->looseHalfHeight = pChild->halfHeight;
+        }
         // Go to the next one
         i++;
     }
+    // Set the node's children (moving all of its objects)
+    pCtx->pNodes[node].children = children;
+    pCtx->pNodes[node].numObjects = 0;
+
+    // On loose mode, only move the objects that fit into a child (the others
+    // are kept on this node)
+    if (pCtx->isLoose) {
+        uint32_t cell;
+
+        cell = pCtx->pNodes[node].nodes;
+        pCtx->pNodes[node].nodes = 0;
+        while (cell) {
+            gfmQuadtreeLL *pCell;
+            uint32_t dst;
+
+            pCell = pCtx->pCells + cell;
+            rv = gfmQuadtree_getLooseChild(&dst, pCtx, node, &(pCell->area));
+            if (rv != GFMRV_TRUE) {
+                dst = node;
+            }
+
+            // Move the cell (nothing is alloc'ed, so the pools are kept)
+            cell = pCell->next;
+            pCell->next = pCtx->pNodes[dst].nodes;
+            pCtx->pNodes[dst].nodes = (uint32_t)(pCell - pCtx->pCells);
+            pCtx->pNodes[dst].numObjects++;
+        }
+
+        rv = GFMRV_OK;
+        goto __ret;
+    }
     
+    // Tracked objects are kept on the leaves overlapped by their tracked
+    // area (which may differ from the one used to insert them)
+    isTracked = (pCtx == &(pRoot->dynamicLayer) && pRoot->isIncremental);
     // Insert every child to the tree it's contained
-    while (pNode->pNodes) {
-        gfmQuadtreeLL *pTmp;
+    while (pCtx->pNodes[node].nodes) {
+        gfmQuadtreeArea area;
+        uint32_t tmp;
         
-        // Get the current node
-        pTmp = pNode->pNodes;
+        // Get the current node (copying its area, since the pool may be
+        // expanded)
+        tmp = pCtx->pNodes[node].nodes;
+        if (isTracked) {
+            gfmQuadtreeDeferred *pTracked;
+
+            // The object will be moved to other leaves, so it must be
+            // traversed again the next time it moves
+            pTracked = pRoot->pDeferred + pCtx->pCells[tmp].seq;
+            pTracked->isValid = 0;
+            area = pTracked->area;
+        }
+        else {
+            area = pCtx->pCells[tmp].area;
+        }
         
         // Add it to every child (that it overlaps)
         i = gfmQT_nw;
         while (i < gfmQT_max) {
-            // Get the current child
-            pChild = pNode->ppChildren[i];
             // Check if the object collides this node
-            rv = gfmQuadtree_overlap(pChild, pTmp->pSelf);
+            rv = gfmQuadtree_overlapArea(pCtx->pNodes + children + i, &area);
             if (rv == GFMRV_TRUE) {
                 // Add it to the child
-                rv = gfmQuadtree_insertObject(pCtx, pChild, pTmp->pSelf);
+                rv = gfmQuadtree_insertObject(pCtx, children + i,
+                        pCtx->pCells + tmp);
                 ASSERT_NR(rv == GFMRV_OK);
             }
             
@@ -534,10 +984,10 @@ static gfmRV gfmQuadtree_subdivide(gfmQuadtreeRoot *pCtx, gfmQuadtree *pNode) {
         }
         
         // Go to the next node
-        pNode->pNodes = pTmp->pNext;
+        pCtx->pNodes[node].nodes = pCtx->pCells[tmp].next;
         // Prepend the node to the free list
-        pTmp->pNext = pCtx->pAvailable;
-        pCtx->pAvailable = pTmp;
+        pCtx->pCells[tmp].next = pCtx->available;
+        pCtx->available = tmp;
     }
     
     rv = GFMRV_OK;
@@ -545,362 +995,302 @@ __ret:
     return rv;
 }
 
-/******************************************************************************/
-/*                                                                            */
-/* Public functions                                                           */
-/*                                                                            */
-/******************************************************************************/
-
 /**
- * Alloc a new root quadtree
- * 
- * @param  ppCtx The root quadtree
- * @return       GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ * Initialize a layer, removing all of its nodes
+ *
+ * @param  [ in]pCtx     The layer
+ * @param  [ in]x        The layer's top-left position
+ * @param  [ in]y        The layer's top-left position
+ * @param  [ in]width    The layer's width
+ * @param  [ in]height   The layer's height
+ * @param  [ in]maxDepth How many levels can the layer branch
+ * @param  [ in]maxNodes How many objects a subtree can have until it must split
+ * @return               GFMRV_OK, GFMRV_ALLOC_FAILED
  */
-gfmRV gfmQuadtree_getNew(gfmQuadtreeRoot **ppCtx) {
+static gfmRV gfmQuadtree_initLayer(gfmQuadtreeLayer *pCtx, int x, int y,
+        int width, int height, int maxDepth, int maxNodes) {
+    gfmQuadtree *pRoot;
+    uint32_t root;
     gfmRV rv;
-    
-    // Sanitize arguments
-    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
-    ASSERT(!(*ppCtx), GFMRV_ARGUMENTS_BAD);
-    
-    // Alloc and clean it
-    *ppCtx = (gfmQuadtreeRoot*)malloc(sizeof(gfmQuadtreeRoot));
-    ASSERT(*ppCtx, GFMRV_ALLOC_FAILED);
-    memset(*ppCtx, 0x0, sizeof(gfmQuadtreeRoot));
-    
+
+    // Set the quadtree's limits
+    pCtx->maxNodes = maxNodes;
+    pCtx->maxDepth = maxDepth;
+    // Reset both pools (the first LL node is reserved as the list's end)
+    pCtx->nodesUsed = 0;
+    pCtx->cellsUsed = 1;
+    pCtx->available = 0;
+    pCtx->nextSeq = 0;
+    pCtx->freeNodes = 0;
+
+    // Retrieve the root from the qt pool
+    rv = gfmQuadtree_getNodes(&root, pCtx, 1);
+    ASSERT_NR(rv == GFMRV_OK);
+    // Initialize this node
+    pRoot = pCtx->pNodes + root;
+    pRoot->children = 0;
+    pRoot->nodes = 0;
+    pRoot->depth = 0;
+    pRoot->numObjects = 0;
+    pRoot->parent = 0;
+    pRoot->centerX = x + width / 2;
+    pRoot->centerY = y + height / 2;
+    // Round the dimension up
+    pRoot->halfWidth = width / 2 + (width % 2);
+    pRoot->halfHeight = height / 2 + (height % 2);
+    // The root is never expanded (objects outside it are simply ignored)
+    pRoot->looseHalfWidth = pRoot->halfWidth;
+    pRoot->looseHalfHeight = pRoot->halfHeight;
+
     rv = GFMRV_OK;
 __ret:
     return rv;
 }
 
 /**
- * Release a quadtree's root and all its members
- * 
- * @param  ppCtx The quadtree root
- * @return       GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ * Release all memory used by a layer
+ *
+ * @param  [ in]pCtx The layer
  */
-gfmRV gfmQuadtree_free(gfmQuadtreeRoot **ppCtx) {
-    gfmRV rv;
-    
-    // Sanitize arguments
-    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
-    ASSERT(*ppCtx, GFMRV_ARGUMENTS_BAD);
-    
-    // Clean the quadtree
-    gfmQuadtree_clean(*ppCtx);
-    // Free the struct
-    free(*ppCtx);
-    *ppCtx = 0;
-    
-    rv = GFMRV_OK;
-__ret:
-    return rv;
+static void gfmQuadtree_cleanLayer(gfmQuadtreeLayer *pCtx) {
+    if (pCtx->pNodes) {
+        free(pCtx->pNodes);
+    }
+    if (pCtx->pCells) {
+        free(pCtx->pCells);
+    }
+    memset(pCtx, 0x0, sizeof(gfmQuadtreeLayer));
 }
 
 /**
- * Clean all memory used by the entire quadtree
- * 
- * @param  pCtx The quadtree root
- * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ * Reset every counter kept for a single frame
+ *
+ * @param  [ in]pCtx The quadtree's root
  */
-gfmRV gfmQuadtree_clean(gfmQuadtreeRoot *pCtx) {
-    gfmRV rv;
-    
-    // Sanitize arguments
-    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
-    
-    // Clean all generic arrays
-    gfmGenArr_clean(pCtx->pQTPool, gfmQuadtreeNode_free);
-    gfmGenArr_clean(pCtx->pQTLLPool, gfmQuadtreeLL_free);
-    // Clean the stack, if any
-    if (pCtx->stack.ppStack) {
-        free(pCtx->stack.ppStack);
-    }
-    memset(pCtx, 0x0, sizeof(gfmQuadtreeRoot));
-    
-    rv = GFMRV_OK;
-__ret:
-    return rv;
+static void gfmQuadtree_resetCounters(gfmQuadtreeRoot *pCtx) {
+    pCtx->duplicates = 0;
+    pCtx->dynamicLayer.overlapTests = 0;
+    pCtx->dynamicLayer.pairs = 0;
+    pCtx->staticLayer.overlapTests = 0;
+    pCtx->staticLayer.pairs = 0;
 }
 
 /**
- * Clean up the previous state and ready the quadtree for collision
- * 
- * @param  pCtx     The quadtree root context
- * @param  x        The quadtree top-left position
- * @param  y        The quadtree top-left position
- * @param  width    The quadtree width
- * @param  height   The quadtree height
- * @param  maxDepth How many levels can the quadtree branch
- * @param  maxNodes How many objects a subtree can have until it must split
- * @return          GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ * Make sure the stack is big enough to traverse a layer
+ *
+ * @param  [ in]pCtx     The quadtree's root
+ * @param  [ in]maxDepth How many levels can the layer branch
+ * @return               GFMRV_OK, GFMRV_ALLOC_FAILED
  */
-gfmRV gfmQuadtree_initRoot(gfmQuadtreeRoot *pCtx, int x, int y, int width,
-        int height, int maxDepth, int maxNodes) {
-    gfmQuadtreePosition i;
+static gfmRV gfmQuadtree_expandStack(gfmQuadtreeRoot *pCtx, int maxDepth) {
     gfmRV rv;
-    
-    // Sanitize argument
-    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
-    ASSERT(width > 0, GFMRV_ARGUMENTS_BAD);
-    ASSERT(height > 0, GFMRV_ARGUMENTS_BAD);
-    ASSERT(maxDepth > 0, GFMRV_ARGUMENTS_BAD);
-    ASSERT(maxNodes > 0, GFMRV_ARGUMENTS_BAD);
-    
-    // Set the quadtree's limits
-    pCtx->maxNodes = maxNodes;
-    pCtx->maxDepth = maxDepth;
-    // Reset all array
-    gfmGenArr_reset(pCtx->pQTPool);
-    gfmGenArr_reset(pCtx->pQTLLPool);
-    // Clear all dynamic list
-    pCtx->pAvailable = 0;
-    pCtx->pColliding = 0;
-    // Remove context object's
-    pCtx->pObject = 0;
-    pCtx->pOther = 0;
-    pCtx->pGroupList = 0;
-    /* Remove the static flag */
-    pCtx->isStatic = 0;
-    
+
     // Check that the stack is big enough
     if (pCtx->stack.len < maxDepth * gfmQT_max) {
+        uint32_t *pTmp;
+
         // Expand the stack so it's big enough
-        pCtx->stack.ppStack = (gfmQuadtree**)realloc(pCtx->stack.ppStack,
-                sizeof(gfmQuadtree*) * maxDepth * gfmQT_max);
-        ASSERT(pCtx->stack.ppStack, GFMRV_ALLOC_FAILED);
+        pTmp = (uint32_t*)realloc(pCtx->stack.pStack,
+                sizeof(uint32_t) * maxDepth * gfmQT_max);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+        pCtx->stack.pStack = pTmp;
         // Set the stack's size
         pCtx->stack.len = maxDepth * gfmQT_max;
     }
     // Clear the stack
     pCtx->stack.pushPos = 0;
-    
-    // Retrieve the root from the qt pool
-    gfmGenArr_getNextRef(gfmQuadtree, pCtx->pQTPool, 5, pCtx->pSelf,
-            gfmQuadtreeNode_getNew);
-    gfmGenArr_push(pCtx->pQTPool);
-    // Initialize this node
-    i = gfmQT_nw;
-    while (i < gfmQT_max) {
-        pCtx->pSelf->ppChildren[i] = 0;
-        i++;
-    }
-    pCtx->pSelf->pNodes = 0;
-    pCtx->pSelf->depth = 0;
-    pCtx->pSelf->numObjects = 0;
-    pCtx->pSelf->centerX = x + width / 2;
-    pCtx->pSelf->centerY = y + height / 2;
-    // Round the dimension up
-    pCtx->pSelf->halfWidth = width / 2 + (width % 2);
-    pCtx->pSelf->halfHeight = height / 2 + (height % 2);
-    
+
     rv = GFMRV_OK;
 __ret:
     return rv;
 }
 
 /**
- * Make the quadtree static
+ * Check if a node of the dynamic layer overlaps a tracked object, restricting
+ * the range within which the object's center may move without changing the
+ * result
  *
- * @param  [ in]pCtx The quadtree's root
- * @return      GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_OK
+ * @param  [ in]pTracked The tracked object
+ * @param  [ in]pNode    The node
+ * @return               GFMRV_TRUE, GFMRV_FALSE
  */
-gfmRV gfmQuadtree_setStatic(gfmQuadtreeRoot *pCtx) {
-    gfmRV rv;
-
-    /* Sanitize arguments */
-    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
-    /* Check if initialized */
-    ASSERT(pCtx->maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+static gfmRV gfmQuadtree_restrictTracked(gfmQuadtreeDeferred *pTracked,
+        gfmQuadtree *pNode) {
+    gfmQuadtreeArea *pArea;
+    int minX, maxX, minY, maxY;
 
-    pCtx->isStatic = 1;
+    /* Range of centers that overlap the node */
+    pArea = &(pTracked->area);
+    minX = pNode->centerX - pNode->halfWidth - pArea->halfWidth;
+    maxX = pNode->centerX + pNode->halfWidth + pArea->halfWidth;
+    minY = pNode->centerY - pNode->halfHeight - pArea->halfHeight;
+    maxY = pNode->centerY + pNode->halfHeight + pArea->halfHeight;
 
-    rv = GFMRV_OK;
-__ret:
-    return rv;
-}
+    /* If it doesn't overlap, keep it away from the node on any axis */
+    if (pArea->centerX < minX) {
+        if (pTracked->maxX > minX - 1) {
+            pTracked->maxX = minX - 1;
+        }
+        return GFMRV_FALSE;
+    }
+    else if (pArea->centerX > maxX) {
+        if (pTracked->minX < maxX + 1) {
+            pTracked->minX = maxX + 1;
+        }
+        return GFMRV_FALSE;
+    }
+    else if (pArea->centerY < minY) {
+        if (pTracked->maxY > minY - 1) {
+            pTracked->maxY = minY - 1;
+        }
+        return GFMRV_FALSE;
+    }
+    else if (pArea->centerY > maxY) {
+        if (pTracked->minY < maxY + 1) {
+            pTracked->minY = maxY + 1;
+        }
+        return GFMRV_FALSE;
+    }
 
-/**
- * Adds a new gfmGroup to the quadtree, subdividing it as necessary and
- * colliding with every possible node
- * 
- * @param  pCtx The quadtree's root
- * @param  pGrp The gfmGroup
- * @return      GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED, 
- *              GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
- */
-gfmRV gfmQuadtree_collideGroup(gfmQuadtreeRoot *pCtx, gfmGroup *pGrp) {
-    gfmRV rv;
-    
-    // Sanitize arguments
-    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
-    ASSERT(pGrp, GFMRV_ARGUMENTS_BAD);
-    // Check if initialized
-    ASSERT(pCtx->maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
-    
-    // Get the list of collideable objects
-    rv = gfmGroup_getCollideableList(&(pCtx->pGroupList), pGrp);
-    ASSERT(rv == GFMRV_OK || rv == GFMRV_GROUP_LIST_EMPTY, rv);
-    
-    // Start the collision
-    if (rv == GFMRV_OK) {
-        // Clear the call stack
-        pCtx->stack.pushPos = 0;
-        // Clear any previous overlap
-        pCtx->pOther = 0;
-        
-        rv = gfmQuadtree_continue(pCtx);
+    /* Otherwise, keep it overlapping the node */
+    if (pTracked->minX < minX) {
+        pTracked->minX = minX;
     }
-    else {
-        rv = GFMRV_QUADTREE_DONE;
+    if (pTracked->maxX > maxX) {
+        pTracked->maxX = maxX;
     }
-__ret:
-    return rv;
+    if (pTracked->minY < minY) {
+        pTracked->minY = minY;
+    }
+    if (pTracked->maxY > maxY) {
+        pTracked->maxY = maxY;
+    }
+    return GFMRV_TRUE;
 }
 
 /**
- * Adds a new gfmObject to the quadtree, subdividing it as necessary and
- * colliding with every possible node
- * 
- * @param  pCtx The quadtree's root
- * @param  pObj The gfmObject
- * @return      GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED, 
- *              GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ * Insert an object into a single node of a loose layer: the deepest one (on the
+ * path chosen by the object's center) whose expanded bounds contain it; Leaves
+ * are subdivided as necessary
+ *
+ * @param  [ in]pCtx   The quadtree's root
+ * @param  [ in]pLayer The layer
+ * @param  [ in]pInfo  The object to be added (and its area, type, order, etc)
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
  */
-gfmRV gfmQuadtree_collideObject(gfmQuadtreeRoot *pCtx, gfmObject *pObj) {
+static gfmRV gfmQuadtree_insertLoose(gfmQuadtreeRoot *pCtx,
+        gfmQuadtreeLayer *pLayer, gfmQuadtreeLL *pInfo) {
+    uint32_t node;
     gfmRV rv;
-    
-    // Sanitize arguments
-    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
-    ASSERT(pObj, GFMRV_ARGUMENTS_BAD);
-    // Check if initialized
-    ASSERT(pCtx->maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
-    // Check if this node overlaps the root
-    rv = gfmQuadtree_overlap(pCtx->pSelf, pObj);
-    if (rv != GFMRV_TRUE) {
-        rv = GFMRV_QUADTREE_DONE;
-        goto __ret;
+
+    node = 0;
+    while (1) {
+        gfmQuadtree *pNode;
+        uint32_t child;
+
+        pNode = pLayer->pNodes + node;
+        if (!pNode->children) {
+            // Stop at the leaf, unless it must (and can) be subdivided
+            if (pNode->numObjects + 1 <= pLayer->maxNodes ||
+                    pNode->depth + 1 >= pLayer->maxDepth) {
+                break;
+            }
+            rv = gfmQuadtree_subdivide(pCtx, pLayer, node);
+            ASSERT_NR(rv == GFMRV_OK);
+        }
+
+        // Go down only if it fits into the child
+        rv = gfmQuadtree_getLooseChild(&child, pLayer, node, &(pInfo->area));
+        if (rv != GFMRV_TRUE) {
+            break;
+        }
+        node = child;
     }
-    //ASSERT(rv == GFMRV_TRUE, GFMRV_QUADTREE_DONE);
-    
-    // Store the object to be added
-    pCtx->pObject = pObj;
-    // Clear the call stack
-    pCtx->stack.pushPos = 0;
-    // Clear any previous overlap
-    pCtx->pOther = 0;
-    
-    // Push the root node to start colliding
-    rv = gfmQuadtree_pushNode(pCtx, pCtx->pSelf);
-    ASSERT_NR(rv == GFMRV_OK);
-    
-    // Collide it
-    rv = gfmQuadtree_continue(pCtx);
-__ret:
-    return rv;
-}
 
-/**
- * Adds a new gfmSprite to the quadtree, subdividing it as necessary and
- * colliding with every possible node
- * 
- * @param  pCtx The quadtree's root
- * @param  pObj The gfmObject
- * @return      GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED, 
- *              GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
- */
-gfmRV gfmQuadtree_collideSprite(gfmQuadtreeRoot *pCtx, gfmSprite *pSpr) {
-    gfmObject *pObj;
-    gfmRV rv;
-    
-    // Sanitize sprite (other checks are done in sub-functions)
-    ASSERT(pSpr, GFMRV_ARGUMENTS_BAD);
-    // Retrieve the sprite's object
-    rv = gfmSprite_getObject(&pObj, pSpr);
+    rv = gfmQuadtree_insertObject(pLayer, node, pInfo);
     ASSERT_NR(rv == GFMRV_OK);
-    // Add it to the quadtree
-    rv = gfmQuadtree_collideObject(pCtx, pObj);
+
+    rv = GFMRV_OK;
 __ret:
     return rv;
 }
 
 /**
- * Adds a new gfmTilemap to the quadtree, subdividing it as necessary and
- * colliding with every possible node
- * 
- * @param  pCtx  The quadtree's root
- * @param  pTMap The gfmTilemap
- * @return       GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED, 
- *               GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
- */
-gfmRV gfmQuadtree_collideTilemap(gfmQuadtreeRoot *pCtx, gfmTilemap *pTMap) {
-    return GFMRV_FUNCTION_NOT_IMPLEMENTED;
-}
-
-/**
- * Populates a quadtree with a group's objects
- * 
- * @param  pCtx The quadtree's root
- * @param  pGrp The tilemap
- * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED
- */
-gfmRV gfmQuadtree_populateGroup(gfmQuadtreeRoot *pCtx, gfmGroup *pGrp) {
-    // TODO Simply iterate through every object and add it
-    return GFMRV_FUNCTION_NOT_IMPLEMENTED;
-}
-
-/**
- * Add an object to the quadtree without collinding it against the tree's objs
- * 
- * @param  pCtx The quadtree's root
- * @param  pObj The gfmObject
- * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED
+ * Insert an object into every leaf of a layer that its area overlaps,
+ * subdividing them as necessary (or into a single node, on loose mode)
+ *
+ * @param  [ in]pCtx     The quadtree's root
+ * @param  [ in]pLayer   The layer
+ * @param  [ in]pInfo    The object to be added (and its area, type, order,
+ *                       etc)
+ * @param  [ in]pTracked The tracked object, whose range is restricted by every
+ *                       node tested (NULL if not on incremental mode)
+ * @return               GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED,
+ *                       GFMRV_QUADTREE_STACK_OVERFLOW,
+ *                       GFMRV_QUADTREE_INVALID_MODE
  */
-gfmRV gfmQuadtree_populateObject(gfmQuadtreeRoot *pCtx, gfmObject *pObj) {
+static gfmRV gfmQuadtree_insertLayer(gfmQuadtreeRoot *pCtx,
+        gfmQuadtreeLayer *pLayer, gfmQuadtreeLL *pInfo,
+        gfmQuadtreeDeferred *pTracked) {
     gfmRV rv;
-    
-    // Sanitize arguments
-    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
-    ASSERT(pObj, GFMRV_ARGUMENTS_BAD);
-    // Check if initialized
-    ASSERT(pCtx->maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
-    
+
     // Check that the object overlaps the root node
-    rv = gfmQuadtree_overlap(pCtx->pSelf, pObj);
+    if (pTracked) {
+        rv = gfmQuadtree_restrictTracked(pTracked, pLayer->pNodes);
+    }
+    else {
+        rv = gfmQuadtree_overlapArea(pLayer->pNodes, &(pInfo->area));
+    }
     ASSERT(rv == GFMRV_TRUE, GFMRV_OK);
+
+    if (pLayer->isLoose) {
+        // Tracked objects rely on the leaves they overlap
+        ASSERT(!pTracked, GFMRV_QUADTREE_INVALID_MODE);
+        rv = gfmQuadtree_insertLoose(pCtx, pLayer, pInfo);
+        goto __ret;
+    }
     
     // Clear the call stack
+    pCtx->pLayer = pLayer;
     pCtx->stack.pushPos = 0;
     // Clear any previous overlap
     pCtx->pOther = 0;
     
     // Push the root node to start overlaping
-    rv = gfmQuadtree_pushNode(pCtx, pCtx->pSelf);
+    rv = gfmQuadtree_pushNode(pCtx, 0);
     ASSERT_NR(rv == GFMRV_OK);
     
     // Continue adding the object
     while (pCtx->stack.pushPos > 0) {
         gfmQuadtree *pNode;
+        uint32_t node;
         
         // Pop the current node
-        rv = gfmQuadtree_popNode(&pNode, pCtx);
+        rv = gfmQuadtree_popNode(&node, pCtx);
         ASSERT_NR(rv == GFMRV_OK);
+        pNode = pLayer->pNodes + node;
 
         // If it has children, push its children
-        if (pNode->ppChildren[gfmQT_nw]) {
+        if (pNode->children) {
             gfmQuadtreePosition i;
-            gfmQuadtree *pChild;
+            uint32_t child;
 
             i = gfmQT_nw;
             while (i < gfmQT_max) {
                 // Get the current child
-                pChild = pNode->ppChildren[i];
+                child = pNode->children + i;
                 // Check if the object overlaps this node
-                rv = gfmQuadtree_overlap(pChild, pObj);
+                if (pTracked) {
+                    rv = gfmQuadtree_restrictTracked(pTracked,
+                            pLayer->pNodes + child);
+                }
+                else {
+                    rv = gfmQuadtree_overlapArea(pLayer->pNodes + child,
+                            &(pInfo->area));
+                }
                 if (rv == GFMRV_TRUE) {
                     // Push it (so it will collide later)
-                    rv = gfmQuadtree_pushNode(pCtx, pChild);
+                    rv = gfmQuadtree_pushNode(pCtx, child);
                     ASSERT_NR(rv == GFMRV_OK);
                 }
                 i++;
@@ -909,18 +1299,18 @@ gfmRV gfmQuadtree_populateObject(gfmQuadtreeRoot *pCtx, gfmObject *pObj) {
         else {
             // Check if adding the node will subdivide the tree and if it
             // can still be subdivided
-            if (pNode->numObjects + 1 > pCtx->maxNodes &&
-                    pNode->depth + 1 < pCtx->maxDepth) {
+            if (pNode->numObjects + 1 > pLayer->maxNodes &&
+                    pNode->depth + 1 < pLayer->maxDepth) {
                 // Subdivide the tree
-                rv = gfmQuadtree_subdivide(pCtx, pNode);
+                rv = gfmQuadtree_subdivide(pCtx, pLayer, node);
                 ASSERT_NR(rv == GFMRV_OK);
                 // Push the node again so its children are overlapped/pushed
-                rv = gfmQuadtree_pushNode(pCtx, pNode);
+                rv = gfmQuadtree_pushNode(pCtx, node);
                 ASSERT_NR(rv == GFMRV_OK);
             }
             else {
                 // Add the object to this node 
-                rv = gfmQuadtree_insertObject(pCtx, pNode, pObj);
+                rv = gfmQuadtree_insertObject(pLayer, node, pInfo);
                 ASSERT_NR(rv == GFMRV_OK);
             }
         }
@@ -932,50 +1322,3151 @@ __ret:
 }
 
 /**
- * Add a sprite to the quadtree without collinding it against the tree's objs
- * 
- * @param  pCtx The quadtree's root
- * @param  pSpr The gfmSprite
- * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED
+ * Add an object to a layer without colliding it
+ *
+ * @param  [ in]pCtx       The quadtree's root
+ * @param  [ in]pLayer     The layer
+ * @param  [ in]pObj       The gfmObject
+ * @param  [ in]isDeferred Whether the object should be collided by
+ *                         gfmQuadtree_collideDeferred
+ * @return                 GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED,
+ *                         GFMRV_QUADTREE_STACK_OVERFLOW,
+ *                         GFMRV_QUADTREE_INVALID_MODE
+ */
+static gfmRV gfmQuadtree_populateLayer(gfmQuadtreeRoot *pCtx,
+        gfmQuadtreeLayer *pLayer, gfmObject *pObj, int isDeferred) {
+    gfmQuadtreeLL info;
+    gfmRV rv;
+    
+    // Objects on the incremental layer must be tracked, instead
+    ASSERT(pLayer != &(pCtx->dynamicLayer) || !pCtx->isIncremental,
+            GFMRV_QUADTREE_INVALID_MODE);
+    // Check that the object overlaps the root node
+    rv = gfmQuadtree_getArea(&(info.area), pObj, pLayer->isSwept);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmQuadtree_overlapArea(pLayer->pNodes, &(info.area));
+    ASSERT(rv == GFMRV_TRUE, GFMRV_OK);
+    // Retrieve the object's type, so it may be ignored by some collisions
+    info.pSelf = pObj;
+    rv = gfmQuadtree_getType(&(info.type), pObj);
+    ASSERT_NR(rv == GFMRV_OK);
+    info.seq = pLayer->nextSeq;
+    pLayer->nextSeq++;
+    info.isDeferred = (uint32_t)isDeferred;
+    info.next = 0;
+    
+    rv = gfmQuadtree_insertLayer(pCtx, pLayer, &info, 0);
+__ret:
+    return rv;
+}
+
+/**
+ * Check if two objects overlap, either on their current position or (on
+ * continuous mode) at any moment since their last update
+ *
+ * @param  [out]pTime   When the objects first touched (always 0, if not on
+ *                      continuous mode)
+ * @param  [ in]pSelf   An object
+ * @param  [ in]pOther  An object
+ * @param  [ in]isSwept Whether the quadtree is on continuous mode
+ * @return              GFMRV_TRUE, GFMRV_FALSE, GFMRV_ARGUMENTS_BAD,
+ *                      GFMRV_OBJECT_NOT_INITIALIZED
+ */
+static gfmRV gfmQuadtree_isOverlaping(double *pTime, gfmObject *pSelf,
+        gfmObject *pOther, int isSwept) {
+    /* Sleeping objects can't wake each other up */
+    if (gfmObject_isAsleep(pSelf) == GFMRV_TRUE
+            && gfmObject_isAsleep(pOther) == GFMRV_TRUE) {
+        *pTime = 0.0;
+        return GFMRV_FALSE;
+    }
+    if (isSwept) {
+        return gfmObject_sweptOverlap(pTime, pSelf, pOther);
+    }
+    *pTime = 0.0;
+    return gfmObject_isOverlaping(pSelf, pOther);
+}
+
+/**
+ * Hash a pair of objects
+ *
+ * @param  [ in]pA The pair's object with the lowest address
+ * @param  [ in]pB The pair's object with the highest address
+ * @return         The pair's hash
+ */
+static unsigned int gfmQuadtree_hashPair(gfmObject *pA, gfmObject *pB) {
+    uint64_t key;
+
+    key = (uint64_t)(uintptr_t)pA * 0x9e3779b97f4a7c15ull;
+    key ^= (uint64_t)(uintptr_t)pB;
+    key ^= key >> 29;
+    key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 32;
+
+    return (unsigned int)key;
+}
+
+/**
+ * Expand the hash set of reported pairs, re-inserting every pair from the
+ * current frame
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @return           GFMRV_OK, GFMRV_ALLOC_FAILED
+ */
+static gfmRV gfmQuadtree_expandReported(gfmQuadtreeRoot *pCtx) {
+    gfmQuadtreeReported *pOld, *pNew;
+    gfmRV rv;
+    int i, len, mask;
+
+    len = pCtx->reportedLen * 2;
+    if (len == 0) {
+        len = 256;
+    }
+    mask = len - 1;
+
+    pNew = (gfmQuadtreeReported*)calloc(len, sizeof(gfmQuadtreeReported));
+    ASSERT(pNew, GFMRV_ALLOC_FAILED);
+
+    /* Move every valid entry to the new set */
+    pOld = pCtx->pReported;
+    i = 0;
+    while (i < pCtx->reportedLen) {
+        if (pOld[i].epoch == pCtx->epoch) {
+            unsigned int pos;
+
+            pos = gfmQuadtree_hashPair(pOld[i].pA, pOld[i].pB) & mask;
+            while (pNew[pos].epoch == pCtx->epoch) {
+                pos = (pos + 1) & mask;
+            }
+            pNew[pos] = pOld[i];
+        }
+        i++;
+    }
+
+    free(pOld);
+    pCtx->pReported = pNew;
+    pCtx->reportedLen = len;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Mark a pair of objects as reported on the current frame
+ *
+ * @param  [ in]pCtx   The quadtree's root
+ * @param  [ in]pSelf  One of the objects
+ * @param  [ in]pOther The other object
+ * @return             GFMRV_TRUE (the pair is new), GFMRV_FALSE (the pair was
+ *                     already reported), GFMRV_ALLOC_FAILED
+ */
+static gfmRV gfmQuadtree_markPair(gfmQuadtreeRoot *pCtx, gfmObject *pSelf,
+        gfmObject *pOther) {
+    gfmQuadtreeReported *pEntry;
+    gfmObject *pA, *pB;
+    gfmRV rv;
+    unsigned int pos, mask;
+
+    /* Keep the set's load at most at 50% */
+    if ((pCtx->reportedCount + 1) * 2 > pCtx->reportedLen) {
+        rv = gfmQuadtree_expandReported(pCtx);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+
+    /* Sort the pair so it's unordered */
+    if ((uintptr_t)pSelf < (uintptr_t)pOther) {
+        pA = pSelf;
+        pB = pOther;
+    }
+    else {
+        pA = pOther;
+        pB = pSelf;
+    }
+
+    mask = pCtx->reportedLen - 1;
+    pos = gfmQuadtree_hashPair(pA, pB) & mask;
+    pEntry = pCtx->pReported + pos;
+    while (pEntry->epoch == pCtx->epoch) {
+        if (pEntry->pA == pA && pEntry->pB == pB) {
+            pCtx->duplicates++;
+            return GFMRV_FALSE;
+        }
+        pos = (pos + 1) & mask;
+        pEntry = pCtx->pReported + pos;
+    }
+
+    pEntry->pA = pA;
+    pEntry->pB = pB;
+    pEntry->epoch = pCtx->epoch;
+    pCtx->reportedCount++;
+
+    rv = GFMRV_TRUE;
+__ret:
+    return rv;
+}
+
+/**
+ * Setup the quadtree to start colliding an object
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @param  [ in]pObj The object to be collided
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_QUADTREE_STACK_OVERFLOW, GFMRV_QUADTREE_DONE (if
+ *                   the object is outside the quadtree)
+ */
+static gfmRV gfmQuadtree_startObject(gfmQuadtreeRoot *pCtx, gfmObject *pObj) {
+    gfmRV rv;
+
+    /* Objects on the incremental layer must be tracked, instead */
+    ASSERT(!pCtx->isIncremental, GFMRV_QUADTREE_INVALID_MODE);
+
+    /* Check which layer should be traversed first (the static layer, if any,
+     * is always collided before the dynamic one); Sleeping objects skip the
+     * static layer, since nothing there could wake them up */
+    pCtx->pLayer = 0;
+    if (pCtx->staticLayer.maxDepth > 0
+            && gfmObject_isAsleep(pObj) != GFMRV_TRUE) {
+        rv = gfmQuadtree_getArea(&(pCtx->curArea), pObj,
+                pCtx->staticLayer.isSwept);
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmQuadtree_overlapArea(pCtx->staticLayer.pNodes,
+                &(pCtx->curArea));
+        if (rv == GFMRV_TRUE) {
+            pCtx->pLayer = &(pCtx->staticLayer);
+        }
+    }
+    if (!pCtx->pLayer) {
+        rv = gfmQuadtree_getArea(&(pCtx->curArea), pObj,
+                pCtx->dynamicLayer.isSwept);
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmQuadtree_overlapArea(pCtx->dynamicLayer.pNodes,
+                &(pCtx->curArea));
+        if (rv == GFMRV_TRUE) {
+            pCtx->pLayer = &(pCtx->dynamicLayer);
+        }
+    }
+    /* Check if this object overlaps the root of either layer */
+    if (!pCtx->pLayer) {
+        rv = GFMRV_QUADTREE_DONE;
+        goto __ret;
+    }
+
+    /* Store the object to be added (and its type) */
+    pCtx->pObject = pObj;
+    rv = gfmQuadtree_getType(&(pCtx->curType), pObj);
+    ASSERT_NR(rv == GFMRV_OK);
+    pCtx->curSeq = pCtx->dynamicLayer.nextSeq;
+    pCtx->dynamicLayer.nextSeq++;
+    /* Clear the call stack and any previous overlap */
+    pCtx->stack.pushPos = 0;
+    pCtx->colliding = 0;
+    pCtx->pOther = 0;
+
+    /* Push the root node to start colliding */
+    rv = gfmQuadtree_pushNode(pCtx, 0);
+__ret:
+    return rv;
+}
+
+/**
+ * Move the current object from the static layer to the dynamic one, after it
+ * was completely collided against the first
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @return           GFMRV_TRUE (the object must still be collided),
+ *                   GFMRV_FALSE, GFMRV_QUADTREE_STACK_OVERFLOW
+ */
+static gfmRV gfmQuadtree_nextLayer(gfmQuadtreeRoot *pCtx) {
+    gfmRV rv;
+
+    if (pCtx->pLayer != &(pCtx->staticLayer)) {
+        return GFMRV_FALSE;
+    }
+
+    pCtx->pLayer = &(pCtx->dynamicLayer);
+    rv = gfmQuadtree_getArea(&(pCtx->curArea), pCtx->pObject,
+            pCtx->pLayer->isSwept);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmQuadtree_overlapArea(pCtx->pLayer->pNodes, &(pCtx->curArea));
+    if (rv != GFMRV_TRUE) {
+        return GFMRV_FALSE;
+    }
+
+    rv = gfmQuadtree_pushNode(pCtx, 0);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    rv = GFMRV_TRUE;
+__ret:
+    return rv;
+}
+
+/**
+ * Collide the current object until it either overlaps another one or is
+ * completely added to the quadtree
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @return           GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE, ...
+ */
+static gfmRV gfmQuadtree_collideCurrent(gfmQuadtreeRoot *pCtx) {
+    gfmQuadtreeLayer *pLayer;
+    gfmQuadtreeLL info;
+    gfmRV rv;
+
+    // Continue adding the object (moving to the next layer as necessary)
+    while (1) {
+        gfmQuadtree *pNode;
+        uint32_t node;
+
+        if (pCtx->stack.pushPos == 0 && !pCtx->colliding) {
+            rv = gfmQuadtree_nextLayer(pCtx);
+            ASSERT(rv == GFMRV_TRUE || rv == GFMRV_FALSE, rv);
+            if (rv == GFMRV_FALSE) {
+                break;
+            }
+        }
+
+        pLayer = pCtx->pLayer;
+
+        // If we were colliding againts objects
+        if (pCtx->colliding) {
+            gfmQuadtreeLL *pTmp;
+
+            // Retrieve the current object and update the list
+            pTmp = pLayer->pCells + pCtx->colliding;
+            pCtx->colliding = pTmp->next;
+
+            // Skip the pair if their types don't interact
+            if (pCtx->ignored[pCtx->curType] & (1u << pTmp->type)) {
+                continue;
+            }
+
+            // Check if both objects overlaps
+            pCtx->pOther = pTmp->pSelf;
+            pLayer->overlapTests++;
+            rv = gfmQuadtree_isOverlaping(&(pCtx->time), pCtx->pObject,
+                    pCtx->pOther, pLayer->isSwept);
+
+            // Ignore the pair if it was already reported on another leaf
+            // (which never happens on loose mode)
+            if (rv == GFMRV_TRUE && !pLayer->isLoose) {
+                rv = gfmQuadtree_markPair(pCtx, pCtx->pObject, pCtx->pOther);
+                ASSERT(rv == GFMRV_TRUE || rv == GFMRV_FALSE, rv);
+            }
+
+            // -- Exit point --
+            // If they did overlap, return with that status
+            if (rv == GFMRV_TRUE) {
+                pLayer->pairs++;
+                return GFMRV_QUADTREE_OVERLAPED;
+            }
+            //ASSERT(rv != GFMRV_TRUE, GFMRV_QUADTREE_OVERLAPED);
+        }
+        else {
+            // Pop the current node
+            rv = gfmQuadtree_popNode(&node, pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+            pNode = pLayer->pNodes + node;
+
+            // If it has children, push its children
+            if (pNode->children) {
+                gfmQuadtreePosition i;
+                uint32_t child;
+
+                i = gfmQT_nw;
+                while (i < gfmQT_max) {
+                    // Get the current child
+                    child = pNode->children + i;
+                    // Check if the object overlaps this node
+                    rv = gfmQuadtree_overlapArea(pLayer->pNodes + child,
+                            &(pCtx->curArea));
+                    if (rv == GFMRV_TRUE) {
+                        // Push it (so it will collide later)
+                        rv = gfmQuadtree_pushNode(pCtx, child);
+                        ASSERT_NR(rv == GFMRV_OK);
+                    }
+                    i++;
+                }
+            }
+
+            // On loose mode, any node may have objects (and the current one
+            // is only inserted after every node was traversed)
+            if (pLayer->isLoose) {
+                pCtx->colliding = pNode->nodes;
+                pCtx->curNode = node;
+            }
+            else if (!pNode->children) {
+                // If it's static (or this is the static layer), collide
+                // against the node's children
+                if (pCtx->isStatic || pLayer == &(pCtx->staticLayer)) {
+                    pCtx->colliding = pNode->nodes;
+                    pCtx->curNode = node;
+                }
+                // Otherwise, check if inserting the node would subdivide
+                // the node (and if there's still room for that
+                else if (pNode->numObjects + 1 > pLayer->maxNodes &&
+                        pNode->depth + 1 < pLayer->maxDepth) {
+                    // Subdivide the tree
+                    rv = gfmQuadtree_subdivide(pCtx, pLayer, node);
+                    ASSERT_NR(rv == GFMRV_OK);
+                    // Push the node again so its children are overlapped/pushed
+                    rv = gfmQuadtree_pushNode(pCtx, node);
+                    ASSERT_NR(rv == GFMRV_OK);
+                }
+                else {
+                    // Otherwise, collide with its nodes
+                    pCtx->colliding = pNode->nodes;
+                    pCtx->curNode = node;
+                    // Add the object to this node
+                    // NOTE: It's added to the begin, so it won't overlap itself
+                    info.pSelf = pCtx->pObject;
+                    info.type = pCtx->curType;
+                    info.seq = pCtx->curSeq;
+                    info.isDeferred = 0;
+                    info.area = pCtx->curArea;
+                    rv = gfmQuadtree_insertObject(pLayer, node, &info);
+                    ASSERT_NR(rv == GFMRV_OK);
+                }
+            }
+        }
+    }
+
+    // Add the object to the loose layer (if it's inside it)
+    pLayer = &(pCtx->dynamicLayer);
+    if (pLayer->isLoose && !pCtx->isStatic && pCtx->pLayer == pLayer &&
+            gfmQuadtree_overlapArea(pLayer->pNodes, &(pCtx->curArea)) ==
+            GFMRV_TRUE) {
+        info.pSelf = pCtx->pObject;
+        info.type = pCtx->curType;
+        info.seq = pCtx->curSeq;
+        info.isDeferred = 0;
+        info.area = pCtx->curArea;
+        rv = gfmQuadtree_insertLoose(pCtx, pLayer, &info);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+
+    rv = GFMRV_QUADTREE_DONE;
+__ret:
+    return rv;
+}
+
+/**
+ * Collide every pending object (i.e., the current one and whatever is left on
+ * the group's list) until an overlap happens or there's nothing else to be
+ * done
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @return           GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE, ...
+ */
+static gfmRV gfmQuadtree_run(gfmQuadtreeRoot *pCtx) {
+    gfmRV rv;
+
+    do {
+        if (pCtx->pObject) {
+            rv = gfmQuadtree_collideCurrent(pCtx);
+            if (rv != GFMRV_QUADTREE_DONE) {
+                /* Either an overlap or an error */
+                goto __ret;
+            }
+            pCtx->pObject = 0;
+        }
+
+        /* Retrieve the next object from the group, skipping those outside the
+         * quadtree */
+        while (pCtx->pGroupList && !pCtx->pObject) {
+            gfmSprite *pSpr;
+            gfmObject *pObj;
+
+            rv = gfmGroup_getNextSprite(&pSpr, &(pCtx->pGroupList));
+            ASSERT(rv == GFMRV_OK, rv);
+            rv = gfmSprite_getObject(&pObj, pSpr);
+            ASSERT_NR(rv == GFMRV_OK);
+
+            rv = gfmQuadtree_startObject(pCtx, pObj);
+            ASSERT(rv == GFMRV_OK || rv == GFMRV_QUADTREE_DONE, rv);
+        }
+    } while (pCtx->pObject);
+
+    rv = GFMRV_QUADTREE_DONE;
+__ret:
+    return rv;
+}
+
+/**
+ * Store an overlap found by gfmQuadtree_collideDeferred on a worker's buffer
+ *
+ * @param  [ in]pWorker  The worker
+ * @param  [ in]pSelf    The deferred object
+ * @param  [ in]pOther   The object it overlaped
+ * @param  [ in]selfSeq  Order in which pSelf was added
+ * @param  [ in]otherSeq Order in which pOther was added
+ * @param  [ in]node     Leaf where the overlap was found
+ * @param  [ in]isStatic Whether pOther is on the static layer
+ * @param  [ in]time     When the objects first touched
+ * @return               GFMRV_OK, GFMRV_ALLOC_FAILED
+ */
+static gfmRV gfmQuadtree_pushDeferredPair(gfmQuadtreeWorker *pWorker,
+        gfmObject *pSelf, gfmObject *pOther, uint32_t selfSeq,
+        uint32_t otherSeq, uint32_t node, int isStatic, double time) {
+    gfmQuadtreeSortedPair *pPair;
+    gfmRV rv;
+
+    /* Expand the buffer as necessary */
+    if (pWorker->used >= pWorker->len) {
+        gfmQuadtreeSortedPair *pTmp;
+        int len;
+
+        len = pWorker->len * 2;
+        if (len < gfmQT_deferredPerTask) {
+            len = gfmQT_deferredPerTask;
+        }
+        pTmp = (gfmQuadtreeSortedPair*)realloc(pWorker->pPairs,
+                sizeof(gfmQuadtreeSortedPair) * len);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+        pWorker->pPairs = pTmp;
+        pWorker->len = len;
+    }
+
+    pPair = pWorker->pPairs + pWorker->used;
+    pPair->pair.pSelf = pSelf;
+    pPair->pair.pOther = pOther;
+    pPair->pair.node = (int)node;
+    pPair->pair.isStatic = isStatic;
+    pPair->pair.time = time;
+    pPair->selfSeq = selfSeq;
+    pPair->otherSeq = otherSeq;
+    pWorker->used++;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Collide every pair of objects on a leaf of the dynamic layer, as
+ * gfmQuadtree_collideDeferredLeaf, but testing each object against a packed
+ * copy of the leaf (so many objects are tested at once); Since time of impact
+ * isn't calculated, it must not be used on continuous mode
+ *
+ * @param  [ in]pCtx    The quadtree's root
+ * @param  [ in]pWorker The worker running the task
+ * @param  [ in]node    The leaf
+ * @return              GFMRV_OK, GFMRV_ALLOC_FAILED
+ */
+static gfmRV gfmQuadtree_collidePackedLeaf(gfmQuadtreeRoot *pCtx,
+        gfmQuadtreeWorker *pWorker, uint32_t node) {
+    gfmPackedHitboxes *pPacked;
+    gfmQuadtreeLayer *pLayer;
+    uint32_t i;
+    int k;
+    gfmRV rv;
+
+    pLayer = &(pCtx->dynamicLayer);
+    pPacked = &(pWorker->packed);
+
+    gfmPackedHitboxes_reset(pPacked);
+    i = pLayer->pNodes[node].nodes;
+    while (i) {
+        rv = gfmPackedHitboxes_push(pPacked,
+                (gfmHitbox*)pLayer->pCells[i].pSelf, (int)i);
+        ASSERT_NR(rv == GFMRV_OK);
+        i = pLayer->pCells[i].next;
+    }
+
+    k = 0;
+    while (k < pPacked->used - 1) {
+        gfmQuadtreeLL *pSelf;
+        int j, numHits;
+
+        pWorker->dynamicTests += pPacked->used - 1 - k;
+        numHits = gfmPackedHitboxes_overlap(pPacked, pPacked->pCenterX[k],
+                pPacked->pCenterY[k], pPacked->pHalfWidth[k],
+                pPacked->pHalfHeight[k], k + 1);
+
+        pSelf = pLayer->pCells + pPacked->pIds[k];
+        j = 0;
+        while (j < numHits) {
+            gfmQuadtreeLL *pA, *pB;
+
+            /* Same filter as gfmQuadtree_collideDeferredLeaf, but applied
+             * only to the pairs that actually overlap */
+            pA = pSelf;
+            pB = pLayer->pCells + pPacked->pIds[pPacked->pHits[j]];
+            j++;
+            if (pA->seq < pB->seq) {
+                pA = pB;
+                pB = pSelf;
+            }
+            if (!pA->isDeferred ||
+                    (pCtx->ignored[pA->type] & (1u << pB->type))) {
+                continue;
+            }
+            /* Same as gfmQuadtree_isOverlaping, skip sleeping pairs */
+            if (gfmObject_isAsleep(pA->pSelf) == GFMRV_TRUE &&
+                    gfmObject_isAsleep(pB->pSelf) == GFMRV_TRUE) {
+                continue;
+            }
+
+            rv = gfmQuadtree_pushDeferredPair(pWorker, pA->pSelf, pB->pSelf,
+                    pA->seq, pB->seq, node, 0, 0.0);
+            ASSERT_NR(rv == GFMRV_OK);
+        }
+        k++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Collide every pair of objects on a leaf of the dynamic layer, as long as the
+ * latter one was deferred
+ *
+ * @param  [ in]pCtx    The quadtree's root
+ * @param  [ in]pWorker The worker running the task
+ * @param  [ in]node    The leaf
+ * @return              GFMRV_OK, GFMRV_ALLOC_FAILED, ...
+ */
+static gfmRV gfmQuadtree_collideDeferredLeaf(gfmQuadtreeRoot *pCtx,
+        gfmQuadtreeWorker *pWorker, uint32_t node) {
+    gfmQuadtreeLayer *pLayer;
+    double time;
+    uint32_t i;
+    gfmRV rv;
+
+    pLayer = &(pCtx->dynamicLayer);
+    if (!pLayer->isSwept) {
+        rv = gfmQuadtree_collidePackedLeaf(pCtx, pWorker, node);
+        goto __ret;
+    }
+
+    i = pLayer->pNodes[node].nodes;
+    while (i) {
+        gfmQuadtreeLL *pSelf;
+        uint32_t j;
+
+        pSelf = pLayer->pCells + i;
+        j = pSelf->next;
+        while (j) {
+            gfmQuadtreeLL *pA, *pB;
+
+            /* Report the pair from the point of view of the latter object
+             * (as gfmQuadtree_collide* would), skipping the ones where it
+             * wasn't deferred (since those were already collided) */
+            pA = pSelf;
+            pB = pLayer->pCells + j;
+            j = pB->next;
+            if (pA->seq < pB->seq) {
+                pA = pB;
+                pB = pSelf;
+            }
+            if (!pA->isDeferred ||
+                    (pCtx->ignored[pA->type] & (1u << pB->type))) {
+                continue;
+            }
+
+            pWorker->dynamicTests++;
+            rv = gfmQuadtree_isOverlaping(&time, pA->pSelf, pB->pSelf,
+                    pLayer->isSwept);
+            ASSERT(rv == GFMRV_TRUE || rv == GFMRV_FALSE, rv);
+            if (rv == GFMRV_TRUE) {
+                rv = gfmQuadtree_pushDeferredPair(pWorker, pA->pSelf,
+                        pB->pSelf, pA->seq, pB->seq, node, 0, time);
+                ASSERT_NR(rv == GFMRV_OK);
+            }
+        }
+        i = pSelf->next;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Collide a deferred object against the static layer (or against the objects
+ * added before it to the dynamic layer, on loose mode)
+ *
+ * @param  [ in]pCtx      The quadtree's root
+ * @param  [ in]pWorker   The worker running the task
+ * @param  [ in]pDeferred The deferred object
+ * @param  [ in]pLayer    The layer
+ * @return                GFMRV_OK, GFMRV_ALLOC_FAILED,
+ *                        GFMRV_QUADTREE_STACK_OVERFLOW, ...
+ */
+static gfmRV gfmQuadtree_collideDeferredLayer(gfmQuadtreeRoot *pCtx,
+        gfmQuadtreeWorker *pWorker, gfmQuadtreeDeferred *pDeferred,
+        gfmQuadtreeLayer *pLayer) {
+    gfmQuadtreeArea area;
+    gfmHitbox *pHitbox;
+    double time;
+    int cx, cy, hw, hh, isAsleep, isStatic, pushPos;
+    gfmRV rv;
+
+    isStatic = (pLayer == &(pCtx->staticLayer));
+    isAsleep = (gfmObject_isAsleep(pDeferred->pSelf) == GFMRV_TRUE);
+    /* Nothing on the static layer could wake up a sleeping object */
+    if (isStatic && isAsleep) {
+        return GFMRV_OK;
+    }
+    rv = gfmQuadtree_getArea(&area, pDeferred->pSelf, pLayer->isSwept);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmQuadtree_overlapArea(pLayer->pNodes, &area);
+    ASSERT(rv == GFMRV_TRUE, GFMRV_OK);
+
+    /* Hitbox tested against the packed copy of each node */
+    pHitbox = (gfmHitbox*)pDeferred->pSelf;
+    cx = pHitbox->x + pHitbox->hw;
+    cy = pHitbox->y + pHitbox->hh;
+    hw = pHitbox->hw;
+    hh = pHitbox->hh;
+
+    /* Traverse the layer using the worker's own stack */
+    pWorker->pStack[0] = 0;
+    pushPos = 1;
+    while (pushPos > 0) {
+        gfmQuadtree *pNode;
+        uint32_t node;
+
+        pushPos--;
+        node = pWorker->pStack[pushPos];
+        pNode = pLayer->pNodes + node;
+
+        if (pNode->children) {
+            gfmQuadtreePosition i;
+
+            i = gfmQT_nw;
+            while (i < gfmQT_max) {
+                uint32_t child;
+
+                child = pNode->children + i;
+                rv = gfmQuadtree_overlapArea(pLayer->pNodes + child, &area);
+                if (rv == GFMRV_TRUE) {
+                    ASSERT(pushPos < pWorker->stackLen,
+                            GFMRV_QUADTREE_STACK_OVERFLOW);
+                    pWorker->pStack[pushPos] = child;
+                    pushPos++;
+                }
+                i++;
+            }
+        }
+        /* Only leaves have objects, unless on loose mode */
+        if (!pNode->children || pLayer->isLoose) {
+            uint32_t cell;
+
+            gfmPackedHitboxes_reset(&(pWorker->packed));
+            cell = pNode->nodes;
+            while (cell) {
+                gfmQuadtreeLL *pOther;
+
+                pOther = pLayer->pCells + cell;
+                cell = pOther->next;
+                /* Pairs are reported by the latter object (the former
+                 * either wasn't deferred or also reports it) */
+                if (!isStatic && pOther->seq >= pDeferred->seq) {
+                    continue;
+                }
+                if (pCtx->ignored[pDeferred->type] & (1u << pOther->type)) {
+                    continue;
+                }
+                /* Two sleeping objects never collide (this must be checked
+                 * here, as the packed test doesn't) */
+                if (isAsleep &&
+                        gfmObject_isAsleep(pOther->pSelf) == GFMRV_TRUE) {
+                    continue;
+                }
+
+                if (isStatic) {
+                    pWorker->staticTests++;
+                }
+                else {
+                    pWorker->dynamicTests++;
+                }
+                /* Unless on continuous mode, test every object at once
+                 * after the list was traversed */
+                if (!pLayer->isSwept) {
+                    rv = gfmPackedHitboxes_push(&(pWorker->packed),
+                            (gfmHitbox*)pOther->pSelf,
+                            (int)(pOther - pLayer->pCells));
+                    ASSERT_NR(rv == GFMRV_OK);
+                    continue;
+                }
+                rv = gfmQuadtree_isOverlaping(&time, pDeferred->pSelf,
+                        pOther->pSelf, pLayer->isSwept);
+                ASSERT(rv == GFMRV_TRUE || rv == GFMRV_FALSE, rv);
+                if (rv == GFMRV_TRUE) {
+                    rv = gfmQuadtree_pushDeferredPair(pWorker,
+                            pDeferred->pSelf, pOther->pSelf, pDeferred->seq,
+                            pOther->seq, node, isStatic, time);
+                    ASSERT_NR(rv == GFMRV_OK);
+                }
+            }
+            if (pWorker->packed.used > 0) {
+                gfmPackedHitboxes *pPacked;
+                int j, numHits;
+
+                pPacked = &(pWorker->packed);
+                numHits = gfmPackedHitboxes_overlap(pPacked, cx, cy, hw, hh,
+                        0);
+                j = 0;
+                while (j < numHits) {
+                    gfmQuadtreeLL *pOther;
+
+                    pOther = pLayer->pCells
+                            + pPacked->pIds[pPacked->pHits[j]];
+                    rv = gfmQuadtree_pushDeferredPair(pWorker,
+                            pDeferred->pSelf, pOther->pSelf, pDeferred->seq,
+                            pOther->seq, node, isStatic, 0.0);
+                    ASSERT_NR(rv == GFMRV_OK);
+                    j++;
+                }
+            }
+        }
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Run a single task of gfmQuadtree_collideDeferred; The first tasks collide
+ * each leaf of the dynamic layer and the remaining ones collide a chunk of
+ * deferred objects against the static layer (and, on loose mode, against the
+ * dynamic one)
+ *
+ * @param  [ in]pArg   The quadtree's root
+ * @param  [ in]worker Index of the worker running the task
+ * @param  [ in]task   Index of the task
+ * @return             GFMRV_OK, GFMRV_ALLOC_FAILED, ...
+ */
+static gfmRV gfmQuadtree_deferredTask(void *pArg, int worker, int task) {
+    gfmQuadtreeWorker *pWorker;
+    gfmQuadtreeRoot *pCtx;
+    gfmRV rv;
+    int i, last;
+
+    pCtx = (gfmQuadtreeRoot*)pArg;
+    pWorker = pCtx->pWorkers + worker;
+
+    if (task < pCtx->leavesUsed) {
+        rv = gfmQuadtree_collideDeferredLeaf(pCtx, pWorker,
+                pCtx->pLeaves[task]);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+    else {
+        i = (task - pCtx->leavesUsed) * gfmQT_deferredPerTask;
+        last = i + gfmQT_deferredPerTask;
+        if (last > pCtx->deferredUsed) {
+            last = pCtx->deferredUsed;
+        }
+        while (i < last) {
+            /* Skip unused handles (on incremental mode) */
+            if (pCtx->pDeferred[i].pSelf && pCtx->staticLayer.maxDepth > 0) {
+                rv = gfmQuadtree_collideDeferredLayer(pCtx, pWorker,
+                        pCtx->pDeferred + i, &(pCtx->staticLayer));
+                ASSERT_NR(rv == GFMRV_OK);
+            }
+            if (pCtx->pDeferred[i].pSelf && pCtx->dynamicLayer.isLoose) {
+                rv = gfmQuadtree_collideDeferredLayer(pCtx, pWorker,
+                        pCtx->pDeferred + i, &(pCtx->dynamicLayer));
+                ASSERT_NR(rv == GFMRV_OK);
+            }
+            i++;
+        }
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Compare two overlaps found by gfmQuadtree_collideDeferred, so they are
+ * sorted in the same order gfmQuadtree_collide* would report them (or by their
+ * time of impact, on continuous mode)
+ *
+ * @param  [ in]pA One of the overlaps
+ * @param  [ in]pB The other overlap
+ * @return         Less than, equal to or greater than 0, if pA should be
+ *                 sorted before, at the same position or after pB
+ */
+static int gfmQuadtree_compareDeferred(const void *pA, const void *pB) {
+    const gfmQuadtreeSortedPair *pPairA, *pPairB;
+
+    pPairA = (const gfmQuadtreeSortedPair*)pA;
+    pPairB = (const gfmQuadtreeSortedPair*)pB;
+
+    /* Always 0, if not on continuous mode */
+    if (pPairA->pair.time != pPairB->pair.time) {
+        return pPairA->pair.time < pPairB->pair.time ? -1 : 1;
+    }
+    if (pPairA->selfSeq != pPairB->selfSeq) {
+        return pPairA->selfSeq < pPairB->selfSeq ? -1 : 1;
+    }
+    /* The static layer is collided first */
+    if (pPairA->pair.isStatic != pPairB->pair.isStatic) {
+        return pPairA->pair.isStatic ? -1 : 1;
+    }
+    if (pPairA->otherSeq != pPairB->otherSeq) {
+        return pPairA->otherSeq < pPairB->otherSeq ? -1 : 1;
+    }
+    return pPairA->pair.node - pPairB->pair.node;
+}
+
+/**
+ * Make sure there's a worker (with a big enough stack) for every thread
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @return           GFMRV_OK, GFMRV_ALLOC_FAILED
+ */
+static gfmRV gfmQuadtree_prepareWorkers(gfmQuadtreeRoot *pCtx) {
+    int i, num, stackLen;
+    gfmRV rv;
+
+    num = 1;
+    if (pCtx->pPool) {
+        rv = gfmThreadPool_getNumWorkers(&num, pCtx->pPool);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+
+    if (pCtx->numWorkers < num) {
+        gfmQuadtreeWorker *pTmp;
+
+        pTmp = (gfmQuadtreeWorker*)realloc(pCtx->pWorkers,
+                sizeof(gfmQuadtreeWorker) * num);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+        memset(pTmp + pCtx->numWorkers, 0x0,
+                sizeof(gfmQuadtreeWorker) * (num - pCtx->numWorkers));
+        pCtx->pWorkers = pTmp;
+        pCtx->numWorkers = num;
+    }
+
+    stackLen = pCtx->staticLayer.maxDepth * gfmQT_max;
+    if (pCtx->dynamicLayer.isLoose &&
+            stackLen < pCtx->dynamicLayer.maxDepth * gfmQT_max) {
+        /* The dynamic layer is traversed just like the static one */
+        stackLen = pCtx->dynamicLayer.maxDepth * gfmQT_max;
+    }
+    i = 0;
+    while (i < num) {
+        gfmQuadtreeWorker *pWorker;
+
+        pWorker = pCtx->pWorkers + i;
+        if (pWorker->stackLen < stackLen) {
+            uint32_t *pTmp;
+
+            pTmp = (uint32_t*)realloc(pWorker->pStack,
+                    sizeof(uint32_t) * stackLen);
+            ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+            pWorker->pStack = pTmp;
+            pWorker->stackLen = stackLen;
+        }
+        i++;
+    }
+    /* Clear the overlaps from every worker (even those no longer used) */
+    i = 0;
+    while (i < pCtx->numWorkers) {
+        pCtx->pWorkers[i].used = 0;
+        pCtx->pWorkers[i].staticTests = 0;
+        pCtx->pWorkers[i].dynamicTests = 0;
+        i++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Make sure there's room for one more deferred (or tracked) object
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @return           GFMRV_OK, GFMRV_ALLOC_FAILED
+ */
+static gfmRV gfmQuadtree_expandDeferred(gfmQuadtreeRoot *pCtx) {
+    gfmRV rv;
+
+    if (pCtx->deferredUsed >= pCtx->deferredLen) {
+        gfmQuadtreeDeferred *pTmp;
+        int len;
+
+        len = pCtx->deferredLen * 2;
+        if (len < gfmQT_deferredPerTask) {
+            len = gfmQT_deferredPerTask;
+        }
+        pTmp = (gfmQuadtreeDeferred*)realloc(pCtx->pDeferred,
+                sizeof(gfmQuadtreeDeferred) * len);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+        pCtx->pDeferred = pTmp;
+        pCtx->deferredLen = len;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Add an object to the dynamic layer, to be collided later by
+ * gfmQuadtree_collideDeferred
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @param  [ in]pObj The gfmObject
+ * @return           GFMRV_OK, GFMRV_ALLOC_FAILED, ...
+ */
+static gfmRV gfmQuadtree_deferLayer(gfmQuadtreeRoot *pCtx, gfmObject *pObj) {
+    gfmQuadtreeDeferred *pDeferred;
+    int isInStatic;
+    gfmRV rv;
+
+    /* Objects on the incremental layer must be tracked, instead */
+    ASSERT(!pCtx->isIncremental, GFMRV_QUADTREE_INVALID_MODE);
+
+    /* Ignore objects outside both layers */
+    isInStatic = 0;
+    if (pCtx->staticLayer.maxDepth > 0) {
+        isInStatic = (gfmQuadtree_overlap(pCtx->staticLayer.pNodes, pObj,
+                pCtx->staticLayer.isSwept) == GFMRV_TRUE);
+    }
+    rv = gfmQuadtree_overlap(pCtx->dynamicLayer.pNodes, pObj,
+            pCtx->dynamicLayer.isSwept);
+    ASSERT(isInStatic || rv == GFMRV_TRUE, GFMRV_OK);
+
+    rv = gfmQuadtree_expandDeferred(pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    pDeferred = pCtx->pDeferred + pCtx->deferredUsed;
+    pDeferred->pSelf = pObj;
+    rv = gfmQuadtree_getType(&(pDeferred->type), pObj);
+    ASSERT_NR(rv == GFMRV_OK);
+    /* populateLayer uses (and increments) the layer's sequence */
+    pDeferred->seq = pCtx->dynamicLayer.nextSeq;
+    rv = gfmQuadtree_populateLayer(pCtx, &(pCtx->dynamicLayer), pObj, 1);
+    ASSERT_NR(rv == GFMRV_OK);
+    if (pCtx->dynamicLayer.nextSeq == pDeferred->seq) {
+        /* The object is only inside the static layer */
+        pCtx->dynamicLayer.nextSeq++;
+    }
+    pCtx->deferredUsed++;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Mark a node of the dynamic layer to be checked (on the next
+ * gfmQuadtree_refresh) for whether its children may be merged
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @param  [ in]node Index of the node
+ * @return           GFMRV_OK, GFMRV_ALLOC_FAILED
+ */
+static gfmRV gfmQuadtree_pushCollapse(gfmQuadtreeRoot *pCtx, uint32_t node) {
+    gfmRV rv;
+
+    if (pCtx->collapseUsed >= pCtx->collapseLen) {
+        uint32_t *pTmp;
+        int len;
+
+        len = pCtx->collapseLen * 2;
+        if (len < gfmQT_deferredPerTask) {
+            len = gfmQT_deferredPerTask;
+        }
+        pTmp = (uint32_t*)realloc(pCtx->pCollapse, sizeof(uint32_t) * len);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+        pCtx->pCollapse = pTmp;
+        pCtx->collapseLen = len;
+    }
+    pCtx->pCollapse[pCtx->collapseUsed] = node;
+    pCtx->collapseUsed++;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Insert a tracked object into the dynamic layer (using its stored area),
+ * retrieving the range within which it may move without being re-inserted
+ *
+ * @param  [ in]pCtx     The quadtree's root
+ * @param  [ in]pTracked The tracked object
+ * @return               GFMRV_OK, GFMRV_ALLOC_FAILED,
+ *                       GFMRV_QUADTREE_STACK_OVERFLOW, ...
+ */
+static gfmRV gfmQuadtree_insertTracked(gfmQuadtreeRoot *pCtx,
+        gfmQuadtreeDeferred *pTracked) {
+    gfmQuadtreeLL info;
+    gfmRV rv;
+
+    info.pSelf = pTracked->pSelf;
+    info.next = 0;
+    info.type = pTracked->type;
+    info.seq = pTracked->seq;
+    info.isDeferred = 1;
+    info.area = pTracked->area;
+
+    /* Every node tested while inserting it restricts its range */
+    pTracked->minX = INT_MIN;
+    pTracked->maxX = INT_MAX;
+    pTracked->minY = INT_MIN;
+    pTracked->maxY = INT_MAX;
+    rv = gfmQuadtree_insertLayer(pCtx, &(pCtx->dynamicLayer), &info,
+            pTracked);
+    ASSERT_NR(rv == GFMRV_OK);
+    pTracked->isValid = 1;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Remove a tracked object from every leaf of the dynamic layer (found through
+ * its stored area); Nodes left sparse are marked to be collapsed later
+ *
+ * @param  [ in]pCtx     The quadtree's root
+ * @param  [ in]pTracked The tracked object
+ * @return               GFMRV_OK, GFMRV_ALLOC_FAILED,
+ *                       GFMRV_QUADTREE_STACK_OVERFLOW, ...
+ */
+static gfmRV gfmQuadtree_removeTracked(gfmQuadtreeRoot *pCtx,
+        gfmQuadtreeDeferred *pTracked) {
+    gfmQuadtreeLayer *pLayer;
+    gfmRV rv;
+
+    pLayer = &(pCtx->dynamicLayer);
+    pTracked->isValid = 0;
+    rv = gfmQuadtree_overlapArea(pLayer->pNodes, &(pTracked->area));
+    ASSERT(rv == GFMRV_TRUE, GFMRV_OK);
+
+    pCtx->pLayer = pLayer;
+    pCtx->stack.pushPos = 0;
+    rv = gfmQuadtree_pushNode(pCtx, 0);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    while (pCtx->stack.pushPos > 0) {
+        gfmQuadtree *pNode;
+        uint32_t node;
+
+        rv = gfmQuadtree_popNode(&node, pCtx);
+        ASSERT_NR(rv == GFMRV_OK);
+        pNode = pLayer->pNodes + node;
+
+        if (pNode->children) {
+            gfmQuadtreePosition i;
+            uint32_t child;
+
+            i = gfmQT_nw;
+            while (i < gfmQT_max) {
+                child = pNode->children + i;
+                rv = gfmQuadtree_overlapArea(pLayer->pNodes + child,
+                        &(pTracked->area));
+                if (rv == GFMRV_TRUE) {
+                    rv = gfmQuadtree_pushNode(pCtx, child);
+                    ASSERT_NR(rv == GFMRV_OK);
+                }
+                i++;
+            }
+        }
+        else {
+            uint32_t *pPrev;
+
+            /* Unlink the object's cell and recycle it */
+            pPrev = &(pNode->nodes);
+            while (*pPrev) {
+                uint32_t cell;
+
+                cell = *pPrev;
+                if (pLayer->pCells[cell].seq == pTracked->seq) {
+                    *pPrev = pLayer->pCells[cell].next;
+                    pLayer->pCells[cell].next = pLayer->available;
+                    pLayer->available = cell;
+                    pNode->numObjects--;
+                    break;
+                }
+                pPrev = &(pLayer->pCells[cell].next);
+            }
+
+            if (node != 0 && pNode->numObjects <= pLayer->maxNodes / 2) {
+                rv = gfmQuadtree_pushCollapse(pCtx, pNode->parent);
+                ASSERT_NR(rv == GFMRV_OK);
+            }
+        }
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Merge the children of every marked node of the dynamic layer, as long as
+ * they are all leaves and have at most half as many objects as would make the
+ * node subdivide (so objects moving around a border don't keep subdividing
+ * and merging it); Released children are recycled on the next subdivision
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @return           GFMRV_OK, GFMRV_ALLOC_FAILED
+ */
+static gfmRV gfmQuadtree_collapse(gfmQuadtreeRoot *pCtx) {
+    gfmQuadtreeLayer *pLayer;
+    gfmRV rv;
+    int limit;
+
+    pLayer = &(pCtx->dynamicLayer);
+    limit = pLayer->maxNodes / 2;
+    while (pCtx->collapseUsed > 0) {
+        gfmQuadtreePosition i;
+        gfmQuadtree *pNode;
+        uint32_t children, node;
+        int total;
+
+        pCtx->collapseUsed--;
+        node = pCtx->pCollapse[pCtx->collapseUsed];
+        pNode = pLayer->pNodes + node;
+        /* Skip released nodes and nodes that were already collapsed */
+        if (pNode->depth < 0 || !pNode->children) {
+            continue;
+        }
+
+        children = pNode->children;
+        total = 0;
+        i = gfmQT_nw;
+        while (i < gfmQT_max && !pLayer->pNodes[children + i].children) {
+            total += pLayer->pNodes[children + i].numObjects;
+            i++;
+        }
+        if (i < gfmQT_max || total > limit) {
+            continue;
+        }
+
+        /* Move every object into the node (only once, even if it was on more
+         * than one child) */
+        pNode->children = 0;
+        pNode->nodes = 0;
+        pNode->numObjects = 0;
+        i = gfmQT_nw;
+        while (i < gfmQT_max) {
+            gfmQuadtree *pChild;
+
+            pChild = pLayer->pNodes + children + i;
+            while (pChild->nodes) {
+                uint32_t cell, tmp;
+
+                cell = pChild->nodes;
+                pChild->nodes = pLayer->pCells[cell].next;
+
+                tmp = pNode->nodes;
+                while (tmp && pLayer->pCells[tmp].seq !=
+                        pLayer->pCells[cell].seq) {
+                    tmp = pLayer->pCells[tmp].next;
+                }
+                if (tmp) {
+                    pLayer->pCells[cell].next = pLayer->available;
+                    pLayer->available = cell;
+                }
+                else {
+                    pLayer->pCells[cell].next = pNode->nodes;
+                    pNode->nodes = cell;
+                    pNode->numObjects++;
+                }
+            }
+            pChild->numObjects = 0;
+            pChild->depth = -1;
+            i++;
+        }
+        pLayer->pNodes[children].children = pLayer->freeNodes;
+        pLayer->freeNodes = children;
+
+        /* Its parent may also have become sparse */
+        if (node != 0 && pNode->numObjects <= limit) {
+            rv = gfmQuadtree_pushCollapse(pCtx, pNode->parent);
+            ASSERT_NR(rv == GFMRV_OK);
+        }
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Check whether an area (or a segment) touches a box
+ *
+ * @param  [out]pDist  Where, along the segment, the box was hit (in the range
+ *                     [0, 1]; always 0 for areas)
+ * @param  [ in]pQuery The area (or segment)
+ * @param  [ in]left   The box's bounds (inclusive)
+ * @param  [ in]top    The box's bounds (inclusive)
+ * @param  [ in]right  The box's bounds (inclusive)
+ * @param  [ in]bottom The box's bounds (inclusive)
+ * @return             GFMRV_TRUE, GFMRV_FALSE
+ */
+static gfmRV gfmQuadtree_queryBox(double *pDist, gfmQuadtreeQuery *pQuery,
+        int left, int top, int right, int bottom) {
+    double tMin, tMax;
+    int i;
+
+    *pDist = 0.0;
+    /* Check the bounds first (which is all that's needed for areas) */
+    if (pQuery->right < left || pQuery->left > right ||
+            pQuery->bottom < top || pQuery->top > bottom) {
+        return GFMRV_FALSE;
+    }
+    if (!pQuery->isRay) {
+        return GFMRV_TRUE;
+    }
+
+    /* Clip the segment against each axis of the box */
+    tMin = 0.0;
+    tMax = 1.0;
+    i = 0;
+    while (i < 2) {
+        double t0, t1;
+        int delta, min, max, start;
+
+        if (i == 0) {
+            start = pQuery->x0;
+            delta = pQuery->x1 - pQuery->x0;
+            min = left;
+            max = right;
+        }
+        else {
+            start = pQuery->y0;
+            delta = pQuery->y1 - pQuery->y0;
+            min = top;
+            max = bottom;
+        }
+
+        if (delta == 0) {
+            if (start < min || start > max) {
+                return GFMRV_FALSE;
+            }
+        }
+        else {
+            t0 = (double)(min - start) / (double)delta;
+            t1 = (double)(max - start) / (double)delta;
+            if (t0 > t1) {
+                double tmp;
+
+                tmp = t0;
+                t0 = t1;
+                t1 = tmp;
+            }
+            if (t0 > tMin) {
+                tMin = t0;
+            }
+            if (t1 < tMax) {
+                tMax = t1;
+            }
+            if (tMin > tMax) {
+                return GFMRV_FALSE;
+            }
+        }
+        i++;
+    }
+
+    *pDist = tMin;
+    return GFMRV_TRUE;
+}
+
+/**
+ * Store every object on a layer touched by the query, without modifying it
+ *
+ * @param  [ in]pCtx     The quadtree's root
+ * @param  [ in]pLayer   The layer
+ * @param  [ in]pQuery   The area (or segment)
+ * @return               GFMRV_OK, GFMRV_ALLOC_FAILED,
+ *                       GFMRV_QUADTREE_STACK_OVERFLOW, ...
+ */
+static gfmRV gfmQuadtree_queryLayer(gfmQuadtreeRoot *pCtx,
+        gfmQuadtreeLayer *pLayer, gfmQuadtreeQuery *pQuery) {
+    int pushPos, stackLen;
+    gfmRV rv;
+
+    /* Make sure the stack is big enough to traverse this layer */
+    stackLen = pLayer->maxDepth * gfmQT_max;
+    if (pCtx->queryStackLen < stackLen) {
+        uint32_t *pTmp;
+
+        pTmp = (uint32_t*)realloc(pCtx->pQueryStack,
+                sizeof(uint32_t) * stackLen);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+        pCtx->pQueryStack = pTmp;
+        pCtx->queryStackLen = stackLen;
+    }
+
+    pCtx->pQueryStack[0] = 0;
+    pushPos = 1;
+    while (pushPos > 0) {
+        gfmQuadtree *pNode;
+        double dist;
+        uint32_t node;
+
+        pushPos--;
+        node = pCtx->pQueryStack[pushPos];
+        pNode = pLayer->pNodes + node;
+
+        rv = gfmQuadtree_queryBox(&dist, pQuery,
+                pNode->centerX - pNode->looseHalfWidth,
+                pNode->centerY - pNode->looseHalfHeight,
+                pNode->centerX + pNode->looseHalfWidth,
+                pNode->centerY + pNode->looseHalfHeight);
+        if (rv != GFMRV_TRUE) {
+            continue;
+        }
+
+        if (pNode->children) {
+            gfmQuadtreePosition i;
+
+            i = gfmQT_nw;
+            while (i < gfmQT_max) {
+                ASSERT(pushPos < pCtx->queryStackLen,
+                        GFMRV_QUADTREE_STACK_OVERFLOW);
+                pCtx->pQueryStack[pushPos] = pNode->children + i;
+                pushPos++;
+                i++;
+            }
+        }
+        /* Only leaves have objects, unless on loose mode */
+        if (!pNode->children || pLayer->isLoose) {
+            uint32_t cell;
+
+            cell = pNode->nodes;
+            while (cell) {
+                gfmQuadtreeLL *pCell;
+                gfmQuadtreeHit *pHit;
+                int x, y, width, height;
+
+                pCell = pLayer->pCells + cell;
+                cell = pCell->next;
+
+                rv = gfmObject_getPosition(&x, &y, pCell->pSelf);
+                ASSERT_NR(rv == GFMRV_OK);
+                rv = gfmObject_getDimensions(&width, &height, pCell->pSelf);
+                ASSERT_NR(rv == GFMRV_OK);
+                rv = gfmQuadtree_queryBox(&dist, pQuery, x, y, x + width,
+                        y + height);
+                if (rv != GFMRV_TRUE) {
+                    continue;
+                }
+
+                /* Expand the buffer as necessary */
+                if (pCtx->hitsUsed >= pCtx->hitsLen) {
+                    gfmQuadtreeHit *pTmp;
+                    int len;
+
+                    len = pCtx->hitsLen * 2;
+                    if (len < gfmQT_deferredPerTask) {
+                        len = gfmQT_deferredPerTask;
+                    }
+                    pTmp = (gfmQuadtreeHit*)realloc(pCtx->pHits,
+                            sizeof(gfmQuadtreeHit) * len);
+                    ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+                    pCtx->pHits = pTmp;
+                    pCtx->hitsLen = len;
+                }
+
+                pHit = pCtx->pHits + pCtx->hitsUsed;
+                pHit->pSelf = pCell->pSelf;
+                pHit->dist = dist;
+                pHit->seq = pCell->seq;
+                pHit->isStatic = (pLayer == &(pCtx->staticLayer));
+                pCtx->hitsUsed++;
+            }
+        }
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Compare two objects found by gfmQuadtree_query* by the order they were added
+ * (with objects from the static layer first)
+ *
+ * @param  [ in]pA One of the objects
+ * @param  [ in]pB The other object
+ * @return         Less than, equal to or greater than 0, if pA should be
+ *                 sorted before, at the same position or after pB
+ */
+static int gfmQuadtree_compareHitOrder(const void *pA, const void *pB) {
+    const gfmQuadtreeHit *pHitA, *pHitB;
+
+    pHitA = (const gfmQuadtreeHit*)pA;
+    pHitB = (const gfmQuadtreeHit*)pB;
+
+    if (pHitA->isStatic != pHitB->isStatic) {
+        return pHitA->isStatic ? -1 : 1;
+    }
+    if (pHitA->seq != pHitB->seq) {
+        return pHitA->seq < pHitB->seq ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ * Compare two objects found by gfmQuadtree_queryRay by their distance to the
+ * segment's start (breaking ties by the order they were added)
+ *
+ * @param  [ in]pA One of the objects
+ * @param  [ in]pB The other object
+ * @return         Less than, equal to or greater than 0, if pA should be
+ *                 sorted before, at the same position or after pB
+ */
+static int gfmQuadtree_compareHitDist(const void *pA, const void *pB) {
+    const gfmQuadtreeHit *pHitA, *pHitB;
+
+    pHitA = (const gfmQuadtreeHit*)pA;
+    pHitB = (const gfmQuadtreeHit*)pB;
+
+    if (pHitA->dist != pHitB->dist) {
+        return pHitA->dist < pHitB->dist ? -1 : 1;
+    }
+    return gfmQuadtree_compareHitOrder(pA, pB);
+}
+
+/**
+ * Retrieve every object (from both layers) touched by the query
+ *
+ * @param  [out]ppObjs  Buffer that will be filled with the objects
+ * @param  [out]pCount  How many objects were stored on the buffer
+ * @param  [ in]pCtx    The quadtree's root
+ * @param  [ in]pQuery  The area (or segment)
+ * @param  [ in]maxObjs How many objects fit on the buffer
+ * @return              GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                      GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED,
+ *                      GFMRV_BUFFER_TOO_SMALL
+ */
+static gfmRV gfmQuadtree_query(gfmObject **ppObjs, int *pCount,
+        gfmQuadtreeRoot *pCtx, gfmQuadtreeQuery *pQuery, int maxObjs) {
+    int count, i;
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCount, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(ppObjs || maxObjs == 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(maxObjs >= 0, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->dynamicLayer.maxDepth > 0 || pCtx->staticLayer.maxDepth > 0,
+            GFMRV_QUADTREE_NOT_INITIALIZED);
+
+    *pCount = 0;
+    pCtx->hitsUsed = 0;
+    if (pCtx->staticLayer.maxDepth > 0) {
+        rv = gfmQuadtree_queryLayer(pCtx, &(pCtx->staticLayer), pQuery);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+    if (pCtx->dynamicLayer.maxDepth > 0) {
+        rv = gfmQuadtree_queryLayer(pCtx, &(pCtx->dynamicLayer), pQuery);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+    ASSERT(pCtx->hitsUsed > 0, GFMRV_OK);
+
+    /* Remove objects found on more than one leaf */
+    qsort(pCtx->pHits, pCtx->hitsUsed, sizeof(gfmQuadtreeHit),
+            gfmQuadtree_compareHitOrder);
+    count = 1;
+    i = 1;
+    while (i < pCtx->hitsUsed) {
+        if (gfmQuadtree_compareHitOrder(pCtx->pHits + i,
+                pCtx->pHits + count - 1) != 0) {
+            pCtx->pHits[count] = pCtx->pHits[i];
+            count++;
+        }
+        i++;
+    }
+    pCtx->hitsUsed = count;
+
+    if (pQuery->isRay) {
+        qsort(pCtx->pHits, pCtx->hitsUsed, sizeof(gfmQuadtreeHit),
+                gfmQuadtree_compareHitDist);
+    }
+
+    /* Return as many objects as possible */
+    i = 0;
+    while (i < pCtx->hitsUsed && i < maxObjs) {
+        ppObjs[i] = pCtx->pHits[i].pSelf;
+        i++;
+    }
+    *pCount = i;
+    ASSERT(pCtx->hitsUsed <= maxObjs, GFMRV_BUFFER_TOO_SMALL);
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Run the collision until either the buffer is filled or there's nothing else
+ * to be collided
+ *
+ * @param  [out]pPairs   Buffer that will be filled with the overlaps
+ * @param  [out]pCount   How many overlaps were stored on the buffer
+ * @param  [ in]pCtx     The quadtree's root
+ * @param  [ in]maxPairs How many overlaps fit on the buffer
+ * @return               GFMRV_QUADTREE_OVERLAPED (the buffer got full),
+ *                       GFMRV_QUADTREE_DONE, ...
+ */
+static gfmRV gfmQuadtree_fillPairs(gfmQuadtreePair *pPairs, int *pCount,
+        gfmQuadtreeRoot *pCtx, int maxPairs) {
+    gfmRV rv;
+    int count;
+
+    count = 0;
+    rv = GFMRV_QUADTREE_OVERLAPED;
+    while (count < maxPairs) {
+        rv = gfmQuadtree_run(pCtx);
+        if (rv != GFMRV_QUADTREE_OVERLAPED) {
+            break;
+        }
+
+        pPairs[count].pSelf = pCtx->pObject;
+        pPairs[count].pOther = pCtx->pOther;
+        pPairs[count].node = (int)pCtx->curNode;
+        pPairs[count].isStatic = (pCtx->pLayer == &(pCtx->staticLayer));
+        pPairs[count].time = pCtx->time;
+        count++;
+    }
+
+    *pCount = count;
+    return rv;
+}
+
+/**
+ * Retrieve the stats of a layer, traversing every node in use
+ *
+ * @param  [out]pStats The stats
+ * @param  [ in]pCtx   The layer
+ */
+static void gfmQuadtree_getLayerStats(gfmQuadtreeStats *pStats,
+        gfmQuadtreeLayer *pCtx) {
+    uint32_t node;
+
+    memset(pStats, 0x0, sizeof(gfmQuadtreeStats));
+    pStats->bytes = (int)(sizeof(gfmQuadtree) * pCtx->nodesLen +
+            sizeof(gfmQuadtreeLL) * pCtx->cellsLen);
+    pStats->overlapTests = pCtx->overlapTests;
+    pStats->pairs = pCtx->pairs;
+
+    node = 0;
+    while (node < pCtx->nodesUsed) {
+        gfmQuadtree *pNode;
+        uint32_t cell;
+        int depth, num;
+
+        pNode = pCtx->pNodes + node;
+        node++;
+        /* Skip children released on incremental mode */
+        if (pNode->depth < 0) {
+            continue;
+        }
+
+        num = 0;
+        cell = pNode->nodes;
+        while (cell) {
+            num++;
+            cell = pCtx->pCells[cell].next;
+        }
+
+        depth = pNode->depth;
+        if (depth > pStats->depth) {
+            pStats->depth = depth;
+        }
+        if (depth >= gfmQuadtreeStats_len) {
+            depth = gfmQuadtreeStats_len - 1;
+        }
+        pStats->nodes++;
+        pStats->nodesPerDepth[depth]++;
+        pStats->cells += num;
+        pStats->cellsPerDepth[depth] += num;
+        if (!pNode->children) {
+            pStats->leaves++;
+        }
+
+        /* Only leaves have objects, unless on loose mode */
+        if (!pNode->children || pCtx->isLoose) {
+            if (num >= gfmQuadtreeStats_len) {
+                num = gfmQuadtreeStats_len - 1;
+            }
+            pStats->objectsPerLeaf[num]++;
+        }
+    }
+}
+
+#if defined(DEBUG)
+/**
+ * Print the dynamic layer's stats (as set by gfmQuadtree_setDrawStats)
+ *
+ * @param  [ in]pQt  The quadtree's root
+ * @param  [ in]pCtx The game's context
+ */
+static void gfmQuadtree_drawStats(gfmQuadtreeRoot *pQt, gfmCtx *pCtx) {
+    gfmQuadtreeStats stats;
+    char pHistogram[gfmQuadtreeStats_len * 12];
+    int i, last, pos;
+
+    gfmQuadtree_getLayerStats(&stats, &(pQt->dynamicLayer));
+
+    /* Only print the histogram up to its last non-empty entry */
+    last = 0;
+    i = 0;
+    while (i < gfmQuadtreeStats_len) {
+        if (stats.objectsPerLeaf[i] > 0) {
+            last = i;
+        }
+        i++;
+    }
+    pos = 0;
+    i = 0;
+    while (i <= last && pos < (int)sizeof(pHistogram)) {
+        pos += snprintf(pHistogram + pos, sizeof(pHistogram) - pos, " %i",
+                stats.objectsPerLeaf[i]);
+        i++;
+    }
+
+    gfmDebug_printf(pCtx, pQt->statsX, pQt->statsY,
+            "NODES %i LEAVES %i DEPTH %i\n"
+            "CELLS %i TESTS %i PAIRS %i\n"
+            "PER LEAF%s", stats.nodes, stats.leaves, stats.depth, stats.cells,
+            stats.overlapTests, stats.pairs, pHistogram);
+}
+#endif
+
+/**
+ * Draw every node (and object) of the layer currently set on the root
+ *
+ * @param  pQt     The quadtree's root
+ * @param  pCtx    The game's context
+ * @param  pColors The colors to be used
+ * @return         GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+static gfmRV gfmQuadtree_drawLayer(gfmQuadtreeRoot *pQt, gfmCtx *pCtx,
+        unsigned char *pColors) {
+    gfmRV rv;
+    
+    // Clear the call stack
+    pQt->stack.pushPos = 0;
+    
+    // Push the root node to start colliding
+    rv = gfmQuadtree_pushNode(pQt, 0);
+    ASSERT_NR(rv == GFMRV_OK);
+    
+    // Iterate through all nodes
+    while (pQt->stack.pushPos > 0) {
+        gfmQuadtree *pNode;
+        unsigned char *pNodeColor;
+        uint32_t node;
+        
+        // Pop the current node
+        rv = gfmQuadtree_popNode(&node, pQt);
+        ASSERT_NR(rv == GFMRV_OK);
+        pNode = pQt->pLayer->pNodes + node;
+        
+        // Get the colors for the qt node
+        pNodeColor = pColors;
+        // Draw the current node
+        rv = gfm_drawRect(pCtx, pNode->centerX - pNode->halfWidth,
+                pNode->centerY - pNode->halfHeight, pNode->halfWidth * 2,
+                pNode->halfHeight * 2, pNodeColor[0], pNodeColor[1],
+                pNodeColor[2]);
+        ASSERT_NR(rv == GFMRV_OK);
+        
+        // If it has children, push its children
+        if (pNode->children) {
+            gfmQuadtreePosition i;
+
+            i = gfmQT_nw;
+            while (i < gfmQT_max) {
+                // Push it (so it will be drawn later)
+                rv = gfmQuadtree_pushNode(pQt, pNode->children + i);
+                ASSERT_NR(rv == GFMRV_OK);
+                i++;
+            }
+        }
+        // Draw its nodes (only leaves have any, unless on loose mode)
+        if (!pNode->children || pQt->pLayer->isLoose) {
+            gfmQuadtreeLL *pTmp;
+            uint32_t cell;
+            
+            cell = pNode->nodes;
+            
+            while (cell) {
+                int height, width, x, y;
+                
+                // Get the object's color
+                pTmp = pQt->pLayer->pCells + cell;
+                pNodeColor = pColors + pTmp->type * 3;
+                
+                // Get the object's position
+                rv = gfmObject_getPosition(&x, &y, pTmp->pSelf);
+                ASSERT_NR(rv == GFMRV_OK);
+                // Get the object's dimensions
+                rv = gfmObject_getDimensions(&width, &height, pTmp->pSelf);
+                ASSERT_NR(rv == GFMRV_OK);
+                
+                // Draw the current node
+                rv = gfm_drawRect(pCtx, x, y, width, height, pNodeColor[0],
+                        pNodeColor[1], pNodeColor[2]);
+                ASSERT_NR(rv == GFMRV_OK);
+                
+                cell = pTmp->next;
+            }
+        }
+    }
+    
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/* Public functions                                                           */
+/*                                                                            */
+/******************************************************************************/
+
+/**
+ * Alloc a new root quadtree
+ * 
+ * @param  ppCtx The root quadtree
+ * @return       GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmQuadtree_getNew(gfmQuadtreeRoot **ppCtx) {
+    gfmRV rv;
+    
+    // Sanitize arguments
+    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(!(*ppCtx), GFMRV_ARGUMENTS_BAD);
+    
+    // Alloc and clean it
+    *ppCtx = (gfmQuadtreeRoot*)malloc(sizeof(gfmQuadtreeRoot));
+    ASSERT(*ppCtx, GFMRV_ALLOC_FAILED);
+    memset(*ppCtx, 0x0, sizeof(gfmQuadtreeRoot));
+    
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Release a quadtree's root and all its members
+ * 
+ * @param  ppCtx The quadtree root
+ * @return       GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmQuadtree_free(gfmQuadtreeRoot **ppCtx) {
+    gfmRV rv;
+    
+    // Sanitize arguments
+    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(*ppCtx, GFMRV_ARGUMENTS_BAD);
+    
+    // Clean the quadtree
+    gfmQuadtree_clean(*ppCtx);
+    // Free the struct
+    free(*ppCtx);
+    *ppCtx = 0;
+    
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Clean all memory used by the entire quadtree
+ * 
+ * @param  pCtx The quadtree root
+ * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmQuadtree_clean(gfmQuadtreeRoot *pCtx) {
+    gfmRV rv;
+    
+    // Sanitize arguments
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    
+    // Clean both layers
+    gfmQuadtree_cleanLayer(&(pCtx->dynamicLayer));
+    gfmQuadtree_cleanLayer(&(pCtx->staticLayer));
+    // Clean the stack, if any
+    if (pCtx->stack.pStack) {
+        free(pCtx->stack.pStack);
+    }
+    /* Clean the reported pairs, if any */
+    if (pCtx->pReported) {
+        free(pCtx->pReported);
+    }
+    /* Clean everything used by gfmQuadtree_collideDeferred */
+    gfmThreadPool_free(&(pCtx->pPool));
+    while (pCtx->numWorkers > 0) {
+        gfmQuadtreeWorker *pWorker;
+
+        pCtx->numWorkers--;
+        pWorker = pCtx->pWorkers + pCtx->numWorkers;
+        if (pWorker->pPairs) {
+            free(pWorker->pPairs);
+        }
+        if (pWorker->pStack) {
+            free(pWorker->pStack);
+        }
+        gfmPackedHitboxes_clean(&(pWorker->packed));
+    }
+    if (pCtx->pWorkers) {
+        free(pCtx->pWorkers);
+    }
+    if (pCtx->pDeferred) {
+        free(pCtx->pDeferred);
+    }
+    if (pCtx->pLeaves) {
+        free(pCtx->pLeaves);
+    }
+    if (pCtx->pSorted) {
+        free(pCtx->pSorted);
+    }
+    if (pCtx->pPairs) {
+        free(pCtx->pPairs);
+    }
+    /* Clean everything used by gfmQuadtree_query* */
+    if (pCtx->pHits) {
+        free(pCtx->pHits);
+    }
+    if (pCtx->pQueryStack) {
+        free(pCtx->pQueryStack);
+    }
+    /* Clean everything used on incremental mode */
+    if (pCtx->pCollapse) {
+        free(pCtx->pCollapse);
+    }
+    memset(pCtx, 0x0, sizeof(gfmQuadtreeRoot));
+    
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Clean up the previous state and ready the quadtree for collision
+ * 
+ * @param  pCtx     The quadtree root context
+ * @param  x        The quadtree top-left position
+ * @param  y        The quadtree top-left position
+ * @param  width    The quadtree width
+ * @param  height   The quadtree height
+ * @param  maxDepth How many levels can the quadtree branch
+ * @param  maxNodes How many objects a subtree can have until it must split
+ * @return          GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmQuadtree_initRoot(gfmQuadtreeRoot *pCtx, int x, int y, int width,
+        int height, int maxDepth, int maxNodes) {
+    gfmRV rv;
+    
+    // Sanitize argument
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(width > 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(height > 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(maxDepth > 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(maxNodes > 0, GFMRV_ARGUMENTS_BAD);
+    
+    // Clear all dynamic list
+    pCtx->colliding = 0;
+    // Remove context object's
+    pCtx->pObject = 0;
+    pCtx->pOther = 0;
+    pCtx->pGroupList = 0;
+    /* Remove the static flag */
+    pCtx->isStatic = 0;
+    pCtx->time = 0.0;
+    /* Start a new frame, forgetting every previously reported pair */
+    pCtx->epoch++;
+    if (pCtx->epoch == 0) {
+        /* On overflow, the entries must actually be cleared */
+        if (pCtx->pReported) {
+            memset(pCtx->pReported, 0x0,
+                    sizeof(gfmQuadtreeReported) * pCtx->reportedLen);
+        }
+        pCtx->epoch = 1;
+    }
+    pCtx->reportedCount = 0;
+    gfmQuadtree_resetCounters(pCtx);
+    /* Forget every deferred (or tracked) object */
+    pCtx->deferredUsed = 0;
+    pCtx->isIncremental = 0;
+    pCtx->trackedFree = 0;
+    pCtx->collapseUsed = 0;
+    
+    rv = gfmQuadtree_expandStack(pCtx, maxDepth);
+    ASSERT_NR(rv == GFMRV_OK);
+    
+    // Reset only the dynamic layer (the static one is kept across frames)
+    rv = gfmQuadtree_initLayer(&(pCtx->dynamicLayer), x, y, width, height,
+            maxDepth, maxNodes);
+    ASSERT_NR(rv == GFMRV_OK);
+    pCtx->pLayer = &(pCtx->dynamicLayer);
+    
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Make the quadtree static
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @return      GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_OK
+ */
+gfmRV gfmQuadtree_setStatic(gfmQuadtreeRoot *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->dynamicLayer.maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+
+    pCtx->isStatic = 1;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Adds a new gfmGroup to the quadtree, subdividing it as necessary and
+ * colliding with every possible node
+ * 
+ * @param  pCtx The quadtree's root
+ * @param  pGrp The gfmGroup
+ * @return      GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED, 
+ *              GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmQuadtree_collideGroup(gfmQuadtreeRoot *pCtx, gfmGroup *pGrp) {
+    gfmRV rv;
+    
+    // Sanitize arguments
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pGrp, GFMRV_ARGUMENTS_BAD);
+    // Check if initialized
+    ASSERT(pCtx->dynamicLayer.maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+    
+    // Get the list of collideable objects
+    rv = gfmGroup_getCollideableList(&(pCtx->pGroupList), pGrp);
+    ASSERT(rv == GFMRV_OK || rv == GFMRV_GROUP_LIST_EMPTY, rv);
+    
+    // Start the collision
+    if (rv == GFMRV_OK) {
+        // Clear the call stack
+        pCtx->stack.pushPos = 0;
+        // Clear any previous overlap
+        pCtx->pObject = 0;
+        pCtx->colliding = 0;
+        pCtx->pOther = 0;
+        
+        rv = gfmQuadtree_run(pCtx);
+    }
+    else {
+        rv = GFMRV_QUADTREE_DONE;
+    }
+__ret:
+    return rv;
+}
+
+/**
+ * Adds a new gfmObject to the quadtree, subdividing it as necessary and
+ * colliding with every possible node
+ * 
+ * @param  pCtx The quadtree's root
+ * @param  pObj The gfmObject
+ * @return      GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED, 
+ *              GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmQuadtree_collideObject(gfmQuadtreeRoot *pCtx, gfmObject *pObj) {
+    gfmRV rv;
+    
+    // Sanitize arguments
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pObj, GFMRV_ARGUMENTS_BAD);
+    // Check if initialized
+    ASSERT(pCtx->dynamicLayer.maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+    // Check if this node overlaps the root and push the root node
+    rv = gfmQuadtree_startObject(pCtx, pObj);
+    if (rv == GFMRV_QUADTREE_DONE) {
+        goto __ret;
+    }
+    ASSERT_NR(rv == GFMRV_OK);
+    
+    // Collide it
+    rv = gfmQuadtree_run(pCtx);
+__ret:
+    return rv;
+}
+
+/**
+ * Adds a new gfmSprite to the quadtree, subdividing it as necessary and
+ * colliding with every possible node
+ * 
+ * @param  pCtx The quadtree's root
+ * @param  pObj The gfmObject
+ * @return      GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED, 
+ *              GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmQuadtree_collideSprite(gfmQuadtreeRoot *pCtx, gfmSprite *pSpr) {
+    gfmObject *pObj;
+    gfmRV rv;
+    
+    // Sanitize sprite (other checks are done in sub-functions)
+    ASSERT(pSpr, GFMRV_ARGUMENTS_BAD);
+    // Retrieve the sprite's object
+    rv = gfmSprite_getObject(&pObj, pSpr);
+    ASSERT_NR(rv == GFMRV_OK);
+    // Add it to the quadtree
+    rv = gfmQuadtree_collideObject(pCtx, pObj);
+__ret:
+    return rv;
+}
+
+/**
+ * Adds a new gfmTilemap to the quadtree, subdividing it as necessary and
+ * colliding with every possible node
+ * 
+ * @param  pCtx  The quadtree's root
+ * @param  pTMap The gfmTilemap
+ * @return       GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED, 
+ *               GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmQuadtree_collideTilemap(gfmQuadtreeRoot *pCtx, gfmTilemap *pTMap) {
+    return GFMRV_FUNCTION_NOT_IMPLEMENTED;
+}
+
+/**
+ * Populates a quadtree with a group's objects
+ * 
+ * @param  pCtx The quadtree's root
+ * @param  pGrp The tilemap
+ * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED
+ */
+gfmRV gfmQuadtree_populateGroup(gfmQuadtreeRoot *pCtx, gfmGroup *pGrp) {
+    // TODO Simply iterate through every object and add it
+    return GFMRV_FUNCTION_NOT_IMPLEMENTED;
+}
+
+/**
+ * Add an object to the quadtree without collinding it against the tree's objs
+ * 
+ * @param  pCtx The quadtree's root
+ * @param  pObj The gfmObject
+ * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED
+ */
+gfmRV gfmQuadtree_populateObject(gfmQuadtreeRoot *pCtx, gfmObject *pObj) {
+    gfmRV rv;
+    
+    // Sanitize arguments
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pObj, GFMRV_ARGUMENTS_BAD);
+    // Check if initialized
+    ASSERT(pCtx->dynamicLayer.maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+    
+    rv = gfmQuadtree_populateLayer(pCtx, &(pCtx->dynamicLayer), pObj, 0);
+__ret:
+    return rv;
+}
+
+/**
+ * Add a sprite to the quadtree without collinding it against the tree's objs
+ * 
+ * @param  pCtx The quadtree's root
+ * @param  pSpr The gfmSprite
+ * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED
+ */
+gfmRV gfmQuadtree_populateSprite(gfmQuadtreeRoot *pCtx, gfmSprite *pSpr) {
+    gfmObject *pObj;
+    gfmRV rv;
+    
+    // Sanitize sprite (other checks are done in sub-functions)
+    ASSERT(pSpr, GFMRV_ARGUMENTS_BAD);
+    // Retrieve the sprite's object
+    rv = gfmSprite_getObject(&pObj, pSpr);
+    ASSERT_NR(rv == GFMRV_OK);
+    // Add it to the quadtree
+    rv = gfmQuadtree_populateObject(pCtx, pObj);
+__ret:
+    return rv;
+}
+
+/**
+ * Populates a quadtree with tilemap's areas
+ * 
+ * @param  pCtx  The quadtree's root
+ * @param  pTMap The tilemap
+ * @return       GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED
+ */
+gfmRV gfmQuadtree_populateTilemap(gfmQuadtreeRoot *pCtx, gfmTilemap *pTMap) {
+    gfmObject *pList;
+    gfmRV rv;
+    int len;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pTMap, GFMRV_ARGUMENTS_BAD);
+
+    /* Get how many areas there are */
+    rv = gfmTilemap_getAreasLength(&len, pTMap);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmTilemap_getArea(&pList, pTMap, 0);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    rv = gfmHitbox_populateQuadtree((gfmHitbox*)pList, pCtx, len);
+__ret:
+    return rv;
+}
+
+/**
+ * Initialize the static layer, removing anything previously added to it
+ *
+ * The static layer is kept across frames (i.e., it isn't modified by
+ * gfmQuadtree_initRoot) and every collided object is tested against it before
+ * being added to the dynamic layer; This way, the level's geometry may be
+ * added only once
+ *
+ * @param  [ in]pCtx     The quadtree's root
+ * @param  [ in]x        The static layer's top-left position
+ * @param  [ in]y        The static layer's top-left position
+ * @param  [ in]width    The static layer's width
+ * @param  [ in]height   The static layer's height
+ * @param  [ in]maxDepth How many levels can the static layer branch
+ * @param  [ in]maxNodes How many objects a subtree can have until it must split
+ * @return               GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmQuadtree_initStatic(gfmQuadtreeRoot *pCtx, int x, int y, int width,
+        int height, int maxDepth, int maxNodes) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(width > 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(height > 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(maxDepth > 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(maxNodes > 0, GFMRV_ARGUMENTS_BAD);
+
+    rv = gfmQuadtree_expandStack(pCtx, maxDepth);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    rv = gfmQuadtree_initLayer(&(pCtx->staticLayer), x, y, width, height,
+            maxDepth, maxNodes);
+__ret:
+    return rv;
+}
+
+/**
+ * Remove the static layer, so objects are only collided against the dynamic
+ * one
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmQuadtree_clearStatic(gfmQuadtreeRoot *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    /* Keep the memory, but mark the layer as uninitialized */
+    pCtx->staticLayer.maxDepth = 0;
+    pCtx->staticLayer.nodesUsed = 0;
+    pCtx->staticLayer.cellsUsed = 1;
+    pCtx->staticLayer.available = 0;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Add an object to the static layer
+ *
+ * NOTE: The object must be kept alive until the static layer is cleared!
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @param  [ in]pObj The gfmObject
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_QUADTREE_NOT_INITIALIZED
+ */
+gfmRV gfmQuadtree_populateStaticObject(gfmQuadtreeRoot *pCtx, gfmObject *pObj) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pObj, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->staticLayer.maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+
+    rv = gfmQuadtree_populateLayer(pCtx, &(pCtx->staticLayer), pObj, 0);
+__ret:
+    return rv;
+}
+
+/**
+ * Add a list of hitboxes to the static layer
+ *
+ * NOTE: The list must be kept alive until the static layer is cleared!
+ *
+ * @param  [ in]pCtx  The quadtree's root
+ * @param  [ in]pList The list of hitboxes
+ * @param  [ in]count How many hitboxes there are on the list
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                    GFMRV_QUADTREE_NOT_INITIALIZED
+ */
+gfmRV gfmQuadtree_populateStaticHitboxes(gfmQuadtreeRoot *pCtx,
+        gfmHitbox *pList, int count) {
+    gfmRV rv;
+    int i;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pList || count == 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(count >= 0, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->staticLayer.maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+
+    i = 0;
+    while (i < count) {
+        gfmHitbox *pHitbox;
+
+        rv = gfmHitbox_getItem(&pHitbox, pList, i);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        /* Conversion from gfmHitbox to gfmObject is valid if only the first
+         * field (a gfmHitbox) from the object will be used */
+        rv = gfmQuadtree_populateLayer(pCtx, &(pCtx->staticLayer),
+                (gfmObject*)pHitbox, 0);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        i++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Add a tilemap's areas to the static layer
+ *
+ * NOTE: The tilemap must not be modified until the static layer is cleared!
+ *
+ * @param  [ in]pCtx  The quadtree's root
+ * @param  [ in]pTMap The tilemap
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                    GFMRV_QUADTREE_NOT_INITIALIZED
+ */
+gfmRV gfmQuadtree_populateStaticTilemap(gfmQuadtreeRoot *pCtx,
+        gfmTilemap *pTMap) {
+    gfmObject *pList;
+    gfmRV rv;
+    int len;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pTMap, GFMRV_ARGUMENTS_BAD);
+
+    /* Get how many areas there are */
+    rv = gfmTilemap_getAreasLength(&len, pTMap);
+    ASSERT_NR(rv == GFMRV_OK);
+    if (len == 0) {
+        rv = GFMRV_OK;
+        goto __ret;
+    }
+    rv = gfmTilemap_getArea(&pList, pTMap, 0);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    rv = gfmQuadtree_populateStaticHitboxes(pCtx, (gfmHitbox*)pList, len);
+__ret:
+    return rv;
+}
+
+/**
+ * Set whether two types of objects interact with each other; Pairs that don't
+ * interact are skipped while colliding, never being tested for overlap nor
+ * reported
+ *
+ * Only the lowest 5 bits of each type are used (the same ones used as colors
+ * by gfmQuadtree_drawBounds); Objects added to the static layer keep the type
+ * they had when added
+ *
+ * @param  [ in]pCtx       The quadtree's root
+ * @param  [ in]type1      One of the types
+ * @param  [ in]type2      The other type
+ * @param  [ in]doInteract Whether the types should interact
+ * @return                 GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmQuadtree_setInteraction(gfmQuadtreeRoot *pCtx, int type1, int type2,
+        int doInteract) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    type1 = (uint32_t)type1 % gfmType_max;
+    type2 = (uint32_t)type2 % gfmType_max;
+    if (doInteract) {
+        pCtx->ignored[type1] &= ~(1u << type2);
+        pCtx->ignored[type2] &= ~(1u << type1);
+    }
+    else {
+        pCtx->ignored[type1] |= 1u << type2;
+        pCtx->ignored[type2] |= 1u << type1;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Make every type interact with every other (which is the default)
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmQuadtree_resetInteractions(gfmQuadtreeRoot *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    memset(pCtx->ignored, 0x0, sizeof(pCtx->ignored));
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Set how many threads gfmQuadtree_collideDeferred may use
+ *
+ * @param  [ in]pCtx       The quadtree's root
+ * @param  [ in]numThreads How many threads should be used (including the
+ *                         calling one); 1 disables threading
+ * @return                 GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED,
+ *                         GFMRV_THREADPOOL_CREATE_FAILED
+ */
+gfmRV gfmQuadtree_setThreads(gfmQuadtreeRoot *pCtx, int numThreads) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(numThreads > 0, GFMRV_ARGUMENTS_BAD);
+
+    /* Release the previous workers (if any) and spawn new ones */
+    gfmThreadPool_free(&(pCtx->pPool));
+    if (numThreads > 1) {
+        rv = gfmThreadPool_getNew(&(pCtx->pPool), numThreads);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Add an object to the quadtree, deferring its collision until
+ * gfmQuadtree_collideDeferred is called
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @param  [ in]pObj The gfmObject
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmQuadtree_deferObject(gfmQuadtreeRoot *pCtx, gfmObject *pObj) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pObj, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->dynamicLayer.maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+
+    rv = gfmQuadtree_deferLayer(pCtx, pObj);
+__ret:
+    return rv;
+}
+
+/**
+ * Add every collideable object from a group to the quadtree, deferring their
+ * collision until gfmQuadtree_collideDeferred is called
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @param  [ in]pGrp The gfmGroup
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmQuadtree_deferGroup(gfmQuadtreeRoot *pCtx, gfmGroup *pGrp) {
+    gfmGroupNode *pList;
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pGrp, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->dynamicLayer.maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+
+    /* Get the list of collideable objects */
+    rv = gfmGroup_getCollideableList(&pList, pGrp);
+    ASSERT(rv == GFMRV_OK || rv == GFMRV_GROUP_LIST_EMPTY, rv);
+    if (rv == GFMRV_GROUP_LIST_EMPTY) {
+        pList = 0;
+    }
+
+    while (pList) {
+        gfmSprite *pSpr;
+        gfmObject *pObj;
+
+        rv = gfmGroup_getNextSprite(&pSpr, &pList);
+        ASSERT(rv == GFMRV_OK, rv);
+        rv = gfmSprite_getObject(&pObj, pSpr);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        rv = gfmQuadtree_deferLayer(pCtx, pObj);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Collide every deferred object against both layers, splitting the work
+ * between the threads set by gfmQuadtree_setThreads; The overlaps are returned
+ * in the same order (and from the same point of view) as if the objects had
+ * been added by gfmQuadtree_collideObject, regardless of how many threads were
+ * used; On continuous mode, they are ordered by their time of impact instead;
+ * On incremental mode, every tracked object is collided (ordered by their
+ * handles)
+ *
+ * NOTE: The returned buffer is owned by the quadtree and is kept valid until
+ * either this function or gfmQuadtree_initRoot is called again
+ *
+ * @param  [out]ppPairs Every overlap found
+ * @param  [out]pCount  How many overlaps were found
+ * @param  [ in]pCtx    The quadtree's root
+ * @return              GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                      GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmQuadtree_collideDeferred(gfmQuadtreePair **ppPairs, int *pCount,
+        gfmQuadtreeRoot *pCtx) {
+    gfmQuadtreeLayer *pLayer;
+    int count, i, numTasks, total;
+    uint32_t node;
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(ppPairs, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCount, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->dynamicLayer.maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+
+    *ppPairs = 0;
+    *pCount = 0;
+    ASSERT(pCtx->deferredUsed > 0, GFMRV_OK);
+
+    /* Retrieve every leaf with at least two objects (on loose mode, each
+     * deferred object traverses the layer instead) */
+    pLayer = &(pCtx->dynamicLayer);
+    pCtx->leavesUsed = 0;
+    node = 0;
+    while (!pLayer->isLoose && node < pLayer->nodesUsed) {
+        gfmQuadtree *pNode;
+
+        pNode = pLayer->pNodes + node;
+        if (!pNode->children && pNode->nodes &&
+                pLayer->pCells[pNode->nodes].next) {
+            if (pCtx->leavesUsed >= pCtx->leavesLen) {
+                uint32_t *pTmp;
+                int len;
+
+                len = pCtx->leavesLen * 2;
+                if (len < gfmQT_deferredPerTask) {
+                    len = gfmQT_deferredPerTask;
+                }
+                pTmp = (uint32_t*)realloc(pCtx->pLeaves,
+                        sizeof(uint32_t) * len);
+                ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+                pCtx->pLeaves = pTmp;
+                pCtx->leavesLen = len;
+            }
+            pCtx->pLeaves[pCtx->leavesUsed] = node;
+            pCtx->leavesUsed++;
+        }
+        node++;
+    }
+
+    /* Collide each leaf and each chunk of deferred objects (against the
+     * static layer) as a separated task */
+    numTasks = pCtx->leavesUsed;
+    if (pCtx->staticLayer.maxDepth > 0 || pLayer->isLoose) {
+        numTasks += (pCtx->deferredUsed + gfmQT_deferredPerTask - 1) /
+                gfmQT_deferredPerTask;
+    }
+    rv = gfmQuadtree_prepareWorkers(pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+    if (pCtx->pPool) {
+        rv = gfmThreadPool_run(pCtx->pPool, gfmQuadtree_deferredTask,
+                (void*)pCtx, numTasks);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+    else {
+        i = 0;
+        while (i < numTasks) {
+            rv = gfmQuadtree_deferredTask((void*)pCtx, 0, i);
+            ASSERT_NR(rv == GFMRV_OK);
+            i++;
+        }
+    }
+
+    /* Merge every worker's overlaps (and counters) */
+    total = 0;
+    i = 0;
+    while (i < pCtx->numWorkers) {
+        total += pCtx->pWorkers[i].used;
+        pCtx->staticLayer.overlapTests += pCtx->pWorkers[i].staticTests;
+        pLayer->overlapTests += pCtx->pWorkers[i].dynamicTests;
+        i++;
+    }
+    ASSERT(total > 0, GFMRV_OK);
+    if (pCtx->sortedLen < total) {
+        gfmQuadtreeSortedPair *pTmp;
+
+        pTmp = (gfmQuadtreeSortedPair*)realloc(pCtx->pSorted,
+                sizeof(gfmQuadtreeSortedPair) * total);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+        pCtx->pSorted = pTmp;
+        pCtx->sortedLen = total;
+    }
+    if (pCtx->pairsLen < total) {
+        gfmQuadtreePair *pTmp;
+
+        pTmp = (gfmQuadtreePair*)realloc(pCtx->pPairs,
+                sizeof(gfmQuadtreePair) * total);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+        pCtx->pPairs = pTmp;
+        pCtx->pairsLen = total;
+    }
+    count = 0;
+    i = 0;
+    while (i < pCtx->numWorkers) {
+        gfmQuadtreeWorker *pWorker;
+
+        pWorker = pCtx->pWorkers + i;
+        if (pWorker->used > 0) {
+            memcpy(pCtx->pSorted + count, pWorker->pPairs,
+                    sizeof(gfmQuadtreeSortedPair) * pWorker->used);
+            count += pWorker->used;
+        }
+        i++;
+    }
+
+    /* Sort them (so the result doesn't depend on the threads) and remove
+     * pairs found on more than one leaf */
+    qsort(pCtx->pSorted, count, sizeof(gfmQuadtreeSortedPair),
+            gfmQuadtree_compareDeferred);
+    count = 0;
+    i = 0;
+    while (i < total) {
+        gfmQuadtreeSortedPair *pPair;
+
+        pPair = pCtx->pSorted + i;
+        if (i == 0 || pPair->selfSeq != pPair[-1].selfSeq ||
+                pPair->pair.isStatic != pPair[-1].pair.isStatic ||
+                pPair->otherSeq != pPair[-1].otherSeq) {
+            pCtx->pPairs[count] = pPair->pair;
+            count++;
+            if (pPair->pair.isStatic) {
+                pCtx->staticLayer.pairs++;
+            }
+            else {
+                pLayer->pairs++;
+            }
+        }
+        else {
+            pCtx->duplicates++;
+        }
+        i++;
+    }
+
+    *ppPairs = pCtx->pPairs;
+    *pCount = count;
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Retrieve every object (from both layers) that touches an area, without
+ * modifying the quadtree; Objects are returned in the order they were added
+ * (with the ones on the static layer first)
+ *
+ * NOTE: This may be safely called while handling an overlap
+ *
+ * @param  [out]ppObjs  Buffer that will be filled with the objects
+ * @param  [out]pCount  How many objects were stored on the buffer
+ * @param  [ in]pCtx    The quadtree's root
+ * @param  [ in]x       The area's top-left position
+ * @param  [ in]y       The area's top-left position
+ * @param  [ in]width   The area's width
+ * @param  [ in]height  The area's height
+ * @param  [ in]maxObjs How many objects fit on the buffer
+ * @return              GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                      GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED,
+ *                      GFMRV_BUFFER_TOO_SMALL (the buffer was filled, but
+ *                      more objects were found)
+ */
+gfmRV gfmQuadtree_queryRect(gfmObject **ppObjs, int *pCount,
+        gfmQuadtreeRoot *pCtx, int x, int y, int width, int height,
+        int maxObjs) {
+    gfmQuadtreeQuery query;
+    gfmRV rv;
+
+    /* Sanitize arguments (other checks are done in sub-functions) */
+    ASSERT(width >= 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(height >= 0, GFMRV_ARGUMENTS_BAD);
+
+    memset(&query, 0x0, sizeof(gfmQuadtreeQuery));
+    query.left = x;
+    query.top = y;
+    query.right = x + width;
+    query.bottom = y + height;
+
+    rv = gfmQuadtree_query(ppObjs, pCount, pCtx, &query, maxObjs);
+__ret:
+    return rv;
+}
+
+/**
+ * Retrieve every object (from both layers) that touches a point, without
+ * modifying the quadtree; Objects are returned in the order they were added
+ * (with the ones on the static layer first)
+ *
+ * NOTE: This may be safely called while handling an overlap
+ *
+ * @param  [out]ppObjs  Buffer that will be filled with the objects
+ * @param  [out]pCount  How many objects were stored on the buffer
+ * @param  [ in]pCtx    The quadtree's root
+ * @param  [ in]x       The point's position
+ * @param  [ in]y       The point's position
+ * @param  [ in]maxObjs How many objects fit on the buffer
+ * @return              GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                      GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED,
+ *                      GFMRV_BUFFER_TOO_SMALL (the buffer was filled, but
+ *                      more objects were found)
+ */
+gfmRV gfmQuadtree_queryPoint(gfmObject **ppObjs, int *pCount,
+        gfmQuadtreeRoot *pCtx, int x, int y, int maxObjs) {
+    return gfmQuadtree_queryRect(ppObjs, pCount, pCtx, x, y, 0, 0, maxObjs);
+}
+
+/**
+ * Retrieve every object (from both layers) crossed by a segment, without
+ * modifying the quadtree; Objects are returned ordered by their distance to
+ * the segment's start (so the first one is the one that blocks a line of
+ * sight)
+ *
+ * NOTE: This may be safely called while handling an overlap
+ *
+ * @param  [out]ppObjs  Buffer that will be filled with the objects
+ * @param  [out]pCount  How many objects were stored on the buffer
+ * @param  [ in]pCtx    The quadtree's root
+ * @param  [ in]x0      The segment's start
+ * @param  [ in]y0      The segment's start
+ * @param  [ in]x1      The segment's end
+ * @param  [ in]y1      The segment's end
+ * @param  [ in]maxObjs How many objects fit on the buffer
+ * @return              GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                      GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED,
+ *                      GFMRV_BUFFER_TOO_SMALL (the buffer was filled with the
+ *                      nearest objects, but more were found)
+ */
+gfmRV gfmQuadtree_queryRay(gfmObject **ppObjs, int *pCount,
+        gfmQuadtreeRoot *pCtx, int x0, int y0, int x1, int y1, int maxObjs) {
+    gfmQuadtreeQuery query;
+
+    query.isRay = 1;
+    query.x0 = x0;
+    query.y0 = y0;
+    query.x1 = x1;
+    query.y1 = y1;
+    /* Bounding box of the segment, used to quickly discard objects */
+    query.left = (x0 < x1) ? x0 : x1;
+    query.right = (x0 < x1) ? x1 : x0;
+    query.top = (y0 < y1) ? y0 : y1;
+    query.bottom = (y0 < y1) ? y1 : y0;
+
+    return gfmQuadtree_query(ppObjs, pCount, pCtx, &query, maxObjs);
+}
+
+/**
+ * Enable (or disable) the continuous mode; On it, objects are inserted into
+ * (and tested against) the quadtree by the area swept since their last update,
+ * and pairs overlap if they touched at any moment during that movement; This
+ * avoids fast objects going through thin ones (e.g., tilemap areas), at the
+ * cost of fatter objects
+ *
+ * The time of each overlap may be retrieved through
+ * gfmQuadtree_getTimeOfImpact (or from the pair's time, on the batched
+ * functions); gfmQuadtree_collideDeferred returns pairs ordered by it
+ *
+ * NOTE: This should be set before populating either layer
+ *
+ * @param  [ in]pCtx         The quadtree's root
+ * @param  [ in]isContinuous Whether continuous mode should be enabled
+ * @return                   GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmQuadtree_setContinuous(gfmQuadtreeRoot *pCtx, int isContinuous) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    pCtx->dynamicLayer.isSwept = (isContinuous != 0);
+    pCtx->staticLayer.isSwept = (isContinuous != 0);
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Retrieve when the current overlap happened, in the range [0, 1] (where 0 is
+ * the objects' previous position and 1 their current one); Only meaningful on
+ * continuous mode (otherwise, it's always 0)
+ *
+ * @param  [out]pTime When the objects first touched
+ * @param  [ in]pCtx  The quadtree's root
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NO_OVERLAP
+ */
+gfmRV gfmQuadtree_getTimeOfImpact(double *pTime, gfmQuadtreeRoot *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pTime, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Check that there's an overlap */
+    ASSERT(pCtx->pOther, GFMRV_QUADTREE_NO_OVERLAP);
+
+    *pTime = pCtx->time;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Clean up the previous state and ready the quadtree for incremental mode; On
+ * it, the dynamic layer is kept across frames: objects are added only once
+ * (through gfmQuadtree_trackObject) and gfmQuadtree_refresh moves them to the
+ * leaves they currently overlap; Overlaps are then retrieved through
+ * gfmQuadtree_collideDeferred
+ *
+ * NOTE: gfmQuadtree_collide*, gfmQuadtree_populate* and gfmQuadtree_defer*
+ * can't be used on incremental mode; Calling gfmQuadtree_initRoot leaves it
+ *
+ * @param  pCtx     The quadtree root context
+ * @param  x        The quadtree top-left position
+ * @param  y        The quadtree top-left position
+ * @param  width    The quadtree width
+ * @param  height   The quadtree height
+ * @param  maxDepth How many levels can the quadtree branch
+ * @param  maxNodes How many objects a subtree can have until it must split
+ * @return          GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmQuadtree_initIncremental(gfmQuadtreeRoot *pCtx, int x, int y,
+        int width, int height, int maxDepth, int maxNodes) {
+    gfmRV rv;
+
+    rv = gfmQuadtree_initRoot(pCtx, x, y, width, height, maxDepth, maxNodes);
+    ASSERT_NR(rv == GFMRV_OK);
+    pCtx->isIncremental = 1;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Add an object to the incremental quadtree, where it's kept until
+ * gfmQuadtree_untrackObject is called (or the quadtree is re-initialized)
+ *
+ * NOTE: The object's type is only retrieved when it's added
+ *
+ * @param  [out]pHandle Handle used to remove the object (also used as its
+ *                      order, when sorting the overlaps)
+ * @param  [ in]pCtx    The quadtree's root
+ * @param  [ in]pObj    The gfmObject
+ * @return              GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                      GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                      GFMRV_QUADTREE_INVALID_MODE, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmQuadtree_trackObject(int *pHandle, gfmQuadtreeRoot *pCtx,
+        gfmObject *pObj) {
+    gfmQuadtreeDeferred *pTracked;
+    gfmRV rv;
+    int handle;
+
+    /* Sanitize arguments */
+    ASSERT(pHandle, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pObj, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->dynamicLayer.maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+    /* Tracked objects rely on the leaves they overlap (see
+     * gfmQuadtree_setLoose) */
+    ASSERT(pCtx->isIncremental && !pCtx->dynamicLayer.isLoose,
+            GFMRV_QUADTREE_INVALID_MODE);
+
+    /* Recycle an unused handle, if any */
+    if (pCtx->trackedFree) {
+        handle = pCtx->trackedFree - 1;
+        pCtx->trackedFree = pCtx->pDeferred[handle].nextFree;
+    }
+    else {
+        rv = gfmQuadtree_expandDeferred(pCtx);
+        ASSERT_NR(rv == GFMRV_OK);
+        handle = pCtx->deferredUsed;
+        pCtx->deferredUsed++;
+    }
+
+    pTracked = pCtx->pDeferred + handle;
+    pTracked->pSelf = pObj;
+    pTracked->seq = (uint32_t)handle;
+    rv = gfmQuadtree_getType(&(pTracked->type), pObj);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmQuadtree_getArea(&(pTracked->area), pObj,
+            pCtx->dynamicLayer.isSwept);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmQuadtree_insertTracked(pCtx, pTracked);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    *pHandle = handle;
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Remove an object from the incremental quadtree; Nodes left sparse are only
+ * merged on the next gfmQuadtree_refresh
+ *
+ * @param  [ in]pCtx   The quadtree's root
+ * @param  [ in]handle The object's handle
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                     GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                     GFMRV_QUADTREE_INVALID_MODE, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmQuadtree_untrackObject(gfmQuadtreeRoot *pCtx, int handle) {
+    gfmQuadtreeDeferred *pTracked;
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->dynamicLayer.maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+    ASSERT(pCtx->isIncremental, GFMRV_QUADTREE_INVALID_MODE);
+    ASSERT(handle >= 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(handle < pCtx->deferredUsed, GFMRV_ARGUMENTS_BAD);
+    pTracked = pCtx->pDeferred + handle;
+    ASSERT(pTracked->pSelf, GFMRV_ARGUMENTS_BAD);
+
+    rv = gfmQuadtree_removeTracked(pCtx, pTracked);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    /* Release the handle */
+    pTracked->pSelf = 0;
+    pTracked->nextFree = pCtx->trackedFree;
+    pCtx->trackedFree = handle + 1;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Update the incremental quadtree with every tracked object's current
+ * position; Objects are only removed from (and re-inserted into) the layer if
+ * they crossed the bounds of any of its nodes (or if a node around them was
+ * subdivided or merged); Nodes left sparse are merged afterward
+ *
+ * @param  [ in]pCtx The quadtree's root
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                   GFMRV_QUADTREE_INVALID_MODE, GFMRV_ALLOC_FAILED,
+ *                   GFMRV_QUADTREE_STACK_OVERFLOW
+ */
+gfmRV gfmQuadtree_refresh(gfmQuadtreeRoot *pCtx) {
+    gfmQuadtreeLayer *pLayer;
+    gfmRV rv;
+    int i;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->dynamicLayer.maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+    ASSERT(pCtx->isIncremental && !pCtx->dynamicLayer.isLoose,
+            GFMRV_QUADTREE_INVALID_MODE);
+
+    /* Start a new frame */
+    gfmQuadtree_resetCounters(pCtx);
+
+    pLayer = &(pCtx->dynamicLayer);
+    i = 0;
+    while (i < pCtx->deferredUsed) {
+        gfmQuadtreeDeferred *pTracked;
+        gfmQuadtreeArea area;
+
+        pTracked = pCtx->pDeferred + i;
+        i++;
+        if (!pTracked->pSelf) {
+            continue;
+        }
+
+        rv = gfmQuadtree_getArea(&area, pTracked->pSelf, pLayer->isSwept);
+        ASSERT_NR(rv == GFMRV_OK);
+        if (area.centerX == pTracked->area.centerX &&
+                area.centerY == pTracked->area.centerY &&
+                area.halfWidth == pTracked->area.halfWidth &&
+                area.halfHeight == pTracked->area.halfHeight) {
+            continue;
+        }
+
+        /* If none of its leaves was subdivided and it didn't cross any
+         * node's bounds, it's still on the same leaves (merging nodes never
+         * changes that) */
+        if (pTracked->isValid &&
+                area.halfWidth == pTracked->area.halfWidth &&
+                area.halfHeight == pTracked->area.halfHeight &&
+                area.centerX >= pTracked->minX &&
+                area.centerX <= pTracked->maxX &&
+                area.centerY >= pTracked->minY &&
+                area.centerY <= pTracked->maxY) {
+            pTracked->area = area;
+            continue;
+        }
+
+        rv = gfmQuadtree_removeTracked(pCtx, pTracked);
+        ASSERT_NR(rv == GFMRV_OK);
+        pTracked->area = area;
+        rv = gfmQuadtree_insertTracked(pCtx, pTracked);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+
+    rv = gfmQuadtree_collapse(pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Enable (or disable) the loose mode; On it, each node's bounds are expanded
+ * by a factor and every object is inserted into a single node (the deepest one
+ * whose expanded bounds contain it, chosen by the object's center), instead of
+ * into every leaf it overlaps; Big objects are therefore kept on nodes closer
+ * to the root, so the memory used doesn't grow with the objects' sizes and
+ * each pair is tested only once
+ *
+ * NOTE: This should be set before populating either layer; It can't be used
+ * with the incremental mode
+ *
+ * @param  [ in]pCtx      The quadtree's root
+ * @param  [ in]looseness By how much each node's bounds are expanded (2.0 is
+ *                        usually a good value), or 0 to disable loose mode
+ * @return                GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmQuadtree_setLoose(gfmQuadtreeRoot *pCtx, double looseness) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(looseness == 0.0 || looseness >= 1.0, GFMRV_ARGUMENTS_BAD);
+
+    pCtx->dynamicLayer.isLoose = (looseness >= 1.0);
+    pCtx->dynamicLayer.looseness = looseness;
+    pCtx->staticLayer.isLoose = (looseness >= 1.0);
+    pCtx->staticLayer.looseness = looseness;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Retrieve the stats of one of the quadtree's layers: how its nodes and
+ * objects are distributed (which is traversed on every call) and how many
+ * pairs were tested and reported on the current frame; Useful to tune
+ * maxDepth and maxNodes
+ *
+ * @param  [out]pStats   The stats
+ * @param  [ in]pCtx     The quadtree's root
+ * @param  [ in]isStatic Whether the static layer's stats should be retrieved
+ *                       (instead of the dynamic one's)
+ * @return               GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                       GFMRV_QUADTREE_NOT_INITIALIZED
  */
-gfmRV gfmQuadtree_populateSprite(gfmQuadtreeRoot *pCtx, gfmSprite *pSpr) {
-    gfmObject *pObj;
+gfmRV gfmQuadtree_getStats(gfmQuadtreeStats *pStats, gfmQuadtreeRoot *pCtx,
+        int isStatic) {
+    gfmQuadtreeLayer *pLayer;
     gfmRV rv;
-    
-    // Sanitize sprite (other checks are done in sub-functions)
-    ASSERT(pSpr, GFMRV_ARGUMENTS_BAD);
-    // Retrieve the sprite's object
-    rv = gfmSprite_getObject(&pObj, pSpr);
-    ASSERT_NR(rv == GFMRV_OK);
-    // Add it to the quadtree
-    rv = gfmQuadtree_populateObject(pCtx, pObj);
+
+    /* Sanitize arguments */
+    ASSERT(pStats, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    if (isStatic) {
+        pLayer = &(pCtx->staticLayer);
+    }
+    else {
+        pLayer = &(pCtx->dynamicLayer);
+    }
+    /* Check if initialized */
+    ASSERT(pLayer->maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+
+    gfmQuadtree_getLayerStats(pStats, pLayer);
+
+    rv = GFMRV_OK;
 __ret:
     return rv;
 }
 
 /**
- * Populates a quadtree with tilemap's areas
- * 
- * @param  pCtx  The quadtree's root
- * @param  pTMap The tilemap
- * @return       GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED
+ * Set whether gfmQuadtree_drawBounds should also print the dynamic layer's
+ * stats (as retrieved by gfmQuadtree_getStats)
+ *
+ * This function uses an internal bitmap font, only available on debug mode.
+ * Therefore, the stats are never printed on release mode.
+ *
+ * @param  [ in]pCtx      The quadtree's root
+ * @param  [ in]drawStats Whether the stats should be printed
+ * @param  [ in]x         Horizontal position (in screen space)
+ * @param  [ in]y         Vertical position (in screen space)
+ * @return                GFMRV_OK, GFMRV_ARGUMENTS_BAD
  */
-gfmRV gfmQuadtree_populateTilemap(gfmQuadtreeRoot *pCtx, gfmTilemap *pTMap) {
-    gfmObject *pList;
+gfmRV gfmQuadtree_setDrawStats(gfmQuadtreeRoot *pCtx, int drawStats, int x,
+        int y) {
     gfmRV rv;
-    int len;
 
     /* Sanitize arguments */
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
-    ASSERT(pTMap, GFMRV_ARGUMENTS_BAD);
 
-    /* Get how many areas there are */
-    rv = gfmTilemap_getAreasLength(&len, pTMap);
-    ASSERT_NR(rv == GFMRV_OK);
-    rv = gfmTilemap_getArea(&pList, pTMap, 0);
-    ASSERT_NR(rv == GFMRV_OK);
+    pCtx->drawStats = (drawStats != 0);
+    pCtx->statsX = x;
+    pCtx->statsY = y;
 
-    rv = gfmHitbox_populateQuadtree((gfmHitbox*)pList, pCtx, len);
+    rv = GFMRV_OK;
 __ret:
     return rv;
 }
@@ -1008,6 +4499,28 @@ __ret:
     return rv;
 }
 
+/**
+ * Retrieve how many overlaps were ignored on the current frame for being
+ * duplicated (i.e., the pair was already reported on another leaf)
+ *
+ * @param  [out]pCount How many overlaps were ignored
+ * @param  [ in]pCtx   The quadtree's root
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmQuadtree_getDuplicatedCount(int *pCount, gfmQuadtreeRoot *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCount, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    *pCount = pCtx->duplicates;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
 /**
  * Continue colliding and adding the node to the quadtree
  * 
@@ -1024,103 +4537,128 @@ gfmRV gfmQuadtree_continue(gfmQuadtreeRoot *pCtx) {
     ASSERT(pCtx->pGroupList || pCtx->pObject,
             GFMRV_QUADTREE_OPERATION_NOT_ACTIVE);
     
-    // Continue adding the object
-    while (pCtx->stack.pushPos > 0 || pCtx->pColliding) {
-        gfmQuadtree *pNode;
-        
-        // If we were colliding againts objects
-        if (pCtx->pColliding) {
-            gfmQuadtreeLL *pTmp;
-            
-            // Retrieve the current object and update the list
-            pTmp = pCtx->pColliding;
-            pCtx->pColliding = pCtx->pColliding->pNext;
-            
-            // Check if both objects overlaps
-            pCtx->pOther = pTmp->pSelf;
-            rv = gfmObject_isOverlaping(pCtx->pObject, pCtx->pOther);
-            
-            // -- Exit point --
-            // If they did overlap, return with that status
-            if (rv == GFMRV_TRUE) {
-                return GFMRV_QUADTREE_OVERLAPED;
-            }
-            //ASSERT(rv != GFMRV_TRUE, GFMRV_QUADTREE_OVERLAPED);
-        }
-        else {
-            // Pop the current node
-            rv = gfmQuadtree_popNode(&pNode, pCtx);
-            ASSERT_NR(rv == GFMRV_OK);
-            
-            // If it has children, push its children
-            if (pNode->ppChildren[gfmQT_nw]) {
-                gfmQuadtreePosition i;
-                gfmQuadtree *pChild;
+    rv = gfmQuadtree_run(pCtx);
+__ret:
+    return rv;
+}
 
-                i = gfmQT_nw;
-                while (i < gfmQT_max) {
-                    // Get the current child
-                    pChild = pNode->ppChildren[i];
-                    // Check if the object overlaps this node
-                    rv = gfmQuadtree_overlap(pChild, pCtx->pObject);
-                    if (rv == GFMRV_TRUE) {
-                        // Push it (so it will collide later)
-                        rv = gfmQuadtree_pushNode(pCtx, pChild);
-                        ASSERT_NR(rv == GFMRV_OK);
-                    }
-                    i++;
-                }
-            }
-            else {
-                // If it's static, collide against the node's children
-                if (pCtx->isStatic) {
-                    pCtx->pColliding = pNode->pNodes;
-                }
-                // Otherwise, check if inserting the node would subdivide
-                // the node (and if there's still room for that
-                else if (pNode->numObjects + 1 > pCtx->maxNodes &&
-                        pNode->depth + 1 < pCtx->maxDepth) {
-                    // Subdivide the tree
-                    rv = gfmQuadtree_subdivide(pCtx, pNode);
-                    ASSERT_NR(rv == GFMRV_OK);
-                    // Push the node again so its children are overlapped/pushed
-                    rv = gfmQuadtree_pushNode(pCtx, pNode);
-                    ASSERT_NR(rv == GFMRV_OK);
-                }
-                else {
-                    // Otherwise, collide with its nodes
-                    pCtx->pColliding = pNode->pNodes;
-                    // Add the object to this node 
-                    // NOTE: It's added to the begin, so it won't overlap itself
-                    rv = gfmQuadtree_insertObject(pCtx, pNode, pCtx->pObject);
-                    ASSERT_NR(rv == GFMRV_OK);
-                }
-            }
-        }
-    }
-    
-    // Check if there's another object from a group
-    if (pCtx->pGroupList) {
-        gfmSprite *pSpr;
-        
-        while (pCtx->pGroupList) {
-            // Retrieve the next sprite...
-            rv = gfmGroup_getNextSprite(&pSpr, &(pCtx->pGroupList));
-            ASSERT(rv == GFMRV_OK, rv);
-            
-            // Collide it!
-            rv = gfmQuadtree_collideSprite(pCtx, pSpr);
-            if (rv != GFMRV_QUADTREE_DONE) {
-                // If this sprite didn't finish, return its status
-                return rv;
-            }
-            // If this sprite didn't collide, go to the next
-        }
+/**
+ * Adds a new gfmGroup to the quadtree, colliding every one of its objects and
+ * storing the overlaps into a buffer instead of halting on each of them
+ *
+ * If the buffer gets filled, GFMRV_QUADTREE_OVERLAPED is returned and
+ * gfmQuadtree_continueBatch must be called (after handling the pairs) to
+ * resume the operation
+ *
+ * @param  [out]pPairs   Buffer that will be filled with the overlaps
+ * @param  [out]pCount   How many overlaps were stored on the buffer
+ * @param  [ in]pCtx     The quadtree's root
+ * @param  [ in]pGrp     The gfmGroup
+ * @param  [ in]maxPairs How many overlaps fit on the buffer
+ * @return               GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                       GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmQuadtree_collideGroupBatch(gfmQuadtreePair *pPairs, int *pCount,
+        gfmQuadtreeRoot *pCtx, gfmGroup *pGrp, int maxPairs) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pPairs, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCount, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pGrp, GFMRV_ARGUMENTS_BAD);
+    ASSERT(maxPairs > 0, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->dynamicLayer.maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+
+    *pCount = 0;
+
+    /* Get the list of collideable objects */
+    rv = gfmGroup_getCollideableList(&(pCtx->pGroupList), pGrp);
+    ASSERT(rv == GFMRV_OK || rv == GFMRV_GROUP_LIST_EMPTY, rv);
+    if (rv == GFMRV_GROUP_LIST_EMPTY) {
+        rv = GFMRV_QUADTREE_DONE;
+        goto __ret;
     }
-    
-    // If the loop stoped, the operation finished
+
+    /* Clear any previous operation */
+    pCtx->stack.pushPos = 0;
     pCtx->pObject = 0;
-    rv = GFMRV_QUADTREE_DONE;
+    pCtx->colliding = 0;
+    pCtx->pOther = 0;
+
+    rv = gfmQuadtree_fillPairs(pPairs, pCount, pCtx, maxPairs);
+__ret:
+    return rv;
+}
+
+/**
+ * Adds a new gfmObject to the quadtree, storing every overlap into a buffer
+ * instead of halting on each of them
+ *
+ * If the buffer gets filled, GFMRV_QUADTREE_OVERLAPED is returned and
+ * gfmQuadtree_continueBatch must be called (after handling the pairs) to
+ * resume the operation
+ *
+ * @param  [out]pPairs   Buffer that will be filled with the overlaps
+ * @param  [out]pCount   How many overlaps were stored on the buffer
+ * @param  [ in]pCtx     The quadtree's root
+ * @param  [ in]pObj     The gfmObject
+ * @param  [ in]maxPairs How many overlaps fit on the buffer
+ * @return               GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                       GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmQuadtree_collideObjectBatch(gfmQuadtreePair *pPairs, int *pCount,
+        gfmQuadtreeRoot *pCtx, gfmObject *pObj, int maxPairs) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pPairs, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCount, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pObj, GFMRV_ARGUMENTS_BAD);
+    ASSERT(maxPairs > 0, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->dynamicLayer.maxDepth > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+
+    *pCount = 0;
+
+    rv = gfmQuadtree_startObject(pCtx, pObj);
+    if (rv == GFMRV_QUADTREE_DONE) {
+        goto __ret;
+    }
+    ASSERT_NR(rv == GFMRV_OK);
+
+    rv = gfmQuadtree_fillPairs(pPairs, pCount, pCtx, maxPairs);
+__ret:
+    return rv;
+}
+
+/**
+ * Continue a batched collision, after its buffer was filled
+ *
+ * @param  [out]pPairs   Buffer that will be filled with the overlaps
+ * @param  [out]pCount   How many overlaps were stored on the buffer
+ * @param  [ in]pCtx     The quadtree's root
+ * @param  [ in]maxPairs How many overlaps fit on the buffer
+ * @return               GFMRV_ARGUMENTS_BAD,
+ *                       GFMRV_QUADTREE_OPERATION_NOT_ACTIVE,
+ *                       GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmQuadtree_continueBatch(gfmQuadtreePair *pPairs, int *pCount,
+        gfmQuadtreeRoot *pCtx, int maxPairs) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pPairs, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCount, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(maxPairs > 0, GFMRV_ARGUMENTS_BAD);
+    /* Check that the operation is active */
+    ASSERT(pCtx->pGroupList || pCtx->pObject,
+            GFMRV_QUADTREE_OPERATION_NOT_ACTIVE);
+
+    rv = gfmQuadtree_fillPairs(pPairs, pCount, pCtx, maxPairs);
 __ret:
     return rv;
 }
@@ -1141,6 +4679,9 @@ __ret:
  * This way, the user may specify 27 different types, each of which may be used
  * in any of 2^27 different entities.
  * NOTE: This functions will be most likely slow!! Be careful when calling it!
+ *
+ * If enabled through gfmQuadtree_setDrawStats, the dynamic layer's stats are
+ * printed over it (only on debug mode).
  * 
  * @param  pQt     The quadtree's root
  * @param  pCtx    The game's context
@@ -1162,97 +4703,22 @@ gfmRV gfmQuadtree_drawBounds(gfmQuadtreeRoot *pQt, gfmCtx *pCtx,
         pColors = gfmQt_defColors;
     }
     
-    // Clear the call stack
-    pQt->stack.pushPos = 0;
-    
-    // Push the root node to start colliding
-    rv = gfmQuadtree_pushNode(pQt, pQt->pSelf);
-    ASSERT_NR(rv == GFMRV_OK);
-    
-    // Iterate through all nodes
-    while (pQt->stack.pushPos > 0 || pQt->pColliding) {
-        gfmQuadtree *pNode;
-        unsigned char *pNodeColor;
-        
-        // Pop the current node
-        rv = gfmQuadtree_popNode(&pNode, pQt);
-        ASSERT_NR(rv == GFMRV_OK);
-        
-        // Get the colors for the qt node
-        pNodeColor = pColors;
-        // Draw the current node
-        rv = gfm_drawRect(pCtx, pNode->centerX - pNode->halfWidth,
-                pNode->centerY - pNode->halfHeight, pNode->halfWidth * 2,
-                pNode->halfHeight * 2, pNodeColor[0], pNodeColor[1],
-                pNodeColor[2]);
+    // Draw the static layer (if any) and then the dynamic one
+    if (pQt->staticLayer.maxDepth > 0) {
+        pQt->pLayer = &(pQt->staticLayer);
+        rv = gfmQuadtree_drawLayer(pQt, pCtx, pColors);
         ASSERT_NR(rv == GFMRV_OK);
-        
-        // If it has children, push its children
-        if (pNode->ppChildren[gfmQT_nw]) {
-            gfmQuadtreePosition i;
-            gfmQuadtree *pChild;
+    }
+    pQt->pLayer = &(pQt->dynamicLayer);
+    rv = gfmQuadtree_drawLayer(pQt, pCtx, pColors);
+    ASSERT_NR(rv == GFMRV_OK);
 
-            i = gfmQT_nw;
-            while (i < gfmQT_max) {
-                // Get the current child
-                pChild = pNode->ppChildren[i];
-                // Push it (so it will be drawn later)
-                rv = gfmQuadtree_pushNode(pQt, pChild);
-                ASSERT_NR(rv == GFMRV_OK);
-                i++;
-            }
-        }
-        else {
-            gfmQuadtreeLL *pTmp;
-            
-            // Otherwise, draw its nodes
-            pTmp = pNode->pNodes;
-            
-            while (pTmp) {
-                unsigned int type;
-                int height, width, x, y;
-                void *pChild;
-                
-                // Get the object's child
-                rv = gfmObject_getChild(&pChild, (int*)&type, pTmp->pSelf);
-                ASSERT_NR(rv == GFMRV_OK);
-                if (type == gfmType_sprite) {
-                    rv = gfmSprite_getChild(&pChild, (int*)&type,
-                            (gfmSprite*)pChild);
-                    ASSERT_NR(rv == GFMRV_OK);
-                    
-                    if (type == gfmType_none) {
-                        // If no custom type was specified, set it to sprite
-                        type = gfmType_sprite;
-                    }
-                }
-                else if (type == gfmType_none) {
-                    // If no custom type was specified, set it to object
-                    type = gfmType_object;
-                }
-                
-                // Get the object's color
-                if (type >= gfmType_max)
-                    type = (type % gfmType_max);
-                pNodeColor = pColors + type * 3;
-                
-                // Get the object's position
-                rv = gfmObject_getPosition(&x, &y, pTmp->pSelf);
-                ASSERT_NR(rv == GFMRV_OK);
-                // Get the object's dimensions
-                rv = gfmObject_getDimensions(&width, &height, pTmp->pSelf);
-                ASSERT_NR(rv == GFMRV_OK);
-                
-                // Draw the current node
-                rv = gfm_drawRect(pCtx, x, y, width, height, pNodeColor[0],
-                        pNodeColor[1], pNodeColor[2]);
-                ASSERT_NR(rv == GFMRV_OK);
-                
-                pTmp = pTmp->pNext;
-            }
-        }
+#if defined(DEBUG)
+    if (pQt->drawStats) {
+        gfmQuadtree_drawStats(pQt, pCtx);
     }
-    
+#endif
+
     rv = GFMRV_OK;
 __ret:
     return rv;
@@ -0,0 +1,840 @@
+/**
+ * @file src/gfmSpatialGrid.c
+ *
+ * Uniform grid broadphase; Each cell points to a linked-list of the objects
+ * that touch it, and every list node is retrieved from a single pool (that is
+ * reset on every frame);
+ * To avoid reporting a pair more than once, a pair is only checked on the
+ * first cell shared by both objects (i.e., the top-left cell of the
+ * intersection of their cell ranges)
+ */
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmGroup.h>
+#include <GFraMe/gfmObject.h>
+#include <GFraMe/gfmSpatialGrid.h>
+#include <GFraMe/gfmSprite.h>
+#include <GFraMe/gfmTilemap.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** An object added to the grid */
+typedef struct stGFMSpatialGridEntry gfmSpatialGridEntry;
+/** Node of a cell's list of objects */
+typedef struct stGFMSpatialGridNode gfmSpatialGridNode;
+
+/** Minimum number of items alloc'ed on each pool */
+enum {
+    gfmSG_minLen = 256
+};
+
+/** An object added to the grid */
+struct stGFMSpatialGridEntry {
+    /** The object */
+    gfmObject *pSelf;
+    /** First column touched by the object */
+    int x0;
+    /** First row touched by the object */
+    int y0;
+    /** Last column touched by the object */
+    int x1;
+    /** Last row touched by the object */
+    int y1;
+};
+
+/** Node of a cell's list of objects */
+struct stGFMSpatialGridNode {
+    /** Index of the object's entry */
+    uint32_t entry;
+    /** Next node on the list (0 if this is the last one) */
+    uint32_t next;
+    /** Column of the cell (since many cells may share a bucket) */
+    int cx;
+    /** Row of the cell (since many cells may share a bucket) */
+    int cy;
+};
+
+/** Spatial grid's context, with its cells and the current overlap */
+struct stGFMSpatialGrid {
+    /** Grid's top-left position */
+    int x;
+    int y;
+    /** Dimensions of each cell (0 if not initialized) */
+    int cellWidth;
+    int cellHeight;
+    /** Number of columns (if the cells are dense) */
+    int cols;
+    /** Number of rows (if the cells are dense) */
+    int rows;
+    /** Whether the cells are hashed into buckets */
+    int isHashed;
+    /** First node of each cell (or bucket) */
+    uint32_t *pCells;
+    /** How many cells (or buckets) are in use */
+    uint32_t numCells;
+    /** How many cells fit on the array */
+    uint32_t cellsLen;
+    /** Pool of list nodes; The first one is reserved as the list's end */
+    gfmSpatialGridNode *pNodes;
+    /** How many nodes are in use */
+    uint32_t nodesUsed;
+    /** How many nodes fit on the pool */
+    uint32_t nodesLen;
+    /** Every object added on this frame */
+    gfmSpatialGridEntry *pEntries;
+    /** How many entries are in use */
+    uint32_t entriesUsed;
+    /** How many entries fit on the array */
+    uint32_t entriesLen;
+    /** List of collideables objects from a group */
+    gfmGroupNode *pGroupList;
+    /** Object currently being collided */
+    gfmObject *pObject;
+    /** Entry of the object currently being collided */
+    uint32_t cur;
+    /** Column of the cell currently being collided */
+    int cx;
+    /** Row of the cell currently being collided */
+    int cy;
+    /** Next node to be checked against the current object */
+    uint32_t colliding;
+    /** Object that overlaped the current one */
+    gfmObject *pOther;
+};
+
+/**
+ * Divide an integer, rounding it toward negative infinity
+ *
+ * @param  [ in]a The dividend
+ * @param  [ in]b The divisor (must be positive)
+ * @return        The quotient
+ */
+static int gfmSpatialGrid_floorDiv(int a, int b) {
+    if (a < 0) {
+        return -((-a + b - 1) / b);
+    }
+    return a / b;
+}
+
+/**
+ * Retrieve the index of a cell on the array (or its bucket)
+ *
+ * @param  [ in]pCtx The grid
+ * @param  [ in]cx   Column of the cell
+ * @param  [ in]cy   Row of the cell
+ * @return           The index
+ */
+static uint32_t gfmSpatialGrid_getCell(gfmSpatialGrid *pCtx, int cx, int cy) {
+    if (pCtx->isHashed) {
+        uint32_t hash;
+
+        hash = ((uint32_t)cx * 73856093u) ^ ((uint32_t)cy * 19349663u);
+        return hash & (pCtx->numCells - 1);
+    }
+    return (uint32_t)(cy * pCtx->cols + cx);
+}
+
+/**
+ * Add an object to a cell's list
+ *
+ * @param  [ in]pCtx  The grid
+ * @param  [ in]entry Index of the object's entry
+ * @param  [ in]cx    Column of the cell
+ * @param  [ in]cy    Row of the cell
+ * @return            GFMRV_OK, GFMRV_ALLOC_FAILED
+ */
+static gfmRV gfmSpatialGrid_insert(gfmSpatialGrid *pCtx, uint32_t entry,
+        int cx, int cy) {
+    gfmSpatialGridNode *pNode;
+    uint32_t cell;
+    gfmRV rv;
+
+    /* Expand the pool as necessary */
+    if (pCtx->nodesUsed >= pCtx->nodesLen) {
+        gfmSpatialGridNode *pTmp;
+        uint32_t len;
+
+        len = pCtx->nodesLen * 2;
+        if (len < gfmSG_minLen) {
+            len = gfmSG_minLen;
+        }
+        pTmp = (gfmSpatialGridNode*)realloc(pCtx->pNodes,
+                sizeof(gfmSpatialGridNode) * len);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+        pCtx->pNodes = pTmp;
+        pCtx->nodesLen = len;
+    }
+
+    /* Prepend the node to the cell's list */
+    cell = gfmSpatialGrid_getCell(pCtx, cx, cy);
+    pNode = pCtx->pNodes + pCtx->nodesUsed;
+    pNode->entry = entry;
+    pNode->next = pCtx->pCells[cell];
+    pNode->cx = cx;
+    pNode->cy = cy;
+    pCtx->pCells[cell] = pCtx->nodesUsed;
+    pCtx->nodesUsed++;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Create the entry for an object, calculating which cells it touches
+ *
+ * @param  [out]pEntry Index of the object's entry
+ * @param  [ in]pCtx   The grid
+ * @param  [ in]pObj   The object
+ * @return             GFMRV_OK, GFMRV_FALSE (the object is outside the grid),
+ *                     GFMRV_ALLOC_FAILED, ...
+ */
+static gfmRV gfmSpatialGrid_addEntry(uint32_t *pEntry, gfmSpatialGrid *pCtx,
+        gfmObject *pObj) {
+    gfmSpatialGridEntry *pTmp;
+    gfmRV rv;
+    int x, y, width, height, x0, y0, x1, y1;
+
+    /* Retrieve the cells touched by the object (its right and bottom edges
+     * are inclusive, as on gfmObject_isOverlaping) */
+    rv = gfmObject_getPosition(&x, &y, pObj);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmObject_getDimensions(&width, &height, pObj);
+    ASSERT_NR(rv == GFMRV_OK);
+    x0 = gfmSpatialGrid_floorDiv(x - pCtx->x, pCtx->cellWidth);
+    y0 = gfmSpatialGrid_floorDiv(y - pCtx->y, pCtx->cellHeight);
+    x1 = gfmSpatialGrid_floorDiv(x + width - pCtx->x, pCtx->cellWidth);
+    y1 = gfmSpatialGrid_floorDiv(y + height - pCtx->y, pCtx->cellHeight);
+
+    /* Clamp it to the grid, if it's dense */
+    if (!pCtx->isHashed) {
+        if (x1 < 0 || y1 < 0 || x0 >= pCtx->cols || y0 >= pCtx->rows) {
+            return GFMRV_FALSE;
+        }
+        if (x0 < 0) {
+            x0 = 0;
+        }
+        if (y0 < 0) {
+            y0 = 0;
+        }
+        if (x1 >= pCtx->cols) {
+            x1 = pCtx->cols - 1;
+        }
+        if (y1 >= pCtx->rows) {
+            y1 = pCtx->rows - 1;
+        }
+    }
+
+    /* Expand the array as necessary */
+    if (pCtx->entriesUsed >= pCtx->entriesLen) {
+        uint32_t len;
+
+        len = pCtx->entriesLen * 2;
+        if (len < gfmSG_minLen) {
+            len = gfmSG_minLen;
+        }
+        pTmp = (gfmSpatialGridEntry*)realloc(pCtx->pEntries,
+                sizeof(gfmSpatialGridEntry) * len);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+        pCtx->pEntries = pTmp;
+        pCtx->entriesLen = len;
+    }
+
+    pTmp = pCtx->pEntries + pCtx->entriesUsed;
+    pTmp->pSelf = pObj;
+    pTmp->x0 = x0;
+    pTmp->y0 = y0;
+    pTmp->x1 = x1;
+    pTmp->y1 = y1;
+    *pEntry = pCtx->entriesUsed;
+    pCtx->entriesUsed++;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Add an object and get ready to collide it
+ *
+ * @param  [ in]pCtx The grid
+ * @param  [ in]pObj The object
+ * @return           GFMRV_OK, GFMRV_SPATIALGRID_DONE (the object is outside the
+ *                   grid), GFMRV_ALLOC_FAILED, ...
+ */
+static gfmRV gfmSpatialGrid_startObject(gfmSpatialGrid *pCtx,
+        gfmObject *pObj) {
+    gfmSpatialGridEntry *pEntry;
+    gfmRV rv;
+
+    rv = gfmSpatialGrid_addEntry(&(pCtx->cur), pCtx, pObj);
+    if (rv == GFMRV_FALSE) {
+        rv = GFMRV_SPATIALGRID_DONE;
+        goto __ret;
+    }
+    ASSERT_NR(rv == GFMRV_OK);
+
+    /* Start from the object's first cell */
+    pEntry = pCtx->pEntries + pCtx->cur;
+    pCtx->pObject = pObj;
+    pCtx->pOther = 0;
+    pCtx->cx = pEntry->x0;
+    pCtx->cy = pEntry->y0;
+    pCtx->colliding = pCtx->pCells[gfmSpatialGrid_getCell(pCtx, pCtx->cx,
+            pCtx->cy)];
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Collide the current object until it either overlaps another one or is
+ * completely added to the grid
+ *
+ * @param  [ in]pCtx The grid
+ * @return           GFMRV_SPATIALGRID_OVERLAPED, GFMRV_SPATIALGRID_DONE, ...
+ */
+static gfmRV gfmSpatialGrid_collideCurrent(gfmSpatialGrid *pCtx) {
+    gfmRV rv;
+
+    while (1) {
+        gfmSpatialGridEntry *pCur;
+
+        /* Check every object on the current cell */
+        while (pCtx->colliding) {
+            gfmSpatialGridEntry *pOther;
+            gfmSpatialGridNode *pNode;
+
+            pNode = pCtx->pNodes + pCtx->colliding;
+            pCtx->colliding = pNode->next;
+
+            /* Skip nodes from other cells on the same bucket */
+            if (pNode->cx != pCtx->cx || pNode->cy != pCtx->cy) {
+                continue;
+            }
+            /* Only check the pair on the first cell shared by both */
+            pCur = pCtx->pEntries + pCtx->cur;
+            pOther = pCtx->pEntries + pNode->entry;
+            if (pCtx->cx != (pCur->x0 > pOther->x0 ? pCur->x0 : pOther->x0) ||
+                    pCtx->cy != (pCur->y0 > pOther->y0 ? pCur->y0 :
+                    pOther->y0)) {
+                continue;
+            }
+
+            rv = gfmObject_isOverlaping(pCtx->pObject, pOther->pSelf);
+            if (rv == GFMRV_TRUE) {
+                pCtx->pOther = pOther->pSelf;
+                return GFMRV_SPATIALGRID_OVERLAPED;
+            }
+        }
+
+        /* Add the object to the cell and go to the next one */
+        rv = gfmSpatialGrid_insert(pCtx, pCtx->cur, pCtx->cx, pCtx->cy);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        pCur = pCtx->pEntries + pCtx->cur;
+        pCtx->cx++;
+        if (pCtx->cx > pCur->x1) {
+            pCtx->cx = pCur->x0;
+            pCtx->cy++;
+            if (pCtx->cy > pCur->y1) {
+                break;
+            }
+        }
+        pCtx->colliding = pCtx->pCells[gfmSpatialGrid_getCell(pCtx, pCtx->cx,
+                pCtx->cy)];
+    }
+
+    pCtx->pOther = 0;
+    rv = GFMRV_SPATIALGRID_DONE;
+__ret:
+    return rv;
+}
+
+/**
+ * Collide the current object and every remaining object on the group list
+ *
+ * @param  [ in]pCtx The grid
+ * @return           GFMRV_SPATIALGRID_OVERLAPED, GFMRV_SPATIALGRID_DONE, ...
+ */
+static gfmRV gfmSpatialGrid_run(gfmSpatialGrid *pCtx) {
+    gfmRV rv;
+
+    do {
+        if (pCtx->pObject) {
+            rv = gfmSpatialGrid_collideCurrent(pCtx);
+            if (rv != GFMRV_SPATIALGRID_DONE) {
+                /* Either an overlap or an error */
+                goto __ret;
+            }
+            pCtx->pObject = 0;
+        }
+
+        /* Retrieve the next object from the group, skipping those outside the
+         * grid */
+        while (pCtx->pGroupList && !pCtx->pObject) {
+            gfmSprite *pSpr;
+            gfmObject *pObj;
+
+            rv = gfmGroup_getNextSprite(&pSpr, &(pCtx->pGroupList));
+            ASSERT(rv == GFMRV_OK, rv);
+            rv = gfmSprite_getObject(&pObj, pSpr);
+            ASSERT_NR(rv == GFMRV_OK);
+
+            rv = gfmSpatialGrid_startObject(pCtx, pObj);
+            ASSERT(rv == GFMRV_OK || rv == GFMRV_SPATIALGRID_DONE, rv);
+        }
+    } while (pCtx->pObject);
+
+    rv = GFMRV_SPATIALGRID_DONE;
+__ret:
+    return rv;
+}
+
+/**
+ * Reset the lists and alloc the cells
+ *
+ * @param  [ in]pCtx     The grid
+ * @param  [ in]numCells How many cells (or buckets) there are
+ * @return               GFMRV_OK, GFMRV_ALLOC_FAILED
+ */
+static gfmRV gfmSpatialGrid_reset(gfmSpatialGrid *pCtx, uint32_t numCells) {
+    gfmRV rv;
+
+    /* Expand the cells as necessary */
+    if (numCells > pCtx->cellsLen) {
+        uint32_t *pTmp;
+
+        pTmp = (uint32_t*)realloc(pCtx->pCells, sizeof(uint32_t) * numCells);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+        pCtx->pCells = pTmp;
+        pCtx->cellsLen = numCells;
+    }
+    pCtx->numCells = numCells;
+    memset(pCtx->pCells, 0x0, sizeof(uint32_t) * numCells);
+
+    /* Reset the pools (the first node is reserved as the list's end) */
+    pCtx->nodesUsed = 1;
+    if (pCtx->nodesLen == 0) {
+        pCtx->pNodes = (gfmSpatialGridNode*)malloc(sizeof(gfmSpatialGridNode)
+                * gfmSG_minLen);
+        ASSERT(pCtx->pNodes, GFMRV_ALLOC_FAILED);
+        pCtx->nodesLen = gfmSG_minLen;
+    }
+    pCtx->entriesUsed = 0;
+
+    /* Clear any previous operation */
+    pCtx->pGroupList = 0;
+    pCtx->pObject = 0;
+    pCtx->pOther = 0;
+    pCtx->colliding = 0;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Alloc a new spatial grid
+ *
+ * @param  [out]ppCtx The alloc'ed grid
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSpatialGrid_getNew(gfmSpatialGrid **ppCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(!(*ppCtx), GFMRV_ARGUMENTS_BAD);
+
+    /* Alloc and clean it */
+    *ppCtx = (gfmSpatialGrid*)malloc(sizeof(gfmSpatialGrid));
+    ASSERT(*ppCtx, GFMRV_ALLOC_FAILED);
+    memset(*ppCtx, 0x0, sizeof(gfmSpatialGrid));
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Release a spatial grid and all its members
+ *
+ * @param  [ in]ppCtx The grid
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmSpatialGrid_free(gfmSpatialGrid **ppCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(*ppCtx, GFMRV_ARGUMENTS_BAD);
+
+    /* Clean the grid */
+    gfmSpatialGrid_clean(*ppCtx);
+    /* Free the struct */
+    free(*ppCtx);
+    *ppCtx = 0;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Clean all memory used by the grid
+ *
+ * @param  [ in]pCtx The grid
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmSpatialGrid_clean(gfmSpatialGrid *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    if (pCtx->pCells) {
+        free(pCtx->pCells);
+    }
+    if (pCtx->pNodes) {
+        free(pCtx->pNodes);
+    }
+    if (pCtx->pEntries) {
+        free(pCtx->pEntries);
+    }
+    memset(pCtx, 0x0, sizeof(gfmSpatialGrid));
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Clean up the previous state and ready the grid for collision, storing its
+ * cells on a dense array; Objects outside the grid's area are ignored
+ *
+ * @param  [ in]pCtx       The grid
+ * @param  [ in]x          The grid's top-left position
+ * @param  [ in]y          The grid's top-left position
+ * @param  [ in]width      The grid's width
+ * @param  [ in]height     The grid's height
+ * @param  [ in]cellWidth  Width of each cell (e.g., the width of a tile)
+ * @param  [ in]cellHeight Height of each cell (e.g., the height of a tile)
+ * @return                 GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSpatialGrid_initRoot(gfmSpatialGrid *pCtx, int x, int y, int width,
+        int height, int cellWidth, int cellHeight) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(width > 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(height > 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(cellWidth > 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(cellHeight > 0, GFMRV_ARGUMENTS_BAD);
+
+    pCtx->x = x;
+    pCtx->y = y;
+    pCtx->cellWidth = cellWidth;
+    pCtx->cellHeight = cellHeight;
+    /* Round the number of cells up */
+    pCtx->cols = width / cellWidth + (width % cellWidth != 0);
+    pCtx->rows = height / cellHeight + (height % cellHeight != 0);
+    pCtx->isHashed = 0;
+
+    rv = gfmSpatialGrid_reset(pCtx, (uint32_t)(pCtx->cols * pCtx->rows));
+__ret:
+    return rv;
+}
+
+/**
+ * Clean up the previous state and ready the grid for collision, hashing its
+ * cells into a fixed number of buckets; There are no bounds, so no object is
+ * ever ignored
+ *
+ * @param  [ in]pCtx       The grid
+ * @param  [ in]cellWidth  Width of each cell (e.g., the width of a tile)
+ * @param  [ in]cellHeight Height of each cell (e.g., the height of a tile)
+ * @param  [ in]numBuckets How many buckets there are (rounded up to a power of
+ *                         2)
+ * @return                 GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSpatialGrid_initHashed(gfmSpatialGrid *pCtx, int cellWidth,
+        int cellHeight, int numBuckets) {
+    uint32_t len;
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(cellWidth > 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(cellHeight > 0, GFMRV_ARGUMENTS_BAD);
+    ASSERT(numBuckets > 0, GFMRV_ARGUMENTS_BAD);
+
+    pCtx->x = 0;
+    pCtx->y = 0;
+    pCtx->cellWidth = cellWidth;
+    pCtx->cellHeight = cellHeight;
+    pCtx->cols = 0;
+    pCtx->rows = 0;
+    pCtx->isHashed = 1;
+
+    len = 1;
+    while (len < (uint32_t)numBuckets) {
+        len *= 2;
+    }
+
+    rv = gfmSpatialGrid_reset(pCtx, len);
+__ret:
+    return rv;
+}
+
+/**
+ * Collide every collideable object from a group
+ *
+ * @param  [ in]pCtx The grid
+ * @param  [ in]pGrp The group
+ * @return           GFMRV_ARGUMENTS_BAD, GFMRV_SPATIALGRID_NOT_INITIALIZED,
+ *                   GFMRV_SPATIALGRID_OVERLAPED, GFMRV_SPATIALGRID_DONE
+ */
+gfmRV gfmSpatialGrid_collideGroup(gfmSpatialGrid *pCtx, gfmGroup *pGrp) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pGrp, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->cellWidth > 0, GFMRV_SPATIALGRID_NOT_INITIALIZED);
+
+    /* Get the list of collideable objects */
+    rv = gfmGroup_getCollideableList(&(pCtx->pGroupList), pGrp);
+    ASSERT(rv == GFMRV_OK || rv == GFMRV_GROUP_LIST_EMPTY, rv);
+
+    if (rv == GFMRV_OK) {
+        /* Clear any previous overlap */
+        pCtx->pObject = 0;
+        pCtx->pOther = 0;
+
+        rv = gfmSpatialGrid_run(pCtx);
+    }
+    else {
+        rv = GFMRV_SPATIALGRID_DONE;
+    }
+__ret:
+    return rv;
+}
+
+/**
+ * Add an object to every cell it touches, colliding it against every object
+ * previously added to those
+ *
+ * @param  [ in]pCtx The grid
+ * @param  [ in]pObj The gfmObject
+ * @return           GFMRV_ARGUMENTS_BAD, GFMRV_SPATIALGRID_NOT_INITIALIZED,
+ *                   GFMRV_SPATIALGRID_OVERLAPED, GFMRV_SPATIALGRID_DONE
+ */
+gfmRV gfmSpatialGrid_collideObject(gfmSpatialGrid *pCtx, gfmObject *pObj) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pObj, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->cellWidth > 0, GFMRV_SPATIALGRID_NOT_INITIALIZED);
+
+    rv = gfmSpatialGrid_startObject(pCtx, pObj);
+    if (rv == GFMRV_SPATIALGRID_DONE) {
+        goto __ret;
+    }
+    ASSERT_NR(rv == GFMRV_OK);
+
+    rv = gfmSpatialGrid_run(pCtx);
+__ret:
+    return rv;
+}
+
+/**
+ * Add a sprite to every cell it touches, colliding it against every object
+ * previously added to those
+ *
+ * @param  [ in]pCtx The grid
+ * @param  [ in]pSpr The gfmSprite
+ * @return           GFMRV_ARGUMENTS_BAD, GFMRV_SPATIALGRID_NOT_INITIALIZED,
+ *                   GFMRV_SPATIALGRID_OVERLAPED, GFMRV_SPATIALGRID_DONE
+ */
+gfmRV gfmSpatialGrid_collideSprite(gfmSpatialGrid *pCtx, gfmSprite *pSpr) {
+    gfmObject *pObj;
+    gfmRV rv;
+
+    /* Sanitize sprite (other checks are done in sub-functions) */
+    ASSERT(pSpr, GFMRV_ARGUMENTS_BAD);
+    /* Retrieve the sprite's object */
+    rv = gfmSprite_getObject(&pObj, pSpr);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    rv = gfmSpatialGrid_collideObject(pCtx, pObj);
+__ret:
+    return rv;
+}
+
+/**
+ * Add an object to the grid without colliding it
+ *
+ * @param  [ in]pCtx The grid
+ * @param  [ in]pObj The gfmObject
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_SPATIALGRID_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSpatialGrid_populateObject(gfmSpatialGrid *pCtx, gfmObject *pObj) {
+    gfmSpatialGridEntry *pEntry;
+    uint32_t entry;
+    gfmRV rv;
+    int cx, cy;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pObj, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->cellWidth > 0, GFMRV_SPATIALGRID_NOT_INITIALIZED);
+
+    rv = gfmSpatialGrid_addEntry(&entry, pCtx, pObj);
+    if (rv == GFMRV_FALSE) {
+        /* Outside the grid */
+        rv = GFMRV_OK;
+        goto __ret;
+    }
+    ASSERT_NR(rv == GFMRV_OK);
+
+    /* Add it to every cell it touches */
+    pEntry = pCtx->pEntries + entry;
+    cy = pEntry->y0;
+    while (cy <= pEntry->y1) {
+        cx = pEntry->x0;
+        while (cx <= pEntry->x1) {
+            rv = gfmSpatialGrid_insert(pCtx, entry, cx, cy);
+            ASSERT_NR(rv == GFMRV_OK);
+            cx++;
+        }
+        cy++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Add a sprite to the grid without colliding it
+ *
+ * @param  [ in]pCtx The grid
+ * @param  [ in]pSpr The gfmSprite
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_SPATIALGRID_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSpatialGrid_populateSprite(gfmSpatialGrid *pCtx, gfmSprite *pSpr) {
+    gfmObject *pObj;
+    gfmRV rv;
+
+    /* Sanitize sprite (other checks are done in sub-functions) */
+    ASSERT(pSpr, GFMRV_ARGUMENTS_BAD);
+    /* Retrieve the sprite's object */
+    rv = gfmSprite_getObject(&pObj, pSpr);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    rv = gfmSpatialGrid_populateObject(pCtx, pObj);
+__ret:
+    return rv;
+}
+
+/**
+ * Add every area of a tilemap to the grid without colliding them
+ *
+ * @param  [ in]pCtx  The grid
+ * @param  [ in]pTMap The tilemap
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                    GFMRV_SPATIALGRID_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSpatialGrid_populateTilemap(gfmSpatialGrid *pCtx, gfmTilemap *pTMap) {
+    gfmRV rv;
+    int i, len;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pTMap, GFMRV_ARGUMENTS_BAD);
+
+    /* Get how many areas there are */
+    rv = gfmTilemap_getAreasLength(&len, pTMap);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    i = 0;
+    while (i < len) {
+        gfmObject *pObj;
+
+        /* Conversion from gfmHitbox to gfmObject is valid if only the first
+         * field (a gfmHitbox) from the object will be used */
+        rv = gfmTilemap_getArea(&pObj, pTMap, i);
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmSpatialGrid_populateObject(pCtx, pObj);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        i++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Return both objects that overlaped
+ *
+ * @param  [out]ppObj1 The object being collided
+ * @param  [out]ppObj2 The object that was previously added
+ * @param  [ in]pCtx   The grid
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_SPATIALGRID_NO_OVERLAP
+ */
+gfmRV gfmSpatialGrid_getOverlaping(gfmObject **ppObj1, gfmObject **ppObj2,
+        gfmSpatialGrid *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(ppObj1, GFMRV_ARGUMENTS_BAD);
+    ASSERT(ppObj2, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Check that an overlap just happened */
+    ASSERT(pCtx->pOther, GFMRV_SPATIALGRID_NO_OVERLAP);
+
+    *ppObj1 = pCtx->pObject;
+    *ppObj2 = pCtx->pOther;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Continue colliding the current object (and group, if any)
+ *
+ * @param  [ in]pCtx The grid
+ * @return           GFMRV_ARGUMENTS_BAD, GFMRV_SPATIALGRID_NOT_INITIALIZED,
+ *                   GFMRV_SPATIALGRID_OPERATION_NOT_ACTIVE,
+ *                   GFMRV_SPATIALGRID_OVERLAPED, GFMRV_SPATIALGRID_DONE
+ */
+gfmRV gfmSpatialGrid_continue(gfmSpatialGrid *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->cellWidth > 0, GFMRV_SPATIALGRID_NOT_INITIALIZED);
+    /* Check that the operation is active */
+    ASSERT(pCtx->pGroupList || pCtx->pObject,
+            GFMRV_SPATIALGRID_OPERATION_NOT_ACTIVE);
+
+    rv = gfmSpatialGrid_run(pCtx);
+__ret:
+    return rv;
+}
+
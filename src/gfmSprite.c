@@ -24,6 +24,9 @@ gfmGenArr_define(gfmAnimation);
 struct stGFMSprite {
     /** The sprite's physical object */
     gfmObject *pObject;
+    /** Whether pObject was set through gfmSprite_setObjectStorage (and, thus,
+     * mustn't be released by the sprite) */
+    int isObjectExternal;
     /** The sprite's 'child-class' (e.g., a player struct) */
     void *pChild;
     /** The sprite child's type */
@@ -100,6 +103,34 @@ __ret:
     return rv;
 }
 
+/**
+ * Make the sprite use an already alloc'ed object, instead of alloc'ing its own
+ * on gfmSprite_init; The object's memory isn't released by the sprite (e.g.,
+ * gfmGroup keeps it on the same block as the sprite itself)
+ * 
+ * NOTE: Must be called before the sprite is initialized
+ * 
+ * @param  pCtx The sprite
+ * @param  pObj The object's memory (at least sizeofGFMObject bytes, zeroed)
+ * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmSprite_setObjectStorage(gfmSprite *pCtx, gfmObject *pObj) {
+    gfmRV rv;
+    
+    // Sanitize arguments
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pObj, GFMRV_ARGUMENTS_BAD);
+    // Check that it doesn't have an object yet
+    ASSERT(!pCtx->pObject, GFMRV_ARGUMENTS_BAD);
+    
+    pCtx->pObject = pObj;
+    pCtx->isObjectExternal = 1;
+    
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
 /**
  * Initialize a sprite given its top-left position and its dimensions
  * 
@@ -173,8 +204,15 @@ gfmRV gfmSprite_clean(gfmSprite *pCtx) {
     // Sanitize arguments
     ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
     
-    // Dealloc the object, if any
-    gfmObject_free(&(pCtx->pObject));
+    // Dealloc the object, if any (or simply detach it, if it isn't ours)
+    if (pCtx->isObjectExternal) {
+        gfmObject_clean(pCtx->pObject);
+        pCtx->pObject = 0;
+        pCtx->isObjectExternal = 0;
+    }
+    else {
+        gfmObject_free(&(pCtx->pObject));
+    }
     
     // Free the animations
     gfmGenArr_clean(pCtx->pAnimations, gfmAnimation_free);
@@ -869,6 +907,59 @@ __ret:
     return rv;
 }
 
+/**
+ * Set for how many frames the sprite must stand still before falling asleep
+ * (see gfmObject_setSleepDelay)
+ * 
+ * @param  pCtx   The sprite
+ * @param  frames Number of frames; 0 (the default) makes the sprite never sleep
+ * @return        GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmSprite_setSleepDelay(gfmSprite *pCtx, int frames) {
+    gfmRV rv;
+    
+    // Check only the sprites
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    // Call the 'super-class' function
+    rv = gfmObject_setSleepDelay(pCtx->pObject, frames);
+__ret:
+    return rv;
+}
+
+/**
+ * Check whether the sprite is asleep
+ * 
+ * @param  pCtx The sprite
+ * @return      GFMRV_TRUE, GFMRV_FALSE, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmSprite_isAsleep(gfmSprite *pCtx) {
+    gfmRV rv;
+    
+    // Check only the sprites
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    // Call the 'super-class' function
+    rv = gfmObject_isAsleep(pCtx->pObject);
+__ret:
+    return rv;
+}
+
+/**
+ * Wake the sprite, so it's updated (and collided) again
+ * 
+ * @param  pCtx The sprite
+ * @return      GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmSprite_wake(gfmSprite *pCtx) {
+    gfmRV rv;
+    
+    // Check only the sprites
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    // Call the 'super-class' function
+    rv = gfmObject_wake(pCtx->pObject);
+__ret:
+    return rv;
+}
+
 /**
  * Apply another sprite's translation into this sprite
  *
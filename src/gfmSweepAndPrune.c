@@ -0,0 +1,744 @@
+/**
+ * @file src/gfmSweepAndPrune.c
+ *
+ * Sort-and-sweep broadphase; Every object added on a frame is stored on an
+ * array sorted by its left edge; Since that array is kept across frames (and
+ * objects usually move just a little between frames), keeping it sorted is
+ * done by moving only the updated object to its new position (i.e., an
+ * insertion sort that is nearly linear);
+ * When an object is collided, the array is swept to both sides of it, stopping
+ * as soon as no other object could possibly overlap it
+ */
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmGroup.h>
+#include <GFraMe/gfmObject.h>
+#include <GFraMe/gfmSprite.h>
+#include <GFraMe/gfmSweepAndPrune.h>
+#include <GFraMe/gfmTilemap.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** An object on the sorted array */
+typedef struct stGFMSweepAndPruneEntry gfmSweepAndPruneEntry;
+
+/** Minimum number of entries alloc'ed (both on the array and on the table) */
+enum {
+    gfmSAP_minLen = 64
+};
+
+/** An object on the sorted array */
+struct stGFMSweepAndPruneEntry {
+    /** The object */
+    gfmObject *pSelf;
+    /** Object's left edge, when it was last added */
+    int minX;
+    /** Object's right edge, when it was last added */
+    int maxX;
+    /** Frame when the object was last added */
+    unsigned frame;
+    /** Slot of the hash table that points to this entry */
+    uint32_t slot;
+};
+
+/** Sort-and-sweep context, with the sorted objects and the current overlap */
+struct stGFMSweepAndPrune {
+    /** Objects sorted by their left edge */
+    gfmSweepAndPruneEntry *pEntries;
+    /** How many entries are in use */
+    int entriesUsed;
+    /** How many entries fit on the array */
+    int entriesLen;
+    /** Hash table from an object to its entry (stores the entry's index + 1, so
+     * 0 means an empty slot) */
+    uint32_t *pTable;
+    /** How many slots there are on the hash table (always a power of 2) */
+    uint32_t tableLen;
+    /** Current frame (0 if not initialized) */
+    unsigned frame;
+    /** Widest object added on this frame */
+    int maxWidth;
+    /** List of collideables objects from a group */
+    gfmGroupNode *pGroupList;
+    /** Object currently being collided */
+    gfmObject *pObject;
+    /** Index of the entry being collided */
+    int cur;
+    /** Next entry to be checked against the current one */
+    int scanPos;
+    /** Whether the entries to the right of the current one are being checked
+     * (the left ones are checked first) */
+    int isScanningRight;
+    /** Object that overlaped the current one */
+    gfmObject *pOther;
+};
+
+/**
+ * Hash an object's address
+ *
+ * @param  [ in]pObj The object
+ * @return           The hash
+ */
+static uint32_t gfmSweepAndPrune_hash(gfmObject *pObj) {
+    uintptr_t addr;
+
+    addr = (uintptr_t)pObj;
+    return (uint32_t)((addr >> 3) ^ (addr >> 17)) * 2654435761u;
+}
+
+/**
+ * Retrieve the slot of the hash table where an object is (or should be)
+ *
+ * @param  [out]pSlot The slot
+ * @param  [ in]pCtx  The context
+ * @param  [ in]pObj  The object
+ * @return            GFMRV_TRUE (the object is on the table), GFMRV_FALSE
+ */
+static gfmRV gfmSweepAndPrune_findSlot(uint32_t *pSlot, gfmSweepAndPrune *pCtx,
+        gfmObject *pObj) {
+    uint32_t mask, slot;
+
+    mask = pCtx->tableLen - 1;
+    slot = gfmSweepAndPrune_hash(pObj) & mask;
+    while (pCtx->pTable[slot] != 0) {
+        if (pCtx->pEntries[pCtx->pTable[slot] - 1].pSelf == pObj) {
+            *pSlot = slot;
+            return GFMRV_TRUE;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    *pSlot = slot;
+    return GFMRV_FALSE;
+}
+
+/**
+ * Rebuild the hash table from the entries, expanding it as necessary
+ *
+ * @param  [ in]pCtx The context
+ * @return           GFMRV_OK, GFMRV_ALLOC_FAILED
+ */
+static gfmRV gfmSweepAndPrune_rebuildTable(gfmSweepAndPrune *pCtx) {
+    uint32_t len;
+    gfmRV rv;
+    int i;
+
+    /* Keep the table at most half full */
+    len = pCtx->tableLen;
+    if (len < gfmSAP_minLen) {
+        len = gfmSAP_minLen;
+    }
+    while (len < (uint32_t)pCtx->entriesUsed * 2) {
+        len *= 2;
+    }
+    if (len != pCtx->tableLen) {
+        uint32_t *pTmp;
+
+        pTmp = (uint32_t*)realloc(pCtx->pTable, sizeof(uint32_t) * len);
+        ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+        pCtx->pTable = pTmp;
+        pCtx->tableLen = len;
+    }
+    memset(pCtx->pTable, 0x0, sizeof(uint32_t) * pCtx->tableLen);
+
+    i = 0;
+    while (i < pCtx->entriesUsed) {
+        uint32_t slot;
+
+        gfmSweepAndPrune_findSlot(&slot, pCtx, pCtx->pEntries[i].pSelf);
+        pCtx->pTable[slot] = (uint32_t)i + 1;
+        pCtx->pEntries[i].slot = slot;
+        i++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Swap two neighbouring entries, keeping the hash table updated
+ *
+ * @param  [ in]pCtx The context
+ * @param  [ in]i    Index of the first entry
+ * @param  [ in]j    Index of the second entry
+ */
+static void gfmSweepAndPrune_swap(gfmSweepAndPrune *pCtx, int i, int j) {
+    gfmSweepAndPruneEntry tmp;
+
+    tmp = pCtx->pEntries[i];
+    pCtx->pEntries[i] = pCtx->pEntries[j];
+    pCtx->pEntries[j] = tmp;
+
+    pCtx->pTable[pCtx->pEntries[i].slot] = (uint32_t)i + 1;
+    pCtx->pTable[pCtx->pEntries[j].slot] = (uint32_t)j + 1;
+}
+
+/**
+ * Add an object to the current frame, updating its bounds and moving it to
+ * its sorted position
+ *
+ * @param  [out]pIndex Index of the object's entry
+ * @param  [ in]pCtx   The context
+ * @param  [ in]pObj   The object
+ * @return             GFMRV_OK, GFMRV_ALLOC_FAILED, ...
+ */
+static gfmRV gfmSweepAndPrune_addObject(int *pIndex, gfmSweepAndPrune *pCtx,
+        gfmObject *pObj) {
+    gfmSweepAndPruneEntry *pEntry;
+    uint32_t slot;
+    gfmRV rv;
+    int i, x, y, width, height;
+
+    /* Retrieve the object's current bounds */
+    rv = gfmObject_getPosition(&x, &y, pObj);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmObject_getDimensions(&width, &height, pObj);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    /* Retrieve the object's entry, adding a new one if it isn't on the
+     * array */
+    if (pCtx->tableLen == 0) {
+        rv = gfmSweepAndPrune_rebuildTable(pCtx);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+    rv = gfmSweepAndPrune_findSlot(&slot, pCtx, pObj);
+    if (rv == GFMRV_TRUE) {
+        i = (int)pCtx->pTable[slot] - 1;
+    }
+    else {
+        /* Expand the array as necessary */
+        if (pCtx->entriesUsed >= pCtx->entriesLen) {
+            gfmSweepAndPruneEntry *pTmp;
+            int len;
+
+            len = pCtx->entriesLen * 2;
+            if (len < gfmSAP_minLen) {
+                len = gfmSAP_minLen;
+            }
+            pTmp = (gfmSweepAndPruneEntry*)realloc(pCtx->pEntries,
+                    sizeof(gfmSweepAndPruneEntry) * len);
+            ASSERT(pTmp, GFMRV_ALLOC_FAILED);
+            pCtx->pEntries = pTmp;
+            pCtx->entriesLen = len;
+        }
+
+        i = pCtx->entriesUsed;
+        pCtx->entriesUsed++;
+        pEntry = pCtx->pEntries + i;
+        pEntry->pSelf = pObj;
+        pEntry->slot = slot;
+
+        if ((uint32_t)pCtx->entriesUsed * 2 > pCtx->tableLen) {
+            rv = gfmSweepAndPrune_rebuildTable(pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+        }
+        else {
+            pCtx->pTable[slot] = (uint32_t)i + 1;
+        }
+    }
+
+    /* Update the entry */
+    pEntry = pCtx->pEntries + i;
+    pEntry->minX = x;
+    pEntry->maxX = x + width;
+    pEntry->frame = pCtx->frame;
+    if (width > pCtx->maxWidth) {
+        pCtx->maxWidth = width;
+    }
+
+    /* Move it to its sorted position (either to the left or to the right) */
+    while (i > 0 && pCtx->pEntries[i - 1].minX > x) {
+        gfmSweepAndPrune_swap(pCtx, i - 1, i);
+        i--;
+    }
+    while (i < pCtx->entriesUsed - 1 && pCtx->pEntries[i + 1].minX < x) {
+        gfmSweepAndPrune_swap(pCtx, i, i + 1);
+        i++;
+    }
+
+    *pIndex = i;
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Add an object and get ready to collide it
+ *
+ * @param  [ in]pCtx The context
+ * @param  [ in]pObj The object
+ * @return           GFMRV_OK, GFMRV_ALLOC_FAILED, ...
+ */
+static gfmRV gfmSweepAndPrune_startObject(gfmSweepAndPrune *pCtx,
+        gfmObject *pObj) {
+    gfmRV rv;
+
+    rv = gfmSweepAndPrune_addObject(&(pCtx->cur), pCtx, pObj);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    pCtx->pObject = pObj;
+    pCtx->pOther = 0;
+    pCtx->scanPos = pCtx->cur - 1;
+    pCtx->isScanningRight = 0;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Sweep the array around the current object until it overlaps another one or
+ * no other object could overlap it
+ *
+ * @param  [ in]pCtx The context
+ * @return           GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE, ...
+ */
+static gfmRV gfmSweepAndPrune_collideCurrent(gfmSweepAndPrune *pCtx) {
+    gfmSweepAndPruneEntry *pCur;
+    gfmRV rv;
+
+    pCur = pCtx->pEntries + pCtx->cur;
+
+    /* Check every object to the left that could reach the current one */
+    while (!pCtx->isScanningRight) {
+        gfmSweepAndPruneEntry *pEntry;
+
+        if (pCtx->scanPos >= 0) {
+            pEntry = pCtx->pEntries + pCtx->scanPos;
+        }
+        if (pCtx->scanPos < 0 || pEntry->minX < pCur->minX - pCtx->maxWidth) {
+            pCtx->isScanningRight = 1;
+            pCtx->scanPos = pCtx->cur + 1;
+            break;
+        }
+        pCtx->scanPos--;
+
+        /* Skip objects that weren't added on this frame (or that end before
+         * the current one) */
+        if (pEntry->frame != pCtx->frame || pEntry->maxX < pCur->minX) {
+            continue;
+        }
+
+        rv = gfmObject_isOverlaping(pCtx->pObject, pEntry->pSelf);
+        if (rv == GFMRV_TRUE) {
+            pCtx->pOther = pEntry->pSelf;
+            return GFMRV_QUADTREE_OVERLAPED;
+        }
+    }
+
+    /* Check every object to the right that starts before the current one
+     * ends */
+    while (pCtx->scanPos < pCtx->entriesUsed) {
+        gfmSweepAndPruneEntry *pEntry;
+
+        pEntry = pCtx->pEntries + pCtx->scanPos;
+        if (pEntry->minX > pCur->maxX) {
+            break;
+        }
+        pCtx->scanPos++;
+
+        if (pEntry->frame != pCtx->frame) {
+            continue;
+        }
+
+        rv = gfmObject_isOverlaping(pCtx->pObject, pEntry->pSelf);
+        if (rv == GFMRV_TRUE) {
+            pCtx->pOther = pEntry->pSelf;
+            return GFMRV_QUADTREE_OVERLAPED;
+        }
+    }
+
+    pCtx->pOther = 0;
+    return GFMRV_QUADTREE_DONE;
+}
+
+/**
+ * Collide the current object and every remaining object on the group list
+ *
+ * @param  [ in]pCtx The context
+ * @return           GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE, ...
+ */
+static gfmRV gfmSweepAndPrune_run(gfmSweepAndPrune *pCtx) {
+    gfmRV rv;
+
+    do {
+        if (pCtx->pObject) {
+            rv = gfmSweepAndPrune_collideCurrent(pCtx);
+            if (rv != GFMRV_QUADTREE_DONE) {
+                /* Either an overlap or an error */
+                goto __ret;
+            }
+            pCtx->pObject = 0;
+        }
+
+        /* Retrieve the next object from the group */
+        if (pCtx->pGroupList) {
+            gfmSprite *pSpr;
+            gfmObject *pObj;
+
+            rv = gfmGroup_getNextSprite(&pSpr, &(pCtx->pGroupList));
+            ASSERT(rv == GFMRV_OK, rv);
+            rv = gfmSprite_getObject(&pObj, pSpr);
+            ASSERT_NR(rv == GFMRV_OK);
+
+            rv = gfmSweepAndPrune_startObject(pCtx, pObj);
+            ASSERT_NR(rv == GFMRV_OK);
+        }
+    } while (pCtx->pObject);
+
+    rv = GFMRV_QUADTREE_DONE;
+__ret:
+    return rv;
+}
+
+/**
+ * Alloc a new sort-and-sweep context
+ *
+ * @param  [out]ppCtx The alloc'ed context
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSweepAndPrune_getNew(gfmSweepAndPrune **ppCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(!(*ppCtx), GFMRV_ARGUMENTS_BAD);
+
+    /* Alloc and clean it */
+    *ppCtx = (gfmSweepAndPrune*)malloc(sizeof(gfmSweepAndPrune));
+    ASSERT(*ppCtx, GFMRV_ALLOC_FAILED);
+    memset(*ppCtx, 0x0, sizeof(gfmSweepAndPrune));
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Release a sort-and-sweep context and all its members
+ *
+ * @param  [ in]ppCtx The context
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmSweepAndPrune_free(gfmSweepAndPrune **ppCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(ppCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(*ppCtx, GFMRV_ARGUMENTS_BAD);
+
+    /* Clean the context */
+    gfmSweepAndPrune_clean(*ppCtx);
+    /* Free the struct */
+    free(*ppCtx);
+    *ppCtx = 0;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Clean all memory used by the context
+ *
+ * @param  [ in]pCtx The context
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmSweepAndPrune_clean(gfmSweepAndPrune *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    if (pCtx->pEntries) {
+        free(pCtx->pEntries);
+    }
+    if (pCtx->pTable) {
+        free(pCtx->pTable);
+    }
+    memset(pCtx, 0x0, sizeof(gfmSweepAndPrune));
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Start a new frame, removing every object that wasn't added on the previous
+ * one (but keeping the sorted order of the others)
+ *
+ * @param  [ in]pCtx The context
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSweepAndPrune_init(gfmSweepAndPrune *pCtx) {
+    gfmRV rv;
+    int i, count;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+
+    /* Remove every object that wasn't added on the last frame */
+    count = 0;
+    i = 0;
+    while (i < pCtx->entriesUsed) {
+        if (pCtx->pEntries[i].frame == pCtx->frame) {
+            if (count != i) {
+                pCtx->pEntries[count] = pCtx->pEntries[i];
+            }
+            count++;
+        }
+        i++;
+    }
+    if (count != pCtx->entriesUsed) {
+        pCtx->entriesUsed = count;
+        rv = gfmSweepAndPrune_rebuildTable(pCtx);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+
+    /* Start the next frame (0 is reserved for 'not initialized') */
+    pCtx->frame++;
+    if (pCtx->frame == 0) {
+        i = 0;
+        while (i < pCtx->entriesUsed) {
+            pCtx->pEntries[i].frame = 0;
+            i++;
+        }
+        pCtx->frame = 1;
+    }
+
+    /* Clear any previous operation */
+    pCtx->maxWidth = 0;
+    pCtx->pGroupList = 0;
+    pCtx->pObject = 0;
+    pCtx->pOther = 0;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Collide every collideable object from a group
+ *
+ * @param  [ in]pCtx The context
+ * @param  [ in]pGrp The group
+ * @return           GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                   GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmSweepAndPrune_collideGroup(gfmSweepAndPrune *pCtx, gfmGroup *pGrp) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pGrp, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->frame > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+
+    /* Get the list of collideable objects */
+    rv = gfmGroup_getCollideableList(&(pCtx->pGroupList), pGrp);
+    ASSERT(rv == GFMRV_OK || rv == GFMRV_GROUP_LIST_EMPTY, rv);
+
+    if (rv == GFMRV_OK) {
+        /* Clear any previous overlap */
+        pCtx->pObject = 0;
+        pCtx->pOther = 0;
+
+        rv = gfmSweepAndPrune_run(pCtx);
+    }
+    else {
+        rv = GFMRV_QUADTREE_DONE;
+    }
+__ret:
+    return rv;
+}
+
+/**
+ * Add an object and collide it against every object previously added on this
+ * frame
+ *
+ * @param  [ in]pCtx The context
+ * @param  [ in]pObj The gfmObject
+ * @return           GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                   GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmSweepAndPrune_collideObject(gfmSweepAndPrune *pCtx, gfmObject *pObj) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pObj, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->frame > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+
+    rv = gfmSweepAndPrune_startObject(pCtx, pObj);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    rv = gfmSweepAndPrune_run(pCtx);
+__ret:
+    return rv;
+}
+
+/**
+ * Add a sprite and collide it against every object previously added on this
+ * frame
+ *
+ * @param  [ in]pCtx The context
+ * @param  [ in]pSpr The gfmSprite
+ * @return           GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                   GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmSweepAndPrune_collideSprite(gfmSweepAndPrune *pCtx, gfmSprite *pSpr) {
+    gfmObject *pObj;
+    gfmRV rv;
+
+    /* Sanitize sprite (other checks are done in sub-functions) */
+    ASSERT(pSpr, GFMRV_ARGUMENTS_BAD);
+    /* Retrieve the sprite's object */
+    rv = gfmSprite_getObject(&pObj, pSpr);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    rv = gfmSweepAndPrune_collideObject(pCtx, pObj);
+__ret:
+    return rv;
+}
+
+/**
+ * Add an object without colliding it
+ *
+ * @param  [ in]pCtx The context
+ * @param  [ in]pObj The gfmObject
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSweepAndPrune_populateObject(gfmSweepAndPrune *pCtx, gfmObject *pObj) {
+    gfmRV rv;
+    int i;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pObj, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->frame > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+
+    rv = gfmSweepAndPrune_addObject(&i, pCtx, pObj);
+__ret:
+    return rv;
+}
+
+/**
+ * Add a sprite without colliding it
+ *
+ * @param  [ in]pCtx The context
+ * @param  [ in]pSpr The gfmSprite
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                   GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSweepAndPrune_populateSprite(gfmSweepAndPrune *pCtx, gfmSprite *pSpr) {
+    gfmObject *pObj;
+    gfmRV rv;
+
+    /* Sanitize sprite (other checks are done in sub-functions) */
+    ASSERT(pSpr, GFMRV_ARGUMENTS_BAD);
+    /* Retrieve the sprite's object */
+    rv = gfmSprite_getObject(&pObj, pSpr);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    rv = gfmSweepAndPrune_populateObject(pCtx, pObj);
+__ret:
+    return rv;
+}
+
+/**
+ * Add every area of a tilemap without colliding them
+ *
+ * @param  [ in]pCtx  The context
+ * @param  [ in]pTMap The tilemap
+ * @return            GFMRV_OK, GFMRV_ARGUMENTS_BAD,
+ *                    GFMRV_QUADTREE_NOT_INITIALIZED, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmSweepAndPrune_populateTilemap(gfmSweepAndPrune *pCtx,
+        gfmTilemap *pTMap) {
+    gfmRV rv;
+    int i, len;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pTMap, GFMRV_ARGUMENTS_BAD);
+
+    /* Get how many areas there are */
+    rv = gfmTilemap_getAreasLength(&len, pTMap);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    i = 0;
+    while (i < len) {
+        gfmObject *pObj;
+
+        /* Conversion from gfmHitbox to gfmObject is valid if only the first
+         * field (a gfmHitbox) from the object will be used */
+        rv = gfmTilemap_getArea(&pObj, pTMap, i);
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmSweepAndPrune_populateObject(pCtx, pObj);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        i++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Return both objects that overlaped
+ *
+ * @param  [out]ppObj1 The object being collided
+ * @param  [out]ppObj2 The object that was previously added
+ * @param  [ in]pCtx   The context
+ * @return             GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NO_OVERLAP
+ */
+gfmRV gfmSweepAndPrune_getOverlaping(gfmObject **ppObj1, gfmObject **ppObj2,
+        gfmSweepAndPrune *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(ppObj1, GFMRV_ARGUMENTS_BAD);
+    ASSERT(ppObj2, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Check that an overlap just happened */
+    ASSERT(pCtx->pOther, GFMRV_QUADTREE_NO_OVERLAP);
+
+    *ppObj1 = pCtx->pObject;
+    *ppObj2 = pCtx->pOther;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Continue colliding the current object (and group, if any)
+ *
+ * @param  [ in]pCtx The context
+ * @return           GFMRV_ARGUMENTS_BAD, GFMRV_QUADTREE_NOT_INITIALIZED,
+ *                   GFMRV_QUADTREE_OPERATION_NOT_ACTIVE,
+ *                   GFMRV_QUADTREE_OVERLAPED, GFMRV_QUADTREE_DONE
+ */
+gfmRV gfmSweepAndPrune_continue(gfmSweepAndPrune *pCtx) {
+    gfmRV rv;
+
+    /* Sanitize arguments */
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    /* Check if initialized */
+    ASSERT(pCtx->frame > 0, GFMRV_QUADTREE_NOT_INITIALIZED);
+    /* Check that the operation is active */
+    ASSERT(pCtx->pGroupList || pCtx->pObject,
+            GFMRV_QUADTREE_OPERATION_NOT_ACTIVE);
+
+    rv = gfmSweepAndPrune_run(pCtx);
+__ret:
+    return rv;
+}
+
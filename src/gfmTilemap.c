@@ -1103,6 +1103,215 @@ __ret:
     return rv;
 }
 
+/**
+ * Walk a segment through the tilemap, cell by cell (i.e., with a DDA), until
+ * it reaches a tile whose type is set on a mask; Since only the cells crossed
+ * by the segment are visited, this costs as much as the segment is long,
+ * regardless of how many areas there are; Tiles are checked by their types
+ * (see gfmTilemap_addTileType), so the areas don't have to be recalculated
+ *
+ * NOTE: Just like gfmTilemap_getTypeAt (and the areas), the tilemap's position
+ * is ignored; Parts of the segment outside the tilemap are ignored as well
+ *
+ * @param  [out]pHit     The first tile hit (only modified on GFMRV_TRUE)
+ * @param  [ in]pCtx     The tilemap
+ * @param  [ in]x0       Horizontal position of the segment's start
+ * @param  [ in]y0       Vertical position of the segment's start
+ * @param  [ in]x1       Horizontal position of the segment's end
+ * @param  [ in]y1       Vertical position of the segment's end
+ * @param  [ in]typeMask Types that stop the segment, as a bit mask (e.g.,
+ *                       (1 << type), for types lower than gfmType_max)
+ * @return               GFMRV_TRUE, GFMRV_FALSE, GFMRV_ARGUMENTS_BAD,
+ *                       GFMRV_TILEMAP_NOT_INITIALIZED
+ */
+gfmRV gfmTilemap_raycast(gfmTilemapHit *pHit, gfmTilemap *pCtx, int x0,
+        int y0, int x1, int y1, uint32_t typeMask) {
+    gfmRV rv;
+    double dx, dy, sx, sy, tEnter, tExit, tMaxX, tMaxY, time;
+    int cx, cy, normalX, normalY, stepX, stepY, tileWidth, tileHeight;
+    int mapWidth, mapHeight;
+
+    /* Sanitize arguments */
+    ASSERT(pHit, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx, GFMRV_ARGUMENTS_BAD);
+    ASSERT(pCtx->pSset, GFMRV_TILEMAP_NOT_INITIALIZED);
+    ASSERT(pCtx->pData, GFMRV_TILEMAP_NOT_INITIALIZED);
+
+    rv = gfmSpriteset_getDimension(&tileWidth, &tileHeight, pCtx->pSset);
+    ASSERT_NR(rv == GFMRV_OK);
+    mapWidth = pCtx->widthInTiles * tileWidth;
+    mapHeight = pCtx->heightInTiles * tileHeight;
+
+    /* Clip the segment to the tilemap, keeping track of the side where it
+     * entered the map */
+    dx = (double)(x1 - x0);
+    dy = (double)(y1 - y0);
+    tEnter = 0.0;
+    tExit = 1.0;
+    normalX = 0;
+    normalY = 0;
+    if (x1 == x0) {
+        ASSERT(x0 >= 0 && x0 < mapWidth, GFMRV_FALSE);
+    }
+    else {
+        double t0, t1;
+
+        t0 = (0 - x0) / dx;
+        t1 = (mapWidth - x0) / dx;
+        if (t0 > t1) {
+            double tmp;
+
+            tmp = t0;
+            t0 = t1;
+            t1 = tmp;
+        }
+        if (t0 > tEnter) {
+            tEnter = t0;
+            normalX = (dx > 0) ? -1 : 1;
+        }
+        if (t1 < tExit) {
+            tExit = t1;
+        }
+    }
+    if (y1 == y0) {
+        ASSERT(y0 >= 0 && y0 < mapHeight, GFMRV_FALSE);
+    }
+    else {
+        double t0, t1;
+
+        t0 = (0 - y0) / dy;
+        t1 = (mapHeight - y0) / dy;
+        if (t0 > t1) {
+            double tmp;
+
+            tmp = t0;
+            t0 = t1;
+            t1 = tmp;
+        }
+        if (t0 > tEnter) {
+            tEnter = t0;
+            normalX = 0;
+            normalY = (dy > 0) ? -1 : 1;
+        }
+        if (t1 < tExit) {
+            tExit = t1;
+        }
+    }
+    ASSERT(tEnter <= tExit, GFMRV_FALSE);
+
+    /* Find the first cell; If the segment entered the map through its
+     * right/bottom edge (which is outside the map), it must move left/up
+     * before reaching any tile, so an edge it starts on belongs to the
+     * previous tile (and a segment that ends on that edge never enters the
+     * map) */
+    sx = x0 + dx * tEnter;
+    sy = y0 + dy * tEnter;
+    cx = (int)(sx / tileWidth);
+    cy = (int)(sy / tileHeight);
+    if (sx >= mapWidth || sy >= mapHeight) {
+        ASSERT(tEnter < tExit, GFMRV_FALSE);
+        if (dx < 0 && sx <= cx * tileWidth) {
+            cx--;
+        }
+        if (dy < 0 && sy <= cy * tileHeight) {
+            cy--;
+        }
+    }
+    ASSERT(cx >= 0 && cx < pCtx->widthInTiles, GFMRV_FALSE);
+    ASSERT(cy >= 0 && cy < pCtx->heightInTiles, GFMRV_FALSE);
+
+    stepX = (dx > 0) ? 1 : ((dx < 0) ? -1 : 0);
+    stepY = (dy > 0) ? 1 : ((dy < 0) ? -1 : 0);
+
+    /* Walk through every cell until a matching tile is found */
+    time = tEnter;
+    while (1) {
+        int type;
+
+        type = 0;
+        rv = gfmTilemap_getTileType(&type, pCtx,
+                pCtx->pData[cx + cy * pCtx->widthInTiles]);
+        if (rv == GFMRV_OK
+                && (typeMask & (1u << ((uint32_t)type % gfmType_max)))) {
+            int x, y;
+
+            /* Keep the point inside the tile (when going left/up, it would
+             * be on the previous tile's edge) */
+            x = (int)(x0 + dx * time);
+            y = (int)(y0 + dy * time);
+            if (x < cx * tileWidth) {
+                x = cx * tileWidth;
+            }
+            else if (x >= (cx + 1) * tileWidth) {
+                x = (cx + 1) * tileWidth - 1;
+            }
+            if (y < cy * tileHeight) {
+                y = cy * tileHeight;
+            }
+            else if (y >= (cy + 1) * tileHeight) {
+                y = (cy + 1) * tileHeight - 1;
+            }
+
+            pHit->tileX = cx;
+            pHit->tileY = cy;
+            pHit->type = type;
+            pHit->x = x;
+            pHit->y = y;
+            pHit->normalX = normalX;
+            pHit->normalY = normalY;
+            pHit->time = time;
+            rv = GFMRV_TRUE;
+            goto __ret;
+        }
+
+        /* Calculate when the segment crosses the cell's next vertical and
+         * horizontal edges (from scratch, instead of accumulating, so an edge
+         * at the segment's end or at a corner isn't missed by rounding) */
+        tMaxX = tExit + 1.0;
+        if (stepX > 0) {
+            tMaxX = ((cx + 1) * tileWidth - x0) / dx;
+        }
+        else if (stepX < 0) {
+            tMaxX = (cx * tileWidth - x0) / dx;
+        }
+        tMaxY = tExit + 1.0;
+        if (stepY > 0) {
+            tMaxY = ((cy + 1) * tileHeight - y0) / dy;
+        }
+        else if (stepY < 0) {
+            tMaxY = (cy * tileHeight - y0) / dy;
+        }
+
+        /* Move to the next cell; When crossing exactly through a corner, it
+         * moves diagonally, unless it's going right and up (or left and
+         * down), in which case the corner itself belongs to the tile on the
+         * right (or bottom), which must be visited first */
+        normalX = 0;
+        normalY = 0;
+        if (tMaxX <= tMaxY && !(tMaxX == tMaxY && stepX < 0 && stepY > 0)) {
+            time = tMaxX;
+            normalX = -stepX;
+        }
+        if (tMaxY <= tMaxX && !(tMaxX == tMaxY && stepY < 0 && stepX > 0)) {
+            time = tMaxY;
+            normalY = -stepY;
+        }
+        cx -= normalX;
+        cy -= normalY;
+        /* Stop if the segment ended before entering the tile (going left/up,
+         * it must cross the edge, instead of simply touching it) */
+        if (time > tExit || (time == tExit && (normalX > 0 || normalY > 0))
+                || cx < 0 || cx >= pCtx->widthInTiles || cy < 0
+                || cy >= pCtx->heightInTiles) {
+            break;
+        }
+    }
+
+    rv = GFMRV_FALSE;
+__ret:
+    return rv;
+}
+
 /**
  * Traverse the map, from a given tile, getting the biggest rectangle that
  * contains all neighboring tiles of the same type; Since the traversal is first
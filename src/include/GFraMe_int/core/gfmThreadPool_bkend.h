@@ -0,0 +1,74 @@
+/**
+ * @file src/include/GFraMe_int/core/gfmThreadPool_bkend.h
+ *
+ * Pool of worker threads that run a list of independent tasks, blocking the
+ * caller (which also runs tasks) until every one of them finishes; Tasks are
+ * retrieved in no particular order, so callers that need a deterministic
+ * result must store each task's output separately and merge them afterward
+ */
+#ifndef __GFMTHREADPOOL_BKEND_STRUCT__
+#define __GFMTHREADPOOL_BKEND_STRUCT__
+
+typedef struct stGFMThreadPool gfmThreadPool;
+
+#endif /* __GFMTHREADPOOL_BKEND_STRUCT__ */
+
+#ifndef __GFMTHREADPOOL_BKEND_H__
+#define __GFMTHREADPOOL_BKEND_H__
+
+#include <GFraMe/gfmError.h>
+
+/**
+ * A task run by the pool
+ *
+ * @param  [ in]pArg   Argument passed to gfmThreadPool_run
+ * @param  [ in]worker Index of the worker running the task (in the range
+ *                     [0, numWorkers), where 0 is the calling thread)
+ * @param  [ in]task   Index of the task (in the range [0, numTasks))
+ * @return             GFMRV_OK, on success; Any other value is returned by
+ *                     gfmThreadPool_run
+ */
+typedef gfmRV (*gfmThreadPoolTask)(void *pArg, int worker, int task);
+
+/**
+ * Alloc a new pool, spawning its workers
+ *
+ * @param  [out]ppCtx      The alloc'ed pool
+ * @param  [ in]numWorkers How many threads should run tasks (including the
+ *                         calling one)
+ * @return                 GFMRV_OK, GFMRV_ARGUMENTS_BAD, GFMRV_ALLOC_FAILED,
+ *                         GFMRV_THREADPOOL_CREATE_FAILED
+ */
+gfmRV gfmThreadPool_getNew(gfmThreadPool **ppCtx, int numWorkers);
+
+/**
+ * Stop every worker and release the pool
+ *
+ * @param  [ in]ppCtx The pool
+ */
+void gfmThreadPool_free(gfmThreadPool **ppCtx);
+
+/**
+ * Retrieve how many threads run tasks (including the calling one)
+ *
+ * @param  [out]pNum How many workers there are
+ * @param  [ in]pCtx The pool
+ * @return           GFMRV_OK, GFMRV_ARGUMENTS_BAD
+ */
+gfmRV gfmThreadPool_getNumWorkers(int *pNum, gfmThreadPool *pCtx);
+
+/**
+ * Run every task, blocking until they have all finished
+ *
+ * @param  [ in]pCtx     The pool
+ * @param  [ in]task     The function called for every task
+ * @param  [ in]pArg     Argument passed to every task
+ * @param  [ in]numTasks How many tasks there are
+ * @return               GFMRV_OK, GFMRV_ARGUMENTS_BAD, the first error
+ *                       returned by a task
+ */
+gfmRV gfmThreadPool_run(gfmThreadPool *pCtx, gfmThreadPoolTask task,
+        void *pArg, int numTasks);
+
+#endif /* __GFMTHREADPOOL_BKEND_H__ */
+
@@ -2,6 +2,12 @@
  * @file src/include/GFraMe_int/gfmFixedPoint.h
  *
  * Define a fixed point number with its ranges and operations.
+ *
+ * There's also a wider (16.16) fixed point, used by gfmObject's physics when
+ * compiled with FIXED_POINT_PHYSICS; Since it only uses integer operations,
+ * its results are the same regardless of compiler or flags. It can only
+ * represent values within [-32768, 32768); Values converted from outside that
+ * range are clamped to it, but operations that leave it overflow.
  */
 #ifndef __GFMFIXEDPOINT_TYPE__
 #define __GFMFIXEDPOINT_TYPE__
@@ -18,6 +24,16 @@ typedef int32_t gfmPromotedFixedPoint;
 /** Maximum error when using fixed point, as a float */
 #define GFM_FIXED_POINT_ERROR ((float)(1.0f / (1 << GFM_FRACTION_BITS)))
 
+/** Wide fixed point (16.16) */
+typedef int32_t gfmFixedPoint32;
+/** Promoted wide fixed point. Required on multiplication and division */
+typedef int64_t gfmPromotedFixedPoint32;
+/** Number of bits used to represent the wide fractional part */
+#define GFM_FRACTION_BITS32 16
+/** Range of the integer part of a wide fixed point number */
+#define GFM_FRACTION_MAX_INT32 ((1 << (32 - 1 - GFM_FRACTION_BITS32)) - 1)
+#define GFM_FRACTION_MIN_INT32 (-(1 << (32 - 1 - GFM_FRACTION_BITS32)))
+
 #endif /* __GFMFIXEDPOINT_TYPE__ */
 
 #ifndef __GFMFIXEDPOINT_H__
@@ -99,5 +115,103 @@ inline static gfmFixedPoint gfmFixedPoint_fromFloat(float val) {
     return (gfmFixedPoint)((integer << GFM_FRACTION_BITS) | fraction);
 }
 
+/**
+ * Multiply two wide fixed point numbers
+ *
+ * @param  [ in]a A factor
+ * @param  [ in]b Another factor
+ * @return        The product
+ */
+inline static gfmFixedPoint32 gfmFixedPoint32_mul(gfmFixedPoint32 a,
+        gfmFixedPoint32 b) {
+    return (gfmFixedPoint32)((a * (gfmPromotedFixedPoint32)b)
+            / (1 << GFM_FRACTION_BITS32));
+}
+
+/**
+ * Divide a wide fixed point number
+ *
+ * @param  [ in]a The dividend
+ * @param  [ in]b The divisor
+ * @return        The quotient
+ */
+inline static gfmFixedPoint32 gfmFixedPoint32_div(gfmFixedPoint32 a,
+        gfmFixedPoint32 b) {
+    gfmPromotedFixedPoint32 div = ((gfmPromotedFixedPoint32)a)
+            * (1 << GFM_FRACTION_BITS32);
+    return (gfmFixedPoint32)(div / b);
+}
+
+/**
+ * Convert an integer to a wide fixed point number; Values out of range are
+ * clamped
+ *
+ * @param  [ in]val The value
+ * @return          The value represented in fixed point notation
+ */
+inline static gfmFixedPoint32 gfmFixedPoint32_fromInt(int val) {
+    if (val > GFM_FRACTION_MAX_INT32) {
+        return INT32_MAX;
+    }
+    else if (val < GFM_FRACTION_MIN_INT32) {
+        return INT32_MIN;
+    }
+    return (gfmFixedPoint32)(val * (1 << GFM_FRACTION_BITS32));
+}
+
+/**
+ * Convert a ratio of integers (e.g., milliseconds / 1000) to a wide fixed
+ * point number
+ *
+ * @param  [ in]num The numerator
+ * @param  [ in]den The denominator
+ * @return          The ratio represented in fixed point notation
+ */
+inline static gfmFixedPoint32 gfmFixedPoint32_fromRatio(int num, int den) {
+    return (gfmFixedPoint32)(((gfmPromotedFixedPoint32)num
+            * (1 << GFM_FRACTION_BITS32)) / den);
+}
+
+/**
+ * Convert a wide fixed point number to an integer; Just like casting a
+ * double, the fractional part is truncated towards 0
+ *
+ * @param  [ in]val The value
+ * @return          The integer part of the value
+ */
+inline static int gfmFixedPoint32_toInt(gfmFixedPoint32 val) {
+    return (int)(val / (1 << GFM_FRACTION_BITS32));
+}
+
+/**
+ * Convert a double to a wide fixed point number; Values out of range are
+ * clamped (and NaN becomes 0), since casting them would be undefined
+ *
+ * @param  [ in]val The value
+ * @return          The value represented in fixed point notation
+ */
+inline static gfmFixedPoint32 gfmFixedPoint32_fromDouble(double val) {
+    if (val >= (double)GFM_FRACTION_MAX_INT32 + 1.0) {
+        return INT32_MAX;
+    }
+    else if (val <= (double)GFM_FRACTION_MIN_INT32) {
+        return INT32_MIN;
+    }
+    else if (val != val) {
+        return 0;
+    }
+    return (gfmFixedPoint32)(val * (double)(1 << GFM_FRACTION_BITS32));
+}
+
+/**
+ * Convert a wide fixed point number to a double
+ *
+ * @param  [ in]val The value
+ * @return          The value represented as a double
+ */
+inline static double gfmFixedPoint32_toDouble(gfmFixedPoint32 val) {
+    return (double)val / (double)(1 << GFM_FRACTION_BITS32);
+}
+
 #endif /* __GFMFIXEDPOINT_H__ */
 
@@ -13,28 +13,17 @@ enum {
     gfmGroup_forceKill = -4322
 };
 
-typedef struct stGFMGroupDrawNode gfmGroupDrawNode;
-
-/** All possible values used by a DrawNode */
-union unGFMGroupRenderUnion {
-    /** Vertical position (used when sorting by vertical position) */
-    int y;
-    /** Time alive (used when sorting by 'age') */
-    int timeAlive;
-    /** Next DrawNode on the stack (i.e., one that has to be rendered and
-     * traversed right) */
-    gfmGroupDrawNode *pStackNext;
+enum {
+    gfmGroup_maxDeferredFrames = 255
 };
-typedef union unGFMGroupRenderUnion gfmGroupRenderUnion;
+
+typedef struct stGFMGroupDrawNode gfmGroupDrawNode;
 
 /** Helper struct used to sort the group */
 struct stGFMGroupDrawNode {
-    /** All possible values used by a DrawNode */
-    gfmGroupRenderUnion data;
-    /** Nodes to the left of this one (i.e., will be rendered first) */
-    gfmGroupDrawNode *pLeft;
-    /** Nodes to the right of this one (i.e., will be rendered afterward) */
-    gfmGroupDrawNode *pRight;
+    /** Sorting key; Either the vertical position (when sorting by vertical
+     * position) or the time alive (when sorting by 'age') */
+    int key;
     /** Nodes actual sprite */
     gfmSprite *pSelf;
 };
@@ -52,6 +41,13 @@ struct stGFMGroupNode {
     int timeAlive;
     /** Whether this reference should be automatically freed or not */
     int autoFree;
+    /** Whether this node (and its sprite) lives on one of the group's slabs,
+        in which case only the group may release its memory */
+    int inSlab;
+    /** For how many frames this node was left out of the collideable list
+        (to stay within the collideable cap); Saturates at
+        gfmGroup_maxDeferredFrames */
+    int deferredFrames;
 };
 
 #endif /* __GFMGROUPHELPERS_STRUCT__ */
@@ -71,12 +67,25 @@ struct stGFMGroupNode {
 gfmRV gfmGroupNode_getNew(gfmGroupNode **ppCtx);
 
 /**
- * Release a node and its sprite, if it's to be automatically managed
+ * Release a node and its sprite, if it's to be automatically managed; Nodes
+ * on a slab only have their sprites cleaned (the slab is released by the group)
  * 
  * @param  ppCtx The node
  * @return       GFMRV_OK, GFMRV_ARGUMENTS_BAD
  */
 gfmRV gfmGroupNode_free(gfmGroupNode **pCtx);
 
+/**
+ * Sort draw nodes from the highest key to the lowest one, keeping the nodes
+ * with equal keys in the order they were added (through a radix sort)
+ *
+ * @param  ppArr The nodes; On return, it points to the sorted nodes (which may
+ *               have been swapped with ppTmp)
+ * @param  ppTmp Temporary storage, with room for as many nodes as ppArr
+ * @param  len   How many nodes there are
+ */
+void gfmGroupDrawNode_sort(gfmGroupDrawNode **ppArr, gfmGroupDrawNode **ppTmp,
+        int len);
+
 #endif /* __GFMGROUPHELPERS_H__ */
 
@@ -0,0 +1,80 @@
+/**
+ * @file src/include/GFraMe_int/gfmObject.h
+ *
+ * Define the object structure, so internal modules (e.g., gfmCollisionSolver)
+ * may access its sub-pixel position and flags.
+ */
+#ifndef __INT_GFMOBJECT_H__
+#define __INT_GFMOBJECT_H__
+
+#include <GFraMe/gfmHitbox.h>
+#include <GFraMe/gfmObject.h>
+#include <GFraMe_int/gfmFixedPoint.h>
+#include <GFraMe_int/gfmHitbox.h>
+#include <stdint.h>
+
+#if defined(FIXED_POINT_PHYSICS)
+/** Type of every physical attribute; Integrating in fixed point makes the
+ * simulation deterministic, regardless of compiler or flags, but positions,
+ * velocities, accelerations and drags must stay within [-32768, 32768) */
+typedef gfmFixedPoint32 gfmObjReal;
+#  define gfmObjReal_fromInt(val)    gfmFixedPoint32_fromInt(val)
+#  define gfmObjReal_toInt(val)      gfmFixedPoint32_toInt(val)
+#  define gfmObjReal_fromDouble(val) gfmFixedPoint32_fromDouble(val)
+#  define gfmObjReal_toDouble(val)   gfmFixedPoint32_toDouble(val)
+/** Check whether a value (int or double) fits a physical attribute */
+#  define gfmObjReal_isInRange(val) \
+    ((val) >= GFM_FRACTION_MIN_INT32 && (val) < GFM_FRACTION_MAX_INT32 + 1.0)
+#else
+/** Type of every physical attribute */
+typedef double gfmObjReal;
+#  define gfmObjReal_fromInt(val)    ((double)(val))
+#  define gfmObjReal_toInt(val)      ((int)(val))
+#  define gfmObjReal_fromDouble(val) ((double)(val))
+#  define gfmObjReal_toDouble(val)   ((double)(val))
+#  define gfmObjReal_isInRange(val)  1
+#endif
+
+enum {
+    gfmFlags_isFixed    = 0x10000
+  , gfmFlags_isAsleep   = 0x20000
+  , gfmFlags_currentBit = 0
+  , gfmFlags_lastBit    = 4
+  , gfmFlags_instBit    = 8
+};
+
+/** The gfmObject structure */
+struct stGFMObject {
+    /** The object's hitbox (i.e., its transform) */
+    gfmHitbox t;
+    /** Collision and fixed flags */
+    uint32_t flags;
+    /** Current accumulated (i.e., sub-pixel) horizontal position */
+    gfmObjReal dx;
+    /** Current accumulated (i.e., sub-pixel) vertical position */
+    gfmObjReal dy;
+    /** Previous accumulated (i.e., sub-pixel) horizontal position */
+    gfmObjReal ldx;
+    /** Previous accumulated (i.e., sub-pixel) vertical position */
+    gfmObjReal ldy;
+    /** Horizontal velocity */
+    gfmObjReal vx;
+    /** Vertical velocity */
+    gfmObjReal vy;
+    /** Horizontal acceleration */
+    gfmObjReal ax;
+    /** Vertical acceleration */
+    gfmObjReal ay;
+    /** Rate at which speed goed back to 0, if there's no horizontal acc */
+    gfmObjReal dragX;
+    /** Rate at which speed goed back to 0, if there's no vertical acc */
+    gfmObjReal dragY;
+    /** For how many frames the object must stand still before falling asleep
+     * (0 if it never sleeps) */
+    int sleepDelay;
+    /** For how many frames the object has been standing still */
+    int stillFrames;
+};
+
+#endif /* __INT_GFMOBJECT_H__ */
+
@@ -0,0 +1,90 @@
+/**
+ * @file src/include/GFraMe_int/gfmPackedHitboxes.h
+ *
+ * Packed (structure-of-arrays) copy of many hitboxes, so a single hitbox may
+ * be tested against several of them at once (using SSE2 or AVX2, if
+ * available when compiling, or a scalar fallback otherwise); Overlaps are
+ * detected exactly as gfmObject_isOverlaping does
+ *
+ * NOTE: Since the copy isn't updated, it should only be used while the
+ * hitboxes don't move
+ */
+#ifndef __GFMPACKEDHITBOXES_STRUCT__
+#define __GFMPACKEDHITBOXES_STRUCT__
+
+/** 'Export' the packed hitboxes */
+typedef struct stGFMPackedHitboxes gfmPackedHitboxes;
+
+#endif /* __GFMPACKEDHITBOXES_STRUCT__ */
+
+#ifndef __GFMPACKEDHITBOXES_H__
+#define __GFMPACKEDHITBOXES_H__
+
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmHitbox.h>
+
+#include <stdint.h>
+
+/** Packed copy of many hitboxes; Should be zero-initialized */
+struct stGFMPackedHitboxes {
+    /** Buffer with every array below */
+    int32_t *pBuf;
+    /** Center of each hitbox */
+    int32_t *pCenterX;
+    int32_t *pCenterY;
+    /** Half the dimensions of each hitbox */
+    int32_t *pHalfWidth;
+    int32_t *pHalfHeight;
+    /** Value associated with each hitbox by the caller */
+    int32_t *pIds;
+    /** Indices of the hitboxes that passed the last test */
+    int32_t *pHits;
+    /** How many hitboxes were packed */
+    int used;
+    /** How many hitboxes fit on the arrays */
+    int len;
+};
+
+/**
+ * Release every array (but not the structure itself)
+ *
+ * @param  [ in]pCtx The packed hitboxes
+ */
+void gfmPackedHitboxes_clean(gfmPackedHitboxes *pCtx);
+
+/**
+ * Remove every packed hitbox (keeping the arrays)
+ *
+ * @param  [ in]pCtx The packed hitboxes
+ */
+void gfmPackedHitboxes_reset(gfmPackedHitboxes *pCtx);
+
+/**
+ * Copy a hitbox (or a gfmObject's hitbox) to the end of the arrays
+ *
+ * @param  [ in]pCtx    The packed hitboxes
+ * @param  [ in]pHitbox The hitbox
+ * @param  [ in]id      Value associated with the hitbox (e.g., its index on
+ *                      some other list)
+ * @return              GFMRV_OK, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmPackedHitboxes_push(gfmPackedHitboxes *pCtx, gfmHitbox *pHitbox,
+        int id);
+
+/**
+ * Test an area against every packed hitbox starting at a given one; The
+ * indices of the ones that overlap it are stored (in order) on pHits
+ *
+ * @param  [ in]pCtx       The packed hitboxes
+ * @param  [ in]centerX    The area's center
+ * @param  [ in]centerY    The area's center
+ * @param  [ in]halfWidth  Half the area's width
+ * @param  [ in]halfHeight Half the area's height
+ * @param  [ in]first      Index of the first hitbox to be tested
+ * @return                 How many hitboxes overlap the area
+ */
+int gfmPackedHitboxes_overlap(gfmPackedHitboxes *pCtx, int centerX,
+        int centerY, int halfWidth, int halfHeight, int first);
+
+#endif /* __GFMPACKEDHITBOXES_H__ */
+
@@ -37,7 +37,8 @@ __ret:
 }
 
 /**
- * Release a node and its sprite, if it's to be automatically managed
+ * Release a node and its sprite, if it's to be automatically managed; Nodes
+ * on a slab only have their sprites cleaned (the slab is released by the group)
  * 
  * @param  ppCtx The node
  * @return       GFMRV_OK, GFMRV_ARGUMENTS_BAD
@@ -50,12 +51,18 @@ gfmRV gfmGroupNode_free(gfmGroupNode **ppCtx) {
     ASSERT(*ppCtx, GFMRV_ARGUMENTS_BAD);
     
     // Release the sprite, if necessary
-    if ((*ppCtx)->autoFree) {
+    if ((*ppCtx)->autoFree && (*ppCtx)->inSlab) {
+        rv = gfmSprite_clean((*ppCtx)->pSelf);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+    else if ((*ppCtx)->autoFree) {
         rv = gfmSprite_free(&((*ppCtx)->pSelf));
         ASSERT_NR(rv == GFMRV_OK);
     }
     // Release the node itself
-    free(*ppCtx);
+    if (!(*ppCtx)->inSlab) {
+        free(*ppCtx);
+    }
     *ppCtx = 0;
     
     rv = GFMRV_OK;
@@ -63,3 +70,84 @@ __ret:
     return rv;
 }
 
+
+/** Retrieve a node's 8 bits digit, so nodes with higher keys come first */
+#define gfmGroupDrawNode_getDigit(pNode, shift) \
+    ((((unsigned int)(pNode)->key ^ 0x7fffffffu) >> (shift)) & 0xff)
+
+/**
+ * Sort draw nodes from the highest key to the lowest one, keeping the nodes
+ * with equal keys in the order they were added; This is a LSD radix sort (with
+ * 8 bits digits), so it takes linear time regardless of how the nodes were
+ * previously ordered; A digit that's equal on every node (e.g., the higher
+ * bits of positions within the screen) is skipped
+ *
+ * @param  ppArr The nodes; On return, it points to the sorted nodes (which may
+ *               have been swapped with ppTmp)
+ * @param  ppTmp Temporary storage, with room for as many nodes as ppArr
+ * @param  len   How many nodes there are
+ */
+void gfmGroupDrawNode_sort(gfmGroupDrawNode **ppArr, gfmGroupDrawNode **ppTmp,
+        int len) {
+    gfmGroupDrawNode *pSrc, *pDst, *pTmp;
+    int pCount[256];
+    int i, shift;
+
+    /* There's nothing to sort (nor any node to read) */
+    if (len <= 1) {
+        return;
+    }
+
+    pSrc = *ppArr;
+    pDst = *ppTmp;
+
+    shift = 0;
+    while (shift < 32) {
+        int sum;
+
+        /* Count how many nodes there are for each digit */
+        memset(pCount, 0x0, sizeof(pCount));
+        i = 0;
+        while (i < len) {
+            pCount[gfmGroupDrawNode_getDigit(pSrc + i, shift)]++;
+            i++;
+        }
+
+        /* Skip this digit if every node has the same value */
+        if (pCount[gfmGroupDrawNode_getDigit(pSrc, shift)] == len) {
+            shift += 8;
+            continue;
+        }
+
+        /* Convert the counts into each digit's first position */
+        sum = 0;
+        i = 0;
+        while (i < 256) {
+            int tmp;
+
+            tmp = pCount[i];
+            pCount[i] = sum;
+            sum += tmp;
+            i++;
+        }
+
+        /* Move every node to its position (in order, so it's stable) */
+        i = 0;
+        while (i < len) {
+            pDst[pCount[gfmGroupDrawNode_getDigit(pSrc + i, shift)]++] =
+                    pSrc[i];
+            i++;
+        }
+
+        pTmp = pSrc;
+        pSrc = pDst;
+        pDst = pTmp;
+        shift += 8;
+    }
+
+    /* Make sure the sorted nodes are the ones on ppArr */
+    *ppArr = pSrc;
+    *ppTmp = pDst;
+}
+
+#undef gfmGroupDrawNode_getDigit
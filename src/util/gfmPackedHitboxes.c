@@ -0,0 +1,311 @@
+/**
+ * @file src/util/gfmPackedHitboxes.c
+ *
+ * Packed (structure-of-arrays) copy of many hitboxes, so a single hitbox may
+ * be tested against several of them at once; It's used by the quadtree to
+ * test an object against every other on a leaf
+ */
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe_int/gfmHitbox.h>
+#include <GFraMe_int/gfmPackedHitboxes.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#  include <immintrin.h>
+#elif defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+enum {
+    /** How many arrays are stored on the buffer */
+    gfmPackedHitboxes_numArrays = 6,
+    /** Every array length is a multiple of this (so the vectorized loop never
+     * reads past its end) */
+    gfmPackedHitboxes_granularity = 16,
+    /** Minimum number of hitboxes alloc'ed */
+    gfmPackedHitboxes_minLen = 64
+};
+
+/**
+ * Release every array (but not the structure itself)
+ *
+ * @param  [ in]pCtx The packed hitboxes
+ */
+void gfmPackedHitboxes_clean(gfmPackedHitboxes *pCtx) {
+    if (!pCtx) {
+        return;
+    }
+
+    free(pCtx->pBuf);
+    memset(pCtx, 0x0, sizeof(gfmPackedHitboxes));
+}
+
+/**
+ * Remove every packed hitbox (keeping the arrays)
+ *
+ * @param  [ in]pCtx The packed hitboxes
+ */
+void gfmPackedHitboxes_reset(gfmPackedHitboxes *pCtx) {
+    pCtx->used = 0;
+}
+
+/**
+ * Expand the arrays so at least one more hitbox fits on them
+ *
+ * @param  [ in]pCtx The packed hitboxes
+ * @return           GFMRV_OK, GFMRV_ALLOC_FAILED
+ */
+static gfmRV gfmPackedHitboxes_expand(gfmPackedHitboxes *pCtx) {
+    gfmRV rv;
+    int32_t *pBuf;
+    int len;
+
+    len = pCtx->len * 2;
+    if (len < gfmPackedHitboxes_minLen) {
+        len = gfmPackedHitboxes_minLen;
+    }
+    len = (len + gfmPackedHitboxes_granularity - 1)
+            & ~(gfmPackedHitboxes_granularity - 1);
+
+    pBuf = (int32_t*)malloc(sizeof(int32_t) * len
+            * gfmPackedHitboxes_numArrays);
+    ASSERT(pBuf, GFMRV_ALLOC_FAILED);
+    /* Zero the padding, so the vectorized loop reads initialized values */
+    memset(pBuf, 0x0, sizeof(int32_t) * len * gfmPackedHitboxes_numArrays);
+
+    if (pCtx->used > 0) {
+        memcpy(pBuf, pCtx->pCenterX, sizeof(int32_t) * pCtx->used);
+        memcpy(pBuf + len, pCtx->pCenterY, sizeof(int32_t) * pCtx->used);
+        memcpy(pBuf + len * 2, pCtx->pHalfWidth, sizeof(int32_t) * pCtx->used);
+        memcpy(pBuf + len * 3, pCtx->pHalfHeight
+                , sizeof(int32_t) * pCtx->used);
+        memcpy(pBuf + len * 4, pCtx->pIds, sizeof(int32_t) * pCtx->used);
+    }
+    free(pCtx->pBuf);
+
+    pCtx->pBuf = pBuf;
+    pCtx->pCenterX = pBuf;
+    pCtx->pCenterY = pBuf + len;
+    pCtx->pHalfWidth = pBuf + len * 2;
+    pCtx->pHalfHeight = pBuf + len * 3;
+    pCtx->pIds = pBuf + len * 4;
+    pCtx->pHits = pBuf + len * 5;
+    pCtx->len = len;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Copy a hitbox (or a gfmObject's hitbox) to the end of the arrays
+ *
+ * @param  [ in]pCtx    The packed hitboxes
+ * @param  [ in]pHitbox The hitbox
+ * @param  [ in]id      Value associated with the hitbox (e.g., its index on
+ *                      some other list)
+ * @return              GFMRV_OK, GFMRV_ALLOC_FAILED
+ */
+gfmRV gfmPackedHitboxes_push(gfmPackedHitboxes *pCtx, gfmHitbox *pHitbox,
+        int id) {
+    gfmRV rv;
+    int i;
+
+    if (pCtx->used >= pCtx->len) {
+        rv = gfmPackedHitboxes_expand(pCtx);
+        ASSERT_NR(rv == GFMRV_OK);
+    }
+
+    i = pCtx->used;
+    pCtx->pCenterX[i] = pHitbox->x + pHitbox->hw;
+    pCtx->pCenterY[i] = pHitbox->y + pHitbox->hh;
+    pCtx->pHalfWidth[i] = pHitbox->hw;
+    pCtx->pHalfHeight[i] = pHitbox->hh;
+    pCtx->pIds[i] = id;
+    pCtx->used++;
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+#if defined(__AVX2__) || defined(__SSE2__)
+/**
+ * Append the index of every bit set on a mask to the list of hits
+ *
+ * @param  [ in]pHits  List of hits
+ * @param  [ in]numHits How many hits there are in the list
+ * @param  [ in]mask    Bit mask of the overlaping hitboxes
+ * @param  [ in]base    Index of the hitbox represented by the first bit
+ * @return              The new number of hits
+ */
+static int gfmPackedHitboxes_emit(int32_t *pHits, int numHits, int mask,
+        int base) {
+    while (mask != 0) {
+        pHits[numHits] = base + __builtin_ctz((unsigned int)mask);
+        numHits++;
+        mask &= mask - 1;
+    }
+
+    return numHits;
+}
+#endif
+
+/**
+ * Test an area against every packed hitbox starting at a given one; The
+ * indices of the ones that overlap it are stored (in order) on pHits
+ *
+ * Both axes are tested exactly as gfmObject_isOverlaping does: the hitboxes
+ * overlap unless the distance between their centers is greater than the sum
+ * of their half dimensions.
+ *
+ * @param  [ in]pCtx       The packed hitboxes
+ * @param  [ in]centerX    The area's center
+ * @param  [ in]centerY    The area's center
+ * @param  [ in]halfWidth  Half the area's width
+ * @param  [ in]halfHeight Half the area's height
+ * @param  [ in]first      Index of the first hitbox to be tested
+ * @return                 How many hitboxes overlap the area
+ */
+int gfmPackedHitboxes_overlap(gfmPackedHitboxes *pCtx, int centerX,
+        int centerY, int halfWidth, int halfHeight, int first) {
+    int32_t *pCX, *pCY, *pHW, *pHH, *pHits;
+    int i, numHits, used;
+
+    pCX = pCtx->pCenterX;
+    pCY = pCtx->pCenterY;
+    pHW = pCtx->pHalfWidth;
+    pHH = pCtx->pHalfHeight;
+    pHits = pCtx->pHits;
+    used = pCtx->used;
+    numHits = 0;
+    i = first;
+
+#if defined(__AVX2__)
+    /* 8 hitboxes per register, 16 per iteration */
+    if (i < used) {
+        __m256i cx, cy, hw, hh;
+
+        cx = _mm256_set1_epi32(centerX);
+        cy = _mm256_set1_epi32(centerY);
+        hw = _mm256_set1_epi32(halfWidth);
+        hh = _mm256_set1_epi32(halfHeight);
+
+        while (i + 16 <= used) {
+            __m256i dx0, dy0, mx0, my0, out0;
+            __m256i dx1, dy1, mx1, my1, out1;
+            int mask0, mask1;
+
+            dx0 = _mm256_sub_epi32(cx
+                    , _mm256_loadu_si256((__m256i*)(pCX + i)));
+            dy0 = _mm256_sub_epi32(cy
+                    , _mm256_loadu_si256((__m256i*)(pCY + i)));
+            mx0 = _mm256_add_epi32(hw
+                    , _mm256_loadu_si256((__m256i*)(pHW + i)));
+            my0 = _mm256_add_epi32(hh
+                    , _mm256_loadu_si256((__m256i*)(pHH + i)));
+            dx1 = _mm256_sub_epi32(cx
+                    , _mm256_loadu_si256((__m256i*)(pCX + i + 8)));
+            dy1 = _mm256_sub_epi32(cy
+                    , _mm256_loadu_si256((__m256i*)(pCY + i + 8)));
+            mx1 = _mm256_add_epi32(hw
+                    , _mm256_loadu_si256((__m256i*)(pHW + i + 8)));
+            my1 = _mm256_add_epi32(hh
+                    , _mm256_loadu_si256((__m256i*)(pHH + i + 8)));
+
+            /* Separated if d > m or -m > d, on either axis */
+            out0 = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpgt_epi32(dx0, mx0)
+                        , _mm256_cmpgt_epi32(_mm256_sub_epi32(
+                            _mm256_setzero_si256(), mx0), dx0))
+                    , _mm256_or_si256(_mm256_cmpgt_epi32(dy0, my0)
+                        , _mm256_cmpgt_epi32(_mm256_sub_epi32(
+                            _mm256_setzero_si256(), my0), dy0)));
+            out1 = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpgt_epi32(dx1, mx1)
+                        , _mm256_cmpgt_epi32(_mm256_sub_epi32(
+                            _mm256_setzero_si256(), mx1), dx1))
+                    , _mm256_or_si256(_mm256_cmpgt_epi32(dy1, my1)
+                        , _mm256_cmpgt_epi32(_mm256_sub_epi32(
+                            _mm256_setzero_si256(), my1), dy1)));
+
+            mask0 = ~_mm256_movemask_ps(_mm256_castsi256_ps(out0)) & 0xff;
+            mask1 = ~_mm256_movemask_ps(_mm256_castsi256_ps(out1)) & 0xff;
+            numHits = gfmPackedHitboxes_emit(pHits, numHits, mask0, i);
+            numHits = gfmPackedHitboxes_emit(pHits, numHits, mask1, i + 8);
+
+            i += 16;
+        }
+    }
+#elif defined(__SSE2__)
+    /* 4 hitboxes per register, 8 per iteration */
+    if (i < used) {
+        __m128i cx, cy, hw, hh;
+
+        cx = _mm_set1_epi32(centerX);
+        cy = _mm_set1_epi32(centerY);
+        hw = _mm_set1_epi32(halfWidth);
+        hh = _mm_set1_epi32(halfHeight);
+
+        while (i + 8 <= used) {
+            __m128i dx0, dy0, mx0, my0, out0;
+            __m128i dx1, dy1, mx1, my1, out1;
+            int mask0, mask1;
+
+            dx0 = _mm_sub_epi32(cx, _mm_loadu_si128((__m128i*)(pCX + i)));
+            dy0 = _mm_sub_epi32(cy, _mm_loadu_si128((__m128i*)(pCY + i)));
+            mx0 = _mm_add_epi32(hw, _mm_loadu_si128((__m128i*)(pHW + i)));
+            my0 = _mm_add_epi32(hh, _mm_loadu_si128((__m128i*)(pHH + i)));
+            dx1 = _mm_sub_epi32(cx, _mm_loadu_si128((__m128i*)(pCX + i + 4)));
+            dy1 = _mm_sub_epi32(cy, _mm_loadu_si128((__m128i*)(pCY + i + 4)));
+            mx1 = _mm_add_epi32(hw, _mm_loadu_si128((__m128i*)(pHW + i + 4)));
+            my1 = _mm_add_epi32(hh, _mm_loadu_si128((__m128i*)(pHH + i + 4)));
+
+            /* Separated if d > m or -m > d, on either axis */
+            out0 = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpgt_epi32(dx0, mx0)
+                        , _mm_cmplt_epi32(dx0, _mm_sub_epi32(
+                            _mm_setzero_si128(), mx0)))
+                    , _mm_or_si128(_mm_cmpgt_epi32(dy0, my0)
+                        , _mm_cmplt_epi32(dy0, _mm_sub_epi32(
+                            _mm_setzero_si128(), my0))));
+            out1 = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpgt_epi32(dx1, mx1)
+                        , _mm_cmplt_epi32(dx1, _mm_sub_epi32(
+                            _mm_setzero_si128(), mx1)))
+                    , _mm_or_si128(_mm_cmpgt_epi32(dy1, my1)
+                        , _mm_cmplt_epi32(dy1, _mm_sub_epi32(
+                            _mm_setzero_si128(), my1))));
+
+            mask0 = ~_mm_movemask_ps(_mm_castsi128_ps(out0)) & 0xf;
+            mask1 = ~_mm_movemask_ps(_mm_castsi128_ps(out1)) & 0xf;
+            numHits = gfmPackedHitboxes_emit(pHits, numHits, mask0, i);
+            numHits = gfmPackedHitboxes_emit(pHits, numHits, mask1, i + 4);
+
+            i += 8;
+        }
+    }
+#endif
+
+    /* Scalar fallback (and the remaining hitboxes) */
+    while (i < used) {
+        int dx, dy, mx, my;
+
+        dx = centerX - pCX[i];
+        dy = centerY - pCY[i];
+        mx = halfWidth + pHW[i];
+        my = halfHeight + pHH[i];
+        if (!(dx > mx || dx < -mx || dy > my || dy < -my)) {
+            pHits[numHits] = i;
+            numHits++;
+        }
+
+        i++;
+    }
+
+    return numHits;
+}
+
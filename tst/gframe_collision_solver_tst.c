@@ -0,0 +1,412 @@
+/**
+ * @file tst/gframe_collision_solver_tst.c
+ *
+ * Check gfmCollisionSolver; A few columns of crates fall onto a fixed floor
+ * and a few other crates (each on its own lane) are pushed against a fixed
+ * wall; On every frame, every overlapping pair (found by testing every pair of
+ * objects) is given to the solver in a random order (and orientation, with
+ * some duplicates); In the end, every crate must rest exactly on top of the
+ * previous one (or 1 pixel away from the wall, as
+ * gfmObject_separateHorizontal does), without sinking into anything nor
+ * jittering; Lastly, the result must not depend on the order the pairs were
+ * added
+ *
+ * Also, a few pairs of overlapping objects are solved together with pairs that
+ * don't overlap at all (as those found by a continuous quadtree), which must
+ * not keep the former from being separated
+ *
+ * NOTE: While the crates are landing, one may briefly sink into another (but
+ * never into the floor nor the wall), as a crate pushed back up may hit one
+ * that wasn't touching it when the pairs were found (which is solved on the
+ * next frame)
+ *
+ * NOTE: Each crate's movement is set by initializing it at its previous
+ * position and then moving it, so no context (nor timer) is required
+ *
+ * Usage: gframe_collision_solver_tst [<frames>]
+ */
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmCollisionSolver.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmObject.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Dimensions of each crate */
+#define CRATE_W     8
+#define CRATE_H     8
+/** How many columns of crates there are */
+#define NUM_COLS    4
+/** How many crates there are on each column */
+#define COL_LEN     6
+/** How many crates are pushed against the wall */
+#define NUM_LANES   6
+/** Where the floor's top is */
+#define FLOOR_Y   200
+/** Where the wall's right side is */
+#define WALL_X     16
+/** Vertical position of the first crate pushed against the wall (and the
+ * distance between lanes) */
+#define LANE_Y      8
+#define LANE_H     12
+/** How much each crate moves per frame */
+#define SPEED       3
+/** For how many of the last frames the crates must stand still */
+#define STILL_FRAMES 30
+/** How many pairs (overlapping or not) are solved together */
+#define NUM_MIXED   8
+/** Objects: the floor, the wall, the columns and then the lanes */
+#define NUM_OBJS   (2 + NUM_COLS * COL_LEN + NUM_LANES)
+#define FIRST_LANE (2 + NUM_COLS * COL_LEN)
+
+/**
+ * Check whether two objects sink into each other (i.e., overlap by more than
+ * their edges)
+ *
+ * @param  [ in]pSelf  An object
+ * @param  [ in]pOther Another object
+ * @return             1 if they do, 0 otherwise
+ */
+static int isSinking(gfmObject *pSelf, gfmObject *pOther) {
+    int sx, sy, sw, sh, ox, oy, ow, oh;
+
+    gfmObject_getPosition(&sx, &sy, pSelf);
+    gfmObject_getDimensions(&sw, &sh, pSelf);
+    gfmObject_getPosition(&ox, &oy, pOther);
+    gfmObject_getDimensions(&ow, &oh, pOther);
+
+    return sx < ox + ow && ox < sx + sw && sy < oy + oh && oy < sy + sh;
+}
+
+/**
+ * Run the scene
+ *
+ * @param  [out]pX     Every object's final position
+ * @param  [out]pY     Every object's final position
+ * @param  [ in]frames For how many frames it should run
+ * @param  [ in]seed   Seed used to shuffle the pairs
+ * @return             How many errors were found (or -1, on failure)
+ */
+static int runScene(int *pX, int *pY, int frames, int seed) {
+    gfmObject *ppObjs[NUM_OBJS];
+    gfmGroupPair pPairs[NUM_OBJS * NUM_OBJS];
+    gfmCollisionSolver *pSolver;
+    gfmRV rv;
+    int errors, frame, i, j, pairs;
+
+    // Initialize every variable
+    memset(ppObjs, 0x0, sizeof(ppObjs));
+    pSolver = 0;
+    errors = 0;
+
+    i = 0;
+    while (i < NUM_OBJS) {
+        rv = gfmObject_getNew(&(ppObjs[i]));
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+
+    // Create the floor and the wall
+    rv = gfmObject_init(ppObjs[0], 0, FLOOR_Y, 256, 16, 0/*pChild*/,
+            0/*type*/);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmObject_setFixed(ppObjs[0]);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmObject_init(ppObjs[1], 0, 0, WALL_X, LANE_Y + NUM_LANES * LANE_H,
+            0/*pChild*/, 0/*type*/);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmObject_setFixed(ppObjs[1]);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Create the crates, slightly apart from each other
+    i = 2;
+    while (i < NUM_OBJS) {
+        int x, y;
+
+        if (i < FIRST_LANE) {
+            x = 64 + 32 * ((i - 2) / COL_LEN);
+            y = FLOOR_Y - 64 - (CRATE_H + 3) * ((i - 2) % COL_LEN);
+        }
+        else {
+            x = WALL_X + 8 + 5 * (i - FIRST_LANE);
+            y = LANE_Y + LANE_H * (i - FIRST_LANE);
+        }
+        rv = gfmObject_init(ppObjs[i], x, y, CRATE_W, CRATE_H, 0/*pChild*/,
+                0/*type*/);
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+
+    rv = gfmCollisionSolver_getNew(&pSolver);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    srand(seed);
+    frame = 0;
+    while (frame < frames) {
+        // Move every crate (down the columns and left along the lanes)
+        i = 2;
+        while (i < NUM_OBJS) {
+            int x, y;
+
+            rv = gfmObject_getPosition(&x, &y, ppObjs[i]);
+            ASSERT_NR(rv == GFMRV_OK);
+            rv = gfmObject_init(ppObjs[i], x, y, CRATE_W, CRATE_H,
+                    0/*pChild*/, 0/*type*/);
+            ASSERT_NR(rv == GFMRV_OK);
+            if (i < FIRST_LANE) {
+                y += SPEED;
+            }
+            else {
+                x -= SPEED;
+            }
+            rv = gfmObject_setPosition(ppObjs[i], x, y);
+            ASSERT_NR(rv == GFMRV_OK);
+            i++;
+        }
+
+        // Find every overlapping pair, randomly flipping and repeating them
+        pairs = 0;
+        i = 0;
+        while (i < NUM_OBJS) {
+            j = i + 1;
+            while (j < NUM_OBJS) {
+                if (gfmObject_isOverlaping(ppObjs[i], ppObjs[j]) ==
+                        GFMRV_TRUE) {
+                    int k;
+
+                    k = 0;
+                    while (k < 1 + rand() % 2) {
+                        if (rand() % 2) {
+                            pPairs[pairs].pSelf = ppObjs[i];
+                            pPairs[pairs].pOther = ppObjs[j];
+                        }
+                        else {
+                            pPairs[pairs].pSelf = ppObjs[j];
+                            pPairs[pairs].pOther = ppObjs[i];
+                        }
+                        pairs++;
+                        k++;
+                    }
+                }
+                j++;
+            }
+            i++;
+        }
+        // Shuffle them
+        i = pairs - 1;
+        while (i > 0) {
+            gfmGroupPair tmp;
+
+            j = rand() % (i + 1);
+            tmp = pPairs[i];
+            pPairs[i] = pPairs[j];
+            pPairs[j] = tmp;
+            i--;
+        }
+
+        rv = gfmCollisionSolver_init(pSolver);
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmCollisionSolver_addPairs(pSolver, pPairs, pairs);
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmCollisionSolver_solve(pSolver);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        // Check that nothing sank into the floor nor the wall (nor, once
+        // settled, into anything else)
+        i = 0;
+        while (i < NUM_OBJS && (i < 2 || frame >= frames - STILL_FRAMES)) {
+            j = i + 1;
+            while (j < NUM_OBJS) {
+                if (isSinking(ppObjs[i], ppObjs[j])) {
+                    printf("seed %d, frame %d: objects %d and %d overlap\n",
+                            seed, frame, i, j);
+                    errors++;
+                }
+                j++;
+            }
+            i++;
+        }
+
+        // Check that the crates are settled and still, by the end
+        i = 2;
+        while (frame >= frames - STILL_FRAMES && i < NUM_OBJS) {
+            gfmCollision dir;
+            int x, y, expX, expY;
+
+            rv = gfmObject_getPosition(&x, &y, ppObjs[i]);
+            ASSERT_NR(rv == GFMRV_OK);
+            rv = gfmObject_getCollision(&dir, ppObjs[i]);
+            ASSERT_NR(rv == GFMRV_OK);
+            if (i < FIRST_LANE) {
+                expX = 64 + 32 * ((i - 2) / COL_LEN);
+                expY = FLOOR_Y - CRATE_H * ((i - 2) % COL_LEN + 1);
+                dir &= gfmCollision_down;
+            }
+            else {
+                expX = WALL_X + 1;
+                expY = LANE_Y + LANE_H * (i - FIRST_LANE);
+                dir &= gfmCollision_left;
+            }
+            if (x != expX || y != expY || !dir) {
+                printf("seed %d, frame %d: crate %d at (%d, %d), expected "
+                        "(%d, %d)%s\n", seed, frame, i, x, y, expX, expY,
+                        dir ? "" : " (and resting on something)");
+                errors++;
+            }
+            i++;
+        }
+
+        frame++;
+    }
+
+    i = 0;
+    while (i < NUM_OBJS) {
+        rv = gfmObject_getPosition(pX + i, pY + i, ppObjs[i]);
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    gfmCollisionSolver_free(&pSolver);
+    i = 0;
+    while (i < NUM_OBJS) {
+        gfmObject_free(&(ppObjs[i]));
+        i++;
+    }
+
+    if (rv != GFMRV_OK) {
+        printf("seed %d: failed (%s)\n", seed, gfmError_dict[rv]);
+        return -1;
+    }
+    return errors;
+}
+
+/**
+ * Solve a few horizontally overlapping pairs together with pairs of objects
+ * that don't overlap, in every possible combination
+ *
+ * @return How many errors were found (or -1, on failure)
+ */
+static int checkMixedPairs() {
+    gfmObject *ppObjs[NUM_MIXED * 2];
+    gfmCollisionSolver *pSolver;
+    gfmRV rv;
+    int errors, i, j, mask;
+
+    // Initialize every variable
+    memset(ppObjs, 0x0, sizeof(ppObjs));
+    pSolver = 0;
+    errors = 0;
+
+    i = 0;
+    while (i < NUM_MIXED * 2) {
+        rv = gfmObject_getNew(&(ppObjs[i]));
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+    rv = gfmCollisionSolver_getNew(&pSolver);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Each bit of the mask selects whether the next pair overlaps or not
+    mask = 0;
+    while (mask < (1 << NUM_MIXED)) {
+        rv = gfmCollisionSolver_init(pSolver);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        i = 0;
+        while (i < NUM_MIXED) {
+            gfmObject *pSelf, *pOther;
+            int y;
+
+            // Place every pair on its own row, far from the others
+            pSelf = ppObjs[i * 2];
+            pOther = ppObjs[i * 2 + 1];
+            y = 32 * i;
+            rv = gfmObject_init(pSelf, 0, y, 16, 16, 0/*pChild*/, 0/*type*/);
+            ASSERT_NR(rv == GFMRV_OK);
+            if (mask & (1 << i)) {
+                rv = gfmObject_init(pOther, 12, y, 16, 16, 0/*pChild*/,
+                        0/*type*/);
+            }
+            else {
+                rv = gfmObject_init(pOther, 20, y, 16, 16, 0/*pChild*/,
+                        0/*type*/);
+            }
+            ASSERT_NR(rv == GFMRV_OK);
+
+            rv = gfmCollisionSolver_addPair(pSolver, pSelf, pOther);
+            ASSERT_NR(rv == GFMRV_OK);
+            i++;
+        }
+
+        rv = gfmCollisionSolver_solve(pSolver);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        j = 0;
+        while (j < NUM_MIXED) {
+            if (isSinking(ppObjs[j * 2], ppObjs[j * 2 + 1])) {
+                printf("mixed pairs 0x%02x: pair %d still overlaps\n", mask,
+                        j);
+                errors++;
+            }
+            j++;
+        }
+
+        mask++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    gfmCollisionSolver_free(&pSolver);
+    i = 0;
+    while (i < NUM_MIXED * 2) {
+        gfmObject_free(&(ppObjs[i]));
+        i++;
+    }
+
+    if (rv != GFMRV_OK) {
+        printf("mixed pairs: failed (%s)\n", gfmError_dict[rv]);
+        return -1;
+    }
+    return errors;
+}
+
+int main(int argc, char *argv[]) {
+    gfmRV rv;
+    int pX[NUM_OBJS], pY[NUM_OBJS], pX2[NUM_OBJS], pY2[NUM_OBJS];
+    int errors, frames, i;
+
+    frames = 120;
+    if (argc > 1) {
+        frames = atoi(argv[1]);
+    }
+    ASSERT(frames > STILL_FRAMES, GFMRV_ARGUMENTS_BAD);
+
+    // Run the scene twice, adding the pairs in different orders
+    errors = runScene(pX, pY, frames, 1234);
+    ASSERT(errors >= 0, GFMRV_FUNCTION_FAILED);
+    i = runScene(pX2, pY2, frames, 4321);
+    ASSERT(i >= 0, GFMRV_FUNCTION_FAILED);
+    errors += i;
+    i = checkMixedPairs();
+    ASSERT(i >= 0, GFMRV_FUNCTION_FAILED);
+    errors += i;
+
+    i = 0;
+    while (i < NUM_OBJS) {
+        if (pX[i] != pX2[i] || pY[i] != pY2[i]) {
+            printf("object %d ended at (%d, %d) and at (%d, %d)\n", i, pX[i],
+                    pY[i], pX2[i], pY2[i]);
+            errors++;
+        }
+        i++;
+    }
+
+    printf("%d frames, %d crates, %d errors\n", frames, NUM_OBJS - 2, errors);
+    rv = (errors == 0) ? GFMRV_OK : GFMRV_FUNCTION_FAILED;
+__ret:
+    return rv;
+}
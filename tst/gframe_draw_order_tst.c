@@ -0,0 +1,243 @@
+/**
+ * @file tst/gframe_draw_order_tst.c
+ *
+ * Benchmark of gfmGroup's draw order sorting; Compares the radix sort used by
+ * gfmGroup_draw (gfmGroupDrawNode_sort) against the unbalanced binary tree it
+ * replaced (reproduced below, as it was on gfmGroup_addBottomTop and
+ * gfmGroup_drawTree), checking that both give the same order
+ *
+ * Usage: gframe_draw_order_tst [<repetitions>]
+ */
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmSprite.h>
+#include <GFraMe_int/gfmGroupHelpers.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/** A node of the old draw tree */
+struct stTreeNode {
+    /** Sorting key */
+    int key;
+    /** Next node on the stack, while traversing the tree */
+    struct stTreeNode *pStackNext;
+    /** Nodes to the left of this one (i.e., will be rendered first) */
+    struct stTreeNode *pLeft;
+    /** Nodes to the right of this one (i.e., will be rendered afterward) */
+    struct stTreeNode *pRight;
+};
+typedef struct stTreeNode treeNode;
+
+/** How the keys are initially ordered */
+enum enKeyPattern {
+    pattern_ascending = 0,
+    pattern_descending,
+    pattern_random,
+    pattern_max
+};
+typedef enum enKeyPattern keyPattern;
+
+static const char *pPatternNames[pattern_max] = {
+    "ascend",
+    "descend",
+    "random"
+};
+
+/**
+ * Sort the nodes by inserting them into the tree (placing the highest key
+ * first) and then traversing it, as gfmGroup_draw used to do
+ *
+ * @param  [out]pOut  Index of each node, in the order they would be drawn
+ * @param  [ in]pArr  The nodes (where the first one is the tree's root)
+ * @param  [ in]len   How many nodes there are
+ */
+static void treeSort(int *pOut, treeNode *pArr, int len) {
+    treeNode *pTop;
+    int i;
+
+    i = 0;
+    while (i < len) {
+        pArr[i].pLeft = 0;
+        pArr[i].pRight = 0;
+        i++;
+    }
+
+    /* Insert every node (gfmGroup_addBottomTop) */
+    i = 1;
+    while (i < len) {
+        treeNode *pRoot;
+
+        pRoot = pArr;
+        while (1) {
+            if (pArr[i].key > pRoot->key) {
+                if (!pRoot->pLeft) {
+                    pRoot->pLeft = pArr + i;
+                    break;
+                }
+                pRoot = pRoot->pLeft;
+            }
+            else {
+                if (!pRoot->pRight) {
+                    pRoot->pRight = pArr + i;
+                    break;
+                }
+                pRoot = pRoot->pRight;
+            }
+        }
+        i++;
+    }
+
+    /* Traverse the tree (gfmGroup_drawTree) */
+    pTop = pArr;
+    pTop->pStackNext = 0;
+    i = 0;
+    while (pTop) {
+        if (pTop->pLeft) {
+            pTop->pLeft->pStackNext = pTop;
+            pTop = pTop->pLeft;
+            pTop->pStackNext->pLeft = 0;
+        }
+        else {
+            pOut[i++] = (int)(pTop - pArr);
+            if (pTop->pRight) {
+                pTop->pRight->pStackNext = pTop->pStackNext;
+                pTop = pTop->pRight;
+            }
+            else {
+                pTop = pTop->pStackNext;
+            }
+        }
+    }
+}
+
+/**
+ * Run the benchmark for a number of nodes and a key pattern
+ *
+ * @param  [ in]len     How many nodes there are
+ * @param  [ in]pattern How the keys are initially ordered
+ * @param  [ in]reps    How many times each sort is run
+ * @return              GFMRV_OK, GFMRV_ALLOC_FAILED, GFMRV_FUNCTION_FAILED
+ */
+static gfmRV runBenchmark(int len, keyPattern pattern, int reps) {
+    gfmGroupDrawNode *pNodes, *pSorted, *pTmp;
+    clock_t radix, start, tree;
+    treeNode *pTree;
+    char *pSprites;
+    gfmRV rv;
+    int *pKeys, *pOrder;
+    int i, rep;
+
+    pKeys = (int*)malloc(sizeof(int) * len);
+    pOrder = (int*)malloc(sizeof(int) * len);
+    pTree = (treeNode*)malloc(sizeof(treeNode) * len);
+    pNodes = (gfmGroupDrawNode*)malloc(sizeof(gfmGroupDrawNode) * len);
+    pSorted = (gfmGroupDrawNode*)malloc(sizeof(gfmGroupDrawNode) * len);
+    pTmp = (gfmGroupDrawNode*)malloc(sizeof(gfmGroupDrawNode) * len);
+    /* Only used to give each node an unique (fake) sprite */
+    pSprites = (char*)malloc(len);
+    ASSERT(pKeys && pOrder && pTree && pNodes && pSorted && pTmp && pSprites,
+            GFMRV_ALLOC_FAILED);
+
+    /* Generate the keys (as vertical positions on a 240px screen) */
+    srand(1234);
+    i = 0;
+    while (i < len) {
+        switch (pattern) {
+            case pattern_ascending: pKeys[i] = i * 240 / len; break;
+            case pattern_descending: pKeys[i] = 240 - i * 240 / len; break;
+            default: pKeys[i] = rand() % 240;
+        }
+        i++;
+    }
+
+    tree = 0;
+    radix = 0;
+    rep = 0;
+    while (rep < reps) {
+        gfmGroupDrawNode *pArr, *pAux;
+
+        i = 0;
+        while (i < len) {
+            pTree[i].key = pKeys[i];
+            pNodes[i].key = pKeys[i];
+            pNodes[i].pSelf = (gfmSprite*)(pSprites + i);
+            i++;
+        }
+
+        start = clock();
+        treeSort(pOrder, pTree, len);
+        tree += clock() - start;
+
+        pArr = pSorted;
+        pAux = pTmp;
+        start = clock();
+        i = 0;
+        while (i < len) {
+            pArr[i] = pNodes[i];
+            i++;
+        }
+        gfmGroupDrawNode_sort(&pArr, &pAux, len);
+        radix += clock() - start;
+
+        /* Check that both sorts gave the same order */
+        i = 0;
+        while (i < len) {
+            ASSERT((char*)pArr[i].pSelf - pSprites == pOrder[i],
+                    GFMRV_FUNCTION_FAILED);
+            i++;
+        }
+
+        rep++;
+    }
+
+    printf("%6d nodes, %-8s: tree %9.3f ms, radix %7.3f ms\n", len,
+            pPatternNames[pattern], 1000.0 * tree / CLOCKS_PER_SEC / reps,
+            1000.0 * radix / CLOCKS_PER_SEC / reps);
+
+    rv = GFMRV_OK;
+__ret:
+    if (rv != GFMRV_OK) {
+        printf("%6d nodes, %-8s: failed (%s)\n", len, pPatternNames[pattern],
+                gfmError_dict[rv]);
+    }
+    free(pKeys);
+    free(pOrder);
+    free(pTree);
+    free(pNodes);
+    free(pSorted);
+    free(pTmp);
+    free(pSprites);
+
+    return rv;
+}
+
+int main(int argc, char *argv[]) {
+    gfmRV rv;
+    int i, reps;
+    int pLens[] = {5000, 20000};
+
+    reps = 10;
+    if (argc > 1) {
+        reps = atoi(argv[1]);
+    }
+    ASSERT(reps > 0, GFMRV_ARGUMENTS_BAD);
+
+    i = 0;
+    while (i < (int)(sizeof(pLens) / sizeof(int))) {
+        keyPattern pattern;
+
+        pattern = pattern_ascending;
+        while (pattern < pattern_max) {
+            rv = runBenchmark(pLens[i], pattern, reps);
+            ASSERT_NR(rv == GFMRV_OK);
+            pattern++;
+        }
+        i++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
@@ -93,6 +93,16 @@ int main(int argc, char *argv[]) {
     TEST(gfmFixedPoint_fromFloat(-0.5f) == 0xFFFFFFE0);
     TEST(gfmFixedPoint_fromFloat(0.3f) == 0x13);
 
+    TEST(gfmFixedPoint32_fromInt(1) == 0x10000);
+    TEST(gfmFixedPoint32_fromInt(32767) == 0x7FFF0000);
+    TEST(gfmFixedPoint32_fromInt(-32768) == INT32_MIN);
+    TEST(gfmFixedPoint32_fromInt(40000) == INT32_MAX);
+    TEST(gfmFixedPoint32_fromInt(-40000) == INT32_MIN);
+    TEST(gfmFixedPoint32_fromDouble(-0.5) == -0x8000);
+    TEST(gfmFixedPoint32_fromDouble(32767.5) == 0x7FFF8000);
+    TEST(gfmFixedPoint32_fromDouble(1e10) == INT32_MAX);
+    TEST(gfmFixedPoint32_fromDouble(-1e10) == INT32_MIN);
+
     TEST(gfmFixedPoint_test(fsub, a=, 3.0f, b=, 2.7f, res=, 0.3f));
     TEST(gfmFixedPoint_test(fsub, a=, 27.53f, b=, 6.7f, res=, 20.83f));
 
@@ -0,0 +1,288 @@
+/**
+ * @file tst/gframe_group_collide_tst.c
+ *
+ * Check gfmGroup_collideGroups against a brute-force test; Two groups (of
+ * sprites with different dimensions) keep spawning sprites that cross each
+ * other and, on every frame, every overlap reported between them is compared
+ * against testing every pair of collideable sprites; A small buffer is used,
+ * so gfmGroup_continueCollision is also exercised
+ *
+ * The test runs for a number of frames (600, by default, or however many were
+ * passed as the first argument) and returns an error if any pair mismatched
+ *
+ * Usage: gframe_group_collide_tst [<frames>]
+ */
+#include <GFraMe/gframe.h>
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmGroup.h>
+#include <GFraMe/gfmObject.h>
+#include <GFraMe/gfmSprite.h>
+#include <GFraMe/gfmSpriteset.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gframe_tst_helpers.h"
+
+// Set the game's FPS
+#define FPS       60
+#define WNDW     160
+#define WNDH     120
+/** How many sprites each group may have */
+#define MAX_SPR  256
+/** How many overlaps fit on the buffer */
+#define MAX_PAIRS 16
+
+/**
+ * Retrieve every collideable object from a group
+ *
+ * @param  [out]ppObjs The objects
+ * @param  [out]pLen   How many objects there are
+ * @param  [ in]pGrp   The group
+ * @return             GFMRV_OK, ...
+ */
+static gfmRV getCollideable(gfmObject **ppObjs, int *pLen, gfmGroup *pGrp) {
+    gfmGroupNode *pList;
+    gfmRV rv;
+
+    *pLen = 0;
+    rv = gfmGroup_getCollideableList(&pList, pGrp);
+    ASSERT(rv == GFMRV_OK || rv == GFMRV_GROUP_LIST_EMPTY, rv);
+    if (rv == GFMRV_GROUP_LIST_EMPTY) {
+        pList = 0;
+    }
+
+    while (pList) {
+        gfmSprite *pSpr;
+
+        ASSERT(*pLen < MAX_SPR, GFMRV_FUNCTION_FAILED);
+        rv = gfmGroup_getNextSprite(&pSpr, &pList);
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmSprite_getObject(ppObjs + *pLen, pSpr);
+        ASSERT_NR(rv == GFMRV_OK);
+        (*pLen)++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Create a group that spawns sprites of a given dimension
+ *
+ * @param  [out]ppGrp The group
+ * @param  [ in]pSset The group's spriteset
+ * @param  [ in]w     The sprites' width
+ * @param  [ in]h     The sprites' height
+ * @return            GFMRV_OK, ...
+ */
+static gfmRV createGroup(gfmGroup **ppGrp, gfmSpriteset *pSset, int w, int h) {
+    gfmRV rv;
+
+    rv = gfmGroup_getNew(ppGrp);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmGroup_setDefSpriteset(*ppGrp, pSset);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmGroup_setDefDimensions(*ppGrp, w, h, 0/*offX*/, 0/*offY*/);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmGroup_preCache(*ppGrp, 0/*initLen*/, MAX_SPR/*maxLen*/);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmGroup_setDeathOnTime(*ppGrp, 3000/*ttl*/);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmGroup_setCollisionQuality(*ppGrp,
+            gfmCollisionQuality_collideEverything);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+int main(int argc, char *argv[]) {
+    gfmCtx *pCtx;
+    gfmGroup *pGrpA, *pGrpB;
+    gfmGroupPair pPairs[MAX_PAIRS];
+    gfmObject *ppObjsA[MAX_SPR], *ppObjsB[MAX_SPR];
+    gfmRV rv;
+    gfmSpriteset *pSset4, *pSset8;
+    char *pReported;
+    int errors, frame, frames, iTex, overlaps;
+
+    // Initialize every variable
+    pCtx = 0;
+    pGrpA = 0;
+    pGrpB = 0;
+    pReported = 0;
+    errors = 0;
+    frame = 0;
+    overlaps = 0;
+
+    frames = 600;
+    if (argc > 1) {
+        frames = atoi(argv[1]);
+    }
+    ASSERT(frames > 0, GFMRV_ARGUMENTS_BAD);
+
+    // Matrix with every reported pair
+    pReported = (char*)malloc(MAX_SPR * MAX_SPR);
+    ASSERT(pReported, GFMRV_ALLOC_FAILED);
+
+    // Try to get a new context
+    rv = gfm_getNew(&pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfm_initStatic(pCtx, "com.gfmgamecorner", "gframe_group_collide");
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Initialize the window
+    rv = gfm_initGameWindow(pCtx, WNDW, WNDH, 640, 480, 0, 0);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Load the texture
+    rv = gfm_loadTextureStatic(&iTex, pCtx, "rainbow_atlas.bmp", 0xff00ff);
+    ASSERT_NR(rv == GFMRV_OK);
+    // Set it as the default
+    rv = gfm_setDefaultTexture(pCtx, iTex);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Create the spritesets
+    rv = gfm_createSpritesetCached(&pSset8, pCtx, iTex, 8/*tw*/, 8/*th*/);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfm_createSpritesetCached(&pSset4, pCtx, iTex, 4/*tw*/, 4/*th*/);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Create both groups: one with small sprites and another with wide ones
+    rv = createGroup(&pGrpA, pSset4, 4/*w*/, 4/*h*/);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = createGroup(&pGrpB, pSset8, 16/*w*/, 6/*h*/);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Set the main loop framerate
+    rv = gfm_setStateFrameRate(pCtx, FPS, FPS);
+    ASSERT_NR(rv == GFMRV_OK);
+    // Initialize the timer
+    rv = gfm_setFPS(pCtx, FPS);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    srand(1234);
+    // Run until the window is closed (or every frame was checked)
+    while (gfm_didGetQuitFlag(pCtx) == GFMRV_FALSE && frame < frames) {
+        rv = gfm_handleEvents(pCtx);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        // Update stuff
+        while (gfm_isUpdating(pCtx) == GFMRV_TRUE && frame < frames) {
+            gfmSprite *pSpr;
+            int count, i, j, lenA, lenB;
+
+            // Spawn a sprite on each group, from opposite sides
+            rv = gfmGroup_recycle(&pSpr, pGrpA);
+            ASSERT_NR(rv == GFMRV_OK || rv == GFMRV_GROUP_MAX_SPRITES);
+            if (rv == GFMRV_OK) {
+                rv = gfmGroup_setPosition(pGrpA, 0, rand() % (WNDH - 4));
+                ASSERT_NR(rv == GFMRV_OK);
+                rv = gfmGroup_setVelocity(pGrpA, 40 + rand() % 40,
+                        rand() % 41 - 20);
+                ASSERT_NR(rv == GFMRV_OK);
+            }
+            rv = gfmGroup_recycle(&pSpr, pGrpB);
+            ASSERT_NR(rv == GFMRV_OK || rv == GFMRV_GROUP_MAX_SPRITES);
+            if (rv == GFMRV_OK) {
+                rv = gfmGroup_setPosition(pGrpB, WNDW - 16,
+                        rand() % (WNDH - 6));
+                ASSERT_NR(rv == GFMRV_OK);
+                rv = gfmGroup_setVelocity(pGrpB, -40 - rand() % 40,
+                        rand() % 41 - 20);
+                ASSERT_NR(rv == GFMRV_OK);
+                rv = gfmGroup_setFrame(pGrpB, 1);
+                ASSERT_NR(rv == GFMRV_OK);
+            }
+
+            // Update both groups (which builds their collideable lists)
+            rv = gfmGroup_update(pGrpA, pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+            rv = gfmGroup_update(pGrpB, pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+
+            rv = getCollideable(ppObjsA, &lenA, pGrpA);
+            ASSERT_NR(rv == GFMRV_OK);
+            rv = getCollideable(ppObjsB, &lenB, pGrpB);
+            ASSERT_NR(rv == GFMRV_OK);
+
+            // Collide the groups, storing every reported pair
+            memset(pReported, 0x0, MAX_SPR * MAX_SPR);
+            rv = gfmGroup_collideGroups(pPairs, &count, pGrpA, pGrpB,
+                    MAX_PAIRS);
+            while (1) {
+                ASSERT_NR(rv == GFMRV_QUADTREE_OVERLAPED ||
+                        rv == GFMRV_QUADTREE_DONE);
+
+                i = 0;
+                while (i < count) {
+                    int a, b;
+
+                    a = getIndex(ppObjsA, lenA, pPairs[i].pSelf);
+                    b = getIndex(ppObjsB, lenB, pPairs[i].pOther);
+                    ASSERT(a >= 0 && b >= 0, GFMRV_FUNCTION_FAILED);
+                    pReported[a * MAX_SPR + b]++;
+                    i++;
+                }
+
+                if (rv == GFMRV_QUADTREE_DONE) {
+                    break;
+                }
+                rv = gfmGroup_continueCollision(pPairs, &count, pGrpA,
+                        MAX_PAIRS);
+            }
+
+            // Compare it against testing every pair
+            i = 0;
+            while (i < lenA) {
+                j = 0;
+                while (j < lenB) {
+                    int expected;
+
+                    expected = (gfmObject_isOverlaping(ppObjsA[i],
+                            ppObjsB[j]) == GFMRV_TRUE);
+                    if (pReported[i * MAX_SPR + j] != expected) {
+                        printf("frame %d: pair (%d, %d) reported %d "
+                                "time(s), expected %d\n", frame, i, j,
+                                pReported[i * MAX_SPR + j], expected);
+                        errors++;
+                    }
+                    overlaps += expected;
+                    j++;
+                }
+                i++;
+            }
+
+            frame++;
+        }
+
+        // Draw stuff
+        while (gfm_isDrawing(pCtx) == GFMRV_TRUE) {
+            rv = gfm_drawBegin(pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+
+            rv = gfmGroup_draw(pGrpA, pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+            rv = gfmGroup_draw(pGrpB, pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+
+            rv = gfm_drawEnd(pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+        }
+    }
+
+    printf("%d frames, %d overlaps, %d errors\n", frame, overlaps, errors);
+    rv = (errors == 0) ? GFMRV_OK : GFMRV_FUNCTION_FAILED;
+__ret:
+    gfmGroup_free(&pGrpA);
+    gfmGroup_free(&pGrpB);
+    gfm_free(&pCtx);
+    free(pReported);
+
+    return rv;
+}
@@ -22,6 +22,7 @@
 
 int main(int argc, char *argv[]) {
     gfmCtx *pCtx;
+    gfmDrawOrder order;
     gfmGroup *pGrp;
     gfmRV rv;
     gfmSprite *pSpr, *pPlayer;
@@ -42,6 +43,7 @@ int main(int argc, char *argv[]) {
     /* Set default values */
     fps = 60;
     fullscreen = 0;
+    order = gfmDrawOrder_oldestFirst;
     particles = 60;
     simple = 0;
     vsync = 0;
@@ -86,6 +88,8 @@ int main(int argc, char *argv[]) {
                                 " [--particles | -p <PPF>]\n"
                         "                                    [--simple | -s] "
                                 "[--fullscreen | -F]\n"
+                        "                                    [--order | -o "
+                                "<order>]\n"
                         "\n"
                         "Description:\n"
                         "\n"
@@ -143,7 +147,17 @@ int main(int argc, char *argv[]) {
                         "        (default: disabled)\n"
                         "\n"
                         "    --fullscreen | -F\n"
-                        "        Make the test run in fullscreen\n");
+                        "        Make the test run in fullscreen\n"
+                        "\n"
+                        "    --order | -o <order>\n"
+                        "        Select the group's draw order, so the draw "
+                                "time of each may be compared\n"
+                        "        (ignored on simple mode). Running with "
+                                "'-p 100' keeps more than 5000\n"
+                        "        particles on screen.\n"
+                        "\n"
+                        "        order = linear | top | bottom | newest | "
+                                "oldest (default: oldest)\n");
                 return 0;
             }
             IS_PARAM_WARGS("--backend", "-b") {
@@ -178,6 +192,25 @@ int main(int argc, char *argv[]) {
             IS_PARAM("--fullscreen", "-F") {
                 fullscreen = 1;
             }
+            IS_PARAM_WARGS("--order", "-o") {
+                if (strcmp(argv[i + 1], "linear") == 0) {
+                    order = gfmDrawOrder_linear;
+                }
+                else if (strcmp(argv[i + 1], "top") == 0) {
+                    order = gfmDrawOrder_topFirst;
+                }
+                else if (strcmp(argv[i + 1], "bottom") == 0) {
+                    order = gfmDrawOrder_bottomFirst;
+                }
+                else if (strcmp(argv[i + 1], "newest") == 0) {
+                    order = gfmDrawOrder_newestFirst;
+                }
+                else if (strcmp(argv[i + 1], "oldest") == 0) {
+                    order = gfmDrawOrder_oldestFirst;
+                }
+
+                i++;
+            }
 
 #undef IS_PARAM
 #undef IS_PARAM_WARG
@@ -295,7 +328,7 @@ int main(int argc, char *argv[]) {
     }
     else {
         // Set the draw order (FUN!!!)
-        rv = gfmGroup_setDrawOrder(pGrp, gfmDrawOrder_oldestFirst);
+        rv = gfmGroup_setDrawOrder(pGrp, order);
         ASSERT_NR(rv == GFMRV_OK);
     }
     // Uncommenting enable the collision list
@@ -0,0 +1,148 @@
+/**
+ * @file tst/gframe_particle_system_tst.c
+ *
+ * Simple test with gfmParticles; A fountain, on the middle of the screen,
+ * spawns a number of particles every frame (60, by default, or however many
+ * were passed as the first argument)
+ */
+#include <GFraMe/gframe.h>
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmParticles.h>
+#include <GFraMe/gfmSpriteset.h>
+
+#include <stdlib.h>
+
+// Set the game's FPS
+#define FPS       60
+#define WNDW     160
+#define WNDH     120
+
+int main(int argc, char *argv[]) {
+    gfmCtx *pCtx;
+    gfmParticles *pParts;
+    gfmRV rv;
+    gfmSpriteset *pSset4, *pSset8;
+    int iTex, num, particles;
+
+    // Initialize every variable
+    pCtx = 0;
+    pParts = 0;
+    num = 0;
+
+    // Set how many particles are spawned per frame
+    particles = 60;
+    if (argc > 1) {
+        particles = atoi(argv[1]);
+    }
+
+    // Try to get a new context
+    rv = gfm_getNew(&pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfm_initStatic(pCtx, "com.gfmgamecorner", "gframe_particle_system");
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Initialize the window
+    rv = gfm_initGameWindow(pCtx, WNDW, WNDH, 640, 480, 1, 0);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Load the texture
+    rv = gfm_loadTextureStatic(&iTex, pCtx, "rainbow_atlas.bmp", 0xff00ff);
+    ASSERT_NR(rv == GFMRV_OK);
+    // Set it as the default
+    rv = gfm_setDefaultTexture(pCtx, iTex);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Create the spritesets
+    rv = gfm_createSpritesetCached(&pSset8, pCtx, iTex, 8/*tw*/, 8/*th*/);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfm_createSpritesetCached(&pSset4, pCtx, iTex, 4/*tw*/, 4/*th*/);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Initalize the FPS counter
+    rv = gfm_initFPSCounter(pCtx, pSset8, 0/*firstTile*/);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Create the particle system
+    rv = gfmParticles_getNew(&pParts);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmParticles_init(pParts, pSset4, 12288/*maxLen*/);
+    ASSERT_NR(rv == GFMRV_OK);
+    // Set the default attributes
+    rv = gfmParticles_setDefAcceleration(pParts, 0/*ax*/, 100/*ay*/);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmParticles_setDeathOnTime(pParts, 2000/*ttl*/);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmParticles_setDeathOnLeave(pParts, 1/*doDie*/);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Set the main loop framerate
+    rv = gfm_setStateFrameRate(pCtx, FPS, FPS);
+    ASSERT_NR(rv == GFMRV_OK);
+    // Initialize the timer
+    rv = gfm_setFPS(pCtx, FPS);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Run until the window is closed
+    while (gfm_didGetQuitFlag(pCtx) == GFMRV_FALSE) {
+        rv = gfm_handleEvents(pCtx);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        // Update stuff
+        while (gfm_isUpdating(pCtx) == GFMRV_TRUE) {
+            int i;
+
+            rv = gfm_fpsCounterUpdateBegin(pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+
+            // Spawn a few particles
+            i = 0;
+            while (i < particles) {
+                rv = gfmParticles_spawn(pParts, WNDW / 2 - 2, WNDH / 2 - 2);
+                ASSERT_NR(rv == GFMRV_OK ||
+                        rv == GFMRV_PARTICLES_MAX_PARTICLES);
+                if (rv == GFMRV_OK) {
+                    // Spread them on a fan, going up
+                    rv = gfmParticles_setVelocity(pParts, (num % 41) * 4 - 80,
+                            -100 - (num % 13) * 5);
+                    ASSERT_NR(rv == GFMRV_OK);
+                    rv = gfmParticles_setFrame(pParts, num % 7);
+                    ASSERT_NR(rv == GFMRV_OK);
+                    num++;
+                }
+                i++;
+            }
+
+            // Update the particles
+            rv = gfmParticles_update(pParts, pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+
+            rv = gfm_fpsCounterUpdateEnd(pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+        }
+
+        // Draw stuff
+        while (gfm_isDrawing(pCtx) == GFMRV_TRUE) {
+            rv = gfm_drawBegin(pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+
+            // Draw the particles
+            rv = gfmParticles_draw(pParts, pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+
+            /* Draw last frame's render info */
+            rv = gfm_drawRenderInfo(pCtx, pSset8, 0, 16, 0);
+            ASSERT_NR(rv == GFMRV_OK);
+
+            rv = gfm_drawEnd(pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+        }
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    gfmParticles_free(&pParts);
+    gfm_free(&pCtx);
+
+    return rv;
+}
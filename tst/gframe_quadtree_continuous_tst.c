@@ -0,0 +1,311 @@
+/**
+ * @file tst/gframe_quadtree_continuous_tst.c
+ *
+ * Check the quadtree's continuous mode against a brute-force test; A number of
+ * (mostly fast) objects move around a world with a few thin walls (on the
+ * static layer) and, on every frame, the overlaps reported by
+ * gfmQuadtree_collideDeferred are compared against testing every pair of
+ * objects; Objects collide if they touched at any moment during the frame,
+ * which is checked by testing the segment travelled by one object (relative to
+ * the other) against their Minkowski sum; Each pair's time of impact must also
+ * match and pairs must be ordered by it
+ *
+ * NOTE: Each object's movement is set by initializing it at its previous
+ * position and then moving it, so no context (nor timer) is required
+ *
+ * Usage: gframe_quadtree_continuous_tst [<frames>]
+ */
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmObject.h>
+#include <GFraMe/gfmQuadtree.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gframe_tst_helpers.h"
+
+/** Dimensions of the world */
+#define WORLD_W   1024
+#define WORLD_H   1024
+/** How many walls there are (i.e., objects on the static layer) */
+#define NUM_WALLS   12
+/** How many objects there are (walls included) */
+#define NUM_OBJS   300
+/** Fastest an object may move, in pixels per frame */
+#define MAX_SPEED   48
+/** Quadtree's parameters */
+#define MAX_DEPTH    6
+#define MAX_NODES    6
+
+/**
+ * Check whether two objects touched at any moment during the frame and, if
+ * so, when they first did
+ *
+ * @param  [out]pTime   When the objects first touched, in the range [0, 1]
+ * @param  [ in]pSelf   An object
+ * @param  [ in]pOther  The other object
+ * @param  [ in]pLastX  Every object's previous position
+ * @param  [ in]pLastY  Every object's previous position
+ * @param  [ in]self    pSelf's index
+ * @param  [ in]other   pOther's index
+ * @return              1 if they touched, 0 otherwise
+ */
+static int bruteForce(double *pTime, gfmObject *pSelf, gfmObject *pOther,
+        int *pLastX, int *pLastY, int self, int other) {
+    long l, t, r, b, x0, y0, x1, y1;
+    int sx, sy, sw, sh, ox, oy, ow, oh;
+    double d, t0, t1;
+    int i;
+
+    gfmObject_getPosition(&sx, &sy, pSelf);
+    gfmObject_getDimensions(&sw, &sh, pSelf);
+    gfmObject_getPosition(&ox, &oy, pOther);
+    gfmObject_getDimensions(&ow, &oh, pOther);
+
+    /* pSelf's movement, relative to pOther */
+    x0 = pLastX[self] - pLastX[other];
+    y0 = pLastY[self] - pLastY[other];
+    x1 = sx - ox;
+    y1 = sy - oy;
+    /* Relative positions where both (inclusive) boxes touch */
+    l = -sw;
+    t = -sh;
+    r = ow;
+    b = oh;
+
+    if (!((x0 >= l && x0 <= r && y0 >= t && y0 <= b) ||
+            (x1 >= l && x1 <= r && y1 >= t && y1 <= b) ||
+            segmentsTouch(x0, y0, x1, y1, l, t, r, t) ||
+            segmentsTouch(x0, y0, x1, y1, r, t, r, b) ||
+            segmentsTouch(x0, y0, x1, y1, l, b, r, b) ||
+            segmentsTouch(x0, y0, x1, y1, l, t, l, b))) {
+        return 0;
+    }
+
+    /* Find where the segment enters the box */
+    *pTime = 0.0;
+    i = 0;
+    while (i < 2) {
+        if (i == 0) {
+            d = (double)(x1 - x0);
+            t0 = (l - x0) / d;
+            t1 = (r - x0) / d;
+        }
+        else {
+            d = (double)(y1 - y0);
+            t0 = (t - y0) / d;
+            t1 = (b - y0) / d;
+        }
+        if (d != 0.0) {
+            if (t0 > t1) {
+                t0 = t1;
+            }
+            if (t0 > *pTime) {
+                *pTime = t0;
+            }
+        }
+        i++;
+    }
+
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    gfmObject *ppObjs[NUM_OBJS];
+    gfmQuadtreePair *pPairs;
+    gfmQuadtreeRoot *pQt;
+    gfmRV rv;
+    char *pReported;
+    double *pTimes;
+    int pVx[NUM_OBJS], pVy[NUM_OBJS];
+    int pLastX[NUM_OBJS], pLastY[NUM_OBJS];
+    int count, errors, frame, frames, i, j, overlaps;
+
+    // Initialize every variable
+    memset(ppObjs, 0x0, sizeof(ppObjs));
+    pQt = 0;
+    pReported = 0;
+    pTimes = 0;
+    errors = 0;
+    overlaps = 0;
+
+    frames = 60;
+    if (argc > 1) {
+        frames = atoi(argv[1]);
+    }
+    ASSERT(frames > 0, GFMRV_ARGUMENTS_BAD);
+
+    // Create every object (the first ones being thin walls)
+    srand(1234);
+    i = 0;
+    while (i < NUM_OBJS) {
+        int h, w;
+
+        if (i < NUM_WALLS && i % 2 == 0) {
+            w = 2;
+            h = 128 + rand() % 256;
+        }
+        else if (i < NUM_WALLS) {
+            w = 128 + rand() % 256;
+            h = 2;
+        }
+        else {
+            /* Keep dimensions even, so they match the object's hitbox */
+            w = 4 + 2 * (rand() % 5);
+            h = 4 + 2 * (rand() % 5);
+        }
+
+        pLastX[i] = rand() % (WORLD_W - w);
+        pLastY[i] = rand() % (WORLD_H - h);
+        pVx[i] = 0;
+        pVy[i] = 0;
+        if (i >= NUM_WALLS) {
+            pVx[i] = rand() % (2 * MAX_SPEED + 1) - MAX_SPEED;
+            pVy[i] = rand() % (2 * MAX_SPEED + 1) - MAX_SPEED;
+        }
+
+        rv = gfmObject_getNew(&(ppObjs[i]));
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmObject_init(ppObjs[i], pLastX[i], pLastY[i], w, h,
+                0/*pChild*/, 0/*type*/);
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+
+    // Matrix with every reported pair (and when it happened)
+    pReported = (char*)malloc(NUM_OBJS * NUM_OBJS);
+    pTimes = (double*)malloc(sizeof(double) * NUM_OBJS * NUM_OBJS);
+    ASSERT(pReported && pTimes, GFMRV_ALLOC_FAILED);
+
+    rv = gfmQuadtree_getNew(&pQt);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmQuadtree_setContinuous(pQt, 1/*isContinuous*/);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Walls never move, so they are only added once
+    rv = gfmQuadtree_initStatic(pQt, 0, 0, WORLD_W, WORLD_H, MAX_DEPTH,
+            MAX_NODES);
+    ASSERT_NR(rv == GFMRV_OK);
+    i = 0;
+    while (i < NUM_WALLS) {
+        rv = gfmQuadtree_populateStaticObject(pQt, ppObjs[i]);
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+
+    frame = 0;
+    while (frame < frames) {
+        double lastTime;
+
+        // Move every object from its previous position
+        i = NUM_WALLS;
+        while (i < NUM_OBJS) {
+            int h, w, x, y;
+
+            rv = gfmObject_getPosition(&x, &y, ppObjs[i]);
+            ASSERT_NR(rv == GFMRV_OK);
+            rv = gfmObject_getDimensions(&w, &h, ppObjs[i]);
+            ASSERT_NR(rv == GFMRV_OK);
+            rv = gfmObject_init(ppObjs[i], x, y, w, h, 0/*pChild*/,
+                    0/*type*/);
+            ASSERT_NR(rv == GFMRV_OK);
+            pLastX[i] = x;
+            pLastY[i] = y;
+
+            x += pVx[i];
+            y += pVy[i];
+            if (x < 0 || x > WORLD_W - w) {
+                pVx[i] = -pVx[i];
+            }
+            if (y < 0 || y > WORLD_H - h) {
+                pVy[i] = -pVy[i];
+            }
+            rv = gfmObject_setPosition(ppObjs[i], x, y);
+            ASSERT_NR(rv == GFMRV_OK);
+            i++;
+        }
+
+        // Collide every moving object
+        rv = gfmQuadtree_initRoot(pQt, 0, 0, WORLD_W, WORLD_H, MAX_DEPTH,
+                MAX_NODES);
+        ASSERT_NR(rv == GFMRV_OK);
+        i = NUM_WALLS;
+        while (i < NUM_OBJS) {
+            rv = gfmQuadtree_deferObject(pQt, ppObjs[i]);
+            ASSERT_NR(rv == GFMRV_OK);
+            i++;
+        }
+        rv = gfmQuadtree_collideDeferred(&pPairs, &count, pQt);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        // Store every reported pair, checking that they are ordered by time
+        memset(pReported, 0x0, NUM_OBJS * NUM_OBJS);
+        lastTime = 0.0;
+        i = 0;
+        while (i < count) {
+            int a, b;
+
+            a = getIndex(ppObjs, NUM_OBJS, pPairs[i].pSelf);
+            b = getIndex(ppObjs, NUM_OBJS, pPairs[i].pOther);
+            ASSERT(a >= 0 && b >= 0, GFMRV_FUNCTION_FAILED);
+            pReported[a * NUM_OBJS + b]++;
+            pReported[b * NUM_OBJS + a]++;
+            pTimes[a * NUM_OBJS + b] = pPairs[i].time;
+            pTimes[b * NUM_OBJS + a] = pPairs[i].time;
+
+            if (pPairs[i].time < lastTime) {
+                printf("frame %d: pair %d reported out of order\n", frame, i);
+                errors++;
+            }
+            lastTime = pPairs[i].time;
+            i++;
+        }
+
+        // Check every pair where at least one object moved
+        i = 0;
+        while (i < NUM_OBJS) {
+            j = (i < NUM_WALLS) ? NUM_WALLS : i + 1;
+            while (j < NUM_OBJS) {
+                double time;
+                int expected;
+
+                expected = bruteForce(&time, ppObjs[j], ppObjs[i], pLastX,
+                        pLastY, j, i);
+                if (pReported[i * NUM_OBJS + j] != expected) {
+                    printf("frame %d: pair (%d, %d) reported %d time(s), "
+                            "expected %d\n", frame, i, j,
+                            pReported[i * NUM_OBJS + j], expected);
+                    errors++;
+                }
+                else if (expected && (pTimes[i * NUM_OBJS + j] < time - 1e-9
+                        || pTimes[i * NUM_OBJS + j] > time + 1e-9)) {
+                    printf("frame %d: pair (%d, %d) touched at %f, expected "
+                            "%f\n", frame, i, j, pTimes[i * NUM_OBJS + j],
+                            time);
+                    errors++;
+                }
+                overlaps += expected;
+                j++;
+            }
+            i++;
+        }
+
+        frame++;
+    }
+
+    printf("%d frames, %d overlaps, %d errors\n", frames, overlaps, errors);
+    rv = (errors == 0) ? GFMRV_OK : GFMRV_FUNCTION_FAILED;
+__ret:
+    gfmQuadtree_free(&pQt);
+    i = 0;
+    while (i < NUM_OBJS) {
+        gfmObject_free(&(ppObjs[i]));
+        i++;
+    }
+    free(pReported);
+    free(pTimes);
+
+    return rv;
+}
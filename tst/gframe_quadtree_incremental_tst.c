@@ -0,0 +1,199 @@
+/**
+ * @file tst/gframe_quadtree_incremental_tst.c
+ *
+ * Check the quadtree's incremental mode against a brute-force test; A number
+ * of objects wander around the world (with a few others on the static layer)
+ * and, on every frame, some of them are untracked or tracked again; The
+ * overlaps reported by gfmQuadtree_refresh and gfmQuadtree_collideDeferred are
+ * then compared against testing every pair of objects
+ *
+ * Usage: gframe_quadtree_incremental_tst [<frames>]
+ */
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmObject.h>
+#include <GFraMe/gfmQuadtree.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gframe_tst_helpers.h"
+
+/** Dimensions of the world */
+#define WORLD_W    1024
+#define WORLD_H    1024
+/** How many objects are on the static layer */
+#define NUM_STATIC   40
+/** How many objects there are (static ones included) */
+#define NUM_OBJS    600
+/** Quadtree's parameters */
+#define MAX_DEPTH     6
+#define MAX_NODES     6
+
+int main(int argc, char *argv[]) {
+    gfmObject *ppObjs[NUM_OBJS];
+    gfmQuadtreePair *pPairs;
+    gfmQuadtreeRoot *pQt;
+    gfmRV rv;
+    char *pReported;
+    int pHandles[NUM_OBJS], pVx[NUM_OBJS], pVy[NUM_OBJS];
+    int count, errors, frame, frames, i, j, overlaps, tracked;
+
+    // Initialize every variable
+    memset(ppObjs, 0x0, sizeof(ppObjs));
+    pQt = 0;
+    pReported = 0;
+    errors = 0;
+    overlaps = 0;
+    tracked = 0;
+
+    frames = 120;
+    if (argc > 1) {
+        frames = atoi(argv[1]);
+    }
+    ASSERT(frames > 0, GFMRV_ARGUMENTS_BAD);
+
+    // Create every object, with different sizes
+    srand(1234);
+    i = 0;
+    while (i < NUM_OBJS) {
+        rv = gfmObject_getNew(&(ppObjs[i]));
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmObject_init(ppObjs[i], rand() % (WORLD_W - 32),
+                rand() % (WORLD_H - 32), 4 + rand() % 28, 4 + rand() % 28,
+                0/*pChild*/, 0/*type*/);
+        ASSERT_NR(rv == GFMRV_OK);
+        pVx[i] = rand() % 9 - 4;
+        pVy[i] = rand() % 9 - 4;
+        pHandles[i] = -1;
+        i++;
+    }
+
+    // Matrix with every reported pair
+    pReported = (char*)malloc(NUM_OBJS * NUM_OBJS);
+    ASSERT(pReported, GFMRV_ALLOC_FAILED);
+
+    rv = gfmQuadtree_getNew(&pQt);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    rv = gfmQuadtree_initStatic(pQt, 0, 0, WORLD_W, WORLD_H, MAX_DEPTH,
+            MAX_NODES);
+    ASSERT_NR(rv == GFMRV_OK);
+    i = 0;
+    while (i < NUM_STATIC) {
+        rv = gfmQuadtree_populateStaticObject(pQt, ppObjs[i]);
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+
+    // Track every other object only once
+    rv = gfmQuadtree_initIncremental(pQt, 0, 0, WORLD_W, WORLD_H, MAX_DEPTH,
+            MAX_NODES);
+    ASSERT_NR(rv == GFMRV_OK);
+    i = NUM_STATIC;
+    while (i < NUM_OBJS) {
+        rv = gfmQuadtree_trackObject(pHandles + i, pQt, ppObjs[i]);
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+
+    frame = 0;
+    while (frame < frames) {
+        // Move every dynamic object, (un)tracking a few of them
+        i = NUM_STATIC;
+        while (i < NUM_OBJS) {
+            int x, y;
+
+            if (rand() % 50 == 0) {
+                if (pHandles[i] >= 0) {
+                    rv = gfmQuadtree_untrackObject(pQt, pHandles[i]);
+                    ASSERT_NR(rv == GFMRV_OK);
+                    pHandles[i] = -1;
+                }
+                else {
+                    rv = gfmQuadtree_trackObject(pHandles + i, pQt,
+                            ppObjs[i]);
+                    ASSERT_NR(rv == GFMRV_OK);
+                }
+            }
+
+            rv = gfmObject_getPosition(&x, &y, ppObjs[i]);
+            ASSERT_NR(rv == GFMRV_OK);
+            x += pVx[i];
+            y += pVy[i];
+            if (x < 0 || x > WORLD_W - 32) {
+                pVx[i] = -pVx[i];
+            }
+            if (y < 0 || y > WORLD_H - 32) {
+                pVy[i] = -pVy[i];
+            }
+            rv = gfmObject_setPosition(ppObjs[i], x, y);
+            ASSERT_NR(rv == GFMRV_OK);
+            i++;
+        }
+
+        // Collide every tracked object
+        rv = gfmQuadtree_refresh(pQt);
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmQuadtree_collideDeferred(&pPairs, &count, pQt);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        memset(pReported, 0x0, NUM_OBJS * NUM_OBJS);
+        i = 0;
+        while (i < count) {
+            int a, b;
+
+            a = getIndex(ppObjs, NUM_OBJS, pPairs[i].pSelf);
+            b = getIndex(ppObjs, NUM_OBJS, pPairs[i].pOther);
+            ASSERT(a >= 0 && b >= 0, GFMRV_FUNCTION_FAILED);
+            pReported[a * NUM_OBJS + b]++;
+            pReported[b * NUM_OBJS + a]++;
+            i++;
+        }
+
+        // Check every pair where at least one object is tracked
+        tracked = 0;
+        i = 0;
+        while (i < NUM_OBJS) {
+            if (i >= NUM_STATIC && pHandles[i] >= 0) {
+                tracked++;
+            }
+            j = (i < NUM_STATIC) ? NUM_STATIC : i + 1;
+            while (j < NUM_OBJS) {
+                int expected;
+
+                expected = 0;
+                if ((i < NUM_STATIC || pHandles[i] >= 0) && pHandles[j] >= 0) {
+                    expected = (gfmObject_isOverlaping(ppObjs[i], ppObjs[j])
+                            == GFMRV_TRUE);
+                }
+                if (pReported[i * NUM_OBJS + j] != expected) {
+                    printf("frame %d: pair (%d, %d) reported %d time(s), "
+                            "expected %d\n", frame, i, j,
+                            pReported[i * NUM_OBJS + j], expected);
+                    errors++;
+                }
+                overlaps += expected;
+                j++;
+            }
+            i++;
+        }
+
+        frame++;
+    }
+
+    printf("%d frames, %d tracked (on the last one), %d overlaps, %d errors\n",
+            frames, tracked, overlaps, errors);
+    rv = (errors == 0) ? GFMRV_OK : GFMRV_FUNCTION_FAILED;
+__ret:
+    gfmQuadtree_free(&pQt);
+    i = 0;
+    while (i < NUM_OBJS) {
+        gfmObject_free(&(ppObjs[i]));
+        i++;
+    }
+    free(pReported);
+
+    return rv;
+}
@@ -0,0 +1,325 @@
+/**
+ * @file tst/gframe_quadtree_query_tst.c
+ *
+ * Check the quadtree's queries (gfmQuadtree_queryRect, gfmQuadtree_queryPoint
+ * and gfmQuadtree_queryRay) against a brute-force test; Objects are split
+ * between the static and the dynamic layers and a number of random queries
+ * is run, both on the regular and on the loose mode (rays must also return
+ * their objects ordered by distance)
+ *
+ * Usage: gframe_quadtree_query_tst [<queries>]
+ */
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmObject.h>
+#include <GFraMe/gfmQuadtree.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gframe_tst_helpers.h"
+
+/** Dimensions of the world */
+#define WORLD_W   1024
+#define WORLD_H    768
+/** How many objects there are */
+#define NUM_OBJS   400
+/** How many of those are on the static layer */
+#define NUM_STATIC 100
+/** Quadtree's parameters */
+#define MAX_DEPTH  6
+#define MAX_NODES  6
+
+/** Types of query */
+enum enQueryType {
+    query_rect = 0,
+    query_point,
+    query_ray,
+    query_max
+};
+typedef enum enQueryType queryType;
+
+static const char *pQueryNames[query_max] = {
+    "rect",
+    "point",
+    "ray"
+};
+
+/**
+ * Check whether a query touches an object's box (whose right and bottom edges
+ * are inclusive, as on the quadtree); Segments are checked by their end points
+ * and by each edge of the box, instead of by clipping it (as the quadtree
+ * does)
+ *
+ * @param  [ in]pObj   The object
+ * @param  [ in]type   The type of query
+ * @param  [ in]pQuery The query's parameters (x, y, width, height for rects;
+ *                     x0, y0, x1, y1 for rays)
+ * @return             1 if they touch, 0 otherwise
+ */
+static int bruteForce(gfmObject *pObj, queryType type, int *pQuery) {
+    int l, t, r, b, x, y, w, h;
+
+    gfmObject_getPosition(&x, &y, pObj);
+    gfmObject_getDimensions(&w, &h, pObj);
+    l = x;
+    t = y;
+    r = x + w;
+    b = y + h;
+
+    if (type != query_ray) {
+        return pQuery[0] <= r && pQuery[0] + pQuery[2] >= l &&
+                pQuery[1] <= b && pQuery[1] + pQuery[3] >= t;
+    }
+
+    /* Either end point inside the box */
+    if ((pQuery[0] >= l && pQuery[0] <= r && pQuery[1] >= t &&
+            pQuery[1] <= b) || (pQuery[2] >= l && pQuery[2] <= r &&
+            pQuery[3] >= t && pQuery[3] <= b)) {
+        return 1;
+    }
+    /* Or crossing any of its edges */
+    return segmentsTouch(pQuery[0], pQuery[1], pQuery[2], pQuery[3], l, t, r,
+            t) || segmentsTouch(pQuery[0], pQuery[1], pQuery[2], pQuery[3], r,
+            t, r, b) || segmentsTouch(pQuery[0], pQuery[1], pQuery[2],
+            pQuery[3], l, b, r, b) || segmentsTouch(pQuery[0], pQuery[1],
+            pQuery[2], pQuery[3], l, t, l, b);
+}
+
+/**
+ * Retrieve where a segment enters an object's box, as a fraction of the
+ * segment (0 if it starts inside the box)
+ *
+ * @param  [ in]pObj   The object (which must be touched by the segment)
+ * @param  [ in]pQuery The segment (x0, y0, x1, y1)
+ * @return             The entry point, in the range [0, 1]
+ */
+static double rayEntry(gfmObject *pObj, int *pQuery) {
+    double d, t0, t1, tEnter;
+    int i, pMin[2], pMax[2];
+
+    gfmObject_getPosition(pMin, pMin + 1, pObj);
+    gfmObject_getDimensions(pMax, pMax + 1, pObj);
+    pMax[0] += pMin[0];
+    pMax[1] += pMin[1];
+
+    tEnter = 0.0;
+    i = 0;
+    while (i < 2) {
+        d = pQuery[2 + i] - pQuery[i];
+        if (d != 0.0) {
+            t0 = (pMin[i] - pQuery[i]) / d;
+            t1 = (pMax[i] - pQuery[i]) / d;
+            if (t0 > t1) {
+                d = t0;
+                t0 = t1;
+                t1 = d;
+            }
+            if (t0 > tEnter) {
+                tEnter = t0;
+            }
+        }
+        i++;
+    }
+
+    return tEnter;
+}
+
+/**
+ * Run every query on the current quadtree
+ *
+ * @param  [ in]pQt     The quadtree
+ * @param  [ in]ppObjs  Every object
+ * @param  [ in]queries How many queries of each type should be run
+ * @param  [ in]isLoose Whether the quadtree is on loose mode (only printed)
+ * @return              How many errors were found (or -1, on failure)
+ */
+static int runQueries(gfmQuadtreeRoot *pQt, gfmObject **ppObjs, int queries,
+        int isLoose) {
+    gfmObject *ppFound[NUM_OBJS];
+    char pFound[NUM_OBJS];
+    int errors, hits;
+    queryType type;
+
+    errors = 0;
+    hits = 0;
+    type = query_rect;
+    while (type < query_max) {
+        int n;
+
+        n = 0;
+        while (n < queries) {
+            gfmRV rv;
+            int pQuery[4];
+            int count, i;
+
+            pQuery[0] = rand() % (WORLD_W + 64) - 32;
+            pQuery[1] = rand() % (WORLD_H + 64) - 32;
+            switch (type) {
+                case query_rect: {
+                    pQuery[2] = rand() % 128;
+                    pQuery[3] = rand() % 128;
+                    rv = gfmQuadtree_queryRect(ppFound, &count, pQt,
+                            pQuery[0], pQuery[1], pQuery[2], pQuery[3],
+                            NUM_OBJS);
+                } break;
+                case query_point: {
+                    pQuery[2] = 0;
+                    pQuery[3] = 0;
+                    rv = gfmQuadtree_queryPoint(ppFound, &count, pQt,
+                            pQuery[0], pQuery[1], NUM_OBJS);
+                } break;
+                default: {
+                    pQuery[2] = rand() % (WORLD_W + 64) - 32;
+                    pQuery[3] = rand() % (WORLD_H + 64) - 32;
+                    rv = gfmQuadtree_queryRay(ppFound, &count, pQt,
+                            pQuery[0], pQuery[1], pQuery[2], pQuery[3],
+                            NUM_OBJS);
+                }
+            }
+            if (rv != GFMRV_OK) {
+                printf("query failed: %s\n", gfmError_dict[rv]);
+                return -1;
+            }
+
+            /* Mark every returned object, checking for repeated ones (and,
+             * for rays, that they are ordered by distance) */
+            memset(pFound, 0x0, sizeof(pFound));
+            i = 0;
+            while (i < count) {
+                int j;
+
+                if (type == query_ray && i > 0 && rayEntry(ppFound[i], pQuery)
+                        < rayEntry(ppFound[i - 1], pQuery) - 1e-9) {
+                    printf("ray query (%d, %d, %d, %d)%s: object %d out of "
+                            "order\n", pQuery[0], pQuery[1], pQuery[2],
+                            pQuery[3], isLoose ? " (loose)" : "", i);
+                    errors++;
+                }
+
+                j = 0;
+                while (j < NUM_OBJS && ppObjs[j] != ppFound[i]) {
+                    j++;
+                }
+                if (j == NUM_OBJS || pFound[j]) {
+                    printf("%s query returned an invalid or repeated "
+                            "object\n", pQueryNames[type]);
+                    errors++;
+                }
+                else {
+                    pFound[j] = 1;
+                }
+                i++;
+            }
+
+            /* Compare against the brute-force test */
+            i = 0;
+            while (i < NUM_OBJS) {
+                int expected;
+
+                expected = bruteForce(ppObjs[i], type, pQuery);
+                if (expected != pFound[i]) {
+                    printf("%s query (%d, %d, %d, %d)%s: object %d %s\n",
+                            pQueryNames[type], pQuery[0], pQuery[1],
+                            pQuery[2], pQuery[3], isLoose ? " (loose)" : "",
+                            i, expected ? "missing" : "unexpected");
+                    errors++;
+                }
+                hits += expected;
+                i++;
+            }
+
+            n++;
+        }
+        type++;
+    }
+
+    printf("%s mode: %d queries, %d hits, %d errors\n",
+            isLoose ? "loose" : "regular", queries * query_max, hits, errors);
+    return errors;
+}
+
+int main(int argc, char *argv[]) {
+    gfmObject *ppObjs[NUM_OBJS];
+    gfmQuadtreeRoot *pQt;
+    gfmRV rv;
+    int errors, i, isLoose, queries;
+
+    // Initialize every variable
+    memset(ppObjs, 0x0, sizeof(ppObjs));
+    pQt = 0;
+    errors = 0;
+
+    queries = 500;
+    if (argc > 1) {
+        queries = atoi(argv[1]);
+    }
+    ASSERT(queries > 0, GFMRV_ARGUMENTS_BAD);
+
+    // Create every object, with different sizes (a few of them big)
+    srand(1234);
+    i = 0;
+    while (i < NUM_OBJS) {
+        int w, h;
+
+        if (i % 40 == 0) {
+            w = 64 + rand() % 192;
+            h = 8 + rand() % 64;
+        }
+        else {
+            w = 2 + rand() % 30;
+            h = 2 + rand() % 30;
+        }
+        rv = gfmObject_getNew(&(ppObjs[i]));
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmObject_init(ppObjs[i], rand() % (WORLD_W - w),
+                rand() % (WORLD_H - h), w, h, 0/*pChild*/, 0/*type*/);
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+
+    rv = gfmQuadtree_getNew(&pQt);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    isLoose = 0;
+    while (isLoose < 2) {
+        rv = gfmQuadtree_setLoose(pQt, isLoose ? 2.0 : 0.0);
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmQuadtree_initStatic(pQt, 0, 0, WORLD_W, WORLD_H, MAX_DEPTH,
+                MAX_NODES);
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmQuadtree_initRoot(pQt, 0, 0, WORLD_W, WORLD_H, MAX_DEPTH,
+                MAX_NODES);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        i = 0;
+        while (i < NUM_OBJS) {
+            if (i < NUM_STATIC) {
+                rv = gfmQuadtree_populateStaticObject(pQt, ppObjs[i]);
+            }
+            else {
+                rv = gfmQuadtree_populateObject(pQt, ppObjs[i]);
+            }
+            ASSERT_NR(rv == GFMRV_OK);
+            i++;
+        }
+
+        i = runQueries(pQt, ppObjs, queries, isLoose);
+        ASSERT(i >= 0, GFMRV_FUNCTION_FAILED);
+        errors += i;
+
+        isLoose++;
+    }
+
+    rv = (errors == 0) ? GFMRV_OK : GFMRV_FUNCTION_FAILED;
+__ret:
+    gfmQuadtree_free(&pQt);
+    i = 0;
+    while (i < NUM_OBJS) {
+        gfmObject_free(&(ppObjs[i]));
+        i++;
+    }
+
+    return rv;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file tst/gframe_quadtree_refresh_tst.c
+ *
+ * Benchmark of the quadtree's incremental mode; A number of objects wander
+ * around the world and, on every frame, they are collided either by
+ * rebuilding the quadtree (gfmQuadtree_initRoot and gfmQuadtree_deferObject
+ * for every object) or by moving them through gfmQuadtree_refresh; Both ways
+ * are then collided with gfmQuadtree_collideDeferred, so the number of
+ * overlaps must match
+ *
+ * Usage: gframe_quadtree_refresh_tst [<frames>]
+ */
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmObject.h>
+#include <GFraMe/gfmQuadtree.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/** Dimensions of the world */
+#define WORLD_W    4096
+#define WORLD_H    4096
+/** Dimensions of each object */
+#define OBJ_W      8
+#define OBJ_H      8
+/** Quadtree's parameters */
+#define MAX_DEPTH  8
+#define MAX_NODES  8
+
+/** Every object, with its position and velocity (in pixels per frame) */
+struct stBenchObject {
+    gfmObject *pObj;
+    int x;
+    int y;
+    int vx;
+    int vy;
+};
+typedef struct stBenchObject benchObject;
+
+/**
+ * Place every object on its initial position, so both runs start equal
+ *
+ * @param  [ in]pObjs The objects
+ * @param  [ in]num   How many objects there are
+ * @return            GFMRV_OK, ...
+ */
+static gfmRV resetObjects(benchObject *pObjs, int num) {
+    gfmRV rv;
+    int i;
+
+    srand(1234);
+    i = 0;
+    while (i < num) {
+        pObjs[i].x = rand() % (WORLD_W - OBJ_W);
+        pObjs[i].y = rand() % (WORLD_H - OBJ_H);
+        pObjs[i].vx = rand() % 5 - 2;
+        pObjs[i].vy = rand() % 5 - 2;
+        rv = gfmObject_setPosition(pObjs[i].pObj, pObjs[i].x, pObjs[i].y);
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Move every object, bouncing them off the world's bounds
+ *
+ * @param  [ in]pObjs The objects
+ * @param  [ in]num   How many objects there are
+ * @return            GFMRV_OK, ...
+ */
+static gfmRV moveObjects(benchObject *pObjs, int num) {
+    gfmRV rv;
+    int i;
+
+    i = 0;
+    while (i < num) {
+        benchObject *pCur;
+
+        pCur = pObjs + i;
+        pCur->x += pCur->vx;
+        pCur->y += pCur->vy;
+        if (pCur->x < 0 || pCur->x > WORLD_W - OBJ_W) {
+            pCur->vx = -pCur->vx;
+            pCur->x += 2 * pCur->vx;
+        }
+        if (pCur->y < 0 || pCur->y > WORLD_H - OBJ_H) {
+            pCur->vy = -pCur->vy;
+            pCur->y += 2 * pCur->vy;
+        }
+        rv = gfmObject_setPosition(pCur->pObj, pCur->x, pCur->y);
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+/**
+ * Run the benchmark for a given number of objects
+ *
+ * @param  [ in]pQt    The quadtree
+ * @param  [ in]pObjs  The objects
+ * @param  [ in]num    How many objects there are
+ * @param  [ in]frames For how many frames it should run
+ * @return             GFMRV_OK, ...
+ */
+static gfmRV runBenchmark(gfmQuadtreeRoot *pQt, benchObject *pObjs, int num,
+        int frames) {
+    gfmQuadtreePair *pPairs;
+    clock_t rebuild, refresh, start;
+    long rebuildPairs, refreshPairs;
+    gfmRV rv;
+    int count, frame, i;
+
+    /* Rebuild the quadtree on every frame */
+    rv = resetObjects(pObjs, num);
+    ASSERT_NR(rv == GFMRV_OK);
+    rebuildPairs = 0;
+    start = clock();
+    frame = 0;
+    while (frame < frames) {
+        rv = moveObjects(pObjs, num);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        rv = gfmQuadtree_initRoot(pQt, 0, 0, WORLD_W, WORLD_H, MAX_DEPTH,
+                MAX_NODES);
+        ASSERT_NR(rv == GFMRV_OK);
+        i = 0;
+        while (i < num) {
+            rv = gfmQuadtree_deferObject(pQt, pObjs[i].pObj);
+            ASSERT_NR(rv == GFMRV_OK);
+            i++;
+        }
+        rv = gfmQuadtree_collideDeferred(&pPairs, &count, pQt);
+        ASSERT_NR(rv == GFMRV_OK);
+        rebuildPairs += count;
+
+        frame++;
+    }
+    rebuild = clock() - start;
+
+    /* Track every object once and refresh it on every frame */
+    rv = resetObjects(pObjs, num);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmQuadtree_initIncremental(pQt, 0, 0, WORLD_W, WORLD_H, MAX_DEPTH,
+            MAX_NODES);
+    ASSERT_NR(rv == GFMRV_OK);
+    i = 0;
+    while (i < num) {
+        int handle;
+
+        rv = gfmQuadtree_trackObject(&handle, pQt, pObjs[i].pObj);
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+    refreshPairs = 0;
+    start = clock();
+    frame = 0;
+    while (frame < frames) {
+        rv = moveObjects(pObjs, num);
+        ASSERT_NR(rv == GFMRV_OK);
+
+        rv = gfmQuadtree_refresh(pQt);
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmQuadtree_collideDeferred(&pPairs, &count, pQt);
+        ASSERT_NR(rv == GFMRV_OK);
+        refreshPairs += count;
+
+        frame++;
+    }
+    refresh = clock() - start;
+
+    printf("%6d objects: rebuild %8.3f ms/frame, refresh %8.3f ms/frame "
+            "(%ld/%ld overlaps)%s\n", num,
+            1000.0 * rebuild / CLOCKS_PER_SEC / frames,
+            1000.0 * refresh / CLOCKS_PER_SEC / frames,
+            rebuildPairs, refreshPairs,
+            (rebuildPairs != refreshPairs) ? " MISMATCH" : "");
+    ASSERT(rebuildPairs == refreshPairs, GFMRV_FUNCTION_FAILED);
+
+    rv = GFMRV_OK;
+__ret:
+    return rv;
+}
+
+int main(int argc, char *argv[]) {
+    benchObject *pObjs;
+    gfmQuadtreeRoot *pQt;
+    gfmRV rv;
+    int frames, i, maxObjs;
+    int pNums[] = {1000, 10000, 50000};
+
+    // Initialize every variable
+    pObjs = 0;
+    pQt = 0;
+    maxObjs = 0;
+
+    frames = 60;
+    if (argc > 1) {
+        frames = atoi(argv[1]);
+    }
+    ASSERT(frames > 0, GFMRV_ARGUMENTS_BAD);
+
+    // Alloc every object
+    maxObjs = pNums[sizeof(pNums) / sizeof(int) - 1];
+    pObjs = (benchObject*)calloc(maxObjs, sizeof(benchObject));
+    ASSERT(pObjs, GFMRV_ALLOC_FAILED);
+    i = 0;
+    while (i < maxObjs) {
+        rv = gfmObject_getNew(&(pObjs[i].pObj));
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmObject_init(pObjs[i].pObj, 0/*x*/, 0/*y*/, OBJ_W, OBJ_H,
+                0/*pChild*/, 0/*type*/);
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+
+    // Alloc the quadtree
+    rv = gfmQuadtree_getNew(&pQt);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    i = 0;
+    while (i < (int)(sizeof(pNums) / sizeof(int))) {
+        rv = runBenchmark(pQt, pObjs, pNums[i], frames);
+        ASSERT_NR(rv == GFMRV_OK);
+        i++;
+    }
+
+    rv = GFMRV_OK;
+__ret:
+    gfmQuadtree_free(&pQt);
+    if (pObjs) {
+        i = 0;
+        while (i < maxObjs) {
+            gfmObject_free(&(pObjs[i].pObj));
+            i++;
+        }
+        free(pObjs);
+    }
+
+    return rv;
+}
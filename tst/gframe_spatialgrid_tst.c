@@ -0,0 +1,226 @@
+/**
+ * @file tst/gframe_spatialgrid_tst.c
+ * 
+ * Basic spatial grid test (the same scene as gframe_quadtree_basic_tst, but
+ * using a gfmSpatialGrid as the broadphase)
+ */
+#include <GFraMe/gframe.h>
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmObject.h>
+#include <GFraMe/gfmSpatialGrid.h>
+#include <GFraMe/gfmSprite.h>
+#include <GFraMe/gfmSpriteset.h>
+#include <GFraMe/gfmTypes.h>
+
+// Set the game's FPS
+#define FPS       60
+#define WNDW     160
+#define WNDH     120
+
+// Define the animations
+enum {
+    ANIM_STAND = 0,
+    ANIM_WALK,
+    ANIM_HURT,
+    ANIM_JUMP,
+    ANIM_FALL,
+    ANIM_MAX,
+};
+
+/** Create the animations */
+int pSprAnims[] = {
+/* num|fps|loop|frames... */
+    // Stand animation
+    8 ,  8,  1 , 32,32,43,32,32,44,32,45,
+    // Walk animation
+    8 , 14,  1 , 33,34,35,36,37,38,39,40,
+    // Hurt animation
+    8 , 12,  0 , 41,42,41,42,41,42,41,42,
+    // Jump animation
+    1 ,  0,  0 , 46,
+    // Fall animation
+    1 ,  0,  0 , 47
+};
+
+int main(int arg, char *argv[]) {
+    gfmCtx *pCtx;
+    gfmObject *pObj;
+    gfmSpatialGrid *pGrid;
+    gfmRV rv;
+    gfmSprite *pSpr;
+    gfmSpriteset *pSset8, *pSset16;
+    int iTex;
+    
+    // Initialize every variable
+    pCtx = 0;
+    pObj = 0;
+    pGrid = 0;
+    pSpr = 0;
+    
+    // Try to get a new context
+    rv = gfm_getNew(&pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfm_initStatic(pCtx, "com.gfmgamecorner", "gframe_spatialgrid");
+    ASSERT_NR(rv == GFMRV_OK);
+    
+    // Initialize the window
+    rv = gfm_initGameWindow(pCtx, WNDW, WNDH, 640, 480, 0, 0);
+    ASSERT_NR(rv == GFMRV_OK);
+    
+    // Load the texture
+    rv = gfm_loadTextureStatic(&iTex, pCtx, "big_atlas.bmp", 0xff00ff);
+    ASSERT_NR(rv == GFMRV_OK);
+    // Set it as the default
+    rv = gfm_setDefaultTexture(pCtx, iTex);
+    ASSERT_NR(rv == GFMRV_OK);
+    
+    // Create the spritesets
+    rv = gfm_createSpritesetCached(&pSset8, pCtx, iTex, 8/*tw*/, 8/*th*/);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfm_createSpritesetCached(&pSset16, pCtx, iTex, 16/*tw*/, 16/*th*/);
+    ASSERT_NR(rv == GFMRV_OK);
+    
+    // Initalize the FPS counter
+    rv = gfm_initFPSCounter(pCtx, pSset8, 64/*firstTile*/);
+    ASSERT_NR(rv == GFMRV_OK);
+    
+    // Create an object
+    rv = gfmObject_getNew(&pObj);
+    ASSERT_NR(rv == GFMRV_OK);
+    // Initialize it
+    rv = gfmObject_init(pObj, 0/*x*/, WNDH - 16/*y*/, WNDW, 16, 0/*pChild*/, 0);
+    ASSERT_NR(rv == GFMRV_OK);
+    // Make it immovable
+    rv = gfmObject_setFixed(pObj);
+    ASSERT_NR(rv == GFMRV_OK);
+    
+    // Create a sprite
+    rv = gfmSprite_getNew(&pSpr);
+    ASSERT_NR(rv == GFMRV_OK);
+    // Initialize it
+    rv = gfmSprite_init(pSpr, 16/*x*/, 16/*y*/, 6/*width*/, 12/*height*/,
+            pSset16, -4/*offX*/, -4/*offY*/, 0/*pChild*/, 0/*type*/);
+    ASSERT_NR(rv == GFMRV_OK);
+    // Add the animations
+    rv = gfmSprite_addAnimationsStatic(pSpr, pSprAnims);
+    ASSERT_NR(rv == GFMRV_OK);
+    // Set the sprite's gravity
+    rv = gfmSprite_setVerticalAcceleration(pSpr, 500.0);
+    ASSERT_NR(rv == GFMRV_OK);
+    
+    // Play an animation
+    rv = gfmSprite_playAnimation(pSpr, ANIM_FALL);
+    ASSERT_NR(rv == GFMRV_OK);
+    
+    // Alloc the grid
+    rv = gfmSpatialGrid_getNew(&pGrid);
+    ASSERT_NR(rv == GFMRV_OK);
+    
+    // Set the main loop framerate
+    rv = gfm_setStateFrameRate(pCtx, FPS, FPS);
+    ASSERT_NR(rv == GFMRV_OK);
+    // Initialize the timer
+    rv = gfm_setFPS(pCtx, FPS);
+    ASSERT_NR(rv == GFMRV_OK);
+    
+    // Run until the window is closed
+    while (gfm_didGetQuitFlag(pCtx) == GFMRV_FALSE) {
+        rv = gfm_handleEvents(pCtx);
+        ASSERT_NR(rv == GFMRV_OK);
+        
+        // Update stuff
+        while (gfm_isUpdating(pCtx) == GFMRV_TRUE) {
+            rv = gfm_fpsCounterUpdateBegin(pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+            
+            // Update the sprite's physics
+            rv = gfmSprite_update(pSpr, pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+            // Update the object's physics
+            rv = gfmObject_update(pObj, pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+            
+            // Initialize the grid, with cells the size of the sprite's tiles
+            rv = gfmSpatialGrid_initRoot(pGrid, -16, -16, WNDW+32, WNDH+32,
+                    16/*cellWidth*/, 16/*cellHeight*/);
+            ASSERT_NR(rv == GFMRV_OK);
+            // Populate the grid with the object
+            rv = gfmSpatialGrid_populateObject(pGrid, pObj);
+            ASSERT_NR(rv == GFMRV_OK);
+            
+            // Add the sprite, colliding with everything
+            rv = gfmSpatialGrid_collideSprite(pGrid, pSpr);
+            ASSERT_NR(rv == GFMRV_SPATIALGRID_DONE ||
+                    rv == GFMRV_SPATIALGRID_OVERLAPED);
+            while (rv != GFMRV_SPATIALGRID_DONE) {
+                gfmObject *pObj1, *pObj2;
+                gfmSprite *pSpr1, *pSpr2;
+                int pType1, pType2;
+                
+                // Get the objects that collided
+                rv = gfmSpatialGrid_getOverlaping(&pObj1, &pObj2, pGrid);
+                ASSERT_NR(rv == GFMRV_OK);
+                
+                // Separate both objects
+                rv = gfmObject_separateHorizontal(pObj1, pObj2);
+                rv = gfmObject_separateVertical(pObj1, pObj2);
+                
+                // Try to get both sprites children
+                rv = gfmObject_getChild((void**)&pSpr1, &pType1, pObj1);
+                ASSERT_NR(rv == GFMRV_OK);
+                rv = gfmObject_getChild((void**)&pSpr2, &pType2, pObj2);
+                ASSERT_NR(rv == GFMRV_OK);
+                
+                // Change the sprite animation and cap its velocity
+                if (pType1 == gfmType_sprite) {
+                    rv = gfmSprite_playAnimation(pSpr1, ANIM_STAND);
+                    ASSERT_NR(rv == GFMRV_OK);
+                    rv = gfmSprite_setVerticalVelocity(pSpr1, 0.0);
+                    ASSERT_NR(rv == GFMRV_OK);
+                    rv = gfmSprite_setVerticalAcceleration(pSpr1, 0.0);
+                    ASSERT_NR(rv == GFMRV_OK);
+                }
+                if (pType2 == gfmType_sprite) {
+                    rv = gfmSprite_playAnimation(pSpr2, ANIM_STAND);
+                    ASSERT_NR(rv == GFMRV_OK);
+                    rv = gfmSprite_setVerticalVelocity(pSpr2, 0.0);
+                    ASSERT_NR(rv == GFMRV_OK);
+                    rv = gfmSprite_setVerticalAcceleration(pSpr2, 0.0);
+                    ASSERT_NR(rv == GFMRV_OK);
+                }
+                
+                // Continue colliding
+                rv = gfmSpatialGrid_continue(pGrid);
+                ASSERT_NR(rv == GFMRV_SPATIALGRID_DONE ||
+                        rv == GFMRV_SPATIALGRID_OVERLAPED);
+            }
+            
+            rv = gfm_fpsCounterUpdateEnd(pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+        }
+        
+        // Draw stuff
+        while (gfm_isDrawing(pCtx) == GFMRV_TRUE) {
+            rv = gfm_drawBegin(pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+            
+            // Draw the sprite
+            rv = gfmSprite_draw(pSpr, pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+            
+            rv = gfm_drawEnd(pCtx);
+            ASSERT_NR(rv == GFMRV_OK);
+        }
+    }
+    
+    rv = GFMRV_OK;
+__ret:
+    gfmSpatialGrid_free(&pGrid);
+    gfmSprite_free(&pSpr);
+    gfmObject_free(&pObj);
+    gfm_free(&pCtx);
+    
+    return rv;
+}
+
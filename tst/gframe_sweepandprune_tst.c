@@ -0,0 +1,166 @@
+/**
+ * @file tst/gframe_sweepandprune_tst.c
+ *
+ * Check gfmSweepAndPrune against a brute-force test; A number of objects
+ * wander around a long strip (the first few ones are populated, the others
+ * are collided) and, on every frame, every overlap reported by the broadphase
+ * is compared against testing every pair of objects
+ *
+ * Usage: gframe_sweepandprune_tst [<frames>]
+ */
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmObject.h>
+#include <GFraMe/gfmSweepAndPrune.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gframe_tst_helpers.h"
+
+/** Dimensions of the world (a long strip) */
+#define WORLD_W   8192
+#define WORLD_H    256
+/** How many objects there are */
+#define NUM_OBJS   600
+/** How many of those are only populated (i.e., never collided) */
+#define NUM_POP     60
+
+int main(int argc, char *argv[]) {
+    gfmObject *ppObjs[NUM_OBJS];
+    gfmSweepAndPrune *pSap;
+    gfmRV rv;
+    char *pReported;
+    int pVx[NUM_OBJS], pVy[NUM_OBJS];
+    int errors, frame, frames, i, j, pairs;
+
+    // Initialize every variable
+    memset(ppObjs, 0x0, sizeof(ppObjs));
+    pSap = 0;
+    pReported = 0;
+    errors = 0;
+    pairs = 0;
+
+    frames = 60;
+    if (argc > 1) {
+        frames = atoi(argv[1]);
+    }
+    ASSERT(frames > 0, GFMRV_ARGUMENTS_BAD);
+
+    // Create every object, with different sizes
+    srand(1234);
+    i = 0;
+    while (i < NUM_OBJS) {
+        rv = gfmObject_getNew(&(ppObjs[i]));
+        ASSERT_NR(rv == GFMRV_OK);
+        rv = gfmObject_init(ppObjs[i], rand() % (WORLD_W - 64),
+                rand() % (WORLD_H - 64), 4 + rand() % 28, 4 + rand() % 28,
+                0/*pChild*/, 0/*type*/);
+        ASSERT_NR(rv == GFMRV_OK);
+        pVx[i] = rand() % 9 - 4;
+        pVy[i] = rand() % 5 - 2;
+        i++;
+    }
+
+    // Matrix with every reported pair
+    pReported = (char*)malloc(NUM_OBJS * NUM_OBJS);
+    ASSERT(pReported, GFMRV_ALLOC_FAILED);
+
+    rv = gfmSweepAndPrune_getNew(&pSap);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    frame = 0;
+    while (frame < frames) {
+        // Move every object
+        i = 0;
+        while (i < NUM_OBJS) {
+            int x, y;
+
+            rv = gfmObject_getPosition(&x, &y, ppObjs[i]);
+            ASSERT_NR(rv == GFMRV_OK);
+            x += pVx[i];
+            y += pVy[i];
+            if (x < 0 || x > WORLD_W - 32) {
+                pVx[i] = -pVx[i];
+            }
+            if (y < 0 || y > WORLD_H - 32) {
+                pVy[i] = -pVy[i];
+            }
+            rv = gfmObject_setPosition(ppObjs[i], x, y);
+            ASSERT_NR(rv == GFMRV_OK);
+            i++;
+        }
+
+        // Run the broadphase, storing every reported pair
+        memset(pReported, 0x0, NUM_OBJS * NUM_OBJS);
+        rv = gfmSweepAndPrune_init(pSap);
+        ASSERT_NR(rv == GFMRV_OK);
+        i = 0;
+        while (i < NUM_OBJS) {
+            if (i < NUM_POP) {
+                rv = gfmSweepAndPrune_populateObject(pSap, ppObjs[i]);
+                ASSERT_NR(rv == GFMRV_OK);
+                i++;
+                continue;
+            }
+
+            rv = gfmSweepAndPrune_collideObject(pSap, ppObjs[i]);
+            ASSERT_NR(rv == GFMRV_QUADTREE_OVERLAPED ||
+                    rv == GFMRV_QUADTREE_DONE);
+            while (rv == GFMRV_QUADTREE_OVERLAPED) {
+                gfmObject *pObj1, *pObj2;
+                int a, b;
+
+                rv = gfmSweepAndPrune_getOverlaping(&pObj1, &pObj2, pSap);
+                ASSERT_NR(rv == GFMRV_OK);
+                a = getIndex(ppObjs, NUM_OBJS, pObj1);
+                b = getIndex(ppObjs, NUM_OBJS, pObj2);
+                ASSERT(a >= 0 && b >= 0, GFMRV_FUNCTION_FAILED);
+                pReported[a * NUM_OBJS + b]++;
+                pReported[b * NUM_OBJS + a]++;
+
+                rv = gfmSweepAndPrune_continue(pSap);
+                ASSERT_NR(rv == GFMRV_QUADTREE_OVERLAPED ||
+                        rv == GFMRV_QUADTREE_DONE);
+            }
+            i++;
+        }
+
+        // Check every pair where at least one object was collided
+        i = 0;
+        while (i < NUM_OBJS) {
+            j = (i < NUM_POP) ? NUM_POP : i + 1;
+            while (j < NUM_OBJS) {
+                int expected;
+
+                expected = (gfmObject_isOverlaping(ppObjs[i], ppObjs[j]) ==
+                        GFMRV_TRUE);
+                if (pReported[i * NUM_OBJS + j] != expected) {
+                    printf("frame %d: pair (%d, %d) reported %d time(s), "
+                            "expected %d\n", frame, i, j,
+                            pReported[i * NUM_OBJS + j], expected);
+                    errors++;
+                }
+                pairs += expected;
+                j++;
+            }
+            i++;
+        }
+
+        frame++;
+    }
+
+    printf("%d frames, %d overlaps, %d errors\n", frames, pairs, errors);
+    rv = (errors == 0) ? GFMRV_OK : GFMRV_FUNCTION_FAILED;
+__ret:
+    gfmSweepAndPrune_free(&pSap);
+    i = 0;
+    while (i < NUM_OBJS) {
+        gfmObject_free(&(ppObjs[i]));
+        i++;
+    }
+    free(pReported);
+
+    return rv;
+}
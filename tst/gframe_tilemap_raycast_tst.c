@@ -0,0 +1,264 @@
+/**
+ * @file tst/gframe_tilemap_raycast_tst.c
+ *
+ * Check gfmTilemap_raycast against a brute-force test; A tilemap is randomly
+ * filled with two types of tiles (only one of them blocking the segments) and
+ * a number of random segments (20000, by default, or however many were passed
+ * as the first argument) are cast through it; Each segment is also sampled
+ * densely (and exactly on every point where it crosses the grid, so segments
+ * going through a tile's corner aren't missed) and the first blocking tile
+ * found that way must be the one returned by the raycast (and it must have
+ * been entered just before that sample)
+ *
+ * Usage: gframe_tilemap_raycast_tst [<segments>]
+ */
+#include <GFraMe/gframe.h>
+#include <GFraMe/gfmAssert.h>
+#include <GFraMe/gfmError.h>
+#include <GFraMe/gfmSpriteset.h>
+#include <GFraMe/gfmTilemap.h>
+#include <GFraMe/gfmTypes.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/** Dimensions of the tilemap, in tiles */
+#define MAP_W      20
+#define MAP_H      15
+/** Dimensions of each tile (non-square, to catch swapped axis) */
+#define TILE_W     16
+#define TILE_H      8
+/** How many points are sampled on each segment */
+#define SAMPLES    200000
+/** Tile (and type) that blocks the segments */
+#define WALL_TILE   1
+#define WALL_TYPE   gfmType_reserved_2
+/** Tile (and type) that is ignored by the segments */
+#define FLOOR_TILE  2
+#define FLOOR_TYPE  gfmType_reserved_3
+
+/**
+ * Divide two integers, rounding towards negative infinity
+ *
+ * @param  [ in]num The dividend
+ * @param  [ in]den The divisor (which must be positive)
+ * @return          The quotient
+ */
+static long floorDiv(long num, long den) {
+    if (num < 0) {
+        return -((-num + den - 1) / den);
+    }
+    return num / den;
+}
+
+/**
+ * Check whether a tile blocks the segment, keeping the earliest one
+ *
+ * @param  [out]pTile  The earliest blocking tile found so far
+ * @param  [out]pTime  When the segment reached pTile
+ * @param  [ in]pData  The tilemap's data
+ * @param  [ in]tx     The tile's column
+ * @param  [ in]ty     The tile's row
+ * @param  [ in]time   When the segment reached the tile
+ */
+static void checkTile(int *pTile, double *pTime, int *pData, long tx, long ty,
+        double time) {
+    if (tx >= 0 && ty >= 0 && tx < MAP_W && ty < MAP_H &&
+            pData[tx + ty * MAP_W] == WALL_TILE &&
+            (*pTile == -1 || time < *pTime)) {
+        *pTile = (int)(tx + ty * MAP_W);
+        *pTime = time;
+    }
+}
+
+/**
+ * Sample a segment, looking for the first blocking tile; Besides the evenly
+ * spaced samples, the segment is sampled exactly (with integers) wherever it
+ * crosses a tile's edge
+ *
+ * @param  [out]pTime  Fraction of the segment where the tile was found
+ * @param  [ in]pData  The tilemap's data
+ * @param  [ in]x0     The segment's start
+ * @param  [ in]y0     The segment's start
+ * @param  [ in]x1     The segment's end
+ * @param  [ in]y1     The segment's end
+ * @return             The tile's index (or -1, if none was found)
+ */
+static int bruteForce(double *pTime, int *pData, int x0, int y0, int x1,
+        int y1) {
+    long dx, dy;
+    int i, tile;
+
+    tile = -1;
+    *pTime = 0.0;
+
+    i = 0;
+    while (i <= SAMPLES) {
+        double s;
+
+        s = (double)i / SAMPLES;
+        checkTile(&tile, pTime, pData,
+                (long)floor((x0 + (x1 - x0) * s) / TILE_W),
+                (long)floor((y0 + (y1 - y0) * s) / TILE_H), s);
+        i++;
+    }
+
+    /* Vertical edges: at x = X, y = y0 + dy * (X - x0) / dx */
+    dx = x1 - x0;
+    dy = y1 - y0;
+    i = 0;
+    while (dx != 0 && i <= MAP_W) {
+        long num, sign, X;
+
+        X = (long)i * TILE_W;
+        sign = (dx > 0) ? 1 : -1;
+        if ((X - x0) * sign >= 0 && (x1 - X) * sign >= 0) {
+            num = (y0 * dx + dy * (X - x0)) * sign;
+            checkTile(&tile, pTime, pData, i,
+                    floorDiv(num, dx * sign * TILE_H),
+                    (double)(X - x0) / dx);
+        }
+        i++;
+    }
+    /* Horizontal edges: at y = Y, x = x0 + dx * (Y - y0) / dy */
+    i = 0;
+    while (dy != 0 && i <= MAP_H) {
+        long num, sign, Y;
+
+        Y = (long)i * TILE_H;
+        sign = (dy > 0) ? 1 : -1;
+        if ((Y - y0) * sign >= 0 && (y1 - Y) * sign >= 0) {
+            num = (x0 * dy + dx * (Y - y0)) * sign;
+            checkTile(&tile, pTime, pData,
+                    floorDiv(num, dy * sign * TILE_W), i,
+                    (double)(Y - y0) / dy);
+        }
+        i++;
+    }
+
+    return tile;
+}
+
+int main(int argc, char *argv[]) {
+    gfmCtx *pCtx;
+    gfmRV rv;
+    gfmSpriteset *pSset;
+    gfmTilemap *pTMap;
+    int *pData;
+    int errors, hits, i, iTex, segments;
+
+    // Initialize every variable
+    pCtx = 0;
+    pSset = 0;
+    pTMap = 0;
+    errors = 0;
+    hits = 0;
+
+    segments = 20000;
+    if (argc > 1) {
+        segments = atoi(argv[1]);
+    }
+    ASSERT(segments > 0, GFMRV_ARGUMENTS_BAD);
+
+    // Try to get a new context
+    rv = gfm_getNew(&pCtx);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfm_initStatic(pCtx, "com.gfmgamecorner", "gframe_tilemap_raycast");
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Initialize the window (required by the texture)
+    rv = gfm_initGameWindow(pCtx, 160, 120, 640, 480, 0, 0);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Load the texture
+    rv = gfm_loadTextureStatic(&iTex, pCtx, "rainbow_atlas.bmp", 0xff00ff);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Create a spriteset
+    rv = gfmSpriteset_getNew(&pSset);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmSpriteset_initCached(pSset, pCtx, iTex, TILE_W, TILE_H);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Create the tilemap and fill it randomly
+    rv = gfmTilemap_getNew(&pTMap);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmTilemap_init(pTMap, pSset, MAP_W, MAP_H, 0/*defTile*/);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmTilemap_getData(&pData, pTMap);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    srand(1234);
+    i = 0;
+    while (i < MAP_W * MAP_H) {
+        if (rand() % 7 == 0) {
+            pData[i] = WALL_TILE;
+        }
+        else if (rand() % 11 == 0) {
+            pData[i] = FLOOR_TILE;
+        }
+        else {
+            pData[i] = 0;
+        }
+        i++;
+    }
+    rv = gfmTilemap_addTileType(pTMap, WALL_TILE, WALL_TYPE);
+    ASSERT_NR(rv == GFMRV_OK);
+    rv = gfmTilemap_addTileType(pTMap, FLOOR_TILE, FLOOR_TYPE);
+    ASSERT_NR(rv == GFMRV_OK);
+
+    // Cast every segment (some starting or ending outside the tilemap)
+    i = 0;
+    while (i < segments) {
+        gfmTilemapHit hit;
+        double time;
+        int expected, x0, y0, x1, y1;
+
+        x0 = rand() % (MAP_W * TILE_W + 80) - 40;
+        y0 = rand() % (MAP_H * TILE_H + 40) - 20;
+        x1 = rand() % (MAP_W * TILE_W + 80) - 40;
+        y1 = rand() % (MAP_H * TILE_H + 40) - 20;
+
+        expected = bruteForce(&time, pData, x0, y0, x1, y1);
+        rv = gfmTilemap_raycast(&hit, pTMap, x0, y0, x1, y1,
+                1u << WALL_TYPE);
+        ASSERT(rv == GFMRV_TRUE || rv == GFMRV_FALSE, rv);
+
+        if (rv == GFMRV_FALSE && expected != -1) {
+            printf("(%d, %d) -> (%d, %d): missed tile (%d, %d)\n", x0, y0,
+                    x1, y1, expected % MAP_W, expected / MAP_W);
+            errors++;
+        }
+        else if (rv == GFMRV_TRUE && expected != hit.tileX +
+                hit.tileY * MAP_W) {
+            printf("(%d, %d) -> (%d, %d): hit tile (%d, %d), expected %d\n",
+                    x0, y0, x1, y1, hit.tileX, hit.tileY, expected);
+            errors++;
+        }
+        else if (rv == GFMRV_TRUE) {
+            // Check that the hit is consistent with the tile
+            if (hit.type != WALL_TYPE || hit.x / TILE_W != hit.tileX ||
+                    hit.y / TILE_H != hit.tileY || hit.time > time + 1e-9 ||
+                    time - hit.time > 1.0 / SAMPLES + 1e-9) {
+                printf("(%d, %d) -> (%d, %d): bad hit on tile (%d, %d) "
+                        "(type %d, at (%d, %d), time %f, expected %f)\n", x0,
+                        y0, x1, y1, hit.tileX, hit.tileY, hit.type, hit.x,
+                        hit.y, hit.time, time);
+                errors++;
+            }
+            hits++;
+        }
+
+        i++;
+    }
+
+    printf("%d segments, %d hits, %d errors\n", segments, hits, errors);
+    rv = (errors == 0) ? GFMRV_OK : GFMRV_FUNCTION_FAILED;
+__ret:
+    gfmTilemap_free(&pTMap);
+    gfmSpriteset_free(&pSset);
+    gfm_free(&pCtx);
+
+    return rv;
+}
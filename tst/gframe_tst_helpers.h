@@ -0,0 +1,83 @@
+/**
+ * @file tst/gframe_tst_helpers.h
+ *
+ * Helpers shared by the brute-force tests: looking up an object's index and
+ * checking whether two segments touch.
+ */
+#ifndef __GFRAME_TST_HELPERS_H__
+#define __GFRAME_TST_HELPERS_H__
+
+#include <GFraMe/gfmObject.h>
+
+/**
+ * Retrieve the index of an object
+ *
+ * @param  [ in]ppObjs The objects
+ * @param  [ in]len    How many objects there are
+ * @param  [ in]pObj   The object
+ * @return             The object's index (or -1, if it wasn't found)
+ */
+inline static int getIndex(gfmObject **ppObjs, int len, gfmObject *pObj) {
+    int i;
+
+    i = 0;
+    while (i < len) {
+        if (ppObjs[i] == pObj) {
+            return i;
+        }
+        i++;
+    }
+    return -1;
+}
+
+/**
+ * Retrieve on which side of the line (ax, ay)-(bx, by) a point is
+ *
+ * @return >0 (counter-clockwise), <0 (clockwise), 0 (collinear)
+ */
+inline static long orientation(long ax, long ay, long bx, long by, long px,
+        long py) {
+    return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+}
+
+/**
+ * Check whether a collinear point (px, py) is within the segment's bounding box
+ *
+ * @return 1 if it is, 0 otherwise
+ */
+inline static int onSegment(long x0, long y0, long x1, long y1, long px,
+        long py) {
+    return px >= (x0 < x1 ? x0 : x1) && px <= (x0 < x1 ? x1 : x0) &&
+            py >= (y0 < y1 ? y0 : y1) && py <= (y0 < y1 ? y1 : y0);
+}
+
+/**
+ * Check whether two segments touch (including their end points)
+ *
+ * @return 1 if they do, 0 otherwise
+ */
+inline static int segmentsTouch(long ax, long ay, long bx, long by, long cx,
+        long cy, long dx, long dy) {
+    long o1, o2, o3, o4;
+
+    o1 = orientation(ax, ay, bx, by, cx, cy);
+    o2 = orientation(ax, ay, bx, by, dx, dy);
+    o3 = orientation(cx, cy, dx, dy, ax, ay);
+    o4 = orientation(cx, cy, dx, dy, bx, by);
+
+    if (((o1 > 0 && o2 < 0) || (o1 < 0 && o2 > 0)) &&
+            ((o3 > 0 && o4 < 0) || (o3 < 0 && o4 > 0))) {
+        return 1;
+    }
+
+    if ((o1 == 0 && onSegment(ax, ay, bx, by, cx, cy)) ||
+            (o2 == 0 && onSegment(ax, ay, bx, by, dx, dy)) ||
+            (o3 == 0 && onSegment(cx, cy, dx, dy, ax, ay)) ||
+            (o4 == 0 && onSegment(cx, cy, dx, dy, bx, by))) {
+        return 1;
+    }
+
+    return 0;
+}
+
+#endif /* __GFRAME_TST_HELPERS_H__ */